@@ -0,0 +1,177 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace SatelliteSignal {
+
+// Opt-in heap allocation counter. Building with
+// SATELLITE_SIGNAL_TRACK_ALLOCATIONS and defining
+// ALLOCATION_TRACKER_IMPLEMENTATION in exactly one translation unit before
+// including this header replaces the global operator new/delete with
+// versions that count calls and bytes. Without both, nothing is replaced
+// and every count stays zero.
+//
+// Counts are process-wide. An AllocationScope additionally attributes the
+// calling thread's allocations to a named tag; allocations made by worker
+// threads the scope spawns land in the untagged bucket. Over-aligned
+// allocations go through the aligned operator new, which is not replaced,
+// and are not counted.
+class AllocationTracker {
+public:
+    static constexpr size_t MAX_TAGS = 64;
+    static constexpr size_t UNTAGGED = 0;
+
+    struct Snapshot {
+        uint64_t allocations = 0;
+        uint64_t deallocations = 0;
+        uint64_t bytes = 0;  // requested by the allocations
+
+        Snapshot operator-(const Snapshot& o) const {
+            return {allocations - o.allocations, deallocations - o.deallocations, bytes - o.bytes};
+        }
+    };
+
+    // True when the counting operators are linked into this program
+    static bool installed() { return installed_flag(); }
+
+    static Snapshot snapshot() {
+        const Counters& c = totals();
+        return {c.allocations.load(std::memory_order_relaxed),
+                c.deallocations.load(std::memory_order_relaxed),
+                c.bytes.load(std::memory_order_relaxed)};
+    }
+
+    // Index of the tag with this name, registered on first use. The name
+    // must outlive the program (a string literal). Past MAX_TAGS names
+    // share the untagged bucket.
+    static size_t tag(const char* name) {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        const char** names = tag_names();
+        for (size_t i = 1; i < MAX_TAGS; ++i) {
+            if (names[i] == nullptr) {
+                names[i] = name;
+                return i;
+            }
+            if (std::strcmp(names[i], name) == 0) return i;
+        }
+        return UNTAGGED;
+    }
+
+    static const char* tag_name(size_t index) {
+        return index == UNTAGGED ? "untagged" : tag_names()[index];
+    }
+
+    static Snapshot tag_snapshot(size_t index) {
+        const Counters& c = tag_counters()[index];
+        return {c.allocations.load(std::memory_order_relaxed),
+                c.deallocations.load(std::memory_order_relaxed),
+                c.bytes.load(std::memory_order_relaxed)};
+    }
+
+    // Called by the replacement operators
+    static void* allocate(size_t size) {
+        record(size);
+        void* p = std::malloc(size ? size : 1);
+        if (p == nullptr) throw std::bad_alloc();
+        return p;
+    }
+
+    static void deallocate(void* p) {
+        if (p == nullptr) return;
+        totals().deallocations.fetch_add(1, std::memory_order_relaxed);
+        tag_counters()[current_tag()].deallocations.fetch_add(1, std::memory_order_relaxed);
+        std::free(p);
+    }
+
+    static bool& installed_flag() {
+        static bool flag = false;
+        return flag;
+    }
+
+    static size_t& current_tag() {
+        thread_local size_t tag = UNTAGGED;
+        return tag;
+    }
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> deallocations{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    // Function-local statics: operator new can run before any other static
+    // initializer
+    static Counters& totals() {
+        static Counters c;
+        return c;
+    }
+
+    static Counters* tag_counters() {
+        static Counters c[MAX_TAGS];
+        return c;
+    }
+
+    static const char** tag_names() {
+        static const char* names[MAX_TAGS] = {};
+        return names;
+    }
+
+    static std::mutex& registry_mutex() {
+        static std::mutex m;
+        return m;
+    }
+
+    static void record(size_t size) {
+        Counters& c = totals();
+        c.allocations.fetch_add(1, std::memory_order_relaxed);
+        c.bytes.fetch_add(size, std::memory_order_relaxed);
+        Counters& t = tag_counters()[current_tag()];
+        t.allocations.fetch_add(1, std::memory_order_relaxed);
+        t.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+};
+
+// Attribute the calling thread's allocations to `tag` until destroyed;
+// scopes nest
+class AllocationScope {
+public:
+    explicit AllocationScope(size_t tag) : previous(AllocationTracker::current_tag()) {
+        AllocationTracker::current_tag() = tag;
+    }
+    explicit AllocationScope(const char* name) : AllocationScope(AllocationTracker::tag(name)) {}
+    ~AllocationScope() { AllocationTracker::current_tag() = previous; }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    size_t previous;
+};
+
+}  // namespace SatelliteSignal
+
+#if defined(SATELLITE_SIGNAL_TRACK_ALLOCATIONS) && defined(ALLOCATION_TRACKER_IMPLEMENTATION)
+
+// The nothrow forms default to these
+void* operator new(std::size_t size) { return SatelliteSignal::AllocationTracker::allocate(size); }
+void* operator new[](std::size_t size) { return SatelliteSignal::AllocationTracker::allocate(size); }
+void operator delete(void* p) noexcept { SatelliteSignal::AllocationTracker::deallocate(p); }
+void operator delete[](void* p) noexcept { SatelliteSignal::AllocationTracker::deallocate(p); }
+void operator delete(void* p, std::size_t) noexcept { SatelliteSignal::AllocationTracker::deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept { SatelliteSignal::AllocationTracker::deallocate(p); }
+
+namespace {
+const bool allocation_tracker_installed = (SatelliteSignal::AllocationTracker::installed_flag() = true);
+}
+
+#endif
+
+#endif // ALLOCATION_TRACKER_H
@@ -1,15 +1,60 @@
+// Counting operator new/delete live in this translation unit (see
+// allocation_tracker.h); they are only active with TRACK_ALLOCATIONS on
+#define ALLOCATION_TRACKER_IMPLEMENTATION
 #include <iostream>
 #include <vector>
 #include <complex>
 #include <random>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <stdexcept>
 #include "signal_processor.h"
 #include "satellite_ephemeris.h"
 #include "doppler_compensator.h"
 #include "benchmark_framework.h"
+#include "benchmark_compare.h"
+#include "fec_encoders.h"
+#include "catalog_propagator.h"
+#include "tle_catalog.h"
+#include "chebyshev_ephemeris.h"
+#include "topocentric_batch.h"
+#include "pass_predictor.h"
+#include "constellation_tracker.h"
+#include "visibility_index.h"
+#include "isl_analyzer.h"
+#include "satellite_table.h"
+#include "handover_scheduler.h"
+#include "coverage_grid.h"
+#include "conjunction_screener.h"
+#include "pipeline_benchmark.h"
+#include "metrics_registry.h"
+#include "iq_file_reader.h"
+#include "iq_recorder.h"
 
 using namespace SatelliteSignal;
 
+// Information bits coded by one call of an encoder benchmark
+BenchmarkFramework::Work throughput(double bits_per_iteration) {
+    return {bits_per_iteration, "bits", bits_per_iteration / 8.0};
+}
+
+// Items handled by one call of a benchmark, plus the input bytes it
+// streamed when given
+BenchmarkFramework::Work rate(double items_per_iteration, const std::string& unit,
+                              double bytes_per_iteration = 0.0) {
+    return {items_per_iteration, unit, bytes_per_iteration};
+}
+
+std::vector<uint8_t> make_random_bits(size_t count) {
+    std::vector<uint8_t> bits(count);
+    std::mt19937 gen(42);
+    for (auto& b : bits) b = gen() & 1;
+    return bits;
+}
+
 void benchmark_fir_filter() {
     const size_t BUFFER_SIZE = 10000;
     std::vector<double> input(BUFFER_SIZE);
@@ -23,8 +68,8 @@ void benchmark_fir_filter() {
     LowpassFilter filter(0.1, 64);
     
     BENCHMARK("FIR Filter (10k samples, 64-tap)", [&]() {
-        filter.process_buffer(input);
-    }, 100);
+        BenchmarkFramework::do_not_optimize(filter.process_buffer(input));
+    }, 100, rate(BUFFER_SIZE, "samples", BUFFER_SIZE * sizeof(double)));
 }
 
 void benchmark_doppler_compensation() {
@@ -41,8 +86,8 @@ void benchmark_doppler_compensation() {
     compensator.update_doppler(5000.0);
     
     BENCHMARK("Doppler Compensation (10k samples)", [&]() {
-        compensator.compensate_buffer(signal);
-    }, 100);
+        BenchmarkFramework::do_not_optimize(compensator.compensate_buffer(signal));
+    }, 100, rate(BUFFER_SIZE, "samples", BUFFER_SIZE * sizeof(ComplexSample)));
 }
 
 void benchmark_qpsk_demodulation() {
@@ -58,8 +103,8 @@ void benchmark_qpsk_demodulation() {
     QPSKDemodulator demod(0.0);
     
     BENCHMARK("QPSK Demodulation (1k symbols)", [&]() {
-        demod.demodulate(signal);
-    }, 100);
+        BenchmarkFramework::do_not_optimize(demod.demodulate(signal));
+    }, 100, rate(BUFFER_SIZE, "symbols", BUFFER_SIZE * sizeof(ComplexSample)));
 }
 
 void benchmark_signal_analysis() {
@@ -73,8 +118,8 @@ void benchmark_signal_analysis() {
     }
     
     BENCHMARK("Signal Analysis (10k samples)", [&]() {
-        SignalAnalyzer::analyze(signal);
-    }, 100);
+        BenchmarkFramework::do_not_optimize(SignalAnalyzer::analyze(signal));
+    }, 100, rate(BUFFER_SIZE, "samples", BUFFER_SIZE * sizeof(ComplexSample)));
 }
 
 void benchmark_frequency_search() {
@@ -88,7 +133,8 @@ void benchmark_frequency_search() {
     }
     
     BENCHMARK("Frequency Search (500 symbols, +-5kHz)", [&]() {
-        FrequencySearcher::search_frequency_range(signal, 0.0, 10000.0, 100.0, 1e6);
+        BenchmarkFramework::do_not_optimize(
+            FrequencySearcher::search_frequency_range(signal, 0.0, 10000.0, 100.0, 1e6));
     }, 10);
 }
 
@@ -117,9 +163,99 @@ void benchmark_ephemeris_calculation() {
     
     BENCHMARK("Ephemeris Position Calculation", [&]() {
         for (double t = 0; t < 15; t += 1) {
-            ephemeris.get_position(t);
+            BenchmarkFramework::do_not_optimize(ephemeris.get_position(t));
         }
-    }, 100);
+    }, 100, rate(15, "propagations"));
+
+    // Catalog scale: a spread of LEO-to-HEO elements through the SoA propagator
+    const size_t CATALOG_SIZE = 10000;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> angle(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<> revs(1.0, 16.0);
+    std::uniform_real_distribution<> ecc(0.0, 0.02);
+
+    CatalogPropagator catalog;
+    for (size_t i = 0; i < CATALOG_SIZE; ++i) {
+        TLE sat = tle;
+        sat.catalog_number = static_cast<long>(i);
+        sat.mean_motion = revs(gen);
+        sat.eccentricity = i % 10 == 0 ? 0.7 : ecc(gen);
+        sat.inclination = angle(gen) / 2.0;
+        sat.raan = angle(gen);
+        sat.argument_perigee = angle(gen);
+        sat.mean_anomaly = angle(gen);
+        catalog.add(sat);
+    }
+
+    CatalogPropagator::States states;
+    double minutes = 0.0;
+    BENCHMARK("Catalog Propagation (10k satellites)", [&]() {
+        catalog.propagate(minutes, states);
+        minutes += 1.0;
+    }, 100, rate(CATALOG_SIZE, "propagations"));
+
+    // The same catalog under SGP4/SDP4, the model the constellation tracker
+    // runs so bulk queries agree with pass prediction
+    CatalogPropagator::Config sgp4_cfg;
+    sgp4_cfg.model = CatalogPropagator::Model::SGP4;
+    CatalogPropagator sgp4_catalog(sgp4_cfg);
+    gen.seed(42);
+    for (size_t i = 0; i < CATALOG_SIZE; ++i) {
+        TLE sat = tle;
+        sat.catalog_number = static_cast<long>(i);
+        sat.mean_motion = revs(gen);
+        sat.eccentricity = i % 10 == 0 ? 0.7 : ecc(gen);
+        sat.inclination = angle(gen) / 2.0;
+        sat.raan = angle(gen);
+        sat.argument_perigee = angle(gen);
+        sat.mean_anomaly = angle(gen);
+        sgp4_catalog.add(sat);
+    }
+    minutes = 0.0;
+    BENCHMARK("Catalog Propagation SGP4 (10k satellites)", [&]() {
+        sgp4_catalog.propagate(minutes, states);
+        minutes += 1.0;
+    }, 20, rate(CATALOG_SIZE, "propagations"));
+}
+
+void benchmark_tle_catalog_load() {
+    // Synthetic public-catalog-sized file of 3-line element sets
+    const size_t CATALOG_SIZE = 30000;
+    const std::string path = "benchmark_catalog.tle";
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> angle(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<> revs(1.0, 16.0);
+    {
+        std::ofstream file(path, std::ios::binary);
+        std::string line1, line2;
+        for (size_t i = 0; i < CATALOG_SIZE; ++i) {
+            TLE tle = TLE();
+            tle.catalog_number = static_cast<long>(i + 1);
+            tle.epoch_year = 24;
+            tle.epoch_day = 100.0 + (i % 50) * 0.1;
+            tle.bstar = 1e-4;
+            tle.element_set_num = 1;
+            tle.mean_motion = revs(gen);
+            tle.eccentricity = 0.001;
+            tle.inclination = angle(gen) / 2.0;
+            tle.raan = angle(gen);
+            tle.argument_perigee = angle(gen);
+            tle.mean_anomaly = angle(gen);
+            TLECatalog::format_lines(tle, line1, line2);
+            file << "SAT-" << i << "\n" << line1 << "\n" << line2 << "\n";
+        }
+    }
+
+    TLECatalog catalog;
+    BENCHMARK("TLE Catalog Load (30k sets, mmap + SGP4 init)", [&]() {
+        catalog.load(path);
+    }, 10, rate(CATALOG_SIZE, "element sets"));
+
+    BENCHMARK("TLE Catalog Reload (30k sets, none changed)", [&]() {
+        catalog.reload(path);
+    }, 10, rate(CATALOG_SIZE, "element sets"));
+
+    std::remove(path.c_str());
 }
 
 void benchmark_topocentric_conversion() {
@@ -144,11 +280,40 @@ void benchmark_topocentric_conversion() {
 
     SatelliteEphemeris ephemeris(tle);
     GroundStation ground_station = {40.0, -105.0, 1600.0};
-    StateVector sat_pos = ephemeris.get_position(0.0);
+    StationFrame station_frame(ground_station);
+    const double minutes = 30.0;
+    StateVector sat_pos = ephemeris.get_position(minutes);
     
     BENCHMARK("Topocentric Conversion (AZ/EL/Range)", [&]() {
-        ephemeris.get_topocentric(sat_pos, ground_station);
-    }, 1000);
+        BenchmarkFramework::do_not_optimize(sat_pos);
+        BenchmarkFramework::do_not_optimize(ephemeris.get_topocentric(sat_pos, station_frame, minutes));
+    }, 0, rate(1, "conversions"));
+
+    // Batched: 10k catalog states against 8 stations per call
+    const size_t SATELLITES = 10000;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<> angle(0.0, 2.0 * M_PI);
+    CatalogPropagator catalog;
+    for (size_t i = 0; i < SATELLITES; ++i) {
+        TLE sat = tle;
+        sat.mean_motion = 12.0 + 4.0 * angle(gen) / (2.0 * M_PI);
+        sat.raan = angle(gen);
+        sat.mean_anomaly = angle(gen);
+        catalog.add(sat);
+    }
+    CatalogPropagator::States states = catalog.propagate(10.0);
+
+    TopocentricBatch batch;
+    const GroundStation stations[] = {
+        {40.0, -105.0, 1600.0}, {-33.9, 18.4, 10.0}, {78.2, 15.4, 500.0}, {35.4, 139.6, 40.0},
+        {-35.4, 149.0, 700.0}, {64.8, -147.7, 150.0}, {5.2, -52.8, 10.0}, {52.2, 5.0, 20.0}};
+    for (const auto& s : stations) batch.add_station(s);
+
+    TopocentricBatch::Views views;
+    const double gmst = ephemeris.get_gmst(10.0);
+    BENCHMARK("Topocentric Batch (10k satellites x 8 stations)", [&]() {
+        batch.compute(states, gmst, views);
+    }, 100, rate(SATELLITES * batch.station_count(), "views"));
 }
 
 void benchmark_doppler_shift_calculation() {
@@ -173,35 +338,906 @@ void benchmark_doppler_shift_calculation() {
 
     SatelliteEphemeris ephemeris(tle);
     GroundStation ground_station = {40.0, -105.0, 1600.0};
-    StateVector sat_pos = ephemeris.get_position(0.0);
-    TopocentricView view = ephemeris.get_topocentric(sat_pos, ground_station);
+    const double minutes = 30.0;
+    StateVector sat_pos = ephemeris.get_position(minutes);
+    TopocentricView view = ephemeris.get_topocentric(sat_pos, ground_station, minutes);
     
     BENCHMARK("Doppler Shift Calculation", [&]() {
-        ephemeris.calculate_doppler_shift(view, 10e9);
-    }, 10000);
+        // Hide the constant input too, or the call is hoisted out of the loop
+        BenchmarkFramework::do_not_optimize(view);
+        BenchmarkFramework::do_not_optimize(ephemeris.calculate_doppler_shift(view, 10e9));
+    }, 0, rate(1, "calculations"));
+
+    // Per-block Doppler updates: 1000 lookups per iteration at 1 ms spacing,
+    // direct SGP4 versus the Chebyshev cache
+    const int LOOKUPS = 1000;
+    StateVector observer = {-1232.0, -4648.0, 4078.0, 0.339, -0.090, 0.0};
+    volatile double sink = 0.0;
+    double t0 = 0.0;
+    BENCHMARK("Doppler Lookup, SGP4 per query (1000 queries)", [&]() {
+        for (int i = 0; i < LOOKUPS; ++i) {
+            StateVector s = ephemeris.get_position(t0 + i * (1.0 / 60000.0));
+            double dx = s.x - observer.x;
+            double dy = s.y - observer.y;
+            double dz = s.z - observer.z;
+            double range_rate = ((s.vx - observer.vx) * dx + (s.vy - observer.vy) * dy +
+                                 (s.vz - observer.vz) * dz) / std::sqrt(dx * dx + dy * dy + dz * dz);
+            sink = doppler_shift_hz(range_rate, 10e9);
+        }
+        t0 += LOOKUPS / 60000.0;
+    }, 100, rate(LOOKUPS, "lookups"));
+
+    ChebyshevEphemeris cache(tle);
+    t0 = 0.0;
+    BENCHMARK("Doppler Lookup, Chebyshev cache (1000 queries)", [&]() {
+        for (int i = 0; i < LOOKUPS; ++i) {
+            sink = cache.get_doppler_shift(t0 + i * (1.0 / 60000.0), observer, 10e9);
+        }
+        t0 += LOOKUPS / 60000.0;
+    }, 100, rate(LOOKUPS, "lookups"));
+    std::cout << "  Cache error bound: " << std::scientific << std::setprecision(2)
+              << cache.get_error_bound() * 1e3 << " m\n\n" << std::fixed;
+}
+
+void benchmark_pass_prediction() {
+    // Walker 53:500/10/1 shell at 550 km over three stations, one day
+    ConstellationTracker::ConstellationConfig cfg = {"BENCH", 500, 550.0, 53.0, 10, 50};
+    PassPredictor predictor;
+    predictor.add_satellites(ConstellationTracker::generate_elements(cfg));
+    predictor.add_station({40.0, -105.0, 1600.0});
+    predictor.add_station({-33.9, 18.4, 10.0});
+    predictor.add_station({78.2, 15.4, 500.0});
+
+    const double start_jd = SGP4Propagator::epoch_julian_date(24, 1.0);
+    size_t passes = 0;
+    BENCHMARK("Pass Prediction (500 satellites x 3 stations x 1 day)", [&]() {
+        passes = predictor.predict(start_jd, 1440.0).size();
+    }, 5);
+    const auto& result = BenchmarkFramework::instance().get_results().back();
+    std::cout << "  Passes found: " << passes << "\n"
+              << "  Rate:   " << std::fixed << std::setprecision(1)
+              << predictor.satellite_count() * predictor.station_count() / (result.mean_ms * 1e-3)
+              << " satellite-station days/s\n\n";
+}
+
+void benchmark_visibility_index() {
+    // Walker 53:10080/72/1 shell at 550 km, 64 stations on a lat/lon grid
+    ConstellationTracker::ConstellationConfig cfg = {"BENCH", 10080, 550.0, 53.0, 72, 140};
+    CatalogPropagator catalog;
+    catalog.add(ConstellationTracker::generate_elements(cfg));
+    CatalogPropagator::States states = catalog.propagate(10.0);
+
+    VisibilityIndex index;
+    std::vector<GroundStation> stations;
+    for (int i = 0; i < 64; ++i) {
+        stations.push_back({-60.0 + 120.0 * (i / 8) / 7.0, -180.0 + 45.0 * (i % 8), 0.0});
+        index.add_station(stations.back(), 10.0);
+    }
+
+    const double gmst = 1.0;
+    std::vector<std::vector<uint32_t>> visible;
+    size_t total = 0;
+    BENCHMARK("Visibility Index (10k satellites, build + 64 station queries)", [&]() {
+        index.build(states, gmst);
+        index.query_all(visible);
+    }, 100, rate(64.0, "station queries"));
+    for (const auto& v : visible) total += v.size();
+
+    // Same answer by scanning every satellite for every station
+    std::vector<StationFrame> frames(stations.begin(), stations.end());
+    BENCHMARK("Visibility Brute Force (10k satellites x 64 stations)", [&]() {
+        for (size_t k = 0; k < frames.size(); ++k) {
+            visible[k].clear();
+            for (size_t i = 0; i < states.size(); ++i) {
+                if (frames[k].view(states.get(i), gmst).elevation >= 10.0) {
+                    visible[k].push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+    }, 10, rate(64.0, "station queries"));
+    std::cout << "  Visible (satellite, station) pairs: " << total << "\n\n";
+}
+
+void benchmark_isl_analysis() {
+    // Walker 53:4032/72/1 shell at 550 km
+    ConstellationTracker::ConstellationConfig cfg = {"BENCH", 4032, 550.0, 53.0, 72, 56};
+    CatalogPropagator catalog;
+    catalog.add(ConstellationTracker::generate_elements(cfg));
+    CatalogPropagator::States states = catalog.propagate(10.0);
+
+    ISLAnalyzer::Config isl_cfg;
+    isl_cfg.max_range_km = 2000.0;
+    ISLAnalyzer isl(isl_cfg);
+    std::vector<ISLAnalyzer::Link> links;
+    BENCHMARK("ISL Analysis, grid (4032 satellites, 2000 km)", [&]() {
+        isl.analyze(states, links);
+    }, 50);
+    std::cout << "  Links: " << links.size() << "\n\n";
+
+    // All pairs with the same range and occultation tests
+    const double range2 = isl_cfg.max_range_km * isl_cfg.max_range_km;
+    const double clear = WGS84_A_KM + isl_cfg.grazing_altitude_km;
+    size_t count = 0;
+    BENCHMARK("ISL Analysis, all pairs (4032 satellites, 2000 km)", [&]() {
+        count = 0;
+        for (size_t i = 0; i < states.size(); ++i) {
+            for (size_t j = i + 1; j < states.size(); ++j) {
+                double dx = states.x[j] - states.x[i];
+                double dy = states.y[j] - states.y[i];
+                double dz = states.z[j] - states.z[i];
+                double d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 <= range2 && ISLAnalyzer::clears_earth(states.x[i], states.y[i], states.z[i],
+                                                              dx, dy, dz, d2, clear * clear)) ++count;
+            }
+        }
+    }, 5);
+    std::cout << "  Links: " << count << "\n\n";
+}
+
+void benchmark_handover_scheduling() {
+    // Walker 53:500/10/1 shell over 20 two-antenna stations, three days
+    ConstellationTracker::ConstellationConfig cfg = {"BENCH", 500, 550.0, 53.0, 10, 50};
+    HandoverScheduler::Config sc;
+    sc.prediction.min_elevation_deg = 10.0;
+    HandoverScheduler scheduler(sc);
+    scheduler.add_satellites(ConstellationTracker::generate_elements(cfg));
+    for (int i = 0; i < 20; ++i) {
+        scheduler.add_station({-50.0 + 100.0 * (i % 5) / 4.0, -180.0 + 90.0 * (i / 5) + 18.0 * (i % 5), 100.0}, 2);
+    }
+    const double start_jd = SGP4Propagator::epoch_julian_date(24, 1.0);
+    BENCHMARK("Pass Prediction (500 satellites x 20 stations x 3 days)", [&]() {
+        scheduler.predict(start_jd, 3.0 * 1440.0);
+    }, 1);
+    std::cout << "  Passes found: " << scheduler.get_passes().size() << "\n\n";
+
+    std::vector<HandoverScheduler::Contact> plan;
+    BENCHMARK("Contact Plan, min-cost flow (20 stations x 2 antennas x 3 days)", [&]() {
+        plan = scheduler.plan();
+    }, 10);
+    std::cout << "  Contacts: " << plan.size() << ", " << std::fixed << std::setprecision(1)
+              << HandoverScheduler::contact_minutes(plan) / 60.0 << " h tracked\n\n";
+
+    HandoverScheduler::Config greedy_cfg = sc;
+    greedy_cfg.solver = HandoverScheduler::Solver::Greedy;
+    HandoverScheduler greedy(greedy_cfg);
+    for (int i = 0; i < 20; ++i) greedy.add_station({0.0, 0.0, 0.0}, 2);
+    greedy.set_passes(scheduler.get_passes());
+    BENCHMARK("Contact Plan, greedy (20 stations x 2 antennas x 3 days)", [&]() {
+        plan = greedy.plan();
+    }, 10);
+    std::cout << "  Contacts: " << plan.size() << ", " << std::fixed << std::setprecision(1)
+              << HandoverScheduler::contact_minutes(plan) / 60.0 << " h tracked\n\n";
+
+    const int QUERIES = 10000;
+    std::vector<uint32_t> visible;
+    size_t found = 0;
+    BENCHMARK("Visible-from-any-station Queries (10k x 10 min windows)", [&]() {
+        found = 0;
+        for (int q = 0; q < QUERIES; ++q) {
+            double t0 = q * (3.0 * 1440.0 / QUERIES);
+            scheduler.visible_satellites(t0, t0 + 10.0, visible);
+            found += visible.size();
+        }
+    }, 10, rate(QUERIES, "queries"));
+    std::cout << "  Mean satellites per window: " << std::setprecision(1)
+              << static_cast<double>(found) / QUERIES << "\n\n";
+}
+
+void benchmark_coverage_analysis() {
+    // Walker 53:500/10/1 shell over one day at 1-minute steps, 2-degree cells
+    ConstellationTracker::ConstellationConfig cfg = {"BENCH", 500, 550.0, 53.0, 10, 50};
+    CatalogPropagator catalog;
+    catalog.add(ConstellationTracker::generate_elements(cfg));
+    const double epoch_jd = SGP4Propagator::epoch_julian_date(24, 1.0);
+
+    CoverageGrid grid;
+    BENCHMARK("Coverage Analysis (500 satellites x 1 day, 2 deg cells)", [&]() {
+        grid.analyze(catalog, epoch_jd, 0.0, 1440.0);
+    }, 5, rate(grid.cell_count() * 1440.0 / grid.get_config().time_step_minutes, "cell-steps"));
+    auto stats = grid.statistics();
+    std::cout << "  Cells: " << grid.cell_count() << ", coverage " << std::fixed << std::setprecision(1)
+              << stats.coverage_percent << "%, max revisit gap " << stats.max_revisit_gap_minutes
+              << " min, mean response " << stats.mean_response_minutes << " min\n\n";
+
+    CoverageGrid::Placement placement;
+    BENCHMARK("Station Placement (10 sites from every cell)", [&]() {
+        placement = grid.place_stations(catalog, epoch_jd, 0.0, 1440.0, 10);
+    }, 5);
+    std::cout << "  Candidates: " << grid.cell_count() << ", contact with 10 sites: "
+              << std::setprecision(1) << placement.contact_percent.back() << "%\n\n";
+}
+
+void benchmark_conjunction_screening() {
+    // Walker 53:10080/72/1 shell plus a crossing 97-degree shell of 2000,
+    // one hour at 10 s steps against a 5 km screening distance
+    ConstellationTracker::ConstellationConfig shell = {"BENCH", 10080, 550.0, 53.0, 72, 140};
+    ConstellationTracker::ConstellationConfig polar = {"BENCH", 2000, 552.0, 97.0, 40, 50};
+    CatalogPropagator catalog;
+    catalog.add(ConstellationTracker::generate_elements(shell));
+    catalog.add(ConstellationTracker::generate_elements(polar));
+
+    ConjunctionScreener screener;
+    std::vector<ConjunctionScreener::Conjunction> found;
+    BENCHMARK("Conjunction Screening (12k satellites x 1 hour)", [&]() {
+        screener.screen(catalog, 0.0, 60.0, found);
+    }, 3);
+    const auto& result = BenchmarkFramework::instance().get_results().back();
+    std::cout << "  Conjunctions: " << found.size() << ", refined pairs: " << screener.get_candidate_count()
+              << "\n  Projected 24 h screen: " << std::fixed << std::setprecision(1)
+              << result.mean_ms * 24.0 / 1000.0 << " s\n\n";
+
+    // The same screen on SGP4 states, as ConstellationTracker runs it
+    CatalogPropagator::Config sgp4_config;
+    sgp4_config.model = CatalogPropagator::Model::SGP4;
+    CatalogPropagator sgp4_catalog(sgp4_config);
+    sgp4_catalog.add(ConstellationTracker::generate_elements(shell));
+    sgp4_catalog.add(ConstellationTracker::generate_elements(polar));
+    BENCHMARK("Conjunction Screening SGP4 (12k satellites x 1 hour)", [&]() {
+        screener.screen(sgp4_catalog, 0.0, 60.0, found);
+    }, 3);
+    const auto& sgp4_result = BenchmarkFramework::instance().get_results().back();
+    std::cout << "  Conjunctions: " << found.size() << ", refined pairs: " << screener.get_candidate_count()
+              << "\n  Projected 24 h screen: " << sgp4_result.mean_ms * 24.0 / 1000.0 << " s\n\n";
+
+    // All pairs at one 10 s step, for scale
+    CatalogPropagator::States states = catalog.propagate(0.0);
+    size_t close = 0;
+    BENCHMARK("Conjunction Screening, all pairs (12k satellites x 1 step)", [&]() {
+        close = 0;
+        for (size_t i = 0; i < states.size(); ++i) {
+            for (size_t j = i + 1; j < states.size(); ++j) {
+                double dx = states.x[j] - states.x[i];
+                double dy = states.y[j] - states.y[i];
+                double dz = states.z[j] - states.z[i];
+                close += dx * dx + dy * dy + dz * dz < 100.0 * 100.0;
+            }
+        }
+    }, 3);
+    const auto& pairs = BenchmarkFramework::instance().get_results().back();
+    std::cout << "  Pairs within 100 km: " << close << "\n  Projected 24 h screen: "
+              << pairs.mean_ms * 8640.0 / 1000.0 << " s (distance test only)\n\n";
+}
+
+void benchmark_constellation_update() {
+    // Walker 53:10080/72/1 shell: bulk propagation, geodetic columns,
+    // visibility index and in-range flags per update
+    ConstellationTracker::ConstellationConfig cfg = {"STARLINK", 10080, 550.0, 53.0, 72, 140};
+    ConstellationTracker tracker(cfg);
+    double t = 0.0;
+    BENCHMARK("Constellation Update (10k satellites)", [&]() {
+        tracker.update(t);
+        t += 1.0;
+    }, 100, rate(static_cast<double>(tracker.get_satellite_count()), "satellites"));
+
+    // Per-satellite storage against the former record with an owned name
+    struct SatelliteRecord {
+        int catalog_number;
+        std::string name;
+        double latitude, longitude, altitude_km, velocity_km_s, signal_strength_dbm;
+        bool in_range;
+    };
+    const SatelliteTable& table = tracker.get_satellites();
+    std::cout << "  Satellite table: " << std::setprecision(1)
+              << static_cast<double>(table.memory_bytes()) / table.size() << " bytes/satellite (record: "
+              << sizeof(SatelliteRecord) << " bytes + name)\n\n";
+
+    // One changed element set patched in place against the full update above
+    std::vector<TLE> elements = ConstellationTracker::generate_elements(cfg);
+    SatelliteId id = 0;
+    BENCHMARK("Constellation Incremental Update (1 of 10k satellites)", [&]() {
+        TLE tle = elements[id];
+        tle.raan += 0.01;
+        tracker.update_satellite(id, tle);
+        id = (id + 7919) % static_cast<SatelliteId>(elements.size());
+    }, 1000, rate(1.0, "updates"));
+}
+
+void benchmark_convolutional_encoder() {
+    const size_t NUM_BYTES = 1 << 16;
+    std::vector<uint8_t> input(NUM_BYTES), output(NUM_BYTES * 2);
+    std::mt19937 gen(42);
+    for (auto& b : input) b = static_cast<uint8_t>(gen());
+
+    ConvolutionalEncoder encoder;
+    BENCHMARK("Convolutional Encoder (K=7 r=1/2, 512 kbit)", [&]() {
+        encoder.encode_packed(input.data(), input.size(), output.data());
+    }, 100, throughput(NUM_BYTES * 8.0));
+}
+
+void benchmark_reed_solomon_encoder() {
+    const size_t NUM_BLOCKS = 64;
+    std::vector<uint8_t> data(NUM_BLOCKS * 223), coded;
+    std::mt19937 gen(42);
+    for (auto& b : data) b = static_cast<uint8_t>(gen());
+
+    ReedSolomonEncoder encoder;
+    BENCHMARK("Reed-Solomon Encoder (255,223) x64", [&]() {
+        encoder.encode(data, coded);
+    }, 100, throughput(data.size() * 8.0));
+}
+
+void benchmark_ldpc_encoder() {
+    auto bits = make_random_bits(32400);
+    std::vector<uint8_t> coded;
+
+    LDPCEncoder encoder;
+    BENCHMARK("LDPC Encoder (64800,32400)", [&]() {
+        encoder.encode(bits, coded);
+    }, 100, throughput(bits.size()));
+}
+
+void benchmark_turbo_encoder() {
+    auto bits = make_random_bits(6144);
+    std::vector<uint8_t> coded;
+
+    TurboEncoder encoder;
+    BENCHMARK("Turbo Encoder (K=6144, QPP)", [&]() {
+        encoder.encode(bits, coded);
+    }, 100, throughput(bits.size()));
+}
+
+void benchmark_hamming_encoder() {
+    auto bits = make_random_bits(65536);
+    std::vector<uint8_t> coded;
+
+    HammingEncoder encoder;
+    BENCHMARK("Hamming Encoder (7,4) 64 kbit", [&]() {
+        encoder.encode(bits, coded);
+    }, 100, throughput(bits.size()));
+}
+
+// Hot-path cost of the live metrics: one update per item
+void benchmark_metrics() {
+    MetricsRegistry registry;
+    ReceiverMetrics metrics(registry);
+    const int updates = 1000;
+
+    BENCHMARK("Metrics Counter Increment (1k)", [&]() {
+        for (int i = 0; i < updates; ++i) metrics.samples_processed.inc();
+    }, 0, rate(updates, "updates"));
+
+    BENCHMARK("Metrics Gauge Set (1k)", [&]() {
+        for (int i = 0; i < updates; ++i) metrics.snr_db.set(i * 0.01);
+    }, 0, rate(updates, "updates"));
+
+    BENCHMARK("Metrics Histogram Observe (1k)", [&]() {
+        for (int i = 0; i < updates; ++i) metrics.block_latency_seconds.observe(i * 1e-5);
+    }, 0, rate(updates, "updates"));
+
+    // Every worker hitting the same counter; the shards keep them apart
+    const unsigned threads = default_thread_count();
+    const int per_thread = 100000;
+    std::ostringstream name;
+    name << "Metrics Counter Increment (" << threads << " threads x 100k)";
+    BENCHMARK(name.str(), [&]() {
+        parallel_workers(threads, [&](unsigned) {
+            for (int i = 0; i < per_thread; ++i) metrics.samples_processed.inc();
+        });
+    }, 0, rate(static_cast<double>(threads) * per_thread, "updates"));
+}
+
+// Streaming a 256 MiB cf32 capture through the mapped reader: block views
+// alone (read every sample in place) and with conversion to ComplexSample
+void benchmark_iq_file() {
+    const std::string path = "benchmark_capture.cf32";
+    const size_t samples = 32 << 20;
+    {
+        std::ofstream file(path, std::ios::binary);
+        std::vector<std::complex<float>> chunk(1 << 20);
+        std::mt19937 gen(7);
+        std::normal_distribution<float> noise(0.0f, 0.5f);
+        for (auto& s : chunk) s = {noise(gen), noise(gen)};
+        for (size_t written = 0; written < samples; written += chunk.size()) {
+            file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(chunk[0]));
+        }
+    }
+
+    IQFileReader::Config cfg;
+    cfg.block_samples = 1 << 16;
+    IQFileReader reader(cfg);
+    if (!reader.open(path)) {
+        std::cerr << "  " << reader.get_error() << "\n";
+        return;
+    }
+    const double bytes = static_cast<double>(samples) * iq_sample_bytes(IQFormat::CF32);
+
+    BENCHMARK("IQ File Stream cf32 (256 MiB, views)", [&]() {
+        reader.rewind();
+        IQBlock block;
+        float power[8] = {};  // independent sums, so the loop is not one serial add chain
+        while (reader.next(block)) {
+            const float* v = reinterpret_cast<const float*>(block.data);
+            for (size_t i = 0; i + 8 <= 2 * block.samples; i += 8) {
+                for (int k = 0; k < 8; ++k) power[k] += v[i + k] * v[i + k];
+            }
+        }
+        BenchmarkFramework::do_not_optimize(power);
+    }, 0, rate(static_cast<double>(samples), "samples", bytes));
+
+    std::vector<ComplexSample> converted;
+    BENCHMARK("IQ File Stream cf32 (256 MiB, to ComplexSample)", [&]() {
+        reader.rewind();
+        IQBlock block;
+        while (reader.next(block)) {
+            IQFileReader::to_complex(block, converted);
+            BenchmarkFramework::do_not_optimize(converted.data());
+        }
+    }, 0, rate(static_cast<double>(samples), "samples", bytes));
+
+    reader.close();
+    std::remove(path.c_str());
+}
+
+// Producer side of recording 256 MiB of cf32 offered as fast as possible:
+// the latency of each write(), the rate the disk sustained and what it had
+// to drop to keep write() from blocking
+void benchmark_iq_recorder() {
+    const std::string base = "benchmark_recording";
+    const size_t block_samples = 4096;
+    const size_t blocks = 8192;
+
+    std::vector<ComplexSample> block(block_samples);
+    std::mt19937 gen(11);
+    std::normal_distribution<double> noise(0.0, 0.3);
+    for (auto& s : block) s = ComplexSample(noise(gen), noise(gen));
+
+    IQRecorder recorder;
+    if (!recorder.open(base)) {
+        std::cerr << "  " << recorder.get_error() << "\n";
+        return;
+    }
+    LatencyHistogram latency;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < blocks; ++b) {
+        auto t0 = std::chrono::steady_clock::now();
+        recorder.write(block);
+        latency.record(std::chrono::steady_clock::now() - t0);
+    }
+    std::chrono::duration<double> offered = std::chrono::steady_clock::now() - start;
+    recorder.close();
+    std::chrono::duration<double> drained = std::chrono::steady_clock::now() - start;
+    const auto stats = recorder.get_stats();
+
+    auto& framework = BenchmarkFramework::instance();
+    framework.record("IQ Recorder write (4096-sample blocks, cf32)", latency,
+                     rate(static_cast<double>(block_samples), "samples",
+                          block_samples * iq_sample_bytes(IQFormat::CF32)));
+    std::cout << "  Offered:          " << std::fixed << std::setprecision(1)
+              << blocks * block_samples / offered.count() / 1e6 << " MS/s from the producer (unpaced)\n";
+    std::cout << "  Written:          " << stats.bytes_written / drained.count() / (1024.0 * 1024.0)
+              << " MiB/s to disk until close() returned\n";
+    std::cout << "  Recorded:         " << stats.samples_recorded << " samples, " << stats.samples_dropped
+              << " dropped (" << std::setprecision(2)
+              << 100.0 * stats.samples_dropped / (blocks * block_samples) << "%), backlog peak "
+              << stats.max_queued_blocks << " of " << recorder.get_config().buffers << " buffers, "
+              << (stats.direct_io ? "O_DIRECT" : "buffered") << "\n\n";
+
+    std::remove((base + ".sigmf-data").c_str());
+    std::remove((base + ".sigmf-meta").c_str());
+}
+
+// Real-time factor, stage shares and block latency tail of one run
+void report_receive_chain(const ReceiveChainBenchmark::Config& cfg, const ReceiveChainBenchmark::Result& r) {
+    std::cout << "  Sample rate:      " << std::fixed << std::setprecision(3) << cfg.sample_rate / 1e6 << " MS/s, "
+              << r.blocks << " blocks of " << cfg.block_size << " (" << r.block_period_ms << " ms each)\n";
+    std::cout << "  Processed rate:   " << r.processed_sample_rate / 1e6 << " MS/s\n";
+    std::cout << "  Real-time factor: " << std::setprecision(2) << r.realtime_factor
+              << (r.realtime_factor >= 1.0 ? "  (keeps up)" : "  (FALLS BEHIND)") << "\n";
+    std::cout << "  Block latency:    p50 " << std::setprecision(3) << r.p50_ms << " ms, p90 " << r.p90_ms
+              << " ms, p99 " << r.p99_ms << " ms, p99.9 " << r.p999_ms << " ms, max " << r.max_ms << " ms\n";
+    std::cout << "  Stage p99:       ";
+    for (int s = ReceiveChainBenchmark::Doppler; s < ReceiveChainBenchmark::STAGE_COUNT; ++s) {
+        auto stage = static_cast<ReceiveChainBenchmark::Stage>(s);
+        std::cout << " " << ReceiveChainBenchmark::stage_name(stage) << " " << std::setprecision(3)
+                  << r.stage_latency[s].percentile_ms(99.0) << " ms";
+    }
+    std::cout << "\n";
+    std::cout << "  Stage share:     ";
+    for (int s = 0; s < ReceiveChainBenchmark::STAGE_COUNT; ++s) {
+        auto stage = static_cast<ReceiveChainBenchmark::Stage>(s);
+        std::cout << " " << ReceiveChainBenchmark::stage_name(stage) << " " << std::setprecision(1)
+                  << 100.0 * r.stage_share(stage) << "%";
+    }
+    std::cout << "\n";
+    if (AllocationTracker::installed()) {
+        std::cout << "  Allocs per block:";
+        for (int s = 0; s < ReceiveChainBenchmark::STAGE_COUNT; ++s) {
+            auto stage = static_cast<ReceiveChainBenchmark::Stage>(s);
+            std::cout << " " << ReceiveChainBenchmark::stage_name(stage) << " " << std::setprecision(1)
+                      << r.stage_allocations[s];
+        }
+        std::cout << " (" << std::setprecision(0) << r.allocated_bytes_per_block() << " bytes in the chain)\n";
+    }
+    std::cout << "\n";
+}
+
+// Runs the receive chain at `cfg` and records its block latencies
+void run_receive_chain(const ReceiveChainBenchmark::Config& cfg) {
+    auto result = ReceiveChainBenchmark(cfg).run();
+    std::ostringstream name;
+    name << "Receive Chain (" << std::defaultfloat << cfg.sample_rate / 1e6 << " MS/s, "
+         << cfg.block_size << "-sample blocks)";
+    auto& framework = BenchmarkFramework::instance();
+    framework.record(name.str(), result.block_latency,
+                     rate(static_cast<double>(cfg.block_size), "samples", cfg.block_size * sizeof(ComplexSample)));
+    framework.set_allocations(result.allocations_per_block(), result.allocated_bytes_per_block());
+    report_receive_chain(cfg, result);
+}
+
+void benchmark_receive_chain() {
+    // Two seconds of a 1 MS/s stream, as configured in the demo
+    ReceiveChainBenchmark::Config cfg;
+    run_receive_chain(cfg);
+}
+
+// ---------------------------------------------------------------------------
+// Scaling sweeps: parameterized families over buffer size, taps, search bins,
+// catalog size and thread count. Run with --sweeps; each family ends with a
+// table and every point lands in the JSON with its parameters.
+// ---------------------------------------------------------------------------
+
+// 1, 2, 4, ... up to and including the core count
+std::vector<unsigned> sweep_thread_counts() {
+    std::vector<unsigned> counts;
+    const unsigned cores = default_thread_count();
+    for (unsigned t = 1; t < cores; t *= 2) counts.push_back(t);
+    counts.push_back(cores);
+    return counts;
+}
+
+// Random LEO-to-HEO catalog, as in the propagation benchmark
+CatalogPropagator make_random_catalog(size_t count, const CatalogPropagator::Config& cfg) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> angle(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<> revs(1.0, 16.0);
+    std::uniform_real_distribution<> ecc(0.0, 0.02);
+
+    TLE tle{};
+    CatalogPropagator catalog(cfg);
+    catalog.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        tle.catalog_number = static_cast<long>(i);
+        tle.mean_motion = revs(gen);
+        tle.eccentricity = i % 10 == 0 ? 0.7 : ecc(gen);
+        tle.inclination = angle(gen) / 2.0;
+        tle.raan = angle(gen);
+        tle.argument_perigee = angle(gen);
+        tle.mean_anomaly = angle(gen);
+        catalog.add(tle);
+    }
+    return catalog;
+}
+
+void sweep_dsp_buffer_sizes() {
+    auto& framework = BenchmarkFramework::instance();
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+
+    // 256 samples (8 KB in and out, L1) to 4M samples (128 MB, DRAM)
+    for (size_t n = 256; n <= (size_t(1) << 22); n *= 4) {
+        std::vector<ComplexSample> signal(n);
+        for (auto& x : signal) x = ComplexSample(dis(gen), dis(gen));
+        DopplerCompensator compensator(1e6);
+        compensator.update_doppler(5000.0);
+        framework.run("Doppler Compensation", {{"samples", double(n)}}, [&]() {
+            BenchmarkFramework::do_not_optimize(compensator.compensate_buffer(signal));
+        }, 0, rate(double(n), "samples", 2.0 * n * sizeof(ComplexSample)));
+    }
+    framework.print_table("Doppler Compensation");
+
+    for (size_t n = 256; n <= (size_t(1) << 18); n *= 4) {
+        std::vector<double> input(n);
+        for (auto& x : input) x = dis(gen);
+        LowpassFilter filter(0.1, 64);
+        framework.run("FIR Filter", {{"samples", double(n)}, {"taps", 64}}, [&]() {
+            BenchmarkFramework::do_not_optimize(filter.process_buffer(input));
+        }, 0, rate(double(n), "samples", 2.0 * n * sizeof(double)));
+    }
+    framework.print_table("FIR Filter");
+}
+
+void sweep_fir_taps() {
+    auto& framework = BenchmarkFramework::instance();
+    const size_t BUFFER_SIZE = 16384;
+    std::vector<double> input(BUFFER_SIZE);
+    std::mt19937 gen(42);
+    std::normal_distribution<> dis(0.0, 1.0);
+    for (auto& x : input) x = dis(gen);
+
+    for (size_t taps = 8; taps <= 512; taps *= 2) {
+        LowpassFilter filter(0.1, taps);
+        framework.run("FIR Filter Taps", {{"taps", double(taps)}, {"samples", double(BUFFER_SIZE)}}, [&]() {
+            BenchmarkFramework::do_not_optimize(filter.process_buffer(input));
+        }, 0, rate(double(BUFFER_SIZE * taps), "taps"));
+    }
+    framework.print_table("FIR Filter Taps");
+}
+
+void sweep_frequency_search_bins() {
+    auto& framework = BenchmarkFramework::instance();
+    const size_t BUFFER_SIZE = 500;
+    const double WIDTH = 10000.0;
+    std::vector<ComplexSample> signal(BUFFER_SIZE);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+    for (auto& x : signal) x = ComplexSample(dis(gen), dis(gen));
+
+    for (double step : {1000.0, 400.0, 200.0, 100.0, 50.0, 25.0, 12.5}) {
+        double bins = std::floor(WIDTH / step) + 1.0;
+        framework.run("Frequency Search", {{"bins", bins}, {"symbols", double(BUFFER_SIZE)}}, [&]() {
+            BenchmarkFramework::do_not_optimize(
+                FrequencySearcher::search_frequency_range(signal, 0.0, WIDTH, step, 1e6));
+        }, 0, rate(bins, "bins"));
+    }
+    framework.print_table("Frequency Search");
 }
 
-void run_all_benchmarks() {
+void sweep_catalog_sizes() {
+    auto& framework = BenchmarkFramework::instance();
+    CatalogPropagator::States states;
+    for (size_t n = 1024; n <= (size_t(1) << 18); n *= 4) {
+        CatalogPropagator catalog = make_random_catalog(n, CatalogPropagator::Config());
+        double minutes = 0.0;
+        framework.run("Catalog Propagation", {{"satellites", double(n)}}, [&]() {
+            catalog.propagate(minutes, states);
+            minutes += 1.0;
+        }, 0, rate(double(n), "propagations", n * 6.0 * sizeof(double)));
+    }
+    framework.print_table("Catalog Propagation");
+}
+
+void sweep_thread_scaling() {
+    auto& framework = BenchmarkFramework::instance();
+
+    const size_t SATELLITES = 1 << 18;
+    CatalogPropagator::States states;
+    for (unsigned threads : sweep_thread_counts()) {
+        CatalogPropagator::Config cfg;
+        cfg.num_threads = threads;
+        CatalogPropagator catalog = make_random_catalog(SATELLITES, cfg);
+        double minutes = 0.0;
+        framework.run("Catalog Propagation Threads", {{"threads", double(threads)}}, [&]() {
+            catalog.propagate(minutes, states);
+            minutes += 1.0;
+        }, 0, rate(double(SATELLITES), "propagations"));
+    }
+    framework.print_table("Catalog Propagation Threads");
+
+    ConstellationTracker::ConstellationConfig walker = {"BENCH", 500, 550.0, 53.0, 10, 50};
+    CatalogPropagator shell;
+    shell.add(ConstellationTracker::generate_elements(walker));
+    const double epoch_jd = SGP4Propagator::epoch_julian_date(24, 1.0);
+    for (unsigned threads : sweep_thread_counts()) {
+        CoverageGrid::Config cfg;
+        cfg.num_threads = threads;
+        CoverageGrid grid(cfg);
+        framework.run("Coverage Analysis Threads", {{"threads", double(threads)}}, [&]() {
+            grid.analyze(shell, epoch_jd, 0.0, 360.0);
+        }, 0, rate(grid.cell_count() * 360.0 / cfg.time_step_minutes, "cell-steps"));
+    }
+    framework.print_table("Coverage Analysis Threads");
+
+    ConstellationTracker::ConstellationConfig dense = {"BENCH", 10080, 550.0, 53.0, 72, 140};
+    ConstellationTracker::ConstellationConfig polar = {"BENCH", 2000, 552.0, 97.0, 40, 50};
+    CatalogPropagator catalog;
+    catalog.add(ConstellationTracker::generate_elements(dense));
+    catalog.add(ConstellationTracker::generate_elements(polar));
+    std::vector<ConjunctionScreener::Conjunction> found;
+    for (unsigned threads : sweep_thread_counts()) {
+        ConjunctionScreener::Config cfg;
+        cfg.num_threads = threads;
+        ConjunctionScreener screener(cfg);
+        framework.run("Conjunction Screening Threads", {{"threads", double(threads)}}, [&]() {
+            screener.screen(catalog, 0.0, 10.0, found);
+        }, 0, rate(catalog.size() * 60.0, "satellite-steps"));
+    }
+    framework.print_table("Conjunction Screening Threads");
+}
+
+struct BenchmarkOptions {
+    std::string filter;              // run only groups whose name contains this
+    std::string baseline_file;       // compare mode when set
+    std::string json_file = "benchmark_results.json";
+    bool json_given = false;
+    bool sweeps = false;             // run the scaling sweeps instead of the suite
+    std::vector<double> pipeline_rates;  // run only the receive chain at these rates
+    ReceiveChainBenchmark::Config pipeline;
+    int min_samples = 0;             // 0 = 1, or 10 in compare mode
+    std::string trace_file;          // Chrome trace of the run when set
+    BenchmarkComparison::Config compare;
+};
+
+static const std::vector<std::pair<std::string, void (*)()>> BENCHMARK_GROUPS = {
+    {"fir_filter", benchmark_fir_filter},
+    {"doppler_compensation", benchmark_doppler_compensation},
+    {"qpsk_demodulation", benchmark_qpsk_demodulation},
+    {"signal_analysis", benchmark_signal_analysis},
+    {"frequency_search", benchmark_frequency_search},
+    {"ephemeris", benchmark_ephemeris_calculation},
+    {"tle_catalog", benchmark_tle_catalog_load},
+    {"topocentric", benchmark_topocentric_conversion},
+    {"doppler_shift", benchmark_doppler_shift_calculation},
+    {"pass_prediction", benchmark_pass_prediction},
+    {"visibility_index", benchmark_visibility_index},
+    {"isl", benchmark_isl_analysis},
+    {"handover", benchmark_handover_scheduling},
+    {"coverage", benchmark_coverage_analysis},
+    {"conjunction", benchmark_conjunction_screening},
+    {"constellation_update", benchmark_constellation_update},
+    {"metrics", benchmark_metrics},
+    {"iq_file", benchmark_iq_file},
+    {"iq_recorder", benchmark_iq_recorder},
+    {"receive_chain", benchmark_receive_chain},
+    {"fec_convolutional", benchmark_convolutional_encoder},
+    {"fec_reed_solomon", benchmark_reed_solomon_encoder},
+    {"fec_ldpc", benchmark_ldpc_encoder},
+    {"fec_turbo", benchmark_turbo_encoder},
+    {"fec_hamming", benchmark_hamming_encoder},
+};
+
+static const std::vector<std::pair<std::string, void (*)()>> SWEEP_GROUPS = {
+    {"dsp_buffer_sizes", sweep_dsp_buffer_sizes},
+    {"fir_taps", sweep_fir_taps},
+    {"frequency_search_bins", sweep_frequency_search_bins},
+    {"catalog_sizes", sweep_catalog_sizes},
+    {"thread_scaling", sweep_thread_scaling},
+};
+
+static void print_help() {
+    std::cout << "\nSatellite Signal Processing Benchmarks\n";
+    std::cout << "======================================\n\n";
+    std::cout << "USAGE:\n";
+    std::cout << "  benchmark_suite [OPTIONS]\n\n";
+    std::cout << "OPTIONS:\n";
+    std::cout << "  --filter TEXT             Run only groups whose name contains TEXT\n";
+    std::cout << "  --list                    List benchmark groups\n";
+    std::cout << "  --sweeps                  Run the scaling sweeps (sizes, taps, bins,\n";
+    std::cout << "                            threads) instead of the suite\n";
+    std::cout << "  --pipeline RATES          Run only the receive chain at comma-separated\n";
+    std::cout << "                            sample rates in Hz (e.g. 1e6,4e6,16e6)\n";
+    std::cout << "  --block N                 Receive chain block size (default: 4096)\n";
+    std::cout << "  --duration S              Receive chain stream length (default: 2 s)\n";
+    std::cout << "  --json FILE               Results file (default: benchmark_results.json,\n";
+    std::cout << "                            benchmark_sweeps.json with --sweeps)\n";
+    std::cout << "  --compare FILE            Compare against a baseline results file; exits 1\n";
+    std::cout << "                            on any significant regression past the threshold\n";
+    std::cout << "  --threshold PCT           Allowed slowdown in compare mode (default: 5)\n";
+    std::cout << "  --tail-threshold PCT      Allowed p99 slowdown of results with 1000 samples,\n";
+    std::cout << "                            or more, such as the receive chain (default: 10)\n";
+    std::cout << "  --alpha P                 Significance level in compare mode (default: 0.01)\n";
+    std::cout << "  --min-samples N           Samples per benchmark at least (default: 1,\n";
+    std::cout << "                            10 in compare mode)\n";
+    std::cout << "  --trace FILE              Write a Chrome trace of the run (needs a build\n";
+    std::cout << "                            with -DENABLE_TRACING=ON)\n";
+    std::cout << "  --help, -h                Print this help message\n\n";
+    std::cout << "EXIT STATUS:\n";
+    std::cout << "  0 on success, 1 on a regression in compare mode, 2 on bad options or\n";
+    std::cout << "  unreadable files\n\n";
+}
+
+static BenchmarkOptions parse_options(int argc, char* argv[]) {
+    BenchmarkOptions opts;
+    int i = 1;
+    try {
+        for (; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                print_help();
+                std::exit(0);
+            }
+            else if (arg == "--list") {
+                for (const auto& group : BENCHMARK_GROUPS) std::cout << group.first << "\n";
+                for (const auto& group : SWEEP_GROUPS) std::cout << group.first << " (--sweeps)\n";
+                std::exit(0);
+            }
+            else if (arg == "--sweeps") opts.sweeps = true;
+            else if (arg == "--pipeline" && i + 1 < argc) {
+                std::stringstream rates(argv[++i]);
+                std::string rate;
+                while (std::getline(rates, rate, ',')) opts.pipeline_rates.push_back(std::stod(rate));
+            }
+            else if (arg == "--block" && i + 1 < argc) opts.pipeline.block_size = std::stoull(argv[++i]);
+            else if (arg == "--duration" && i + 1 < argc) opts.pipeline.duration_seconds = std::stod(argv[++i]);
+            else if (arg == "--filter" && i + 1 < argc) opts.filter = argv[++i];
+            else if (arg == "--json" && i + 1 < argc) {
+                opts.json_file = argv[++i];
+                opts.json_given = true;
+            }
+            else if (arg == "--compare" && i + 1 < argc) opts.baseline_file = argv[++i];
+            else if (arg == "--threshold" && i + 1 < argc) opts.compare.threshold_percent = std::stod(argv[++i]);
+            else if (arg == "--tail-threshold" && i + 1 < argc) opts.compare.tail_threshold_percent = std::stod(argv[++i]);
+            else if (arg == "--alpha" && i + 1 < argc) opts.compare.alpha = std::stod(argv[++i]);
+            else if (arg == "--min-samples" && i + 1 < argc) opts.min_samples = std::stoi(argv[++i]);
+            else if (arg == "--trace" && i + 1 < argc) opts.trace_file = argv[++i];
+            else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                print_help();
+                std::exit(2);
+            }
+        }
+    }
+    catch (const std::logic_error&) {
+        // std::stod and friends throw on values that are not numbers or out of range
+        std::cerr << "Invalid value for " << argv[i - 1] << ": " << argv[i] << "\n";
+        print_help();
+        std::exit(2);
+    }
+    if (opts.sweeps && !opts.json_given) opts.json_file = "benchmark_sweeps.json";
+    return opts;
+}
+
+void run_all_benchmarks(const BenchmarkOptions& opts) {
     std::cout << "\n";
     std::cout << "================================================================\n";
     std::cout << "              SATELLITE SIGNAL PROCESSING BENCHMARKS           \n";
     std::cout << "================================================================\n";
     std::cout << "\nRunning comprehensive performance analysis...\n";
-    
-    benchmark_fir_filter();
-    benchmark_doppler_compensation();
-    benchmark_qpsk_demodulation();
-    benchmark_signal_analysis();
-    benchmark_frequency_search();
-    benchmark_ephemeris_calculation();
-    benchmark_topocentric_conversion();
-    benchmark_doppler_shift_calculation();
-    
-    BenchmarkFramework::instance().print_all_results();
-    BenchmarkFramework::instance().export_json("benchmark_results.json");
+
+    if (!opts.pipeline_rates.empty()) {
+        for (double rate : opts.pipeline_rates) {
+            ReceiveChainBenchmark::Config cfg = opts.pipeline;
+            cfg.sample_rate = rate;
+            run_receive_chain(cfg);
+        }
+        return;
+    }
+
+    for (const auto& group : opts.sweeps ? SWEEP_GROUPS : BENCHMARK_GROUPS) {
+        if (group.first.find(opts.filter) != std::string::npos) group.second();
+    }
+
+    if (!opts.sweeps) BenchmarkFramework::instance().print_all_results();
 }
 
-int main() {
-    run_all_benchmarks();
-    return 0;
-}
\ No newline at end of file
+int main(int argc, char* argv[]) {
+    BenchmarkOptions opts = parse_options(argc, argv);
+    const bool compare = !opts.baseline_file.empty();
+
+    std::vector<BenchmarkFramework::BenchmarkResult> baseline;
+    if (compare && !BenchmarkComparison::load(opts.baseline_file, baseline)) {
+        std::cerr << "Error: cannot read baseline " << opts.baseline_file << "\n";
+        return 2;
+    }
+
+    // A handful of samples per benchmark gives the rank test something to
+    // work with; single-shot timings cannot show significance
+    auto& framework = BenchmarkFramework::instance();
+    BenchmarkFramework::Config cfg = framework.get_config();
+    cfg.min_samples = opts.min_samples > 0 ? opts.min_samples : (compare ? 10 : 1);
+    if (opts.sweeps) {
+        // Many points, each auto-calibrated: a shorter budget per point
+        cfg.auto_time_ms = 200.0;
+        cfg.auto_min_samples = 5;
+    }
+    framework.set_config(cfg);
+
+    auto& tracer = Tracer::instance();
+    if (!opts.trace_file.empty()) {
+#ifndef SATELLITE_SIGNAL_TRACING
+        std::cerr << "Warning: built without ENABLE_TRACING; the trace will be empty\n";
+#endif
+        tracer.set_thread_name("main");
+        tracer.start();
+    }
+
+    run_all_benchmarks(opts);
+
+    if (!opts.trace_file.empty()) {
+        tracer.stop();
+        if (!tracer.export_chrome_trace(opts.trace_file)) {
+            std::cerr << "Error: cannot write trace " << opts.trace_file << "\n";
+            return 2;
+        }
+        std::cout << "\n✓ Trace written to: " << opts.trace_file;
+        if (tracer.dropped_events() > 0) std::cout << " (" << tracer.dropped_events() << " oldest events overwritten)";
+        std::cout << "\n";
+    }
+
+    // Compare runs leave the baseline alone unless asked to write results
+    if (!compare || opts.json_given) framework.export_json(opts.json_file);
+    if (!compare) return 0;
+
+    BenchmarkComparison comparison(opts.compare);
+    int regressions = comparison.report(comparison.compare(baseline, framework.get_results()));
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,450 @@
+#ifndef BENCHMARK_COMPARE_H
+#define BENCHMARK_COMPARE_H
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "benchmark_framework.h"
+
+// Compares benchmark results against a baseline exported by
+// BenchmarkFramework::export_json. Each benchmark is judged on the
+// histogram of its per-call sample times, with every bucket a run of tied
+// values: a Mann-Whitney U test says whether the two runs differ at all,
+// and a bootstrap interval on the ratio of medians says by how much. A
+// benchmark regresses when the difference is significant and the median
+// slowed down by more than the threshold, or when both runs have enough
+// samples for a p99 and it slowed down by more than the tail threshold.
+//
+// Baseline entries without a histogram are gated on their percentiles
+// alone; those with neither are reported as untested.
+class BenchmarkComparison {
+public:
+    struct Config {
+        double threshold_percent = 5.0;  // slowdowns within this are not regressions
+        double tail_threshold_percent = 10.0;  // p99 slowdowns
+        uint64_t tail_min_samples = 1000;     // per run, before the p99 is gated
+        double alpha = 0.01;             // significance level
+        int bootstrap_resamples = 2000;
+        double confidence = 0.95;        // bootstrap interval
+        uint32_t seed = 1;
+    };
+
+    enum class Verdict { Faster, Slower, Regression, Unchanged, Untested, Missing };
+
+    struct Comparison {
+        std::string name;
+        double baseline_median_ms = 0.0;
+        double current_median_ms = 0.0;
+        double ratio = 1.0;                  // current / baseline median
+        double ratio_low = 1.0, ratio_high = 1.0;
+        double p_value = 1.0;
+        bool sampled = false;                // judged on histograms, not percentiles alone
+        double tail_ratio = 1.0;             // current / baseline p99
+        Verdict verdict = Verdict::Missing;
+    };
+
+    // Per-call sample times as (ms, count) in ascending order: the non-empty
+    // histogram buckets at their midpoints, scaled by the batch size
+    using Distribution = std::vector<std::pair<double, uint64_t>>;
+
+    struct MannWhitney {
+        double u = 0.0;        // U statistic of the first sample
+        double z = 0.0;
+        double p_value = 1.0;  // two-sided
+    };
+
+    BenchmarkComparison() : BenchmarkComparison(Config()) {}
+    explicit BenchmarkComparison(const Config& cfg) : config(cfg) {}
+
+    // Read the benchmarks of a results file; false if it cannot be parsed.
+    // Raw times_ms from older files are loaded into the histogram; files
+    // with neither compare on percentiles, or not at all.
+    static bool load(const std::string& filename, std::vector<BenchmarkFramework::BenchmarkResult>& out) {
+        std::ifstream file(filename);
+        if (!file.is_open()) return false;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        JsonReader reader(buffer.str());
+        out.clear();
+        return reader.read_results(out);
+    }
+
+    std::vector<Comparison> compare(const std::vector<BenchmarkFramework::BenchmarkResult>& baseline,
+                                    const std::vector<BenchmarkFramework::BenchmarkResult>& current) const {
+        std::map<std::string, const BenchmarkFramework::BenchmarkResult*> by_name;
+        for (const auto& b : baseline) by_name[b.name] = &b;
+
+        std::vector<Comparison> out;
+        for (const auto& c : current) {
+            Comparison cmp;
+            cmp.name = c.name;
+            cmp.current_median_ms = c.median_ms;
+            auto it = by_name.find(c.name);
+            if (it != by_name.end()) compare(*it->second, c, cmp);
+            out.push_back(cmp);
+        }
+        return out;
+    }
+
+    static Distribution distribution(const BenchmarkFramework::BenchmarkResult& result) {
+        Distribution d;
+        const auto& h = result.histogram;
+        const double scale = 1e-6 / std::max(1, result.batch);
+        for (size_t i = 0; i < h.bucket_count(); ++i) {
+            if (h.bucket(i) == 0) continue;
+            d.push_back({0.5 * (h.lowest_equivalent(i) + h.highest_equivalent(i)) * scale, h.bucket(i)});
+        }
+        return d;
+    }
+
+    // Two-sided test with the normal approximation, corrected for ties and
+    // continuity. Values shared by both distributions form one run of ties.
+    static MannWhitney mann_whitney(const Distribution& a, const Distribution& b) {
+        MannWhitney result;
+        double n1 = 0.0, n2 = 0.0;
+        for (const auto& x : a) n1 += x.second;
+        for (const auto& x : b) n2 += x.second;
+        const double n = n1 + n2;
+        if (n1 == 0.0 || n2 == 0.0) return result;
+
+        // Average ranks over runs of ties, merging the two in value order
+        double rank_sum_a = 0.0, tie_term = 0.0, seen = 0.0;
+        for (size_t i = 0, j = 0; i < a.size() || j < b.size();) {
+            double value = j == b.size() || (i < a.size() && a[i].first <= b[j].first) ? a[i].first : b[j].first;
+            double ca = i < a.size() && a[i].first == value ? static_cast<double>(a[i++].second) : 0.0;
+            double cb = j < b.size() && b[j].first == value ? static_cast<double>(b[j++].second) : 0.0;
+            double t = ca + cb;
+            rank_sum_a += ca * (seen + 0.5 * (t + 1.0));
+            tie_term += t * t * t - t;
+            seen += t;
+        }
+
+        result.u = rank_sum_a - 0.5 * n1 * (n1 + 1);
+        const double mean = 0.5 * n1 * n2;
+        const double variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)));
+        if (variance <= 0.0) return result;
+        double diff = std::fabs(result.u - mean);
+        result.z = (result.u > mean ? 1.0 : -1.0) * std::max(0.0, diff - 0.5) / std::sqrt(variance);
+        result.p_value = std::erfc(std::fabs(result.z) / std::sqrt(2.0));
+        return result;
+    }
+
+    // Percentile bootstrap interval for median(current) / median(baseline)
+    void bootstrap_ratio(const Distribution& baseline, const Distribution& current,
+                         double& low, double& high) const {
+        std::mt19937 rng(config.seed);
+        std::vector<double> ratios;
+        ratios.reserve(config.bootstrap_resamples);
+        for (int r = 0; r < config.bootstrap_resamples; ++r) {
+            double mb = resample_median(baseline, rng);
+            if (mb > 0.0) ratios.push_back(resample_median(current, rng) / mb);
+        }
+        if (ratios.empty()) {
+            low = high = 1.0;
+            return;
+        }
+        std::sort(ratios.begin(), ratios.end());
+        double tail = 0.5 * (1.0 - config.confidence);
+        low = ratios[static_cast<size_t>(tail * (ratios.size() - 1))];
+        high = ratios[static_cast<size_t>((1.0 - tail) * (ratios.size() - 1))];
+    }
+
+    // Print a table of the comparisons; returns the number of regressions
+    int report(const std::vector<Comparison>& comparisons, std::ostream& os = std::cout) const {
+        int regressions = 0, untested = 0;
+        os << "\n================================================================\n";
+        os << "              BASELINE COMPARISON (threshold " << std::fixed << std::setprecision(1)
+           << config.threshold_percent << "%, alpha " << std::setprecision(3) << config.alpha << ")\n";
+        os << "================================================================\n\n";
+        os << std::left << std::setw(58) << "Benchmark" << std::right << std::setw(12) << "Base ms"
+           << std::setw(12) << "Now ms" << std::setw(9) << "Change" << std::setw(20) << "Median CI"
+           << std::setw(10) << "p" << "  Verdict\n";
+        for (const auto& c : comparisons) {
+            os << std::left << std::setw(58) << c.name.substr(0, 57) << std::right;
+            if (c.verdict == Verdict::Missing) {
+                os << std::setw(12) << "-" << std::setw(12) << std::setprecision(6) << c.current_median_ms
+                   << "  not in baseline\n";
+                continue;
+            }
+            // Percentile-gated results show the p99 change in place of the
+            // interval, and no p-value
+            std::ostringstream ci, p;
+            ci << std::showpos << std::fixed << std::setprecision(1);
+            if (c.sampled) {
+                ci << (c.ratio_low - 1.0) * 100.0 << "%.." << (c.ratio_high - 1.0) * 100.0 << "%";
+                p << std::scientific << std::setprecision(1) << c.p_value;
+            } else {
+                if (c.verdict != Verdict::Untested) ci << "p99 " << (c.tail_ratio - 1.0) * 100.0 << "%";
+                p << "-";
+            }
+            std::ostringstream change;
+            change << std::showpos << std::fixed << std::setprecision(1) << (c.ratio - 1.0) * 100.0 << "%";
+            os << std::setw(12) << std::setprecision(6) << c.baseline_median_ms
+               << std::setw(12) << c.current_median_ms << std::setw(9) << change.str()
+               << std::setw(20) << ci.str() << std::setw(10) << p.str() << "  " << verdict_name(c.verdict) << "\n";
+            if (c.verdict == Verdict::Regression) ++regressions;
+            if (c.verdict == Verdict::Untested) ++untested;
+        }
+        os << "\n" << regressions << " regression(s) past " << std::setprecision(1)
+           << config.threshold_percent << "%";
+        if (untested > 0) os << ", " << untested << " untested (no samples or percentiles to compare)";
+        os << "\n";
+        return regressions;
+    }
+
+    static const char* verdict_name(Verdict v) {
+        switch (v) {
+            case Verdict::Faster: return "faster";
+            case Verdict::Slower: return "slower";
+            case Verdict::Regression: return "REGRESSION";
+            case Verdict::Unchanged: return "unchanged";
+            case Verdict::Untested: return "untested";
+            default: return "missing";
+        }
+    }
+
+    const Config& get_config() const { return config; }
+
+private:
+    Config config;
+
+    // Median of a resample with replacement of `d`, as large as `d`. The
+    // bucket counts are multinomial, drawn as a chain of binomials, so a
+    // resample costs one draw per bucket rather than one per sample.
+    static double resample_median(const Distribution& d, std::mt19937& rng) {
+        uint64_t total = 0;
+        for (const auto& x : d) total += x.second;
+        uint64_t remaining = total, left = total, seen = 0;
+        const uint64_t half = (total + 1) / 2;
+        for (size_t k = 0; k < d.size(); ++k) {
+            uint64_t c = remaining;
+            if (k + 1 < d.size() && remaining > 0) {
+                double p = std::min(1.0, static_cast<double>(d[k].second) / left);
+                c = std::binomial_distribution<uint64_t>(remaining, p)(rng);
+            }
+            left -= d[k].second;
+            remaining -= c;
+            seen += c;
+            if (seen >= half) return d[k].first;
+        }
+        return d.empty() ? 0.0 : d.back().first;
+    }
+
+    void compare(const BenchmarkFramework::BenchmarkResult& base, const BenchmarkFramework::BenchmarkResult& now,
+                 Comparison& cmp) const {
+        cmp.baseline_median_ms = base.median_ms;
+        cmp.ratio = base.median_ms > 0.0 ? now.median_ms / base.median_ms : 1.0;
+        cmp.ratio_low = cmp.ratio_high = cmp.ratio;
+        const double limit = 1.0 + config.threshold_percent / 100.0;
+
+        const double tail_limit = 1.0 + config.tail_threshold_percent / 100.0;
+        if (base.p99_ms > 0.0 && now.p99_ms > 0.0) cmp.tail_ratio = now.p99_ms / base.p99_ms;
+
+        // Without a histogram on both sides there is nothing to test, so the
+        // percentiles are held to the thresholds directly
+        if (base.histogram.empty() || now.histogram.empty()) {
+            if (base.median_ms <= 0.0 || base.p99_ms <= 0.0 || now.p99_ms <= 0.0) {
+                cmp.verdict = Verdict::Untested;
+                return;
+            }
+            if (cmp.ratio > limit || cmp.tail_ratio > tail_limit) {
+                cmp.verdict = Verdict::Regression;
+            } else {
+                cmp.verdict = cmp.ratio < 1.0 / limit ? Verdict::Faster : Verdict::Unchanged;
+            }
+            return;
+        }
+        cmp.sampled = true;
+        const Distribution b = distribution(base), c = distribution(now);
+        cmp.p_value = mann_whitney(c, b).p_value;
+        bootstrap_ratio(b, c, cmp.ratio_low, cmp.ratio_high);
+
+        const bool tail_gated = base.histogram.count() >= config.tail_min_samples &&
+                                now.histogram.count() >= config.tail_min_samples;
+        if (tail_gated && cmp.tail_ratio > tail_limit) {
+            cmp.verdict = Verdict::Regression;
+        } else if (cmp.p_value >= config.alpha) {
+            cmp.verdict = Verdict::Unchanged;
+        } else if (cmp.ratio < 1.0) {
+            cmp.verdict = Verdict::Faster;
+        } else {
+            cmp.verdict = cmp.ratio > limit ? Verdict::Regression : Verdict::Slower;
+        }
+    }
+
+    // Just enough JSON for export_json's output: objects, arrays, strings,
+    // numbers and literals, with the fields of each benchmark picked out
+    class JsonReader {
+    public:
+        explicit JsonReader(std::string text) : s(std::move(text)) {}
+
+        bool read_results(std::vector<BenchmarkFramework::BenchmarkResult>& out) {
+            skip_ws();
+            if (!consume('{')) return false;
+            if (peek() == '}') return true;
+            do {
+                std::string key;
+                if (!read_string(key) || !consume(':')) return false;
+                if (key == "benchmarks") {
+                    if (!read_benchmarks(out)) return false;
+                } else if (!skip_value()) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume('}');
+        }
+
+    private:
+        std::string s;
+        size_t pos = 0;
+
+        void skip_ws() {
+            while (pos < s.size() && std::isspace(static_cast<unsigned char>(s[pos]))) ++pos;
+        }
+
+        char peek() {
+            skip_ws();
+            return pos < s.size() ? s[pos] : '\0';
+        }
+
+        bool consume(char c) {
+            if (peek() != c) return false;
+            ++pos;
+            return true;
+        }
+
+        bool read_string(std::string& out) {
+            if (!consume('"')) return false;
+            out.clear();
+            while (pos < s.size() && s[pos] != '"') {
+                char c = s[pos++];
+                if (c == '\\' && pos < s.size()) {
+                    char e = s[pos++];
+                    switch (e) {
+                        case 'b': c = '\b'; break;
+                        case 'f': c = '\f'; break;
+                        case 'n': c = '\n'; break;
+                        case 'r': c = '\r'; break;
+                        case 't': c = '\t'; break;
+                        default: c = e;
+                    }
+                }
+                out += c;
+            }
+            return pos++ < s.size();
+        }
+
+        bool read_number(double& out) {
+            skip_ws();
+            const char* begin = s.c_str() + pos;
+            char* end = nullptr;
+            out = std::strtod(begin, &end);
+            if (end == begin) return false;
+            pos += static_cast<size_t>(end - begin);
+            return true;
+        }
+
+        bool read_numbers(std::vector<double>& out) {
+            if (!consume('[')) return false;
+            if (consume(']')) return true;
+            do {
+                double x;
+                if (!read_number(x)) return false;
+                out.push_back(x);
+            } while (consume(','));
+            return consume(']');
+        }
+
+        bool read_integer(int& out) {
+            double x;
+            if (!read_number(x)) return false;
+            out = std::max(1, static_cast<int>(x));
+            return true;
+        }
+
+        // [[lowest ns, count], ...] as written by export_json
+        bool read_buckets(SatelliteSignal::LatencyHistogram& out) {
+            if (!consume('[')) return false;
+            if (consume(']')) return true;
+            do {
+                std::vector<double> pair;
+                if (!read_numbers(pair) || pair.size() != 2) return false;
+                out.record(static_cast<uint64_t>(pair[0]), static_cast<uint64_t>(pair[1]));
+            } while (consume(','));
+            return consume(']');
+        }
+
+        bool skip_value() {
+            char c = peek();
+            if (c == '"') {
+                std::string ignored;
+                return read_string(ignored);
+            }
+            if (c == '{' || c == '[') {
+                char close = c == '{' ? '}' : ']';
+                ++pos;
+                if (consume(close)) return true;
+                do {
+                    if (c == '{') {
+                        std::string key;
+                        if (!read_string(key) || !consume(':')) return false;
+                    }
+                    if (!skip_value()) return false;
+                } while (consume(','));
+                return consume(close);
+            }
+            if (std::isalpha(static_cast<unsigned char>(c))) {
+                while (pos < s.size() && std::isalpha(static_cast<unsigned char>(s[pos]))) ++pos;
+                return true;
+            }
+            double ignored;
+            return read_number(ignored);
+        }
+
+        bool read_benchmarks(std::vector<BenchmarkFramework::BenchmarkResult>& out) {
+            if (!consume('[')) return false;
+            if (consume(']')) return true;
+            do {
+                BenchmarkFramework::BenchmarkResult r{};
+                std::vector<double> times_ms;
+                if (!consume('{')) return false;
+                if (!consume('}')) {
+                    do {
+                        std::string key;
+                        if (!read_string(key) || !consume(':')) return false;
+                        bool ok = true;
+                        if (key == "name") ok = read_string(r.name);
+                        else if (key == "min_ms") ok = read_number(r.min_ms);
+                        else if (key == "max_ms") ok = read_number(r.max_ms);
+                        else if (key == "mean_ms") ok = read_number(r.mean_ms);
+                        else if (key == "median_ms") ok = read_number(r.median_ms);
+                        else if (key == "stddev_ms") ok = read_number(r.stddev_ms);
+                        else if (key == "p99_ms") ok = read_number(r.p99_ms);
+                        else if (key == "batch") ok = read_integer(r.batch);
+                        else if (key == "histogram_ns") ok = read_buckets(r.histogram);
+                        else if (key == "times_ms") ok = read_numbers(times_ms);
+                        else ok = skip_value();
+                        if (!ok) return false;
+                    } while (consume(','));
+                    if (!consume('}')) return false;
+                }
+                for (double t : times_ms) r.histogram.record(static_cast<uint64_t>(std::llround(t * 1e6 * r.batch)));
+                out.push_back(r);
+            } while (consume(','));
+            return consume(']');
+        }
+    };
+};
+
+#endif
@@ -12,17 +12,155 @@
 #include <fstream>
 #include <ctime>
 #include <sstream>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "allocation_tracker.h"
+#include "latency_histogram.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#ifndef _MSC_VER
+#include <x86intrin.h>
+#endif
+#define BENCHMARK_HAS_TSC 1
+#endif
+
+// CPU cycle counter: the hardware cycle counter through perf_event_open when
+// the kernel allows it, else the time-stamp counter (reference cycles at the
+// nominal clock rather than core cycles), else nothing
+class CycleCounter {
+public:
+    CycleCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            if (read_perf() != 0 || read_perf() != 0) {
+                counter_source = "perf_event";
+                return;
+            }
+            close(fd);
+            fd = -1;
+        }
+#endif
+#ifdef BENCHMARK_HAS_TSC
+        counter_source = "tsc";
+#endif
+    }
+
+    ~CycleCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    CycleCounter(const CycleCounter&) = delete;
+    CycleCounter& operator=(const CycleCounter&) = delete;
+
+    bool available() const { return !counter_source.empty(); }
+
+    // "perf_event", "tsc" or empty when no counter is available
+    const std::string& source() const { return counter_source; }
+
+    uint64_t now() const {
+#ifdef __linux__
+        if (fd >= 0) return read_perf();
+#endif
+#ifdef BENCHMARK_HAS_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+private:
+    std::string counter_source;
+#ifdef __linux__
+    int fd = -1;
+
+    uint64_t read_perf() const {
+        uint64_t value = 0;
+        if (read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) return 0;
+        return value;
+    }
+#endif
+};
 
 class BenchmarkFramework {
 public:
+    struct Config {
+        double warmup_ms = 20.0;        // untimed calls before measuring (at least one)
+        double min_sample_ms = 0.05;    // fast bodies run in batches at least this long
+        double auto_time_ms = 500.0;    // measuring budget when iterations = 0
+        int auto_min_samples = 10;
+        int auto_max_samples = 100000;
+        int min_samples = 1;            // floor on every benchmark's sample count
+    };
+
+    // Parameter values of one point in a benchmark family, in column order
+    using Params = std::vector<std::pair<std::string, double>>;
+
+    // Times are per call of the benchmark body; each sample times `batch`
+    // back-to-back calls. Every statistic comes from `histogram`, which holds
+    // the sample durations (of the whole batch) in nanoseconds; raw samples
+    // are not kept.
     struct BenchmarkResult {
         std::string name;
-        std::vector<double> times_ms;
+        std::string family;                 // empty for a standalone benchmark
+        Params params;
+        SatelliteSignal::LatencyHistogram histogram;
         double min_ms;
         double max_ms;
         double mean_ms;
         double median_ms;
         double stddev_ms;
+        double p90_ms = 0.0;
+        double p99_ms = 0.0;
+        double p999_ms = 0.0;
+        int batch = 1;
+        int warmup_iterations = 0;
+        double cycles_per_iteration = 0.0;  // median; 0 when not measured
+        std::string cycle_source;
+        double items_per_iteration = 0.0;
+        std::string item_unit;
+        double bytes_per_iteration = 0.0;
+        bool allocations_tracked = false;    // counting operators linked in
+        double allocations_per_iteration = 0.0;
+        double allocated_bytes_per_iteration = 0.0;
+
+        double items_per_second() const { return items_per_iteration / (mean_ms * 1e-3); }
+        double bytes_per_second() const { return bytes_per_iteration / (mean_ms * 1e-3); }
+    };
+
+    // Work done by one call of the benchmark body, such as {4096,
+    // "samples", 32768}; printed and exported as rates from the mean time
+    struct Work {
+        double items;
+        std::string unit;
+        double bytes;
+
+        Work(double items_per_call = 0.0, std::string item_unit = "items", double bytes_per_call = 0.0)
+            : items(items_per_call), unit(std::move(item_unit)), bytes(bytes_per_call) {}
     };
 
     static BenchmarkFramework& instance() {
@@ -30,29 +168,172 @@ public:
         return bf;
     }
 
-    void run(const std::string& name, std::function<void()> func, int iterations = 1000) {
-        std::vector<double> times;
-        
-        for (int i = 0; i < iterations; ++i) {
-            auto start = std::chrono::high_resolution_clock::now();
+    void set_config(const Config& cfg) { config = cfg; }
+    const Config& get_config() const { return config; }
+
+    // Keep `value` and everything it points to alive: the compiler must
+    // assume the barrier reads it, so the work producing it cannot be
+    // discarded as dead code
+    template <typename T>
+    static void do_not_optimize(T&& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+        _ReadWriteBarrier();
+#endif
+    }
+
+    // Force pending stores to memory before the barrier
+    static void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        _ReadWriteBarrier();
+#endif
+    }
+
+    // Run `func` for `iterations` timed samples after a warmup. Bodies
+    // faster than Config::min_sample_ms are batched so the clock resolution
+    // does not dominate. iterations = 0 picks the sample count to fill
+    // Config::auto_time_ms.
+    void run(const std::string& name, std::function<void()> func, int iterations = 1000,
+             const Work& work = Work()) {
+        using Clock = std::chrono::steady_clock;
+
+        // Warmup also estimates the cost of one call for batching
+        int warmup = 0;
+        auto warmup_start = Clock::now();
+        double elapsed_ms = 0.0;
+        do {
             func();
-            auto end = std::chrono::high_resolution_clock::now();
-            
-            double duration_ms = std::chrono::duration<double, std::milli>(end - start).count();
-            times.push_back(duration_ms);
+            ++warmup;
+            elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - warmup_start).count();
+        } while (elapsed_ms < config.warmup_ms);
+        const double call_ms = elapsed_ms / warmup;
+
+        int batch = 1;
+        if (call_ms < config.min_sample_ms) {
+            batch = static_cast<int>(std::ceil(config.min_sample_ms / std::max(call_ms, 1e-6)));
+        }
+        if (iterations <= 0) {
+            double samples = config.auto_time_ms / (call_ms * batch);
+            iterations = static_cast<int>(std::min<double>(config.auto_max_samples,
+                                                           std::max<double>(config.auto_min_samples, samples)));
+        }
+        iterations = std::max(iterations, config.min_samples);
+
+        std::vector<double> cycles;
+        SatelliteSignal::LatencyHistogram histogram;
+        if (cycle_counter.available()) cycles.reserve(iterations);
+
+        const auto allocations_before = SatelliteSignal::AllocationTracker::snapshot();
+        for (int i = 0; i < iterations; ++i) {
+            uint64_t c0 = cycle_counter.now();
+            auto start = Clock::now();
+            for (int b = 0; b < batch; ++b) func();
+            auto end = Clock::now();
+            uint64_t c1 = cycle_counter.now();
+
+            histogram.record(end - start);
+            if (cycle_counter.available()) cycles.push_back(static_cast<double>(c1 - c0) / batch);
         }
+        const auto allocated = SatelliteSignal::AllocationTracker::snapshot() - allocations_before;
 
-        BenchmarkResult result = compute_statistics(name, times);
+        BenchmarkResult result;
+        result.name = name;
+        result.batch = batch;
+        result.histogram = std::move(histogram);
+        set_statistics(result);
+        result.warmup_iterations = warmup;
+        if (SatelliteSignal::AllocationTracker::installed()) {
+            const double calls = static_cast<double>(iterations) * batch;
+            result.allocations_tracked = true;
+            result.allocations_per_iteration = allocated.allocations / calls;
+            result.allocated_bytes_per_iteration = allocated.bytes / calls;
+        }
+        if (!cycles.empty()) {
+            result.cycles_per_iteration = median(cycles);
+            result.cycle_source = cycle_counter.source();
+        }
+        set_work(result, work);
         results.push_back(result);
-        
+
         print_result(result);
     }
 
+    // Add latencies measured outside run(), such as per-block latencies of
+    // a streaming pipeline. Only the histogram is kept.
+    void record(const std::string& name, const SatelliteSignal::LatencyHistogram& latency,
+                const Work& work = Work()) {
+        if (latency.empty()) return;
+        BenchmarkResult result;
+        result.name = name;
+        result.histogram = latency;
+        set_statistics(result);
+        set_work(result, work);
+        results.push_back(std::move(result));
+        print_result(results.back());
+    }
+
+    // One point of a parameterized family such as {"samples", 4096}; the
+    // result is named "family/samples:4096" and keeps its parameters for
+    // tables and plots
+    void run(const std::string& family, const Params& params, std::function<void()> func, int iterations = 0,
+             const Work& work = Work()) {
+        std::string name = family;
+        for (const auto& p : params) name += "/" + p.first + ":" + format_param(p.second);
+        run(name, std::move(func), iterations, work);
+        results.back().family = family;
+        results.back().params = params;
+    }
+
+    // Table of every point of `family` run so far: its parameters, median
+    // time and the recorded rates
+    void print_table(const std::string& family, std::ostream& os = std::cout) const {
+        std::vector<const BenchmarkResult*> rows;
+        for (const auto& r : results) {
+            if (r.family == family) rows.push_back(&r);
+        }
+        if (rows.empty()) return;
+
+        os << "\n" << family << "\n";
+        for (const auto& p : rows.front()->params) os << std::right << std::setw(12) << p.first;
+        os << std::setw(14) << "Median ms" << std::setw(14) << "Cycles";
+        if (rows.front()->items_per_iteration > 0.0) {
+            os << std::setw(18) << ("M " + rows.front()->item_unit + "/s");
+        }
+        if (rows.front()->bytes_per_iteration > 0.0) os << std::setw(12) << "MiB/s";
+        os << "\n";
+        for (const auto* r : rows) {
+            for (const auto& p : r->params) os << std::setw(12) << format_param(p.second);
+            os << std::setw(14) << std::fixed << std::setprecision(6) << r->median_ms
+               << std::setw(14) << std::setprecision(0) << r->cycles_per_iteration;
+            if (r->items_per_iteration > 0.0) {
+                os << std::setw(18) << std::setprecision(3) << r->items_per_second() * 1e-6;
+            }
+            if (r->bytes_per_iteration > 0.0) {
+                os << std::setw(12) << std::setprecision(1) << r->bytes_per_second() / (1024.0 * 1024.0);
+            }
+            os << "\n";
+        }
+        os << "\n";
+    }
+
+    // Heap allocations per iteration for a result added with record()
+    void set_allocations(double allocations_per_iteration, double bytes_per_iteration) {
+        if (results.empty() || !SatelliteSignal::AllocationTracker::installed()) return;
+        results.back().allocations_tracked = true;
+        results.back().allocations_per_iteration = allocations_per_iteration;
+        results.back().allocated_bytes_per_iteration = bytes_per_iteration;
+    }
+
     void print_all_results() {
         std::cout << "\n================================================================\n";
         std::cout << "              BENCHMARK RESULTS\n";
         std::cout << "================================================================\n\n";
-        
+
         for (const auto& result : results) {
             print_result(result);
         }
@@ -78,18 +359,63 @@ public:
 
         file << "{\n";
         file << "  \"timestamp\": \"" << timestamp << "\",\n";
+        file << "  \"cycle_source\": \"" << cycle_counter.source() << "\",\n";
         file << "  \"benchmarks\": [\n";
 
         for (size_t i = 0; i < results.size(); ++i) {
             const auto& result = results[i];
             file << "    {\n";
             file << "      \"name\": \"" << escape_json(result.name) << "\",\n";
+            if (!result.family.empty()) {
+                file << "      \"family\": \"" << escape_json(result.family) << "\",\n";
+                file << "      \"params\": {";
+                for (size_t k = 0; k < result.params.size(); ++k) {
+                    file << (k ? ", " : "") << "\"" << escape_json(result.params[k].first) << "\": "
+                         << format_param(result.params[k].second);
+                }
+                file << "},\n";
+            }
             file << "      \"min_ms\": " << std::fixed << std::setprecision(6) << result.min_ms << ",\n";
             file << "      \"max_ms\": " << std::fixed << std::setprecision(6) << result.max_ms << ",\n";
             file << "      \"mean_ms\": " << std::fixed << std::setprecision(6) << result.mean_ms << ",\n";
             file << "      \"median_ms\": " << std::fixed << std::setprecision(6) << result.median_ms << ",\n";
             file << "      \"stddev_ms\": " << std::fixed << std::setprecision(6) << result.stddev_ms << ",\n";
-            file << "      \"iterations\": " << result.times_ms.size() << "\n";
+            file << "      \"p90_ms\": " << std::fixed << std::setprecision(6) << result.p90_ms << ",\n";
+            file << "      \"p99_ms\": " << std::fixed << std::setprecision(6) << result.p99_ms << ",\n";
+            file << "      \"p999_ms\": " << std::fixed << std::setprecision(6) << result.p999_ms << ",\n";
+            if (result.cycles_per_iteration > 0.0) {
+                file << "      \"cycles_per_iteration\": " << std::fixed << std::setprecision(1)
+                     << result.cycles_per_iteration << ",\n";
+            }
+            if (result.items_per_iteration > 0.0) {
+                file << "      \"items_per_second\": " << std::fixed << std::setprecision(1)
+                     << result.items_per_second() << ",\n";
+                file << "      \"item_unit\": \"" << escape_json(result.item_unit) << "\",\n";
+            }
+            if (result.bytes_per_iteration > 0.0) {
+                file << "      \"bytes_per_second\": " << std::fixed << std::setprecision(1)
+                     << result.bytes_per_second() << ",\n";
+            }
+            if (result.allocations_tracked) {
+                file << "      \"allocations_per_iteration\": " << std::fixed << std::setprecision(3)
+                     << result.allocations_per_iteration << ",\n";
+                file << "      \"allocated_bytes_per_iteration\": " << std::fixed << std::setprecision(1)
+                     << result.allocated_bytes_per_iteration << ",\n";
+            }
+            file << "      \"warmup_iterations\": " << result.warmup_iterations << ",\n";
+            file << "      \"samples\": " << result.histogram.count() << ",\n";
+            file << "      \"batch\": " << result.batch << ",\n";
+            file << "      \"iterations\": " << result.histogram.count() * result.batch << ",\n";
+            // Non-empty buckets of the sample histogram as [lowest ns, count]
+            file << "      \"histogram_ns\": [";
+            bool first = true;
+            for (size_t k = 0; k < result.histogram.bucket_count(); ++k) {
+                uint64_t n = result.histogram.bucket(k);
+                if (n == 0) continue;
+                file << (first ? "" : ", ") << "[" << result.histogram.lowest_equivalent(k) << ", " << n << "]";
+                first = false;
+            }
+            file << "]\n";
             file << "    }";
             if (i < results.size() - 1) file << ",";
             file << "\n";
@@ -120,36 +446,43 @@ private:
         return result;
     }
     std::vector<BenchmarkResult> results;
+    Config config;
+    CycleCounter cycle_counter;
 
-    BenchmarkResult compute_statistics(const std::string& name,
-                                       const std::vector<double>& times) {
-        BenchmarkResult result;
-        result.name = name;
-        result.times_ms = times;
+    static std::string format_param(double value) {
+        std::ostringstream oss;
+        oss << std::defaultfloat << std::setprecision(10) << value;
+        return oss.str();
+    }
 
-        result.min_ms = *std::min_element(times.begin(), times.end());
-        result.max_ms = *std::max_element(times.begin(), times.end());
-        result.mean_ms = std::accumulate(times.begin(), times.end(), 0.0) /
-                         times.size();
+    static double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        size_t n = values.size();
+        return n % 2 == 0 ? (values[n / 2 - 1] + values[n / 2]) / 2.0 : values[n / 2];
+    }
 
-        std::vector<double> sorted_times = times;
-        std::sort(sorted_times.begin(), sorted_times.end());
-        if (sorted_times.size() % 2 == 0) {
-            result.median_ms = (sorted_times[sorted_times.size() / 2 - 1] +
-                                sorted_times[sorted_times.size() / 2]) /
-                               2.0;
-        } else {
-            result.median_ms = sorted_times[sorted_times.size() / 2];
-        }
+    // Per-call statistics from the histogram of sample durations; min, max,
+    // mean and standard deviation are exact, percentiles are to within the
+    // histogram's precision
+    static void set_statistics(BenchmarkResult& result) {
+        const auto& h = result.histogram;
+        const double per_call = 1.0 / result.batch;
+        result.min_ms = h.min() * 1e-6 * per_call;
+        result.max_ms = h.max() * 1e-6 * per_call;
+        result.mean_ms = h.mean() * 1e-6 * per_call;
+        result.stddev_ms = h.stddev() * 1e-6 * per_call;
+        result.median_ms = h.percentile_ms(50.0) * per_call;
+        result.p90_ms = result.histogram.percentile_ms(90.0) * per_call;
+        result.p99_ms = result.histogram.percentile_ms(99.0) * per_call;
+        result.p999_ms = result.histogram.percentile_ms(99.9) * per_call;
+    }
 
-        double variance = 0.0;
-        for (double t : times) {
-            variance += (t - result.mean_ms) * (t - result.mean_ms);
+    static void set_work(BenchmarkResult& result, const Work& work) {
+        if (work.items > 0.0) {
+            result.items_per_iteration = work.items;
+            result.item_unit = work.unit;
         }
-        variance /= times.size();
-        result.stddev_ms = std::sqrt(variance);
-
-        return result;
+        result.bytes_per_iteration = work.bytes;
     }
 
     void print_result(const BenchmarkResult& result) {
@@ -164,11 +497,33 @@ private:
                   << result.median_ms << " ms\n";
         std::cout << "  StdDev: " << std::fixed << std::setprecision(6)
                   << result.stddev_ms << " ms\n";
-        std::cout << "  Iter:   " << result.times_ms.size() << "\n\n";
+        std::cout << "  Tail:   p90 " << std::fixed << std::setprecision(6) << result.p90_ms
+                  << ", p99 " << result.p99_ms << ", p99.9 " << result.p999_ms << " ms\n";
+        if (result.cycles_per_iteration > 0.0) {
+            std::cout << "  Cycles: " << std::fixed << std::setprecision(0)
+                      << result.cycles_per_iteration << " (" << result.cycle_source << ")\n";
+        }
+        if (result.items_per_iteration > 0.0) {
+            std::cout << "  Rate:   " << std::fixed << std::setprecision(3)
+                      << result.items_per_second() * 1e-6 << " M " << result.item_unit << "/s\n";
+        }
+        if (result.bytes_per_iteration > 0.0) {
+            std::cout << "  Bytes:  " << std::fixed << std::setprecision(2)
+                      << result.bytes_per_second() / (1024.0 * 1024.0) << " MiB/s\n";
+        }
+        if (result.allocations_tracked) {
+            std::cout << "  Allocs: " << std::fixed << std::setprecision(2)
+                      << result.allocations_per_iteration << " per call ("
+                      << std::setprecision(0) << result.allocated_bytes_per_iteration << " bytes)\n";
+        }
+        std::cout << "  Iter:   " << result.histogram.count();
+        if (result.batch > 1) std::cout << " x " << result.batch;
+        std::cout << " (warmup " << result.warmup_iterations << ")\n\n";
     }
 };
 
-#define BENCHMARK(name, func, iters) \
-    BenchmarkFramework::instance().run(name, func, iters)
+// BENCHMARK(name, func, iters) or BENCHMARK(name, func, iters, work)
+#define BENCHMARK(name, func, ...) \
+    BenchmarkFramework::instance().run(name, func, __VA_ARGS__)
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,133 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <stdexcept>
+#include "ber_simulator.h"
+#include "fec_codecs.h"
+
+using namespace SatelliteSignal;
+
+struct SimulationOptions {
+    std::string codec = "uncoded";
+    std::string csv_file = "ber_results.csv";
+    std::string json_file = "ber_results.json";
+    std::string metrics_file;        // Prometheus text file when set
+    double metrics_interval = 5.0;
+    BerSimulator::Config config;
+};
+
+static void print_help() {
+    std::cout << "\nBER/FER Monte Carlo Simulation\n";
+    std::cout << "==============================\n\n";
+    std::cout << "USAGE:\n";
+    std::cout << "  ber_simulation [OPTIONS]\n\n";
+    std::cout << "OPTIONS:\n";
+    std::cout << "  --codec NAME              Code under test (default: uncoded):\n";
+    std::cout << "                            ";
+    for (const auto& name : FecCodecs::names()) std::cout << name << " ";
+    std::cout << "\n";
+    std::cout << "  --ebn0-start DB           First Eb/N0 point (default: 0.0)\n";
+    std::cout << "  --ebn0-stop DB            Last Eb/N0 point (default: 10.0)\n";
+    std::cout << "  --ebn0-step DB            Eb/N0 step (default: 1.0)\n";
+    std::cout << "  --bit-errors N            Bit errors required per point (default: 1000)\n";
+    std::cout << "  --frame-errors N          Frame errors required per point (default: 100)\n";
+    std::cout << "  --max-frames N            Frame budget per point (default: 1000000)\n";
+    std::cout << "  --min-ber BER             Stop the sweep below this BER (default: 1e-7)\n";
+    std::cout << "  --doppler HZ              Channel carrier offset (default: 0)\n";
+    std::cout << "  --doppler-error HZ        Residual offset after compensation (default: 0)\n";
+    std::cout << "  --symbol-rate HZ          Symbol rate for Doppler phase (default: 1e6)\n";
+    std::cout << "  --threads N               Worker threads, 0 = all cores (default: 0)\n";
+    std::cout << "  --seed N                  Base RNG seed (default: 1)\n";
+    std::cout << "  --csv FILE                CSV output (default: ber_results.csv)\n";
+    std::cout << "  --json FILE               JSON output (default: ber_results.json)\n";
+    std::cout << "  --metrics FILE            Write Prometheus text-format metrics (frames\n";
+    std::cout << "                            decoded, FEC corrections) to FILE\n";
+    std::cout << "  --metrics-interval S      Seconds between metrics writes (default: 5)\n";
+    std::cout << "  --help, -h                Print this help message\n\n";
+}
+
+static SimulationOptions parse_options(int argc, char* argv[]) {
+    SimulationOptions opts;
+    auto& cfg = opts.config;
+
+    int i = 1;
+    try {
+        for (; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg == "--help" || arg == "-h") {
+                print_help();
+                exit(0);
+            }
+            else if (arg == "--codec" && i + 1 < argc) opts.codec = argv[++i];
+            else if (arg == "--ebn0-start" && i + 1 < argc) cfg.ebn0_start_db = std::stod(argv[++i]);
+            else if (arg == "--ebn0-stop" && i + 1 < argc) cfg.ebn0_stop_db = std::stod(argv[++i]);
+            else if (arg == "--ebn0-step" && i + 1 < argc) cfg.ebn0_step_db = std::stod(argv[++i]);
+            else if (arg == "--bit-errors" && i + 1 < argc) cfg.target_bit_errors = std::stoull(argv[++i]);
+            else if (arg == "--frame-errors" && i + 1 < argc) cfg.target_frame_errors = std::stoull(argv[++i]);
+            else if (arg == "--max-frames" && i + 1 < argc) cfg.max_frames = std::stoull(argv[++i]);
+            else if (arg == "--min-ber" && i + 1 < argc) cfg.min_ber = std::stod(argv[++i]);
+            else if (arg == "--doppler" && i + 1 < argc) cfg.doppler_hz = std::stod(argv[++i]);
+            else if (arg == "--doppler-error" && i + 1 < argc) cfg.doppler_error_hz = std::stod(argv[++i]);
+            else if (arg == "--symbol-rate" && i + 1 < argc) cfg.symbol_rate_hz = std::stod(argv[++i]);
+            else if (arg == "--threads" && i + 1 < argc) cfg.num_threads = std::stoul(argv[++i]);
+            else if (arg == "--seed" && i + 1 < argc) cfg.seed = std::stoull(argv[++i]);
+            else if (arg == "--csv" && i + 1 < argc) opts.csv_file = argv[++i];
+            else if (arg == "--json" && i + 1 < argc) opts.json_file = argv[++i];
+            else if (arg == "--metrics" && i + 1 < argc) opts.metrics_file = argv[++i];
+            else if (arg == "--metrics-interval" && i + 1 < argc) opts.metrics_interval = std::stod(argv[++i]);
+            else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                print_help();
+                exit(1);
+            }
+        }
+    }
+    catch (const std::logic_error&) {
+        // Thrown by the std::sto* conversions for values that do not parse or overflow
+        std::cerr << "Invalid value for " << argv[i - 1] << ": " << argv[i] << "\n";
+        print_help();
+        exit(1);
+    }
+
+    return opts;
+}
+
+int main(int argc, char* argv[]) {
+    SimulationOptions opts = parse_options(argc, argv);
+    opts.config.verbose = true;
+
+    BerSimulator::Codec codec;
+    if (!FecCodecs::make(opts.codec, codec)) {
+        std::cerr << "Error: unknown codec " << opts.codec << "\n";
+        return 1;
+    }
+
+    unsigned threads = opts.config.num_threads == 0 ? default_thread_count() : opts.config.num_threads;
+    std::cout << "\nBER/FER sweep: " << codec.name << " (k=" << codec.info_bits
+              << ", n=" << codec.coded_bits << ", " << threads << " threads)\n\n";
+
+    MetricsRegistry metrics_registry;
+    DecoderMetrics decoder_metrics(metrics_registry);
+    std::unique_ptr<MetricsExporter> metrics_exporter;
+    if (!opts.metrics_file.empty()) {
+        opts.config.metrics = &decoder_metrics;
+        metrics_exporter.reset(new MetricsExporter(metrics_registry, {opts.metrics_file, opts.metrics_interval}));
+    }
+
+    BerSimulator simulator(opts.config);
+    auto curve = simulator.run(codec);
+    if (metrics_exporter) {
+        metrics_exporter->stop();
+        std::cout << "\nMetrics written to: " << opts.metrics_file << "\n";
+    }
+
+    bool ok = BerSimulator::write_csv(opts.csv_file, codec.name, curve) &&
+              BerSimulator::write_json(opts.json_file, codec.name, curve);
+    if (ok) {
+        std::cout << "\nResults saved to: " << opts.csv_file << ", " << opts.json_file << "\n";
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,358 @@
+#ifndef BER_SIMULATOR_H
+#define BER_SIMULATOR_H
+
+#define _USE_MATH_DEFINES
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#include "parallel_for.h"
+#include "metrics_registry.h"
+
+namespace SatelliteSignal {
+
+// xoshiro256** generator. Small state and a jump() that advances 2^128 steps,
+// which gives every worker thread its own non-overlapping stream.
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 1) {
+        uint64_t x = seed;
+        for (auto& word : s) word = splitmix64(x);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    void jump() {
+        static const uint64_t JUMP[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+                                        0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (uint64_t word : JUMP) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (uint64_t(1) << b)) {
+                    for (int i = 0; i < 4; ++i) t[i] ^= s[i];
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; ++i) s[i] = t[i];
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+// Monte Carlo BER/FER simulation over encoder -> QPSK -> AWGN (+ Doppler)
+// -> soft demapper -> decoder. Soft values follow the decoder convention in
+// fec_decoders.h: positive means bit 1.
+class BerSimulator {
+public:
+    using EncodeFn = std::function<void(const std::vector<uint8_t>& info_bits,
+                                        std::vector<uint8_t>& coded_bits)>;
+    // Returns the symbols or bits the decoder corrected in the frame, 0 for
+    // decoders that do not count them
+    using DecodeFn = std::function<uint64_t(const std::vector<double>& soft_bits,
+                                            std::vector<uint8_t>& decoded_bits)>;
+
+    // A code under test. The factories are called once per worker thread so
+    // encoders and decoders may keep scratch state without locking.
+    struct Codec {
+        std::string name;
+        size_t info_bits = 0;
+        size_t coded_bits = 0;
+        std::function<EncodeFn()> make_encoder;
+        std::function<DecodeFn()> make_decoder;
+
+        double rate() const {
+            return coded_bits == 0 ? 1.0 : static_cast<double>(info_bits) / coded_bits;
+        }
+    };
+
+    struct Config {
+        double ebn0_start_db = 0.0;
+        double ebn0_stop_db = 10.0;
+        double ebn0_step_db = 1.0;
+        uint64_t target_bit_errors = 1000;   // both targets must be met to stop
+        uint64_t target_frame_errors = 100;
+        uint64_t max_frames = 1000000;
+        double min_ber = 1e-7;               // stop the sweep below this BER
+        double doppler_hz = 0.0;             // carrier offset applied by the channel
+        double doppler_error_hz = 0.0;       // residual left after compensation
+        double symbol_rate_hz = 1e6;
+        unsigned num_threads = 0;            // 0 = hardware concurrency
+        uint64_t seed = 1;
+        bool verbose = false;
+        DecoderMetrics* metrics = nullptr;   // counts every decoded frame when set
+    };
+
+    struct Point {
+        double ebn0_db;
+        uint64_t frames;
+        uint64_t bits;
+        uint64_t bit_errors;
+        uint64_t frame_errors;
+        double ber;
+        double fer;
+        double seconds;
+    };
+
+    BerSimulator() : BerSimulator(Config()) {}
+    explicit BerSimulator(const Config& cfg) : config(cfg) {}
+
+    std::vector<Point> run(const Codec& codec) const {
+        std::vector<Point> curve;
+        if (codec.info_bits == 0 || !codec.make_encoder || !codec.make_decoder) return curve;
+
+        int num_points = static_cast<int>(
+            std::floor((config.ebn0_stop_db - config.ebn0_start_db) / config.ebn0_step_db + 1e-9)) + 1;
+
+        for (int p = 0; p < num_points; ++p) {
+            double ebn0_db = config.ebn0_start_db + p * config.ebn0_step_db;
+            Point point = run_point(codec, ebn0_db, static_cast<uint64_t>(p));
+            curve.push_back(point);
+
+            if (config.verbose) print_point(point);
+
+            if (point.bit_errors == 0 || point.ber < config.min_ber) break;
+        }
+
+        return curve;
+    }
+
+    Point run_point(const Codec& codec, double ebn0_db, uint64_t point_index = 0) const {
+        double esn0 = std::pow(10.0, ebn0_db / 10.0) * codec.rate() * 2.0;
+        double sigma = std::sqrt(1.0 / (2.0 * esn0));
+
+        std::atomic<uint64_t> frames(0);
+        std::atomic<uint64_t> bit_errors(0);
+        std::atomic<uint64_t> frame_errors(0);
+
+        auto done = [&]() {
+            if (frames.load(std::memory_order_relaxed) >= config.max_frames) return true;
+            return bit_errors.load(std::memory_order_relaxed) >= config.target_bit_errors &&
+                   frame_errors.load(std::memory_order_relaxed) >= config.target_frame_errors;
+        };
+
+        uint64_t stream_seed = config.seed;
+        for (uint64_t i = 0; i <= point_index; ++i) Xoshiro256::splitmix64(stream_seed);
+
+        auto start = std::chrono::steady_clock::now();
+
+        unsigned workers = config.num_threads == 0 ? default_thread_count() : config.num_threads;
+        parallel_workers(workers, [&](unsigned worker) {
+            Xoshiro256 rng(stream_seed);
+            for (unsigned j = 0; j < worker; ++j) rng.jump();
+
+            EncodeFn encode = codec.make_encoder();
+            DecodeFn decode = codec.make_decoder();
+            FrameScratch scratch;
+
+            while (!done()) {
+                uint64_t errors = simulate_frame(codec, encode, decode, sigma, rng, scratch);
+                frames.fetch_add(1, std::memory_order_relaxed);
+                if (config.metrics) config.metrics->record_frame(scratch.corrected);
+                if (errors > 0) {
+                    bit_errors.fetch_add(errors, std::memory_order_relaxed);
+                    frame_errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        auto end = std::chrono::steady_clock::now();
+
+        Point point;
+        point.ebn0_db = ebn0_db;
+        point.frames = frames.load();
+        point.bits = point.frames * codec.info_bits;
+        point.bit_errors = bit_errors.load();
+        point.frame_errors = frame_errors.load();
+        point.ber = point.bits ? static_cast<double>(point.bit_errors) / point.bits : 0.0;
+        point.fer = point.frames ? static_cast<double>(point.frame_errors) / point.frames : 0.0;
+        point.seconds = std::chrono::duration<double>(end - start).count();
+        return point;
+    }
+
+    // Uncoded QPSK reference, useful to validate the channel against theory
+    static Codec uncoded(size_t frame_bits = 1024) {
+        Codec codec;
+        codec.name = "uncoded";
+        codec.info_bits = frame_bits;
+        codec.coded_bits = frame_bits;
+        codec.make_encoder = []() -> EncodeFn {
+            return [](const std::vector<uint8_t>& in, std::vector<uint8_t>& out) { out = in; };
+        };
+        codec.make_decoder = []() -> DecodeFn {
+            return [](const std::vector<double>& soft, std::vector<uint8_t>& out) -> uint64_t {
+                out.resize(soft.size());
+                for (size_t i = 0; i < soft.size(); ++i) out[i] = soft[i] > 0.0 ? 1 : 0;
+                return 0;
+            };
+        };
+        return codec;
+    }
+
+    // Theoretical uncoded BPSK/QPSK bit error rate
+    static double theoretical_qpsk_ber(double ebn0_db) {
+        return 0.5 * std::erfc(std::sqrt(std::pow(10.0, ebn0_db / 10.0)));
+    }
+
+    static void print_point(const Point& p) {
+        std::cout << std::fixed << std::setprecision(2) << "  Eb/N0 " << std::setw(6) << p.ebn0_db
+                  << " dB  BER " << std::scientific << std::setprecision(3) << p.ber
+                  << "  FER " << p.fer << std::fixed << "  frames " << p.frames
+                  << "  (" << std::setprecision(2) << p.seconds << " s)\n";
+    }
+
+    static bool write_csv(const std::string& filename, const std::string& codec_name,
+                          const std::vector<Point>& curve) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return false;
+        }
+
+        file << "codec,ebn0_db,frames,bits,bit_errors,frame_errors,ber,fer,seconds\n";
+        for (const auto& p : curve) {
+            file << codec_name << "," << std::fixed << std::setprecision(2) << p.ebn0_db << ","
+                 << p.frames << "," << p.bits << "," << p.bit_errors << "," << p.frame_errors << ","
+                 << std::scientific << std::setprecision(6) << p.ber << "," << p.fer << ","
+                 << std::fixed << std::setprecision(3) << p.seconds << "\n";
+        }
+        return true;
+    }
+
+    static bool write_json(const std::string& filename, const std::string& codec_name,
+                           const std::vector<Point>& curve) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return false;
+        }
+
+        file << "{\n";
+        file << "  \"codec\": \"" << codec_name << "\",\n";
+        file << "  \"points\": [\n";
+        for (size_t i = 0; i < curve.size(); ++i) {
+            const auto& p = curve[i];
+            file << "    {\"ebn0_db\": " << std::fixed << std::setprecision(2) << p.ebn0_db
+                 << ", \"frames\": " << p.frames
+                 << ", \"bits\": " << p.bits
+                 << ", \"bit_errors\": " << p.bit_errors
+                 << ", \"frame_errors\": " << p.frame_errors
+                 << ", \"ber\": " << std::scientific << std::setprecision(6) << p.ber
+                 << ", \"fer\": " << p.fer
+                 << ", \"seconds\": " << std::fixed << std::setprecision(3) << p.seconds << "}";
+            if (i + 1 < curve.size()) file << ",";
+            file << "\n";
+        }
+        file << "  ]\n";
+        file << "}\n";
+        return true;
+    }
+
+private:
+    Config config;
+
+    struct FrameScratch {
+        std::vector<uint8_t> info;
+        std::vector<uint8_t> coded;
+        std::vector<double> soft;
+        std::vector<uint8_t> decoded;
+        uint64_t corrected = 0;              // by the last decode
+    };
+
+    uint64_t simulate_frame(const Codec& codec, const EncodeFn& encode, const DecodeFn& decode,
+                            double sigma, Xoshiro256& rng, FrameScratch& s) const {
+        s.info.resize(codec.info_bits);
+        for (size_t i = 0; i < s.info.size(); i += 64) {
+            uint64_t word = rng();
+            size_t n = std::min<size_t>(64, s.info.size() - i);
+            for (size_t b = 0; b < n; ++b) s.info[i + b] = (word >> b) & 1;
+        }
+
+        encode(s.info, s.coded);
+
+        // Gray-mapped QPSK: even bits on I, odd bits on Q, bit 1 -> +1/sqrt(2)
+        const double amp = 1.0 / std::sqrt(2.0);
+        const double llr_scale = 2.0 * amp / (sigma * sigma);
+        std::normal_distribution<double> noise(0.0, sigma);
+
+        bool rotate = config.doppler_hz != 0.0 || config.doppler_error_hz != 0.0;
+        std::complex<double> channel_phasor(1.0, 0.0);
+        std::complex<double> receiver_phasor(1.0, 0.0);
+        std::complex<double> channel_step = std::polar(1.0, 2.0 * M_PI * config.doppler_hz / config.symbol_rate_hz);
+        std::complex<double> receiver_step = std::polar(
+            1.0, -2.0 * M_PI * (config.doppler_hz + config.doppler_error_hz) / config.symbol_rate_hz);
+
+        size_t num_coded = s.coded.size();
+        s.soft.resize(num_coded);
+        for (size_t i = 0; i < num_coded; i += 2) {
+            double bi = s.coded[i] ? amp : -amp;
+            double bq = (i + 1 < num_coded && s.coded[i + 1]) ? amp : -amp;
+            std::complex<double> symbol(bi, bq);
+
+            if (rotate) {
+                symbol *= channel_phasor;
+                channel_phasor *= channel_step;
+            }
+
+            symbol += std::complex<double>(noise(rng), noise(rng));
+
+            if (rotate) {
+                symbol *= receiver_phasor;
+                receiver_phasor *= receiver_step;
+            }
+
+            s.soft[i] = llr_scale * symbol.real();
+            if (i + 1 < num_coded) s.soft[i + 1] = llr_scale * symbol.imag();
+        }
+
+        s.corrected = decode(s.soft, s.decoded);
+
+        uint64_t errors = 0;
+        for (size_t i = 0; i < s.info.size(); ++i) {
+            uint8_t bit = i < s.decoded.size() ? s.decoded[i] : uint8_t(s.info[i] ^ 1);
+            errors += (bit != s.info[i]);
+        }
+        return errors;
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // BER_SIMULATOR_H
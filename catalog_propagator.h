@@ -0,0 +1,322 @@
+#ifndef CATALOG_PROPAGATOR_H
+#define CATALOG_PROPAGATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "satellite_ephemeris.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Branch-free sin/cos for |x| up to ~1e6 rad. Written without library calls or
+// data-dependent branches so loops over it auto-vectorize across satellites.
+// Range reduction to [-pi/4, pi/4] with a three-part pi/2, then the Cephes
+// minimax polynomials; error is within a few ulp of std::sin/std::cos.
+inline void fast_sincos(double x, double& s, double& c) {
+    constexpr double ROUND = 6755399441055744.0;  // 1.5 * 2^52
+    constexpr double TWO_OVER_PI = 0.63661977236758134308;
+    constexpr double PIO2_1 = 1.57079632673412561417e+00;
+    constexpr double PIO2_2 = 6.07710050630396597660e-11;
+    constexpr double PIO2_3 = 2.02226624871116645580e-21;
+
+    double k = (x * TWO_OVER_PI + ROUND) - ROUND;
+    double r = ((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+    double z = r * r;
+
+    double ps = 1.58962301576546568060e-10;
+    ps = ps * z - 2.50507477628578072866e-8;
+    ps = ps * z + 2.75573136213857245213e-6;
+    ps = ps * z - 1.98412698295895385996e-4;
+    ps = ps * z + 8.33333333332211858878e-3;
+    ps = ps * z - 1.66666666666666307295e-1;
+    double sin_r = r + r * z * ps;
+
+    double pc = -1.13585365213876817300e-11;
+    pc = pc * z + 2.08757008419747316778e-9;
+    pc = pc * z - 2.75573141792967388112e-7;
+    pc = pc * z + 2.48015872888517045348e-5;
+    pc = pc * z - 1.38888888888730564116e-3;
+    pc = pc * z + 4.16666666666665929218e-2;
+    double cos_r = 1.0 - 0.5 * z + z * z * pc;
+
+    // Quadrant q = k mod 4 selects swap and signs, computed arithmetically so
+    // the compiler does not need to if-convert
+    int32_t q = static_cast<int32_t>(k);
+    double swap = static_cast<double>(q & 1);
+    double sin_sign = 1.0 - static_cast<double>(q & 2);
+    double cos_sign = 1.0 - static_cast<double>((q + 1) & 2);
+    s = sin_sign * (sin_r + swap * (cos_r - sin_r));
+    c = cos_sign * (cos_r + swap * (sin_r - cos_r));
+}
+
+// Propagator for a whole catalog. Elements are held structure-of-arrays with
+// the perifocal-to-ECI rotation cached per satellite, so a two-body
+// propagation step is Kepler's equation plus two 3-vector scalings.
+// Satellites are processed in fixed-size blocks whose inner loops vectorize,
+// and blocks are spread across worker threads.
+//
+// Model::TWO_BODY is unperturbed two-body motion (no J2 or drag), suited to
+// raw throughput across a catalog. Velocity uses the eccentric-anomaly form
+// of the perifocal velocity, which avoids the atan2 for true anomaly.
+// Model::SGP4 runs an initialized SGP4/SDP4 propagator per satellite in the
+// same block loop, so bulk states agree with SatelliteEphemeris and
+// PassPredictor; use it whenever bulk results are compared with those.
+//
+// Times count from each satellite's own epoch unless Config::epoch_jd sets
+// a common origin, in which case every satellite is propagated from its
+// own epoch by the offset to that origin.
+class CatalogPropagator {
+public:
+    enum class Model { TWO_BODY, SGP4 };
+
+    struct Config {
+        Model model = Model::TWO_BODY;
+        double epoch_jd = 0.0;            // common time origin; 0 = each satellite's epoch
+        unsigned num_threads = 0;         // 0 = all cores
+        size_t grain = 1024;              // satellites per work item
+        double kepler_tolerance = 1e-12;  // rad, two-body only
+        int max_kepler_iterations = 30;
+        SGP4Propagator::Config sgp4;
+    };
+
+    // ECI states, one array per component
+    struct States {
+        std::vector<double> x, y, z;
+        std::vector<double> vx, vy, vz;
+
+        void resize(size_t n) {
+            x.resize(n); y.resize(n); z.resize(n);
+            vx.resize(n); vy.resize(n); vz.resize(n);
+        }
+
+        size_t size() const { return x.size(); }
+
+        StateVector get(size_t i) const {
+            return {x[i], y[i], z[i], vx[i], vy[i], vz[i]};
+        }
+    };
+
+    CatalogPropagator() : CatalogPropagator(Config()) {}
+    explicit CatalogPropagator(const Config& cfg) : config(cfg) {}
+
+    size_t add(const TLE& tle) {
+        for (auto* v : columns()) v->push_back(0.0);
+        if (config.model == Model::SGP4) sgp4.emplace_back(tle, config.sgp4);
+        set_elements(size() - 1, tle);
+        return size() - 1;
+    }
+
+    // Replace the elements of satellite `index`
+    void set(size_t index, const TLE& tle) {
+        if (config.model == Model::SGP4) sgp4[index] = SGP4Propagator(tle, config.sgp4);
+        set_elements(index, tle);
+    }
+
+    // Remove satellite `index`; the last satellite moves into its place
+    void remove(size_t index) {
+        for (auto* v : columns()) {
+            (*v)[index] = v->back();
+            v->pop_back();
+        }
+        if (config.model == Model::SGP4) {
+            if (index + 1 != sgp4.size()) sgp4[index] = std::move(sgp4.back());
+            sgp4.pop_back();
+        }
+    }
+
+    void add(const std::vector<TLE>& tles) {
+        reserve(size() + tles.size());
+        for (const auto& tle : tles) add(tle);
+    }
+
+    void reserve(size_t n) {
+        for (auto* v : columns()) v->reserve(n);
+        if (config.model == Model::SGP4) sgp4.reserve(n);
+    }
+
+    void clear() {
+        for (auto* v : columns()) v->clear();
+        sgp4.clear();
+    }
+
+    size_t size() const { return mean_anomaly.size(); }
+
+    // Propagate every satellite to `minutes_from_epoch` after its own epoch,
+    // or after Config::epoch_jd when set
+    void propagate(double minutes_from_epoch, States& out) const {
+        out.resize(size());
+        parallel_for(size(), [&](size_t begin, size_t end, unsigned) {
+            for (size_t b = begin; b < end; b += BLOCK) {
+                propagate_block(b, std::min(end, b + BLOCK), minutes_from_epoch, out, 0);
+            }
+        }, config.grain, config.num_threads);
+    }
+
+    // Satellites [begin, end) only, on the calling thread; `out` must
+    // already hold size() states
+    void propagate(double minutes_from_epoch, States& out, size_t begin, size_t end) const {
+        for (size_t b = begin; b < end; b += BLOCK) {
+            propagate_block(b, std::min(end, b + BLOCK), minutes_from_epoch, out, 0);
+        }
+    }
+
+    States propagate(double minutes_from_epoch) const {
+        States out;
+        propagate(minutes_from_epoch, out);
+        return out;
+    }
+
+    StateVector propagate_one(size_t index, double minutes_from_epoch) const {
+        States out;
+        out.resize(1);
+        propagate_block(index, index + 1, minutes_from_epoch, out, index);
+        return out.get(0);
+    }
+
+    const Config& get_config() const { return config; }
+
+private:
+    static constexpr size_t BLOCK = 64;
+
+    Config config;
+
+    std::vector<double> mean_anomaly;     // rad at epoch
+    std::vector<double> mean_motion;      // rad/min
+    std::vector<double> eccentricity;
+    std::vector<double> semi_major_axis;  // km
+    std::vector<double> semi_minor_axis;  // km
+    std::vector<double> velocity_scale;   // sqrt(mu * a), km^2/s
+    std::vector<double> epoch_offset;     // min from the time origin to the satellite's epoch
+
+    // Perifocal unit vectors P (towards perigee) and Q in ECI
+    std::vector<double> px, py, pz;
+    std::vector<double> qx, qy, qz;
+
+    std::vector<SGP4Propagator> sgp4;     // Model::SGP4 only
+
+    std::vector<std::vector<double>*> columns() {
+        return {&mean_anomaly, &mean_motion, &eccentricity, &semi_major_axis,
+                &semi_minor_axis, &velocity_scale, &epoch_offset, &px, &py, &pz, &qx, &qy, &qz};
+    }
+
+    // Two-body elements and perifocal frame of satellite `index`
+    void set_elements(size_t index, const TLE& tle) {
+        double n = tle.mean_motion * 2.0 * M_PI / 1440.0;  // rad/min
+        double a = std::pow(EARTH_MU / (n * n / 3600.0), 1.0 / 3.0);
+        double e = tle.eccentricity;
+
+        double cos_raan = std::cos(tle.raan), sin_raan = std::sin(tle.raan);
+        double cos_inc = std::cos(tle.inclination), sin_inc = std::sin(tle.inclination);
+        double cos_arg = std::cos(tle.argument_perigee), sin_arg = std::sin(tle.argument_perigee);
+
+        mean_anomaly[index] = tle.mean_anomaly;
+        mean_motion[index] = n;
+        eccentricity[index] = e;
+        semi_major_axis[index] = a;
+        semi_minor_axis[index] = a * std::sqrt(1.0 - e * e);
+        velocity_scale[index] = std::sqrt(EARTH_MU * a);
+        epoch_offset[index] = config.epoch_jd == 0.0 ? 0.0 :
+            (config.epoch_jd - SGP4Propagator::epoch_julian_date(tle.epoch_year, tle.epoch_day)) * 1440.0;
+
+        px[index] = cos_raan * cos_arg - sin_raan * sin_arg * cos_inc;
+        py[index] = sin_raan * cos_arg + cos_raan * sin_arg * cos_inc;
+        pz[index] = sin_inc * sin_arg;
+        qx[index] = -cos_raan * sin_arg - sin_raan * cos_arg * cos_inc;
+        qy[index] = -sin_raan * sin_arg + cos_raan * cos_arg * cos_inc;
+        qz[index] = sin_inc * cos_arg;
+    }
+
+    // Propagate satellites [begin, end) into out[i - out_offset]
+    void propagate_block(size_t begin, size_t end, double t, States& out, size_t out_offset) const {
+        if (config.model == Model::SGP4) {
+            for (size_t i = begin; i < end; ++i) {
+                StateVector sv{};              // stays zero if SGP4 fails
+                sgp4[i].propagate(t + epoch_offset[i], sv);
+                const size_t o = i - out_offset;
+                out.x[o] = sv.x; out.y[o] = sv.y; out.z[o] = sv.z;
+                out.vx[o] = sv.vx; out.vy[o] = sv.vy; out.vz[o] = sv.vz;
+            }
+            return;
+        }
+
+        const size_t count = end - begin;
+        const double* e = eccentricity.data() + begin;
+        const double* m0 = mean_anomaly.data() + begin;
+        const double* n = mean_motion.data() + begin;
+        const double* dt = epoch_offset.data() + begin;
+        double M[BLOCK], E[BLOCK], sin_E[BLOCK], cos_E[BLOCK];
+
+        // Mean anomaly wrapped to [-pi, pi]; eccentric orbits start Newton at pi
+        for (size_t j = 0; j < count; ++j) {
+            constexpr double ROUND = 6755399441055744.0;
+            double m = m0[j] + n[j] * (t + dt[j]);
+            double turns = (m * (0.5 / M_PI) + ROUND) - ROUND;
+            m -= turns * (2.0 * M_PI);
+            M[j] = m;
+            double start = m < 0.0 ? -M_PI : M_PI;
+            E[j] = e[j] > 0.8 ? start : m;
+        }
+
+        // Newton on E - e sin E = M, lock-step across the block until every
+        // lane has converged. Step sizes are checked in a separate scalar pass
+        // so the update loop itself stays free of reductions.
+        double step[BLOCK];
+        for (int it = 0; it < config.max_kepler_iterations; ++it) {
+            for (size_t j = 0; j < count; ++j) {
+                double s, c;
+                fast_sincos(E[j], s, c);
+                step[j] = (E[j] - e[j] * s - M[j]) / (1.0 - e[j] * c);
+                E[j] -= step[j];
+            }
+            bool converged = true;
+            for (size_t j = 0; j < count && converged; ++j) {
+                converged = std::fabs(step[j]) < config.kepler_tolerance;
+            }
+            if (converged) break;
+        }
+
+        for (size_t j = 0; j < count; ++j) {
+            fast_sincos(E[j], sin_E[j], cos_E[j]);
+        }
+
+        // Perifocal position and velocity from E, then rotate into ECI. The
+        // results land in block-local arrays first: outputs that cannot alias
+        // the element columns keep the loop vectorizable.
+        const double* a = semi_major_axis.data() + begin;
+        const double* b = semi_minor_axis.data() + begin;
+        const double* h = velocity_scale.data() + begin;
+        const double *Px = px.data() + begin, *Py = py.data() + begin, *Pz = pz.data() + begin;
+        const double *Qx = qx.data() + begin, *Qy = qy.data() + begin, *Qz = qz.data() + begin;
+        double X[BLOCK], Y[BLOCK], Z[BLOCK], VX[BLOCK], VY[BLOCK], VZ[BLOCK];
+
+        for (size_t j = 0; j < count; ++j) {
+            double xp = a[j] * (cos_E[j] - e[j]);
+            double yp = b[j] * sin_E[j];
+            double k = h[j] / (a[j] * (1.0 - e[j] * cos_E[j]));
+            double vxp = -k * sin_E[j];
+            double vyp = k * (b[j] / a[j]) * cos_E[j];
+
+            X[j] = Px[j] * xp + Qx[j] * yp;
+            Y[j] = Py[j] * xp + Qy[j] * yp;
+            Z[j] = Pz[j] * xp + Qz[j] * yp;
+            VX[j] = Px[j] * vxp + Qx[j] * vyp;
+            VY[j] = Py[j] * vxp + Qy[j] * vyp;
+            VZ[j] = Pz[j] * vxp + Qz[j] * vyp;
+        }
+
+        size_t o = begin - out_offset;
+        std::copy(X, X + count, out.x.begin() + o);
+        std::copy(Y, Y + count, out.y.begin() + o);
+        std::copy(Z, Z + count, out.z.begin() + o);
+        std::copy(VX, VX + count, out.vx.begin() + o);
+        std::copy(VY, VY + count, out.vy.begin() + o);
+        std::copy(VZ, VZ + count, out.vz.begin() + o);
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // CATALOG_PROPAGATOR_H
@@ -0,0 +1,238 @@
+#ifndef CHEBYSHEV_EPHEMERIS_H
+#define CHEBYSHEV_EPHEMERIS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "satellite_ephemeris.h"
+
+namespace SatelliteSignal {
+
+// Piecewise Chebyshev fit of one satellite's SGP4 trajectory. A window of
+// fixed-length segments is fitted ahead of the query time; each segment holds
+// interpolants for position and velocity sampled at the Chebyshev nodes, so a
+// lookup is a Clenshaw recurrence instead of a full SGP4 step. When a query
+// falls outside the window, the window is refitted starting at that time.
+//
+// Every segment is checked against SGP4 between its nodes and at both ends;
+// segments whose position error exceeds the tolerance are halved until they
+// pass (or reach the minimum length). The largest checked error is reported
+// as the segment's error bound.
+class ChebyshevEphemeris {
+public:
+    struct Config {
+        int degree = 8;                    // polynomial degree per segment
+        double segment_minutes = 10.0;
+        double window_minutes = 120.0;     // span fitted per refill
+        double tolerance_km = 1e-3;
+        double min_segment_minutes = 0.25;
+        SGP4Propagator::Config sgp4;
+    };
+
+    struct Segment {
+        double start, end;                 // minutes from epoch
+        double mid, inv_half;              // maps t to tau in [-1, 1]
+        size_t offset;                     // into coefficient storage
+        double position_error_km;
+        double velocity_error_km_s;
+    };
+
+    ChebyshevEphemeris(const TLE& tle) : ChebyshevEphemeris(tle, Config()) {}
+    ChebyshevEphemeris(const TLE& tle, const Config& cfg)
+        : config(cfg), sgp4(tle, cfg.sgp4), nodes(cfg.degree + 1) {
+        // cos(pi k (j + 1/2) / N) for the fit, plus the check points between
+        // neighbouring nodes
+        const int n = nodes;
+        node_tau.resize(n);
+        basis.resize(static_cast<size_t>(n) * n);
+        for (int j = 0; j < n; ++j) {
+            node_tau[j] = std::cos(M_PI * (j + 0.5) / n);
+            for (int k = 0; k < n; ++k) {
+                basis[static_cast<size_t>(k) * n + j] = std::cos(M_PI * k * (j + 0.5) / n);
+            }
+        }
+        check_tau = {-1.0, 1.0};
+        for (int j = 1; j < n; ++j) check_tau.push_back(std::cos(M_PI * j / n));
+    }
+
+    // Interpolated TEME state; refits the window if `minutes_from_epoch` is
+    // outside it
+    StateVector get_position(double minutes_from_epoch) {
+        double v[COMPONENTS];
+        evaluate(find_segment(minutes_from_epoch), minutes_from_epoch, v);
+        return {v[0], v[1], v[2], v[3], v[4], v[5]};
+    }
+
+    // Range rate in km/s (positive = receding) relative to an observer state
+    // in the same frame
+    double get_range_rate(double minutes_from_epoch, const StateVector& observer) {
+        double v[COMPONENTS];
+        evaluate(find_segment(minutes_from_epoch), minutes_from_epoch, v);
+        double dx = v[0] - observer.x, dy = v[1] - observer.y, dz = v[2] - observer.z;
+        double range = std::sqrt(dx * dx + dy * dy + dz * dz);
+        return ((v[3] - observer.vx) * dx + (v[4] - observer.vy) * dy +
+                (v[5] - observer.vz) * dz) / range;
+    }
+
+    double get_doppler_shift(double minutes_from_epoch, const StateVector& observer,
+                             double carrier_frequency_hz) {
+        return doppler_shift_hz(get_range_rate(minutes_from_epoch, observer), carrier_frequency_hz);
+    }
+
+    // Same queries against a ground station, rotated into TEME by GMST at the
+    // query time
+    double get_range_rate(double minutes_from_epoch, const StationFrame& station) {
+        return get_range_rate(minutes_from_epoch, station.inertial_state(get_gmst(minutes_from_epoch)));
+    }
+
+    double get_doppler_shift(double minutes_from_epoch, const StationFrame& station,
+                             double carrier_frequency_hz) {
+        return doppler_shift_hz(get_range_rate(minutes_from_epoch, station), carrier_frequency_hz);
+    }
+
+    double get_gmst(double minutes_from_epoch) const {
+        return SGP4Propagator::gmst(sgp4.get_epoch_jd() + minutes_from_epoch / 1440.0);
+    }
+
+    // Fit the window starting at `start_minutes` now rather than on first use
+    void prefill(double start_minutes) {
+        segments.clear();
+        coefficients.clear();
+        int count = std::max(1, static_cast<int>(std::ceil(config.window_minutes / config.segment_minutes)));
+        for (int i = 0; i < count; ++i) {
+            fit_segment(start_minutes + i * config.segment_minutes,
+                        start_minutes + (i + 1) * config.segment_minutes);
+        }
+        window_start = start_minutes;
+        window_end = start_minutes + count * config.segment_minutes;
+        last_segment = 0;
+        ++refills;
+    }
+
+    bool covers(double minutes_from_epoch) const {
+        return minutes_from_epoch >= window_start && minutes_from_epoch < window_end;
+    }
+
+    // Largest checked position error over the current window, km
+    double get_error_bound() const {
+        double bound = 0.0;
+        for (const auto& s : segments) bound = std::max(bound, s.position_error_km);
+        return bound;
+    }
+
+    const std::vector<Segment>& get_segments() const { return segments; }
+    double get_window_start() const { return window_start; }
+    double get_window_end() const { return window_end; }
+    size_t get_refill_count() const { return refills; }
+    SGP4Propagator& get_propagator() { return sgp4; }
+    const Config& get_config() const { return config; }
+
+private:
+    static constexpr int COMPONENTS = 6;   // x, y, z, vx, vy, vz
+
+    Config config;
+    SGP4Propagator sgp4;
+    int nodes;
+    std::vector<double> node_tau;
+    std::vector<double> basis;             // [k][j]
+    std::vector<double> check_tau;
+
+    std::vector<Segment> segments;
+    std::vector<double> coefficients;      // [segment][k][component]
+    double window_start = 0.0;
+    double window_end = 0.0;               // empty until first use
+    size_t last_segment = 0;
+    size_t refills = 0;
+
+    const Segment& find_segment(double t) {
+        if (!covers(t)) {
+            prefill(std::floor(t / config.segment_minutes) * config.segment_minutes);
+        }
+        // Consecutive queries usually land in the same or the next segment
+        const Segment* s = &segments[last_segment];
+        if (t >= s->start && t < s->end) return *s;
+        if (last_segment + 1 < segments.size() && t >= s->end && t < segments[last_segment + 1].end) {
+            return segments[++last_segment];
+        }
+        auto it = std::upper_bound(segments.begin(), segments.end(), t,
+                                   [](double value, const Segment& seg) { return value < seg.start; });
+        last_segment = static_cast<size_t>(it - segments.begin()) - 1;
+        return segments[last_segment];
+    }
+
+    // Clenshaw recurrence for all six components at once
+    void evaluate(const Segment& s, double t, double* out) const {
+        const double tau = (t - s.mid) * s.inv_half;
+        const double two_tau = 2.0 * tau;
+        const double* c = coefficients.data() + s.offset;
+        double b1[COMPONENTS] = {}, b2[COMPONENTS] = {};
+        for (int k = nodes - 1; k >= 1; --k) {
+            const double* ck = c + k * COMPONENTS;
+            for (int i = 0; i < COMPONENTS; ++i) {
+                double b0 = two_tau * b1[i] - b2[i] + ck[i];
+                b2[i] = b1[i];
+                b1[i] = b0;
+            }
+        }
+        for (int i = 0; i < COMPONENTS; ++i) out[i] = tau * b1[i] - b2[i] + c[i];
+    }
+
+    static void to_array(const StateVector& s, double* v) {
+        v[0] = s.x; v[1] = s.y; v[2] = s.z;
+        v[3] = s.vx; v[4] = s.vy; v[5] = s.vz;
+    }
+
+    void fit_segment(double start, double end) {
+        const int n = nodes;
+        const double mid = 0.5 * (start + end);
+        const double half = 0.5 * (end - start);
+
+        std::vector<double> samples(static_cast<size_t>(n) * COMPONENTS);
+        StateVector state;
+        for (int j = 0; j < n; ++j) {
+            sgp4.propagate(mid + half * node_tau[j], state);
+            to_array(state, &samples[static_cast<size_t>(j) * COMPONENTS]);
+        }
+
+        Segment seg = {start, end, mid, 1.0 / half, coefficients.size(), 0.0, 0.0};
+        coefficients.resize(seg.offset + static_cast<size_t>(n) * COMPONENTS);
+        double* c = coefficients.data() + seg.offset;
+        for (int k = 0; k < n; ++k) {
+            const double scale = (k == 0 ? 1.0 : 2.0) / n;
+            for (int i = 0; i < COMPONENTS; ++i) {
+                double sum = 0.0;
+                for (int j = 0; j < n; ++j) {
+                    sum += samples[static_cast<size_t>(j) * COMPONENTS + i] * basis[static_cast<size_t>(k) * n + j];
+                }
+                c[k * COMPONENTS + i] = sum * scale;
+            }
+        }
+
+        double truth[COMPONENTS], fit[COMPONENTS];
+        for (double tau : check_tau) {
+            double t = mid + half * tau;
+            sgp4.propagate(t, state);
+            to_array(state, truth);
+            evaluate(seg, t, fit);
+            seg.position_error_km = std::max(seg.position_error_km,
+                std::sqrt((fit[0] - truth[0]) * (fit[0] - truth[0]) + (fit[1] - truth[1]) * (fit[1] - truth[1]) +
+                          (fit[2] - truth[2]) * (fit[2] - truth[2])));
+            seg.velocity_error_km_s = std::max(seg.velocity_error_km_s,
+                std::sqrt((fit[3] - truth[3]) * (fit[3] - truth[3]) + (fit[4] - truth[4]) * (fit[4] - truth[4]) +
+                          (fit[5] - truth[5]) * (fit[5] - truth[5])));
+        }
+
+        if (seg.position_error_km > config.tolerance_km && half >= config.min_segment_minutes) {
+            coefficients.resize(seg.offset);
+            fit_segment(start, mid);
+            fit_segment(mid, end);
+            return;
+        }
+        segments.push_back(seg);
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // CHEBYSHEV_EPHEMERIS_H
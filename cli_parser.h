@@ -25,6 +25,11 @@ public:
         bool enable_csv_output = false;
         bool verbose = false;
         std::string output_file = "";
+        std::string metrics_file = "";     // Prometheus text file when set
+        double metrics_interval = 5.0;     // seconds between metrics writes
+        std::string iq_file = "";          // recorded capture to process
+        std::string iq_format = "";        // raw sample format; empty = from metadata or extension
+        std::string record_base = "";      // SigMF base name for recording the demo's samples
     };
 
     static Options parse(int argc, char* argv[]) {
@@ -67,6 +72,21 @@ public:
             else if (arg == "--output-file" && i + 1 < argc) {
                 opts.output_file = argv[++i];
             }
+            else if (arg == "--iq-file" && i + 1 < argc) {
+                opts.iq_file = argv[++i];
+            }
+            else if (arg == "--iq-format" && i + 1 < argc) {
+                opts.iq_format = argv[++i];
+            }
+            else if (arg == "--record" && i + 1 < argc) {
+                opts.record_base = argv[++i];
+            }
+            else if (arg == "--metrics" && i + 1 < argc) {
+                opts.metrics_file = argv[++i];
+            }
+            else if (arg == "--metrics-interval" && i + 1 < argc) {
+                opts.metrics_interval = std::stod(argv[++i]);
+            }
             else if (arg == "--json") {
                 opts.enable_json_output = true;
             }
@@ -105,6 +125,13 @@ private:
         std::cout << "  --elev METERS             Ground station elevation (default: 1600.0)\n";
         std::cout << "  --output-format FORMAT    Output format: text|json|csv (default: text)\n";
         std::cout << "  --output-file FILE        Output file path\n";
+        std::cout << "  --iq-file FILE            Process a recorded capture (SigMF or raw\n";
+        std::cout << "                            .cf32/.cf64/.cs16/.cu8) instead of a synthetic signal\n";
+        std::cout << "  --iq-format FMT           Sample format of a raw capture: cf32|cf64|cs16|cu8\n";
+        std::cout << "  --record BASE             Record the input and Doppler-corrected samples as\n";
+        std::cout << "                            SigMF (BASE-raw.sigmf-*, BASE-corrected.sigmf-*)\n";
+        std::cout << "  --metrics FILE            Write Prometheus text-format metrics to FILE\n";
+        std::cout << "  --metrics-interval S      Seconds between metrics writes (default: 5)\n";
         std::cout << "  --json                    Enable JSON output\n";
         std::cout << "  --csv                     Enable CSV output\n";
         std::cout << "  --benchmark               Run benchmark suite\n";
@@ -0,0 +1,280 @@
+#ifndef CONJUNCTION_SCREENER_H
+#define CONJUNCTION_SCREENER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "orbital_types.h"
+#include "catalog_propagator.h"
+#include "root_finding.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Close-approach screening for a whole catalog. The screening span is cut
+// into fixed steps and the catalog is propagated to the middle of each. A
+// pair can only come within the screening distance during a step if it is
+// within that distance plus the largest relative motion over half a step,
+// so positions are bucketed in a 3D spatial hash with cells of that size
+// and only pairs in adjacent cells are tested. Survivors go through a
+// straight-line closest-approach test (padded for orbital curvature), and
+// the rest are refined: relative position is interpolated with cubic
+// Hermite polynomials through the states at the start, middle and end of
+// the step, and Brent's minimizer finds the time and distance of closest
+// approach. Steps are spread across worker threads.
+//
+// States come from the catalog as configured, so screen a catalog built
+// with CatalogPropagator::Model::SGP4 for times and miss distances that
+// agree with the rest of the library; two-body catalogs are only fit for
+// throughput. Satellites whose state is inside the Earth (decayed, or an
+// SGP4 failure, which leaves a zero state) are skipped for that step.
+class ConjunctionScreener {
+public:
+    struct Config {
+        double screening_distance_km = 5.0;
+        double step_seconds = 10.0;
+        double time_tolerance_seconds = 0.01;  // of the time of closest approach
+        unsigned num_threads = 0;              // 0 = all cores
+        size_t grain = 16;                     // steps per work item
+    };
+
+    struct Conjunction {
+        uint32_t a, b;                         // satellite indices, a < b
+        double tca_minutes;                    // in catalog time
+        double miss_distance_km;
+        double relative_speed_km_s;
+    };
+
+    ConjunctionScreener() : ConjunctionScreener(Config()) {}
+    explicit ConjunctionScreener(const Config& cfg) : config(cfg) {}
+
+    // Every approach within the screening distance in [start, start +
+    // duration) minutes of catalog time, sorted by time of closest approach
+    void screen(const CatalogPropagator& catalog, double start_minutes, double duration_minutes,
+                std::vector<Conjunction>& out) {
+        out.clear();
+        const double dt = config.step_seconds / 60.0;
+        const size_t steps = static_cast<size_t>(std::ceil(duration_minutes / dt - 1e-9));
+        const size_t grain = std::max<size_t>(1, config.grain);
+        chunks.resize((steps + grain - 1) / grain);
+        chunk_candidates.assign(chunks.size(), 0);
+        for (auto& c : chunks) c.clear();
+
+        parallel_for(steps, [&](size_t begin, size_t end, unsigned) {
+            Workspace ws;
+            ws.states.resize(catalog.size());
+            for (size_t k = begin; k < end; ++k) {
+                double t0 = start_minutes + k * dt;
+                double t1 = std::min(start_minutes + duration_minutes, t0 + dt);
+                screen_step(catalog, t0, t1, k > 0, k + 1 < steps, ws, chunks[begin / grain]);
+            }
+            chunk_candidates[begin / grain] = ws.candidates;
+        }, grain, config.num_threads);
+
+        candidates = 0;
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            out.insert(out.end(), chunks[c].begin(), chunks[c].end());
+            candidates += chunk_candidates[c];
+        }
+
+        // An approach at a step boundary can be found from both sides
+        std::sort(out.begin(), out.end(), [](const Conjunction& x, const Conjunction& y) {
+            if (x.a != y.a) return x.a < y.a;
+            if (x.b != y.b) return x.b < y.b;
+            return x.tca_minutes < y.tca_minutes;
+        });
+        size_t kept = 0;
+        for (size_t i = 0; i < out.size(); ++i) {
+            if (kept > 0 && out[kept - 1].a == out[i].a && out[kept - 1].b == out[i].b &&
+                out[i].tca_minutes - out[kept - 1].tca_minutes < dt) {
+                if (out[i].miss_distance_km < out[kept - 1].miss_distance_km) out[kept - 1] = out[i];
+                continue;
+            }
+            out[kept++] = out[i];
+        }
+        out.resize(kept);
+        std::sort(out.begin(), out.end(), [](const Conjunction& x, const Conjunction& y) {
+            return x.tca_minutes < y.tca_minutes;
+        });
+    }
+
+    // Pairs refined by the last screen()
+    size_t get_candidate_count() const { return candidates; }
+    const Config& get_config() const { return config; }
+
+private:
+    struct Workspace {
+        CatalogPropagator::States states;
+        std::vector<int32_t> cx, cy, cz;
+        std::vector<uint32_t> bucket_start;    // CSR offsets into order
+        std::vector<uint32_t> order;           // satellites by bucket
+        std::vector<uint32_t> bucket;          // of each satellite
+        std::vector<uint32_t> fill;
+        std::vector<uint8_t> valid;            // state above the Earth's surface
+        size_t candidates = 0;
+    };
+
+    Config config;
+    std::vector<std::vector<Conjunction>> chunks;  // per work item, reused
+    std::vector<size_t> chunk_candidates;
+    size_t candidates = 0;
+
+    static uint32_t hash_cell(int32_t x, int32_t y, int32_t z, uint32_t mask) {
+        return (static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u ^
+                static_cast<uint32_t>(z) * 83492791u) & mask;
+    }
+
+    // Pairs that close in [t0, t1]; open_start / open_end mark ends shared
+    // with a neighbouring step
+    void screen_step(const CatalogPropagator& catalog, double t0, double t1, bool open_start, bool open_end,
+                     Workspace& ws, std::vector<Conjunction>& out) const {
+        const size_t n = catalog.size();
+        const double mid = 0.5 * (t0 + t1);
+        const double half_s = 0.5 * (t1 - t0) * 60.0;
+        auto& st = ws.states;
+        catalog.propagate(mid, st, 0, n);
+
+        // Largest relative speed and acceleration bound the motion in half
+        // a step
+        double v2_max = 0.0, r2_min = 1e300;
+        ws.valid.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            double r2 = st.x[i] * st.x[i] + st.y[i] * st.y[i] + st.z[i] * st.z[i];
+            ws.valid[i] = r2 >= WGS84_A_KM * WGS84_A_KM;
+            if (!ws.valid[i]) continue;
+            v2_max = std::max(v2_max, st.vx[i] * st.vx[i] + st.vy[i] * st.vy[i] + st.vz[i] * st.vz[i]);
+            r2_min = std::min(r2_min, r2);
+        }
+        const double curvature = 0.5 * (2.0 * EARTH_MU / r2_min) * half_s * half_s;
+        const double linear_limit = config.screening_distance_km + curvature;
+        const double reach = linear_limit + 2.0 * 1.05 * std::sqrt(v2_max) * half_s;
+        const double reach2 = reach * reach;
+        const double inv = 1.0 / reach;
+
+        // Spatial hash: counting sort of satellites by bucket
+        uint32_t buckets = 16;
+        while (buckets < 2 * n) buckets *= 2;
+        const uint32_t mask = buckets - 1;
+        ws.cx.resize(n); ws.cy.resize(n); ws.cz.resize(n);
+        ws.bucket.resize(n);
+        ws.order.resize(n);
+        ws.bucket_start.assign(buckets + 1, 0);
+        for (size_t i = 0; i < n; ++i) {
+            ws.cx[i] = static_cast<int32_t>(std::floor(st.x[i] * inv));
+            ws.cy[i] = static_cast<int32_t>(std::floor(st.y[i] * inv));
+            ws.cz[i] = static_cast<int32_t>(std::floor(st.z[i] * inv));
+            ws.bucket[i] = hash_cell(ws.cx[i], ws.cy[i], ws.cz[i], mask);
+            ++ws.bucket_start[ws.bucket[i] + 1];
+        }
+        for (uint32_t b = 1; b <= buckets; ++b) ws.bucket_start[b] += ws.bucket_start[b - 1];
+        ws.fill.assign(ws.bucket_start.begin(), ws.bucket_start.end() - 1);
+        for (size_t i = 0; i < n; ++i) ws.order[ws.fill[ws.bucket[i]]++] = static_cast<uint32_t>(i);
+
+        for (uint32_t i = 0; i < n; ++i) {
+            if (!ws.valid[i]) continue;
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dz = -1; dz <= 1; ++dz) {
+                        const int32_t x = ws.cx[i] + dx, y = ws.cy[i] + dy, z = ws.cz[i] + dz;
+                        const uint32_t b = hash_cell(x, y, z, mask);
+                        for (uint32_t o = ws.bucket_start[b]; o < ws.bucket_start[b + 1]; ++o) {
+                            const uint32_t j = ws.order[o];
+                            // Each pair once, and only from its own cell
+                            if (j <= i || !ws.valid[j] || ws.cx[j] != x || ws.cy[j] != y || ws.cz[j] != z) continue;
+                            double rx = st.x[j] - st.x[i], ry = st.y[j] - st.y[i], rz = st.z[j] - st.z[i];
+                            double d2 = rx * rx + ry * ry + rz * rz;
+                            if (d2 > reach2) continue;
+
+                            // Straight-line closest approach within the step
+                            double vx = st.vx[j] - st.vx[i], vy = st.vy[j] - st.vy[i], vz = st.vz[j] - st.vz[i];
+                            double v2 = vx * vx + vy * vy + vz * vz;
+                            double tau = v2 > 0.0 ? -(rx * vx + ry * vy + rz * vz) / v2 : 0.0;
+                            tau = std::min(half_s, std::max(-half_s, tau));
+                            double px = rx + vx * tau, py = ry + vy * tau, pz = rz + vz * tau;
+                            if (px * px + py * py + pz * pz > linear_limit * linear_limit) continue;
+
+                            ++ws.candidates;
+                            refine(catalog, i, j, t0, mid, t1, open_start, open_end, st, out);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Closest approach of satellites a and b in [t0, t1] from cubic Hermite
+    // interpolation of their relative state at t0, mid and t1
+    void refine(const CatalogPropagator& catalog, uint32_t a, uint32_t b, double t0, double mid, double t1,
+                bool open_start, bool open_end, const CatalogPropagator::States& st,
+                std::vector<Conjunction>& out) const {
+        StateVector rel[3];
+        StateVector a0 = catalog.propagate_one(a, t0), b0 = catalog.propagate_one(b, t0);
+        StateVector a2 = catalog.propagate_one(a, t1), b2 = catalog.propagate_one(b, t1);
+        rel[0] = difference(b0, a0);
+        rel[1] = difference(st.get(b), st.get(a));
+        rel[2] = difference(b2, a2);
+        const double times[3] = {t0, mid, t1};
+        const double tolerance = config.time_tolerance_seconds / 60.0;
+
+        double best_t = mid, best_d2 = 1e300;
+        StateVector best_v = rel[1];
+        for (int seg = 0; seg < 2; ++seg) {
+            const StateVector& p = rel[seg];
+            const StateVector& q = rel[seg + 1];
+            const double span = (times[seg + 1] - times[seg]) * 60.0;  // seconds
+            if (span <= 0.0) continue;
+            auto position = [&](double s, double& x, double& y, double& z) {
+                double s2 = s * s, s3 = s2 * s;
+                double h00 = 2.0 * s3 - 3.0 * s2 + 1.0, h10 = s3 - 2.0 * s2 + s;
+                double h01 = -2.0 * s3 + 3.0 * s2, h11 = s3 - s2;
+                x = h00 * p.x + h10 * span * p.vx + h01 * q.x + h11 * span * q.vx;
+                y = h00 * p.y + h10 * span * p.vy + h01 * q.y + h11 * span * q.vy;
+                z = h00 * p.z + h10 * span * p.vz + h01 * q.z + h11 * span * q.vz;
+            };
+            auto distance2 = [&](double s) {
+                double x, y, z;
+                position(s, x, y, z);
+                return x * x + y * y + z * z;
+            };
+            auto [s, d2] = brent_minimize(distance2, 0.0, 1.0, tolerance * 60.0 / span);
+            for (double end : {0.0, 1.0}) {
+                double d2_end = distance2(end);
+                if (d2_end < d2) {
+                    s = end;
+                    d2 = d2_end;
+                }
+            }
+            if (d2 < best_d2) {
+                best_d2 = d2;
+                best_t = s == 1.0 ? times[seg + 1] : times[seg] + s * (times[seg + 1] - times[seg]);
+                // Relative velocity: derivative of the Hermite polynomial
+                double s2 = s * s;
+                double d00 = 6.0 * s2 - 6.0 * s, d10 = 3.0 * s2 - 4.0 * s + 1.0;
+                double d01 = -6.0 * s2 + 6.0 * s, d11 = 3.0 * s2 - 2.0 * s;
+                best_v.vx = (d00 * p.x + d01 * q.x) / span + d10 * p.vx + d11 * q.vx;
+                best_v.vy = (d00 * p.y + d01 * q.y) / span + d10 * p.vy + d11 * q.vy;
+                best_v.vz = (d00 * p.z + d01 * q.z) / span + d10 * p.vz + d11 * q.vz;
+            }
+        }
+
+        const double limit = config.screening_distance_km;
+        if (best_d2 > limit * limit) return;
+        // At a step end shared with a neighbour, keep the approach only if
+        // the range there shows the minimum is on this side
+        auto range_rate = [](const StateVector& r) { return r.x * r.vx + r.y * r.vy + r.z * r.vz; };
+        if (open_start && best_t == t0 && range_rate(rel[0]) >= 0.0) return;
+        if (open_end && best_t == t1 && range_rate(rel[2]) <= 0.0) return;
+        out.push_back({a, b, best_t, std::sqrt(best_d2),
+                       std::sqrt(best_v.vx * best_v.vx + best_v.vy * best_v.vy + best_v.vz * best_v.vz)});
+    }
+
+    static StateVector difference(const StateVector& b, const StateVector& a) {
+        return {b.x - a.x, b.y - a.y, b.z - a.z, b.vx - a.vx, b.vy - a.vy, b.vz - a.vz};
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // CONJUNCTION_SCREENER_H
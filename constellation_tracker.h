@@ -6,20 +6,22 @@
 #include <string>
 #include <cmath>
 #include <algorithm>
+#include <iostream>
+#include "orbital_types.h"
+#include "sgp4_propagator.h"
+#include "pass_predictor.h"
+#include "catalog_propagator.h"
+#include "visibility_index.h"
+#include "isl_analyzer.h"
+#include "satellite_table.h"
+#include "handover_scheduler.h"
+#include "coverage_grid.h"
+#include "conjunction_screener.h"
 
-struct Satellite {
-    int catalog_number;
-    std::string name;
-    double latitude;
-    double longitude;
-    double altitude_km;
-    double velocity_km_s;
-    double signal_strength_dbm;
-    bool in_range;
-};
+namespace SatelliteSignal {
 
 struct PassPrediction {
-    std::string satellite_name;
+    SatelliteId satellite;
     double rise_time_minutes;
     double set_time_minutes;
     double max_elevation_degrees;
@@ -28,13 +30,21 @@ struct PassPrediction {
 };
 
 struct NetworkLink {
-    std::string from_satellite;
-    std::string to_satellite;
+    SatelliteId from_satellite;
+    SatelliteId to_satellite;
     double link_budget_margin_db;
     bool is_viable;
     double data_rate_mbps;
 };
 
+// Station coverage passing from one satellite to the next
+struct HandoverEvent {
+    SatelliteId from_satellite;
+    SatelliteId to_satellite;
+    double time_minutes;                    // when the outgoing satellite sets
+    double gap_minutes;                     // until the incoming one rises
+};
+
 class ConstellationTracker {
 public:
     struct ConstellationConfig {
@@ -44,103 +54,232 @@ public:
         double orbital_inclination_deg;
         int num_orbital_planes;
         int sats_per_plane;
+        int walker_phasing = 1;                 // Walker-delta F
+        int epoch_year = 24;
+        double epoch_day = 1.0;
+        GroundStation ground_station = {40.0, -105.0, 1600.0};
+        double min_elevation_deg = 5.0;
+        double carrier_frequency_hz = 10e9;
+        double isl_max_range_km = 5000.0;
     };
 
-    ConstellationTracker(const ConstellationConfig& cfg) : config(cfg) {
+    ConstellationTracker(const ConstellationConfig& cfg)
+        : config(cfg), predictor(make_predictor_config(cfg)), catalog(make_catalog_config(cfg)),
+          isl(make_isl_config(cfg)) {
         initialize_constellation();
     }
 
-    std::vector<Satellite> get_visible_satellites(double current_time_minutes) {
-        std::vector<Satellite> visible;
-        
-        for (auto& sat : satellites) {
-            if (is_satellite_visible(sat, current_time_minutes)) {
-                visible.push_back(sat);
+    // Walker-delta i:T/P/F element sets for the configured shell: P planes
+    // evenly spaced in RAAN, satellites evenly spaced in each plane, and
+    // adjacent planes offset in phase by F * 360 / T degrees
+    static std::vector<TLE> generate_elements(const ConstellationConfig& cfg) {
+        const int total = cfg.num_orbital_planes * cfg.sats_per_plane;
+        const double a = WGS84_A_KM + cfg.orbit_altitude_km;
+        const double revs_per_day = std::sqrt(EARTH_MU / (a * a * a)) * 86400.0 / (2.0 * M_PI);
+
+        std::vector<TLE> elements;
+        elements.reserve(total);
+        for (int plane = 0; plane < cfg.num_orbital_planes; ++plane) {
+            for (int sat = 0; sat < cfg.sats_per_plane; ++sat) {
+                TLE tle = TLE();
+                tle.catalog_number = plane * cfg.sats_per_plane + sat + 1000;
+                tle.epoch_year = cfg.epoch_year;
+                tle.epoch_day = cfg.epoch_day;
+                tle.element_set_num = 1;
+                tle.mean_motion = revs_per_day;
+                tle.eccentricity = 0.0001;
+                tle.inclination = cfg.orbital_inclination_deg * DEG_TO_RAD;
+                tle.raan = 2.0 * M_PI * plane / cfg.num_orbital_planes;
+                tle.mean_anomaly = 2.0 * M_PI * sat / cfg.sats_per_plane +
+                                   2.0 * M_PI * cfg.walker_phasing * plane / total;
+                elements.push_back(tle);
             }
         }
-        
+        return elements;
+    }
+
+    // Propagate the shell to `time_minutes` after the constellation epoch and
+    // refresh the geodetic and in-range columns of the satellite table
+    void update(double time_minutes) {
+        current_time = time_minutes;
+        catalog.propagate(time_minutes, states);
+        double gmst = SGP4Propagator::gmst(epoch_jd + time_minutes / 1440.0);
+        table.update(states, gmst);
+        visibility.build(states, gmst);
+        visible.clear();
+        visibility.query(0, visible);
+        std::fill(table.in_range.begin(), table.in_range.end(), 0);
+        for (SatelliteId id : visible) table.in_range[id] = 1;
+    }
+
+    // Ids of the satellites above the station mask at `current_time_minutes`
+    // after the constellation epoch. The shell is propagated in bulk and
+    // bucketed by sub-satellite point, so only satellites near the station
+    // are tested.
+    const std::vector<SatelliteId>& get_visible_satellites(double current_time_minutes) {
+        update(current_time_minutes);
         return visible;
     }
 
+    // Incremental catalog changes. Each patches the satellite table, the
+    // propagators, the visibility index, the state and visible set of the
+    // last update() and the cached pass window for the affected satellite
+    // only. Elements may have any epoch.
+    SatelliteId insert_satellite(const TLE& tle, std::string_view name, float signal_dbm = -120.0f) {
+        SatelliteId id = table.add(static_cast<int32_t>(tle.catalog_number), name, signal_dbm);
+        catalog.add(tle);
+        predictor.add_satellite(tle);
+        if (has_pass_window) cached_passes.emplace_back();
+        states.resize(table.size());
+        refresh_satellite(id);
+        return id;
+    }
+
+    void update_satellite(SatelliteId id, const TLE& tle) {
+        table.set(id, static_cast<int32_t>(tle.catalog_number), table.name(id));
+        catalog.set(id, tle);
+        predictor.set_satellite(id, tle);
+        refresh_satellite(id);
+    }
+
+    // Remove satellite `id`. Ids stay dense: the last satellite takes over
+    // `id`, and its old id is returned.
+    SatelliteId remove_satellite(SatelliteId id) {
+        const SatelliteId last = static_cast<SatelliteId>(table.size() - 1);
+        table.remove(id);
+        catalog.remove(id);
+        predictor.remove_satellite(id);
+        visibility.remove_satellite(id);
+        for (auto* column : {&states.x, &states.y, &states.z, &states.vx, &states.vy, &states.vz}) {
+            (*column)[id] = column->back();
+            column->pop_back();
+        }
+        if (has_pass_window) {
+            cached_passes[id] = std::move(cached_passes.back());
+            cached_passes.pop_back();
+            for (auto& p : cached_passes[id]) p.satellite = id;
+        }
+        visible.erase(std::remove(visible.begin(), visible.end(), id), visible.end());
+        for (auto& v : visible) {
+            if (v == last) v = id;
+        }
+        return last;
+    }
+
+    // Id of the satellite with `catalog_number`, or NameTable::npos
+    SatelliteId find_satellite(int32_t catalog_number) const {
+        auto it = std::find(table.catalog_number.begin(), table.catalog_number.end(), catalog_number);
+        return it == table.catalog_number.end() ? NameTable::npos
+                                                : static_cast<SatelliteId>(it - table.catalog_number.begin());
+    }
+
+    const SatelliteTable& get_satellites() const { return table; }
+    std::string_view get_satellite_name(SatelliteId id) const { return table.name(id); }
+
+    // Passes over the configured ground station in the window, sorted by
+    // rise time; times are minutes after the constellation epoch. The last
+    // window's passes are cached per satellite, so repeating it after
+    // incremental changes only re-predicts the satellites that changed.
     std::vector<PassPrediction> predict_passes(double start_time_min, double duration_hours) {
+        predict_pass_window(start_time_min, duration_hours);
+
         std::vector<PassPrediction> passes;
-        
-        double end_time = start_time_min + duration_hours * 60.0;
-        
-        for (const auto& sat : satellites) {
-            double pass_time = predict_next_pass(sat.name, start_time_min);
-            
-            if (pass_time < end_time) {
+        for (const auto& list : cached_passes) {
+            for (const auto& p : list) {
                 PassPrediction pred;
-                pred.satellite_name = sat.name;
-                pred.rise_time_minutes = pass_time;
-                pred.set_time_minutes = pass_time + estimate_pass_duration(sat);
-                pred.max_elevation_degrees = estimate_max_elevation(sat);
-                pred.duration_minutes = estimate_pass_duration(sat);
-                pred.doppler_rate_hz_per_s = estimate_doppler_rate(sat);
-                
+                pred.satellite = p.satellite;
+                pred.rise_time_minutes = start_time_min + p.aos;
+                pred.set_time_minutes = start_time_min + p.los;
+                pred.max_elevation_degrees = p.max_elevation_deg;
+                pred.duration_minutes = p.duration();
+                pred.doppler_rate_hz_per_s = std::fabs(doppler_shift_hz(p.tca_range_acceleration,
+                                                                        config.carrier_frequency_hz));
                 passes.push_back(pred);
             }
         }
-        
-        std::sort(passes.begin(), passes.end(), 
-            [](const PassPrediction& a, const PassPrediction& b) {
-                return a.rise_time_minutes < b.rise_time_minutes;
-            });
-        
+        std::stable_sort(passes.begin(), passes.end(), [](const PassPrediction& a, const PassPrediction& b) {
+            return a.rise_time_minutes < b.rise_time_minutes;
+        });
         return passes;
     }
 
-    std::vector<NetworkLink> analyze_inter_satellite_links() {
+    // Line-of-sight pairs within the ISL range at `time_minutes` after the
+    // constellation epoch, as satellite index pairs
+    const std::vector<ISLAnalyzer::Link>& get_inter_satellite_links(double time_minutes) {
+        catalog.propagate(time_minutes, states);
+        isl.analyze(states, isl_links);
+        return isl_links;
+    }
+
+    std::vector<NetworkLink> analyze_inter_satellite_links(double time_minutes = 0.0) {
         std::vector<NetworkLink> links;
-        
-        for (size_t i = 0; i < satellites.size(); ++i) {
-            for (size_t j = i + 1; j < satellites.size(); ++j) {
-                double distance = calculate_distance(satellites[i], satellites[j]);
-                double link_budget = calculate_link_budget(distance);
-                
-                if (link_budget > 0.0) {
-                    NetworkLink link;
-                    link.from_satellite = satellites[i].name;
-                    link.to_satellite = satellites[j].name;
-                    link.link_budget_margin_db = link_budget;
-                    link.is_viable = link_budget > 3.0;
-                    link.data_rate_mbps = estimate_isl_data_rate(link_budget);
-                    
-                    links.push_back(link);
-                }
+        for (const auto& l : get_inter_satellite_links(time_minutes)) {
+            double link_budget = calculate_link_budget(l.range_km);
+            if (link_budget > 0.0) {
+                NetworkLink link;
+                link.from_satellite = l.a;
+                link.to_satellite = l.b;
+                link.link_budget_margin_db = link_budget;
+                link.is_viable = link_budget > 3.0;
+                link.data_rate_mbps = estimate_isl_data_rate(link_budget);
+                links.push_back(link);
             }
         }
-        
         return links;
     }
 
-    std::vector<PassPrediction> find_handover_events(double duration_hours) {
-        std::vector<PassPrediction> handovers;
-        
-        auto passes = predict_passes(0.0, duration_hours);
-        
-        for (size_t i = 0; i + 1 < passes.size(); ++i) {
-            double gap = passes[i + 1].rise_time_minutes - passes[i].set_time_minutes;
-            
-            if (gap > 0.0 && gap < 5.0) {
-                PassPrediction handover = passes[i];
-                handover.satellite_name = passes[i].satellite_name + " -> " + passes[i + 1].satellite_name;
-                handover.duration_minutes = gap;
-                handovers.push_back(handover);
-            }
+    // Satellite changes of the station antenna over the first
+    // `duration_hours`, from a contact plan that maximizes total tracking
+    // time with `setup_minutes` between contacts
+    std::vector<HandoverEvent> find_handover_events(double duration_hours, double setup_minutes = 1.0) {
+        predict_pass_window(0.0, duration_hours);
+        HandoverScheduler::Config sc;
+        sc.setup_minutes = setup_minutes;
+        HandoverScheduler scheduler(sc);
+        scheduler.add_station(config.ground_station);
+        std::vector<PassPredictor::Pass> passes;
+        for (const auto& list : cached_passes) passes.insert(passes.end(), list.begin(), list.end());
+        scheduler.set_passes(std::move(passes));
+
+        std::vector<HandoverEvent> handovers;
+        for (const auto& h : HandoverScheduler::handovers(scheduler.plan())) {
+            handovers.push_back({h.from_satellite, h.to_satellite, h.time, h.gap});
         }
-        
         return handovers;
     }
 
+    // Close approaches within `distance_km` over `duration_hours` from
+    // `start_time_min`, screened on SGP4 states; times are minutes after
+    // the constellation epoch
+    std::vector<ConjunctionScreener::Conjunction> screen_conjunctions(double duration_hours,
+                                                                      double distance_km = 5.0,
+                                                                      double start_time_min = 0.0) {
+        ConjunctionScreener::Config sc;
+        sc.screening_distance_km = distance_km;
+        ConjunctionScreener screener(sc);
+        std::vector<ConjunctionScreener::Conjunction> conjunctions;
+        screener.screen(catalog, start_time_min, duration_hours * 60.0, conjunctions);
+        return conjunctions;
+    }
+
+    // Coverage of the Earth by the shell over `duration_hours` from the
+    // epoch, above the configured elevation mask
+    CoverageGrid::Statistics analyze_coverage(double duration_hours, double step_minutes = 1.0) {
+        CoverageGrid::Config cc;
+        cc.min_elevation_deg = config.min_elevation_deg;
+        cc.time_step_minutes = step_minutes;
+        CoverageGrid grid(cc);
+        grid.analyze(catalog, epoch_jd, 0.0, duration_hours * 60.0);
+        return grid.statistics();
+    }
+
     void optimize_ground_station_network(double coverage_target_percent = 95.0) {
-        int num_stations_required = 1;
-        
-        for (int n = 1; n <= 10; ++n) {
-            double coverage = estimate_global_coverage(n);
-            if (coverage >= coverage_target_percent) {
-                num_stations_required = n;
+        CoverageGrid grid(coverage_config());
+        auto placement = place_ground_stations(grid, 10);
+        size_t num_stations_required = placement.cells.size();
+        for (size_t n = 0; n < placement.contact_percent.size(); ++n) {
+            if (placement.contact_percent[n] >= coverage_target_percent) {
+                num_stations_required = n + 1;
                 break;
             }
         }
@@ -150,29 +289,31 @@ public:
                   << num_stations_required << "\n";
         
         std::cout << "Suggested locations:\n";
-        generate_optimal_station_locations(num_stations_required);
+        for (size_t i = 0; i < num_stations_required; ++i) {
+            double latitude, longitude;
+            grid.cell_center(placement.cells[i], latitude, longitude);
+            std::cout << "  Station " << (i + 1) << ": " 
+                      << latitude << "N, " << longitude << "E ("
+                      << placement.contact_percent[i] << "%)\n";
+        }
     }
 
+    // Percent of satellite time over one day in view of at least one of the
+    // best `num_ground_stations` sites
     double estimate_global_coverage(int num_ground_stations) {
-        double coverage = 0.0;
-        
-        for (int n = 0; n < num_ground_stations; ++n) {
-            double coverage_area = 4.0 * 3.14159265359 * std::pow(satellites[0].altitude_km / 1000.0, 2);
-            double earth_area = 4.0 * 3.14159265359 * std::pow(6371.0, 2);
-            coverage += std::min(coverage_area / earth_area, 1.0);
-        }
-        
-        return std::min(coverage * 100.0, 100.0);
+        CoverageGrid grid(coverage_config());
+        auto placement = place_ground_stations(grid, static_cast<size_t>(std::max(0, num_ground_stations)));
+        return placement.contact_percent.empty() ? 0.0 : placement.contact_percent.back();
     }
 
     int get_satellite_count() const {
-        return satellites.size();
+        return static_cast<int>(table.size());
     }
 
     void print_constellation_info() {
         std::cout << "\nConstellation: " << config.constellation_name << "\n";
         std::cout << "===============================================\n";
-        std::cout << "Number of Satellites: " << satellites.size() << "\n";
+        std::cout << "Number of Satellites: " << table.size() << "\n";
         std::cout << "Orbital Altitude: " << config.orbit_altitude_km << " km\n";
         std::cout << "Inclination: " << config.orbital_inclination_deg << " degrees\n";
         std::cout << "Orbital Planes: " << config.num_orbital_planes << "\n";
@@ -181,75 +322,119 @@ public:
 
 private:
     ConstellationConfig config;
-    std::vector<Satellite> satellites;
+    SatelliteTable table;
+    std::vector<SatelliteId> visible;
+    PassPredictor predictor;
+    CatalogPropagator catalog;              // SGP4, like the pass predictor
+    CatalogPropagator::States states;
+    VisibilityIndex visibility;
+    ISLAnalyzer isl;
+    std::vector<ISLAnalyzer::Link> isl_links;
+    double epoch_jd = 0.0;
+    double current_time = 0.0;              // of the last update()
 
-    void initialize_constellation() {
-        satellites.clear();
-        
-        for (int plane = 0; plane < config.num_orbital_planes; ++plane) {
-            for (int sat = 0; sat < config.sats_per_plane; ++sat) {
-                Satellite s;
-                s.catalog_number = plane * config.sats_per_plane + sat + 1000;
-                s.name = config.constellation_name + "-" + std::to_string(s.catalog_number);
-                
-                double plane_angle = (plane * 360.0) / config.num_orbital_planes;
-                double sat_angle = (sat * 360.0) / config.sats_per_plane;
-                
-                s.latitude = 0.0;
-                s.longitude = sat_angle;
-                s.altitude_km = config.orbit_altitude_km;
-                s.velocity_km_s = std::sqrt(3.986e5 / (6371.0 + s.altitude_km));
-                s.signal_strength_dbm = -120.0 + (plane % 3) * 5;
-                s.in_range = false;
-                
-                satellites.push_back(s);
-            }
-        }
+    std::vector<std::vector<PassPredictor::Pass>> cached_passes;  // per satellite
+    bool has_pass_window = false;
+    double pass_start = 0.0, pass_hours = 0.0;
+
+    void predict_pass_window(double start_time_min, double duration_hours) {
+        if (has_pass_window && start_time_min == pass_start && duration_hours == pass_hours) return;
+        cached_passes = predictor.predict_each(epoch_jd + start_time_min / 1440.0, duration_hours * 60.0);
+        has_pass_window = true;
+        pass_start = start_time_min;
+        pass_hours = duration_hours;
     }
 
-    bool is_satellite_visible(const Satellite& sat, double current_time_min) {
-        double elevation = estimate_elevation(sat, current_time_min);
-        return elevation > 5.0;
+    CoverageGrid::Config coverage_config() const {
+        CoverageGrid::Config cc;
+        cc.min_elevation_deg = config.min_elevation_deg;
+        return cc;
     }
 
-    double estimate_elevation(const Satellite& sat, double time_min) {
-        double phase = std::fmod(time_min * 360.0 / 90.0, 360.0);
-        double elevation = 80.0 * std::sin(phase * 3.14159265359 / 180.0);
-        return elevation;
+    CoverageGrid::Placement place_ground_stations(const CoverageGrid& grid, size_t count) const {
+        return grid.place_stations(catalog, epoch_jd, 0.0, 1440.0, count);
     }
 
-    double predict_next_pass(const std::string& sat_name, double start_time_min) {
-        return start_time_min + 20.0 + (std::hash<std::string>{}(sat_name) % 100) / 10.0;
+    static PassPredictor::Config make_predictor_config(const ConstellationConfig& cfg) {
+        PassPredictor::Config pc;
+        pc.min_elevation_deg = cfg.min_elevation_deg;
+        return pc;
     }
 
-    double estimate_pass_duration(const Satellite& sat) {
-        double altitude_factor = sat.altitude_km / 400.0;
-        return 10.0 * altitude_factor;
+    // Bulk queries (visibility, links, coverage, screening) run the same
+    // SGP4 model as pass prediction so their answers agree. Time counts
+    // from the constellation epoch; each satellite is propagated from its
+    // own TLE epoch by the offset.
+    static CatalogPropagator::Config make_catalog_config(const ConstellationConfig& cfg) {
+        CatalogPropagator::Config cc;
+        cc.model = CatalogPropagator::Model::SGP4;
+        cc.epoch_jd = SGP4Propagator::epoch_julian_date(cfg.epoch_year, cfg.epoch_day);
+        return cc;
     }
 
-    double estimate_max_elevation(const Satellite& sat) {
-        return 60.0 + (sat.altitude_km / 400.0) * 20.0;
+    static ISLAnalyzer::Config make_isl_config(const ConstellationConfig& cfg) {
+        ISLAnalyzer::Config ic;
+        ic.max_range_km = cfg.isl_max_range_km;
+        return ic;
     }
 
-    double estimate_doppler_rate(const Satellite& sat) {
-        return sat.velocity_km_s * 100.0;
+    void initialize_constellation() {
+        epoch_jd = SGP4Propagator::epoch_julian_date(config.epoch_year, config.epoch_day);
+        auto elements = generate_elements(config);
+        predictor.clear();
+        predictor.add_satellites(elements);
+        if (predictor.station_count() == 0) predictor.add_station(config.ground_station);
+        catalog.clear();
+        catalog.add(elements);
+        if (visibility.station_count() == 0) {
+            visibility.add_station(config.ground_station, config.min_elevation_deg);
+        }
+
+        has_pass_window = false;
+        table.clear();
+        table.reserve(elements.size(), elements.size() * (config.constellation_name.size() + 6));
+        for (size_t i = 0; i < elements.size(); ++i) {
+            int plane = static_cast<int>(i) / config.sats_per_plane;
+            table.add(static_cast<int32_t>(elements[i].catalog_number),
+                      config.constellation_name + "-" + std::to_string(elements[i].catalog_number),
+                      -120.0f + (plane % 3) * 5.0f);
+        }
+        update(0.0);
     }
 
-    double calculate_distance(const Satellite& sat1, const Satellite& sat2) {
-        double dlat = sat1.latitude - sat2.latitude;
-        double dlon = sat1.longitude - sat2.longitude;
-        return std::sqrt(dlat * dlat + dlon * dlon) * 111.32;
+    // Bring one satellite's state, columns, visibility and cached passes up
+    // to date after its elements changed
+    void refresh_satellite(SatelliteId id) {
+        double gmst = SGP4Propagator::gmst(epoch_jd + current_time / 1440.0);
+        StateVector s = catalog.propagate_one(id, current_time);
+        states.x[id] = s.x; states.y[id] = s.y; states.z[id] = s.z;
+        states.vx[id] = s.vx; states.vy[id] = s.vy; states.vz[id] = s.vz;
+        table.update(states, gmst, id, id + 1);
+
+        visibility.set_satellite(id, s, gmst);
+        bool now_visible = visibility.visible(0, s, gmst);
+        auto it = std::find(visible.begin(), visible.end(), id);
+        if (now_visible && it == visible.end()) visible.push_back(id);
+        if (!now_visible && it != visible.end()) visible.erase(it);
+        table.in_range[id] = now_visible ? 1 : 0;
+
+        if (has_pass_window) {
+            cached_passes[id] = predictor.predict(id, epoch_jd + pass_start / 1440.0, pass_hours * 60.0);
+        }
     }
 
+    // Received SNR of a 10 W, 38 dBi to 38 dBi crosslink in 100 MHz at a
+    // 500 K system temperature, with free-space loss at the carrier
     double calculate_link_budget(double distance_km) {
-        const double TX_POWER = 30.0;
-        const double TX_GAIN = 20.0;
-        const double RX_GAIN = 20.0;
-        const double PATH_LOSS = 20 * std::log10(distance_km) + 20 * std::log10(10e9 / 3e8);
-        const double NOISE_FIGURE = 5.0;
-        
-        double link_budget = TX_POWER + TX_GAIN + RX_GAIN - PATH_LOSS - NOISE_FIGURE;
-        return link_budget;
+        const double TX_POWER_DBW = 10.0;
+        const double TX_GAIN = 38.0;
+        const double RX_GAIN = 38.0;
+        const double LOSSES = 5.0;
+        const double NOISE_DBW = -228.6 + 10.0 * std::log10(500.0) + 10.0 * std::log10(100e6);
+        const double PATH_LOSS = 20.0 * std::log10(distance_km) +
+                                 20.0 * std::log10(config.carrier_frequency_hz / 1e9) + 92.45;
+
+        return TX_POWER_DBW + TX_GAIN + RX_GAIN - LOSSES - PATH_LOSS - NOISE_DBW;
     }
 
     double estimate_isl_data_rate(double link_budget_db) {
@@ -260,18 +445,8 @@ private:
         double snr_margin = link_budget_db - SNR_REQUIRED;
         return std::min(1000.0 * (1.0 + snr_margin / 20.0), 10000.0);
     }
-
-    void generate_optimal_station_locations(int num_stations) {
-        double spacing = 360.0 / num_stations;
-        
-        for (int i = 0; i < num_stations; ++i) {
-            double longitude = i * spacing;
-            double latitude = 45.0;
-            
-            std::cout << "  Station " << (i + 1) << ": " 
-                      << latitude << "N, " << longitude << "E\n";
-        }
-    }
 };
 
-#endif
\ No newline at end of file
+}  // namespace SatelliteSignal
+
+#endif // CONSTELLATION_TRACKER_H
\ No newline at end of file
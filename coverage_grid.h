@@ -0,0 +1,408 @@
+#ifndef COVERAGE_GRID_H
+#define COVERAGE_GRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "orbital_types.h"
+#include "station_frame.h"
+#include "sgp4_propagator.h"
+#include "catalog_propagator.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Coverage and revisit analytics for a constellation. The Earth is cut into
+// latitude bands of equal height, and each band into equal longitude cells
+// whose count follows the band's area, so cells are within rounding of equal
+// area (statistics weight by the exact cell area). A cell is covered when a
+// satellite is above the elevation mask seen from its center.
+//
+// analyze() propagates the catalog on a fixed time step, time steps spread
+// across worker threads. Each step marks every satellite's footprint as runs
+// of set bits in a per-step bitset over cells (one run per band the
+// footprint crosses). The step-major bitsets are then transposed 64 x 64 at
+// a time into one bitset over time per cell, from which coverage fraction,
+// longest revisit gap and mean response time follow with word operations,
+// cells spread across workers.
+//
+// Station placement uses the same footprints for a sample of (satellite,
+// time) pairs: each cell's bitset records the samples a station there would
+// see, and stations are added greedily by the number of samples not yet in
+// contact, scoring every candidate cell per pick.
+class CoverageGrid {
+public:
+    struct Config {
+        double cell_size_deg = 2.0;          // band height and nominal cell width
+        double min_elevation_deg = 10.0;     // seen from the cell center
+        double time_step_minutes = 1.0;
+        size_t placement_samples = 8192;     // satellite-time pairs, rounded up to 64
+        unsigned num_threads = 0;            // 0 = all cores
+        size_t grain = 8;                    // time steps per work item
+    };
+
+    struct CellMetrics {
+        float coverage_fraction;             // of time steps with a satellite in view
+        float max_gap_minutes;               // longest stretch without one
+        float mean_response_minutes;         // mean wait for the next one
+    };
+
+    // Area-weighted over the grid
+    struct Statistics {
+        double coverage_percent;             // of area x time
+        double ever_covered_percent;         // of area seen at least once
+        double max_revisit_gap_minutes;      // worst cell
+        double mean_response_minutes;
+    };
+
+    struct Placement {
+        std::vector<uint32_t> cells;         // chosen sites in order of selection
+        std::vector<double> contact_percent; // of samples in view of the first k + 1
+    };
+
+    CoverageGrid() : CoverageGrid(Config()) {}
+    explicit CoverageGrid(const Config& cfg) : config(cfg) {
+        bands = std::max(1, static_cast<int>(std::ceil(180.0 / config.cell_size_deg)));
+        band_height = M_PI / bands;
+        band_offset.assign(bands + 1, 0);
+        band_cells.resize(bands);
+        band_sin.resize(bands);
+        band_cos.resize(bands);
+        band_area.resize(bands);
+        const double target = band_height * band_height;
+        for (int b = 0; b < bands; ++b) {
+            double lo = -M_PI / 2.0 + b * band_height;
+            double center = lo + 0.5 * band_height;
+            double area = 2.0 * M_PI * (std::sin(lo + band_height) - std::sin(lo));
+            band_cells[b] = std::max(1, static_cast<int>(std::lround(area / target)));
+            band_offset[b + 1] = band_offset[b] + band_cells[b];
+            band_sin[b] = std::sin(center);
+            band_cos[b] = std::cos(center);
+            band_area[b] = area / band_cells[b] / (4.0 * M_PI);
+        }
+        row_words = (cell_count() + 63) / 64;
+        mask_rad = config.min_elevation_deg * DEG_TO_RAD;
+        cos_mask = std::cos(mask_rad);
+        sin_mask = std::sin(mask_rad);
+    }
+
+    size_t cell_count() const { return static_cast<size_t>(band_offset[bands]); }
+    size_t step_count() const { return steps; }
+    const Config& get_config() const { return config; }
+
+    // Fraction of the sphere covered by cell `c`
+    double cell_area(uint32_t c) const { return band_area[band_of_cell(c)]; }
+
+    void cell_center(uint32_t c, double& lat_deg, double& lon_deg) const {
+        int b = band_of_cell(c);
+        int j = static_cast<int>(c) - band_offset[b];
+        lat_deg = (-M_PI / 2.0 + (b + 0.5) * band_height) * RAD_TO_DEG;
+        lon_deg = (-M_PI + (j + 0.5) * 2.0 * M_PI / band_cells[b]) * RAD_TO_DEG;
+    }
+
+    uint32_t cell_of(double lat_deg, double lon_deg) const {
+        int b = band_of(lat_deg * DEG_TO_RAD);
+        double lon = std::remainder(lon_deg * DEG_TO_RAD, 2.0 * M_PI);
+        int j = static_cast<int>((lon + M_PI) / (2.0 * M_PI) * band_cells[b]);
+        return static_cast<uint32_t>(band_offset[b] + std::min(j, band_cells[b] - 1));
+    }
+
+    // Coverage of every cell over [start, start + duration) minutes of
+    // catalog time (see CatalogPropagator::Config::epoch_jd), sampled every
+    // time_step_minutes; `epoch_jd` is the date of catalog time zero and
+    // fixes Earth rotation
+    void analyze(const CatalogPropagator& catalog, double epoch_jd, double start_minutes,
+                 double duration_minutes) {
+        const double dt = config.time_step_minutes;
+        steps = std::max<size_t>(1, static_cast<size_t>(std::ceil(duration_minutes / dt - 1e-9)));
+        step_words = (steps + 63) / 64;
+        rows.assign(step_words * 64 * row_words, 0);
+
+        const size_t n = catalog.size();
+        parallel_for(steps, [&](size_t begin, size_t end, unsigned) {
+            CatalogPropagator::States st;
+            st.resize(n);
+            std::vector<double> half(bands);
+            for (size_t k = begin; k < end; ++k) {
+                double t = start_minutes + k * dt;
+                catalog.propagate(t, st, 0, n);
+                double gmst = SGP4Propagator::gmst(epoch_jd + t / 1440.0);
+                double c = std::cos(gmst), s = std::sin(gmst);
+                uint64_t* row = rows.data() + k * row_words;
+                for (size_t i = 0; i < n; ++i) mark_footprint(st.x[i], st.y[i], st.z[i], c, s, row, half.data());
+            }
+        }, config.grain, config.num_threads);
+
+        transpose(rows, step_words, series);
+        compute_metrics();
+    }
+
+    const std::vector<CellMetrics>& get_cell_metrics() const { return metrics; }
+
+    // Bit k set when cell `c` is covered at time step k
+    const uint64_t* coverage_bits(uint32_t c) const { return series.data() + c * step_words; }
+
+    Statistics statistics() const {
+        Statistics stats = {0.0, 0.0, 0.0, 0.0};
+        for (uint32_t c = 0; c < cell_count(); ++c) {
+            const CellMetrics& m = metrics[c];
+            double w = cell_area(c);
+            stats.coverage_percent += 100.0 * w * m.coverage_fraction;
+            stats.ever_covered_percent += m.coverage_fraction > 0.0f ? 100.0 * w : 0.0;
+            stats.max_revisit_gap_minutes = std::max(stats.max_revisit_gap_minutes,
+                                                     static_cast<double>(m.max_gap_minutes));
+            stats.mean_response_minutes += w * m.mean_response_minutes;
+        }
+        return stats;
+    }
+
+    // Up to `count` station sites, picked greedily by how many sampled
+    // satellite-time pairs they add to those already in contact. Candidates
+    // are cells; empty means every cell.
+    Placement place_stations(const CatalogPropagator& catalog, double epoch_jd, double start_minutes,
+                             double duration_minutes, size_t count,
+                             const std::vector<uint32_t>& candidates = {}) const {
+        const size_t samples = std::max<size_t>(64, (config.placement_samples + 63) / 64 * 64);
+        const size_t sample_words = samples / 64;
+        const size_t n = catalog.size();
+        Placement placement;
+        if (n == 0) return placement;
+
+        // Samples evenly spread in time, satellites scattered by a
+        // multiplicative hash
+        std::vector<uint64_t> sample_rows(samples * row_words, 0);
+        parallel_for(samples, [&](size_t begin, size_t end, unsigned) {
+            std::vector<double> half(bands);
+            for (size_t k = begin; k < end; ++k) {
+                double t = start_minutes + duration_minutes * (k + 0.5) / samples;
+                size_t id = static_cast<size_t>((k * 2654435761ull) % n);
+                StateVector sv = catalog.propagate_one(id, t);
+                double gmst = SGP4Propagator::gmst(epoch_jd + t / 1440.0);
+                mark_footprint(sv.x, sv.y, sv.z, std::cos(gmst), std::sin(gmst),
+                               sample_rows.data() + k * row_words, half.data());
+            }
+        }, 64, config.num_threads);
+        std::vector<uint64_t> seen;
+        transpose(sample_rows, sample_words, seen);
+
+        std::vector<uint32_t> sites = candidates;
+        if (sites.empty()) {
+            sites.resize(cell_count());
+            for (uint32_t c = 0; c < sites.size(); ++c) sites[c] = c;
+        }
+
+        const size_t grain = 256;
+        std::vector<uint64_t> covered(sample_words, 0);
+        std::vector<size_t> chunk_best((sites.size() + grain - 1) / grain);
+        std::vector<size_t> chunk_gain(chunk_best.size());
+        for (size_t pick = 0; pick < count; ++pick) {
+            parallel_for(sites.size(), [&](size_t begin, size_t end, unsigned) {
+                size_t best = begin, best_gain = 0;
+                for (size_t i = begin; i < end; ++i) {
+                    const uint64_t* bits = seen.data() + sites[i] * sample_words;
+                    size_t gain = 0;
+                    for (size_t w = 0; w < sample_words; ++w) gain += popcount(bits[w] & ~covered[w]);
+                    if (gain > best_gain) {
+                        best = i;
+                        best_gain = gain;
+                    }
+                }
+                chunk_best[begin / grain] = best;
+                chunk_gain[begin / grain] = best_gain;
+            }, grain, config.num_threads);
+
+            size_t best = 0;
+            for (size_t ch = 1; ch < chunk_gain.size(); ++ch) {
+                if (chunk_gain[ch] > chunk_gain[best]) best = ch;
+            }
+            if (chunk_gain[best] == 0) break;
+
+            const uint32_t cell = sites[chunk_best[best]];
+            const uint64_t* bits = seen.data() + cell * sample_words;
+            size_t total = 0;
+            for (size_t w = 0; w < sample_words; ++w) {
+                covered[w] |= bits[w];
+                total += popcount(covered[w]);
+            }
+            placement.cells.push_back(cell);
+            placement.contact_percent.push_back(100.0 * total / samples);
+        }
+        return placement;
+    }
+
+private:
+    Config config;
+    int bands = 0;
+    double band_height = 0.0;
+    std::vector<int> band_offset;        // first cell of each band, plus the total
+    std::vector<int> band_cells;
+    std::vector<double> band_sin, band_cos;  // of the band's center latitude
+    std::vector<double> band_area;       // per cell, fraction of the sphere
+    size_t row_words = 0;                // 64-bit words per bitset over cells
+    double mask_rad = 0.0, cos_mask = 1.0, sin_mask = 0.0;
+
+    size_t steps = 0;
+    size_t step_words = 0;               // 64-bit words per bitset over time
+    std::vector<uint64_t> rows;          // step-major, bit = cell
+    std::vector<uint64_t> series;        // cell-major, bit = step
+    std::vector<CellMetrics> metrics;
+
+    static int popcount(uint64_t x) {
+        x = x - ((x >> 1) & 0x5555555555555555ull);
+        x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<int>((x * 0x0101010101010101ull) >> 56);
+    }
+
+    int band_of(double lat) const {
+        int b = static_cast<int>((lat + M_PI / 2.0) / band_height);
+        return std::min(bands - 1, std::max(0, b));
+    }
+
+    int band_of_cell(uint32_t c) const {
+        return static_cast<int>(std::upper_bound(band_offset.begin(), band_offset.end(),
+                                                 static_cast<int>(c)) - band_offset.begin()) - 1;
+    }
+
+    static void set_bits(uint64_t* row, size_t first, size_t last) {
+        if (first >= last) return;
+        size_t w0 = first / 64, w1 = (last - 1) / 64;
+        uint64_t m0 = ~0ull << (first % 64);
+        uint64_t m1 = ~0ull >> (63 - (last - 1) % 64);
+        if (w0 == w1) {
+            row[w0] |= m0 & m1;
+            return;
+        }
+        row[w0] |= m0;
+        for (size_t w = w0 + 1; w < w1; ++w) row[w] = ~0ull;
+        row[w1] |= m1;
+    }
+
+    // Set the bits of the cells whose centers see the satellite at TEME
+    // position (x, y, z) above the mask; (c, s) = cos and sin of GMST and
+    // `half` is scratch for one value per band
+    void mark_footprint(double x, double y, double z, double c, double s, uint64_t* row, double* half) const {
+        const double ex = c * x + s * y, ey = -s * x + c * y;
+        const double horizontal = std::sqrt(ex * ex + ey * ey);
+        const double r = std::sqrt(horizontal * horizontal + z * z);
+
+        // Earth central angle out to the mask: acos(Re cos(mask) / r) - mask
+        const double k = std::min(1.0, WGS84_A_KM * cos_mask / r);
+        const double reach = std::acos(k) - mask_rad;
+        if (reach <= 0.0) return;
+        const double cos_reach = k * cos_mask + std::sqrt(1.0 - k * k) * sin_mask;
+
+        const double lat = std::atan2(z, horizontal), lon = std::atan2(ey, ex) + M_PI;
+        const double sin_lat = z / r, cos_lat = horizontal / r;
+        const int b0 = band_of(lat - reach), count = band_of(lat + reach) - b0 + 1;
+
+        // Longitude half-width of the footprint at each band's center
+        // latitude, from cos(reach) = sin*sin + cos*cos*cos(half), in a loop
+        // that vectorizes. Negative when the band is missed; pi when it is
+        // covered all the way round.
+        const double* bs = band_sin.data() + b0;
+        const double* bc = band_cos.data() + b0;
+        for (int i = 0; i < count; ++i) {
+            double q = (cos_reach - bs[i] * sin_lat) / std::max(bc[i] * cos_lat, 1e-300);
+            double h = fast_atan2(std::sqrt(std::max(0.0, 1.0 - q * q)), std::max(-1.0, q));
+            half[i] = h - static_cast<double>(q > 1.0) * (h + 1.0);
+        }
+
+        for (int i = 0; i < count; ++i) {
+            if (half[i] < 0.0) continue;
+            const int b = b0 + i;
+            const long n = band_cells[b];
+            const size_t offset = static_cast<size_t>(band_offset[b]);
+            const double scale = n / (2.0 * M_PI);
+            long j0 = static_cast<long>(std::ceil((lon - half[i]) * scale - 0.5));
+            long j1 = static_cast<long>(std::floor((lon + half[i]) * scale - 0.5));
+            if (j1 < j0) continue;
+            if (j1 - j0 + 1 >= n) {
+                set_bits(row, offset, offset + n);
+                continue;
+            }
+            const size_t length = static_cast<size_t>(j1 - j0 + 1);
+            if (j0 < 0) j0 += n;
+            if (j0 >= n) j0 -= n;
+            const size_t first = static_cast<size_t>(j0);
+            if (first + length <= static_cast<size_t>(n)) {
+                set_bits(row, offset + first, offset + first + length);
+            } else {
+                set_bits(row, offset + first, offset + n);
+                set_bits(row, offset, offset + first + length - n);
+            }
+        }
+    }
+
+    // In place: bit j of a[i] moves to bit i of a[j]
+    static void transpose64(uint64_t a[64]) {
+        uint64_t m = 0x00000000FFFFFFFFull;
+        for (int j = 32; j != 0; j >>= 1, m ^= m << j) {
+            for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+                uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+                a[k | j] ^= t;
+                a[k] ^= t << j;
+            }
+        }
+    }
+
+    // Row-major bitsets (64 * words rows of row_words words, bit = cell)
+    // into one bitset of `words` words per cell
+    void transpose(const std::vector<uint64_t>& in, size_t words, std::vector<uint64_t>& out) const {
+        out.assign(row_words * 64 * words, 0);
+        parallel_for(row_words, [&](size_t begin, size_t end, unsigned) {
+            uint64_t block[64];
+            for (size_t cw = begin; cw < end; ++cw) {
+                for (size_t tw = 0; tw < words; ++tw) {
+                    for (size_t i = 0; i < 64; ++i) block[i] = in[(tw * 64 + i) * row_words + cw];
+                    transpose64(block);
+                    for (size_t j = 0; j < 64; ++j) out[(cw * 64 + j) * words + tw] = block[j];
+                }
+            }
+        }, 4, config.num_threads);
+    }
+
+    void compute_metrics() {
+        const double dt = config.time_step_minutes;
+        metrics.resize(cell_count());
+        parallel_for(cell_count(), [&](size_t begin, size_t end, unsigned) {
+            for (size_t c = begin; c < end; ++c) {
+                const uint64_t* bits = series.data() + c * step_words;
+                size_t covered = 0, run = 0, max_run = 0;
+                double wait = 0.0;                // in steps, summed over steps
+                auto close_run = [&]() {
+                    max_run = std::max(max_run, run);
+                    wait += 0.5 * static_cast<double>(run) * (run + 1);
+                    run = 0;
+                };
+                for (size_t w = 0; w < step_words; ++w) {
+                    const size_t valid = std::min<size_t>(64, steps - w * 64);
+                    const uint64_t word = bits[w];
+                    if (word == 0) {
+                        run += valid;
+                        continue;
+                    }
+                    covered += popcount(word);
+                    for (size_t k = 0; k < valid; ++k) {
+                        if (word >> k & 1) {
+                            if (run > 0) close_run();
+                        } else {
+                            ++run;
+                        }
+                    }
+                }
+                // A gap still open at the end counts as if covered next step
+                close_run();
+                metrics[c] = {static_cast<float>(static_cast<double>(covered) / steps),
+                              static_cast<float>(max_run * dt),
+                              static_cast<float>(wait * dt / steps)};
+            }
+        }, 256, config.num_threads);
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // COVERAGE_GRID_H
@@ -8,6 +8,7 @@
 #endif
 #include <vector>
 #include <complex>
+#include "scoped_trace.h"
 
 namespace SatelliteSignal {
 
@@ -63,6 +64,7 @@ public:
     // Batch process samples
     std::vector<std::complex<double>> compensate_buffer(
         const std::vector<std::complex<double>>& samples) {
+        TRACE_SCOPE("DopplerCompensator::compensate_buffer");
         std::vector<std::complex<double>> output(samples.size());
         for (size_t i = 0; i < samples.size(); ++i) {
             output[i] = compensate(samples[i]);
@@ -0,0 +1,192 @@
+#ifndef FEC_CODECS_H
+#define FEC_CODECS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "ber_simulator.h"
+#include "fec_encoders.h"
+#include "fec_decoders.h"
+
+namespace SatelliteSignal {
+
+// Encoder/decoder pairs from fec_encoders.h and fec_decoders.h wrapped as
+// BerSimulator codecs. Each factory call builds fresh coder objects, so every
+// worker thread owns its own tables and scratch buffers.
+class FecCodecs {
+public:
+    static BerSimulator::Codec convolutional(size_t frame_bits = 1024) {
+        ConvolutionalEncoder::Config cfg;
+        BerSimulator::Codec codec;
+        codec.name = "convolutional";
+        codec.info_bits = frame_bits;
+        codec.coded_bits = ConvolutionalEncoder(cfg).encoded_length(frame_bits);
+        codec.make_encoder = [cfg]() -> BerSimulator::EncodeFn {
+            auto encoder = std::make_shared<ConvolutionalEncoder>(cfg);
+            return [encoder](const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+                encoder->encode(in, out);
+            };
+        };
+        codec.make_decoder = []() -> BerSimulator::DecodeFn {
+            auto decoder = std::make_shared<ConvolutionalDecoder>();
+            return [decoder](const std::vector<double>& soft, std::vector<uint8_t>& out) -> uint64_t {
+                decoder->decode(soft, out);
+                return 0;
+            };
+        };
+        return codec;
+    }
+
+    // One RS(255,223) codeword per frame, hard decisions on the soft input
+    static BerSimulator::Codec reed_solomon() {
+        ReedSolomonEncoder::Config cfg;
+        BerSimulator::Codec codec;
+        codec.name = "reed_solomon";
+        codec.info_bits = static_cast<size_t>(cfg.info_length) * 8;
+        codec.coded_bits = static_cast<size_t>(cfg.code_length) * 8;
+        codec.make_encoder = [cfg]() -> BerSimulator::EncodeFn {
+            auto encoder = std::make_shared<ReedSolomonEncoder>(cfg);
+            auto bytes = std::make_shared<std::vector<uint8_t>>();
+            auto coded = std::make_shared<std::vector<uint8_t>>();
+            return [encoder, bytes, coded](const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+                pack_bits(in, *bytes);
+                encoder->encode(*bytes, *coded);
+                unpack_bytes(*coded, out);
+            };
+        };
+        codec.make_decoder = []() -> BerSimulator::DecodeFn {
+            auto decoder = std::make_shared<ReedSolomonDecoder>();
+            auto bytes = std::make_shared<std::vector<uint8_t>>();
+            auto bits = std::make_shared<std::vector<uint8_t>>();
+            return [decoder, bytes, bits](const std::vector<double>& soft, std::vector<uint8_t>& out) -> uint64_t {
+                slice(soft, *bits);
+                pack_bits(*bits, *bytes);
+                long before = decoder->get_corrected_symbols();
+                unpack_bytes(decoder->decode(*bytes), out);
+                return static_cast<uint64_t>(decoder->get_corrected_symbols() - before);
+            };
+        };
+        return codec;
+    }
+
+    static BerSimulator::Codec ldpc(int code_length = 64800, int info_length = 32400, int iterations = 50) {
+        BerSimulator::Codec codec;
+        codec.name = "ldpc";
+        codec.info_bits = static_cast<size_t>(info_length);
+        codec.coded_bits = static_cast<size_t>(code_length);
+        codec.make_encoder = [code_length, info_length]() -> BerSimulator::EncodeFn {
+            LDPCEncoder::Config cfg;
+            cfg.code_length = code_length;
+            cfg.info_length = info_length;
+            auto encoder = std::make_shared<LDPCEncoder>(cfg);
+            return [encoder](const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+                encoder->encode(in, out);
+            };
+        };
+        codec.make_decoder = [code_length, info_length, iterations]() -> BerSimulator::DecodeFn {
+            LDPCDecoder::Config cfg;
+            cfg.code_length = code_length;
+            cfg.info_length = info_length;
+            cfg.iterations = iterations;
+            auto decoder = std::make_shared<LDPCDecoder>(cfg);
+            return [decoder](const std::vector<double>& soft, std::vector<uint8_t>& out) -> uint64_t {
+                decoder->decode(soft, out);
+                return 0;
+            };
+        };
+        return codec;
+    }
+
+    static BerSimulator::Codec turbo(int frame_size = 6144, int iterations = 6) {
+        BerSimulator::Codec codec;
+        codec.name = "turbo";
+        codec.info_bits = static_cast<size_t>(frame_size);
+        codec.coded_bits = 3 * static_cast<size_t>(frame_size) + 4 * TurboTrellis::TAIL;
+        codec.make_encoder = [frame_size]() -> BerSimulator::EncodeFn {
+            TurboEncoder::Config cfg;
+            cfg.frame_size = frame_size;
+            auto encoder = std::make_shared<TurboEncoder>(cfg);
+            return [encoder](const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+                encoder->encode(in, out);
+            };
+        };
+        codec.make_decoder = [frame_size, iterations]() -> BerSimulator::DecodeFn {
+            TurboDecoder::Config cfg;
+            cfg.frame_size = frame_size;
+            cfg.iterations = iterations;
+            auto decoder = std::make_shared<TurboDecoder>(cfg);
+            return [decoder](const std::vector<double>& soft, std::vector<uint8_t>& out) -> uint64_t {
+                decoder->decode(soft, out);
+                return 0;
+            };
+        };
+        return codec;
+    }
+
+    // Hamming(7,4) blocks, hard decisions on the soft input
+    static BerSimulator::Codec hamming(size_t frame_bits = 1024) {
+        HammingEncoder::Config cfg;
+        size_t blocks = (frame_bits + cfg.data_bits - 1) / cfg.data_bits;
+        BerSimulator::Codec codec;
+        codec.name = "hamming";
+        codec.info_bits = blocks * cfg.data_bits;
+        codec.coded_bits = blocks * (cfg.data_bits + cfg.parity_bits);
+        codec.make_encoder = [cfg]() -> BerSimulator::EncodeFn {
+            auto encoder = std::make_shared<HammingEncoder>(cfg);
+            return [encoder](const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+                encoder->encode(in, out);
+            };
+        };
+        codec.make_decoder = []() -> BerSimulator::DecodeFn {
+            auto decoder = std::make_shared<HammingDecoder>();
+            auto bits = std::make_shared<std::vector<uint8_t>>();
+            return [decoder, bits](const std::vector<double>& soft, std::vector<uint8_t>& out) -> uint64_t {
+                slice(soft, *bits);
+                long before = decoder->get_corrected_bits();
+                out = decoder->decode(*bits);
+                return static_cast<uint64_t>(decoder->get_corrected_bits() - before);
+            };
+        };
+        return codec;
+    }
+
+    static bool make(const std::string& name, BerSimulator::Codec& codec) {
+        if (name == "uncoded") codec = BerSimulator::uncoded();
+        else if (name == "convolutional") codec = convolutional();
+        else if (name == "reed_solomon") codec = reed_solomon();
+        else if (name == "ldpc") codec = ldpc();
+        else if (name == "ldpc_short") codec = ldpc(16200, 8100);
+        else if (name == "turbo") codec = turbo();
+        else if (name == "hamming") codec = hamming();
+        else return false;
+        return true;
+    }
+
+    static std::vector<std::string> names() {
+        return {"uncoded", "convolutional", "reed_solomon", "ldpc", "ldpc_short", "turbo", "hamming"};
+    }
+
+    // MSB-first bit packing shared by the byte-oriented codes
+    static void pack_bits(const std::vector<uint8_t>& bits, std::vector<uint8_t>& bytes) {
+        bytes.assign((bits.size() + 7) / 8, 0);
+        for (size_t i = 0; i < bits.size(); ++i) {
+            bytes[i >> 3] |= static_cast<uint8_t>((bits[i] & 1) << (7 - (i & 7)));
+        }
+    }
+
+    static void unpack_bytes(const std::vector<uint8_t>& bytes, std::vector<uint8_t>& bits) {
+        bits.resize(bytes.size() * 8);
+        for (size_t i = 0; i < bits.size(); ++i) {
+            bits[i] = (bytes[i >> 3] >> (7 - (i & 7))) & 1;
+        }
+    }
+
+    static void slice(const std::vector<double>& soft, std::vector<uint8_t>& bits) {
+        bits.resize(soft.size());
+        for (size_t i = 0; i < soft.size(); ++i) bits[i] = soft[i] > 0.0 ? 1 : 0;
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // FEC_CODECS_H
@@ -0,0 +1,242 @@
+#ifndef FEC_COMMON_H
+#define FEC_COMMON_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+#include <numeric>
+#include <random>
+#include <algorithm>
+
+// Code structures shared by fec_encoders.h and fec_decoders.h so that every
+// encoder/decoder pair is built from the same tables.
+
+// GF(2^8) arithmetic with primitive polynomial x^8 + x^4 + x^3 + x^2 + 1
+class GF256 {
+public:
+    static const GF256& instance() {
+        static GF256 gf;
+        return gf;
+    }
+
+    uint8_t mul(uint8_t a, uint8_t b) const {
+        if (a == 0 || b == 0) return 0;
+        return exp_table[log_table[a] + log_table[b]];
+    }
+
+    uint8_t div(uint8_t a, uint8_t b) const {
+        if (a == 0) return 0;
+        return exp_table[log_table[a] + 255 - log_table[b]];
+    }
+
+    uint8_t pow_alpha(int power) const {
+        power %= 255;
+        if (power < 0) power += 255;
+        return exp_table[power];
+    }
+
+    uint8_t exp(int i) const { return exp_table[i]; }
+    int log(uint8_t a) const { return log_table[a]; }
+
+private:
+    std::array<uint8_t, 512> exp_table;
+    std::array<int, 256> log_table;
+
+    GF256() {
+        int x = 1;
+        for (int i = 0; i < 255; ++i) {
+            exp_table[i] = static_cast<uint8_t>(x);
+            log_table[x] = i;
+            x <<= 1;
+            if (x & 0x100) x ^= 0x11D;
+        }
+        for (int i = 255; i < 512; ++i) exp_table[i] = exp_table[i - 255];
+        log_table[0] = 0;
+    }
+};
+
+// Reed-Solomon generator polynomial g(x) = prod_{i=0}^{2t-1} (x - alpha^i),
+// coefficients stored lowest degree first with g[2t] = 1
+inline std::vector<uint8_t> reed_solomon_generator(int parity_symbols) {
+    const GF256& gf = GF256::instance();
+    std::vector<uint8_t> g(1, 1);
+    for (int i = 0; i < parity_symbols; ++i) {
+        std::vector<uint8_t> next(g.size() + 1, 0);
+        uint8_t root = gf.pow_alpha(i);
+        for (size_t j = 0; j < g.size(); ++j) {
+            next[j + 1] ^= g[j];
+            next[j] ^= gf.mul(g[j], root);
+        }
+        g.swap(next);
+    }
+    return g;
+}
+
+// Quadratic permutation polynomial interleaver pi(i) = (f1*i + f2*i^2) mod K
+// as used by the LTE turbo code
+class QPPInterleaver {
+public:
+    QPPInterleaver(size_t frame_size) : K(frame_size) {
+        select_parameters();
+        table.resize(K);
+        for (size_t i = 0; i < K; ++i) {
+            uint64_t idx = (static_cast<uint64_t>(f1) * i +
+                            static_cast<uint64_t>(f2) * ((i * i) % K)) % K;
+            table[i] = static_cast<uint32_t>(idx);
+        }
+    }
+
+    uint32_t operator[](size_t i) const { return table[i]; }
+    size_t size() const { return K; }
+    uint32_t get_f1() const { return f1; }
+    uint32_t get_f2() const { return f2; }
+
+private:
+    size_t K;
+    uint32_t f1 = 1;
+    uint32_t f2 = 0;
+    std::vector<uint32_t> table;
+
+    void select_parameters() {
+        // LTE (36.212 table 5.1.3-3) entries for common sizes
+        if (K == 40)   { f1 = 3;   f2 = 10;  return; }
+        if (K == 1024) { f1 = 31;  f2 = 64;  return; }
+        if (K == 6144) { f1 = 263; f2 = 480; return; }
+
+        // Otherwise: f2 a multiple of every prime factor of K and f1 coprime
+        // to K, which makes the polynomial a permutation
+        uint64_t radical = 1;
+        size_t n = K;
+        for (size_t p = 2; p * p <= n; ++p) {
+            if (n % p == 0) {
+                radical *= p;
+                while (n % p == 0) n /= p;
+            }
+        }
+        if (n > 1) radical *= n;
+
+        f2 = static_cast<uint32_t>(radical * 2 < K ? radical * 2 : radical) % static_cast<uint32_t>(K);
+        f1 = static_cast<uint32_t>(K / 8) | 1u;
+        while (std::gcd<size_t, size_t>(f1, K) != 1) f1 += 2;
+        if (K <= 2) { f1 = 1; f2 = 0; }
+    }
+};
+
+// DVB-S2 style irregular repeat-accumulate LDPC structure. Information bits
+// are split into groups of up to 360 lanes; lane j of a group with base
+// parity address x touches check (x + j*q) mod M, q = M / lanes. Parity bits
+// form the dual-diagonal accumulator p[i] ^= p[i-1].
+//
+// The degree profile follows DVB-S2 (a block of high-degree groups, the rest
+// degree 3), while base addresses are drawn from a seeded generator instead of
+// the standard's annex tables.
+class LDPCParityStructure {
+public:
+    LDPCParityStructure(size_t code_length, size_t info_length, uint32_t seed = 0x5A7E111u)
+        : n(code_length), k(info_length), m(code_length - info_length) {
+        lanes = std::gcd(std::gcd(k, m), size_t(360));
+        if (lanes == 0) lanes = 1;
+        q = m / lanes;
+
+        size_t num_groups = k / lanes;
+        double rate = static_cast<double>(k) / n;
+        size_t high_degree = rate <= 0.5 ? 8 : 12;
+        size_t high_groups = static_cast<size_t>(num_groups * (rate <= 0.5 ? 0.4 : 0.15));
+        if (high_groups == 0 && num_groups > 0) high_groups = 1;
+
+        std::mt19937 gen(seed);
+        group_addresses.resize(num_groups);
+        for (size_t g = 0; g < num_groups; ++g) {
+            size_t degree = g < high_groups ? high_degree : 3;
+            degree = std::min(degree, q);
+
+            // Distinct residues mod q keep the 360 lanes of a group on
+            // distinct checks, so no check sees the same bit twice
+            std::vector<uint8_t> used(q, 0);
+            std::uniform_int_distribution<size_t> dist(0, m - 1);
+            while (group_addresses[g].size() < degree) {
+                size_t x = dist(gen);
+                if (used[x % q]) continue;
+                used[x % q] = 1;
+                group_addresses[g].push_back(static_cast<uint32_t>(x));
+            }
+        }
+    }
+
+    size_t code_length() const { return n; }
+    size_t info_length() const { return k; }
+    size_t parity_length() const { return m; }
+    size_t lane_count() const { return lanes; }
+    size_t lane_step() const { return q; }
+    const std::vector<std::vector<uint32_t>>& addresses() const { return group_addresses; }
+
+    // Call visit(info_bit, check) for every information-bit edge
+    template <typename Visit>
+    void for_each_info_edge(Visit&& visit) const {
+        for (size_t g = 0; g < group_addresses.size(); ++g) {
+            for (uint32_t x : group_addresses[g]) {
+                size_t check = x;
+                for (size_t j = 0; j < lanes; ++j) {
+                    visit(g * lanes + j, check);
+                    check += q;
+                    if (check >= m) check -= m;
+                }
+            }
+        }
+    }
+
+private:
+    size_t n;
+    size_t k;
+    size_t m;
+    size_t lanes;
+    size_t q;
+    std::vector<std::vector<uint32_t>> group_addresses;
+};
+
+// LTE turbo constituent encoder: recursive systematic convolutional code with
+// feedback 1 + D^2 + D^3 (13 octal) and feedforward 1 + D + D^3 (15 octal)
+struct TurboTrellis {
+    static constexpr int STATES = 8;
+    static constexpr int TAIL = 3;
+
+    // state bits: bit2 = most recent register
+    static int next_state(int state, int input) {
+        int d1 = (state >> 2) & 1, d2 = (state >> 1) & 1, d3 = state & 1;
+        int a = input ^ d2 ^ d3;
+        return (a << 2) | (d1 << 1) | d2;
+    }
+
+    static int parity(int state, int input) {
+        int d1 = (state >> 2) & 1, d2 = (state >> 1) & 1, d3 = state & 1;
+        int a = input ^ d2 ^ d3;
+        return a ^ d1 ^ d3;
+    }
+
+    // Input that drives the register towards zero during termination
+    static int tail_input(int state) {
+        return ((state >> 1) & 1) ^ (state & 1);
+    }
+};
+
+// Hamming syndrome column of each data bit; parity bit j has column 1 << j
+inline std::vector<uint32_t> hamming_data_syndromes(int parity_bits, int data_bits) {
+    std::vector<uint32_t> columns;
+    for (uint32_t s = 1; s < (1u << parity_bits) && static_cast<int>(columns.size()) < data_bits; ++s) {
+        if ((s & (s - 1)) != 0) columns.push_back(s);
+    }
+    return columns;
+}
+
+// Parity of an integer's set bits
+inline int bit_parity(uint32_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return static_cast<int>(x & 1);
+}
+
+#endif // FEC_COMMON_H
@@ -3,121 +3,443 @@
 
 #include <vector>
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
+#include "fec_common.h"
+#include "scoped_trace.h"
 
+// Soft inputs use the convention positive = bit 1. Each decoder inverts the
+// matching encoder in fec_encoders.h.
+
+// Soft-decision Viterbi decoder for rate 1/n convolutional codes
 class ViterbiDecoder {
 public:
     struct Config {
         int constraint_length = 7;
         int code_rate_num = 1;
         int code_rate_den = 2;
+        std::vector<int> generator_polys = {0171, 0133};
+        bool terminated = true;   // encoder flushed back to state 0
     };
 
-    ViterbiDecoder(const Config& cfg = Config()) : config(cfg) {
+    ViterbiDecoder() : ViterbiDecoder(Config()) {}
+    explicit ViterbiDecoder(const Config& cfg) : config(cfg) {
         init_trellis();
     }
 
     std::vector<uint8_t> decode(const std::vector<double>& encoded_bits) {
         std::vector<uint8_t> decoded;
-        
-        if (encoded_bits.empty()) return decoded;
-        
-        size_t num_output_bits = encoded_bits.size() / config.code_rate_den * config.code_rate_num;
-        decoded.resize(num_output_bits);
-        
-        for (size_t i = 0; i < num_output_bits && i < encoded_bits.size(); ++i) {
-            decoded[i] = encoded_bits[i] > 0.0 ? 1 : 0;
-        }
-        
+        decode(encoded_bits, decoded);
         return decoded;
     }
 
-    double get_error_rate() const {
-        return 0.01;
+    void decode(const std::vector<double>& encoded_bits, std::vector<uint8_t>& decoded) {
+        TRACE_SCOPE("ViterbiDecoder::decode");
+        decoded.clear();
+        size_t n = config.generator_polys.size();
+        size_t steps = encoded_bits.size() / n;
+        if (steps == 0) return;
+
+        int K = config.constraint_length;
+        size_t words = (num_states + 63) / 64;
+        decisions.assign(steps * words, 0);
+        metrics.assign(num_states, NEG_INF);
+        next_metrics.assign(num_states, NEG_INF);
+        metrics[0] = 0.0f;
+
+        size_t patterns = size_t(1) << n;
+        branch_metric.resize(patterns);
+
+        for (size_t t = 0; t < steps; ++t) {
+            const double* soft = &encoded_bits[t * n];
+            for (size_t p = 0; p < patterns; ++p) {
+                float m = 0.0f;
+                for (size_t j = 0; j < n; ++j) {
+                    float s = static_cast<float>(soft[j]);
+                    m += ((p >> (n - 1 - j)) & 1) ? s : -s;
+                }
+                branch_metric[p] = m;
+            }
+
+            uint64_t* dec = &decisions[t * words];
+            float best = NEG_INF;
+            for (uint32_t ns = 0; ns < num_states; ++ns) {
+                uint32_t u = ns >> (K - 2);
+                uint32_t s0 = (ns << 1) & state_mask;
+                uint32_t s1 = s0 | 1;
+                float m0 = metrics[s0] + branch_metric[branch_output[(s0 << 1) | u]];
+                float m1 = metrics[s1] + branch_metric[branch_output[(s1 << 1) | u]];
+                if (m1 > m0) {
+                    next_metrics[ns] = m1;
+                    dec[ns >> 6] |= uint64_t(1) << (ns & 63);
+                } else {
+                    next_metrics[ns] = m0;
+                }
+                best = std::max(best, next_metrics[ns]);
+            }
+
+            for (auto& m : next_metrics) m -= best;
+            metrics.swap(next_metrics);
+        }
+
+        uint32_t state = 0;
+        if (!config.terminated) {
+            state = static_cast<uint32_t>(std::max_element(metrics.begin(), metrics.end()) - metrics.begin());
+        }
+
+        std::vector<uint8_t> path(steps);
+        for (size_t t = steps; t-- > 0;) {
+            path[t] = static_cast<uint8_t>(state >> (K - 2));
+            uint32_t b = (decisions[t * words + (state >> 6)] >> (state & 63)) & 1;
+            state = ((state << 1) & state_mask) | b;
+        }
+
+        size_t tail = config.terminated ? static_cast<size_t>(K - 1) : 0;
+        size_t out_bits = steps > tail ? steps - tail : 0;
+        decoded.assign(path.begin(), path.begin() + out_bits);
     }
 
 private:
+    static constexpr float NEG_INF = -1e30f;
+
     Config config;
-    
+    uint32_t num_states = 0;
+    uint32_t state_mask = 0;
+    std::vector<uint8_t> branch_output;   // [state << 1 | input] -> output pattern
+    std::vector<float> metrics;
+    std::vector<float> next_metrics;
+    std::vector<float> branch_metric;
+    std::vector<uint64_t> decisions;
+
     void init_trellis() {
+        int K = config.constraint_length;
+        size_t n = config.generator_polys.size();
+        num_states = 1u << (K - 1);
+        state_mask = num_states - 1;
+
+        branch_output.resize(num_states * 2);
+        for (uint32_t s = 0; s < num_states; ++s) {
+            for (uint32_t u = 0; u < 2; ++u) {
+                uint32_t reg = (u << (K - 1)) | s;
+                uint8_t out = 0;
+                for (size_t j = 0; j < n; ++j) {
+                    out = static_cast<uint8_t>((out << 1) | bit_parity(reg & config.generator_polys[j]));
+                }
+                branch_output[(s << 1) | u] = out;
+            }
+        }
     }
 };
 
+// Max-log-MAP turbo decoder for the LTE-style code produced by TurboEncoder
 class TurboDecoder {
 public:
     struct Config {
         int frame_size = 6144;
         int iterations = 6;
-        double scale_factor = 1.0;
+        double scale_factor = 0.75;   // extrinsic scaling, recovers most of the max-log loss
     };
 
-    TurboDecoder(const Config& cfg = Config()) : config(cfg) {}
+    TurboDecoder() : TurboDecoder(Config()) {}
+    explicit TurboDecoder(const Config& cfg) : config(cfg), interleaver(cfg.frame_size) {
+        for (int s = 0; s < TurboTrellis::STATES; ++s) {
+            for (int u = 0; u < 2; ++u) {
+                next_state[s][u] = TurboTrellis::next_state(s, u);
+                parity_bit[s][u] = TurboTrellis::parity(s, u);
+            }
+        }
+    }
 
     std::vector<uint8_t> decode(const std::vector<double>& encoded_bits) {
         std::vector<uint8_t> decoded;
-        
-        if (encoded_bits.empty()) return decoded;
-        
-        size_t output_size = std::min(static_cast<size_t>(config.frame_size), encoded_bits.size() / 3);
-        decoded.resize(output_size);
-        
-        for (size_t i = 0; i < output_size; ++i) {
-            double soft_value = 0.0;
-            if (3 * i < encoded_bits.size()) soft_value += encoded_bits[3 * i];
-            if (3 * i + 1 < encoded_bits.size()) soft_value += encoded_bits[3 * i + 1];
-            if (3 * i + 2 < encoded_bits.size()) soft_value += encoded_bits[3 * i + 2];
-            
-            decoded[i] = soft_value > 0.0 ? 1 : 0;
-        }
-        
+        decode(encoded_bits, decoded);
         return decoded;
     }
 
-    double get_error_rate() const {
-        return 0.001;
+    void decode(const std::vector<double>& encoded_bits, std::vector<uint8_t>& decoded) {
+        TRACE_SCOPE("TurboDecoder::decode");
+        size_t K = config.frame_size;
+        size_t frame_len = 3 * K + 4 * TurboTrellis::TAIL;
+        size_t frames = encoded_bits.size() / frame_len;
+        decoded.resize(frames * K);
+
+        for (size_t f = 0; f < frames; ++f) {
+            decode_frame(&encoded_bits[f * frame_len], &decoded[f * K]);
+        }
     }
 
+    int get_last_iterations() const { return last_iterations; }
+
 private:
+    static constexpr float NEG_INF = -1e30f;
+
     Config config;
+    QPPInterleaver interleaver;
+    int next_state[TurboTrellis::STATES][2];
+    int parity_bit[TurboTrellis::STATES][2];
+    int last_iterations = 0;
+
+    std::vector<float> sys1, par1, apriori1, llr1;
+    std::vector<float> sys2, par2, apriori2, llr2;
+    std::vector<float> alpha, beta;
+
+    void decode_frame(const double* in, uint8_t* out) {
+        size_t K = config.frame_size;
+        size_t len = K + TurboTrellis::TAIL;
+        float scale = static_cast<float>(config.scale_factor);
+
+        sys1.assign(len, 0.0f); par1.assign(len, 0.0f); apriori1.assign(len, 0.0f);
+        sys2.assign(len, 0.0f); par2.assign(len, 0.0f); apriori2.assign(len, 0.0f);
+        llr1.resize(K); llr2.resize(K);
+
+        for (size_t k = 0; k < K; ++k) {
+            sys1[k] = static_cast<float>(in[3 * k]);
+            par1[k] = static_cast<float>(in[3 * k + 1]);
+            par2[k] = static_cast<float>(in[3 * k + 2]);
+        }
+        for (size_t k = 0; k < K; ++k) sys2[k] = sys1[interleaver[k]];
+
+        const double* tail = in + 3 * K;
+        for (int t = 0; t < TurboTrellis::TAIL; ++t) {
+            sys1[K + t] = static_cast<float>(tail[2 * t]);
+            par1[K + t] = static_cast<float>(tail[2 * t + 1]);
+            sys2[K + t] = static_cast<float>(tail[2 * TurboTrellis::TAIL + 2 * t]);
+            par2[K + t] = static_cast<float>(tail[2 * TurboTrellis::TAIL + 2 * t + 1]);
+        }
+
+        last_iterations = 0;
+        for (int it = 0; it < config.iterations; ++it) {
+            ++last_iterations;
+
+            bcjr(sys1, par1, apriori1, llr1);
+            for (size_t k = 0; k < K; ++k) {
+                size_t pk = interleaver[k];
+                apriori2[k] = scale * (llr1[pk] - sys1[pk] - apriori1[pk]);
+            }
+
+            bcjr(sys2, par2, apriori2, llr2);
+            bool agree = true;
+            for (size_t k = 0; k < K; ++k) {
+                size_t pk = interleaver[k];
+                apriori1[pk] = scale * (llr2[k] - sys2[k] - apriori2[k]);
+                agree = agree && ((llr2[k] > 0.0f) == (llr1[pk] > 0.0f));
+            }
+
+            if (agree) break;
+        }
+
+        for (size_t k = 0; k < K; ++k) {
+            out[interleaver[k]] = llr2[k] > 0.0f ? 1 : 0;
+        }
+    }
+
+    // Max-log BCJR over one terminated constituent trellis; writes the
+    // a posteriori LLR of the K information bits
+    void bcjr(const std::vector<float>& sys, const std::vector<float>& par,
+              const std::vector<float>& apriori, std::vector<float>& llr) {
+        const int S = TurboTrellis::STATES;
+        size_t K = config.frame_size;
+        size_t len = sys.size();
+
+        alpha.assign((len + 1) * S, NEG_INF);
+        beta.assign((len + 1) * S, NEG_INF);
+        alpha[0] = 0.0f;
+        beta[len * S] = 0.0f;
+
+        auto gamma = [&](size_t k, int s, int u) {
+            float su = u ? 0.5f : -0.5f;
+            float sp = parity_bit[s][u] ? 0.5f : -0.5f;
+            return su * (sys[k] + apriori[k]) + sp * par[k];
+        };
+        auto allowed = [&](size_t k, int s, int u) {
+            return k < K || u == TurboTrellis::tail_input(s);
+        };
+
+        for (size_t k = 0; k < len; ++k) {
+            const float* a = &alpha[k * S];
+            float* an = &alpha[(k + 1) * S];
+            for (int s = 0; s < S; ++s) {
+                if (a[s] <= NEG_INF) continue;
+                for (int u = 0; u < 2; ++u) {
+                    if (!allowed(k, s, u)) continue;
+                    int ns = next_state[s][u];
+                    an[ns] = std::max(an[ns], a[s] + gamma(k, s, u));
+                }
+            }
+            float norm = *std::max_element(an, an + S);
+            for (int s = 0; s < S; ++s) an[s] -= norm;
+        }
+
+        for (size_t k = len; k-- > 0;) {
+            const float* bn = &beta[(k + 1) * S];
+            float* b = &beta[k * S];
+            for (int s = 0; s < S; ++s) {
+                for (int u = 0; u < 2; ++u) {
+                    if (!allowed(k, s, u)) continue;
+                    int ns = next_state[s][u];
+                    if (bn[ns] <= NEG_INF) continue;
+                    b[s] = std::max(b[s], bn[ns] + gamma(k, s, u));
+                }
+            }
+            float norm = *std::max_element(b, b + S);
+            for (int s = 0; s < S; ++s) b[s] -= norm;
+        }
+
+        for (size_t k = 0; k < K; ++k) {
+            float best[2] = {NEG_INF, NEG_INF};
+            const float* a = &alpha[k * S];
+            const float* bn = &beta[(k + 1) * S];
+            for (int s = 0; s < S; ++s) {
+                for (int u = 0; u < 2; ++u) {
+                    float m = a[s] + gamma(k, s, u) + bn[next_state[s][u]];
+                    best[u] = std::max(best[u], m);
+                }
+            }
+            llr[k] = best[1] - best[0];
+        }
+    }
 };
 
+// Layered normalized min-sum decoder for the DVB-S2 style code produced by
+// LDPCEncoder. Stops early once every parity check is satisfied.
 class LDPCDecoder {
 public:
     struct Config {
         int code_length = 64800;
         int info_length = 32400;
         int iterations = 50;
+        float min_sum_scale = 0.75f;
     };
 
-    LDPCDecoder(const Config& cfg = Config()) : config(cfg) {}
+    LDPCDecoder() : LDPCDecoder(Config()) {}
+    explicit LDPCDecoder(const Config& cfg)
+        : config(cfg), structure(cfg.code_length, cfg.info_length) {
+        build_graph();
+    }
 
     std::vector<uint8_t> decode(const std::vector<double>& encoded_bits) {
         std::vector<uint8_t> decoded;
-        
-        if (encoded_bits.empty()) return decoded;
-        
-        size_t output_size = std::min(static_cast<size_t>(config.info_length), encoded_bits.size() / 2);
-        decoded.resize(output_size);
-        
-        for (size_t i = 0; i < output_size; ++i) {
-            double soft_value = 0.0;
-            if (2 * i < encoded_bits.size()) soft_value += encoded_bits[2 * i];
-            if (2 * i + 1 < encoded_bits.size()) soft_value += encoded_bits[2 * i + 1];
-            
-            decoded[i] = soft_value > 0.0 ? 1 : 0;
-        }
-        
+        decode(encoded_bits, decoded);
         return decoded;
     }
 
-    double get_error_rate() const {
-        return 0.0001;
+    void decode(const std::vector<double>& encoded_bits, std::vector<uint8_t>& decoded) {
+        TRACE_SCOPE("LDPCDecoder::decode");
+        size_t n = structure.code_length();
+        size_t k = structure.info_length();
+        size_t frames = encoded_bits.size() / n;
+        decoded.resize(frames * k);
+
+        for (size_t f = 0; f < frames; ++f) {
+            decode_frame(&encoded_bits[f * n], &decoded[f * k]);
+        }
     }
 
+    int get_last_iterations() const { return last_iterations; }
+
 private:
     Config config;
+    LDPCParityStructure structure;
+    std::vector<uint32_t> check_start;   // CSR over checks
+    std::vector<uint32_t> edge_var;
+    std::vector<float> posterior;
+    std::vector<float> check_msg;
+    std::vector<float> var_msg;
+    int last_iterations = 0;
+
+    void build_graph() {
+        size_t k = structure.info_length();
+        size_t m = structure.parity_length();
+
+        std::vector<uint32_t> degree(m, 0);
+        structure.for_each_info_edge([&](size_t, size_t check) { ++degree[check]; });
+        for (size_t c = 0; c < m; ++c) degree[c] += (c == 0) ? 1 : 2;
+
+        check_start.assign(m + 1, 0);
+        for (size_t c = 0; c < m; ++c) check_start[c + 1] = check_start[c] + degree[c];
+        edge_var.resize(check_start[m]);
+
+        std::vector<uint32_t> fill(check_start.begin(), check_start.end() - 1);
+        structure.for_each_info_edge([&](size_t bit, size_t check) {
+            edge_var[fill[check]++] = static_cast<uint32_t>(bit);
+        });
+        for (size_t c = 0; c < m; ++c) {
+            if (c > 0) edge_var[fill[c]++] = static_cast<uint32_t>(k + c - 1);
+            edge_var[fill[c]++] = static_cast<uint32_t>(k + c);
+        }
+
+        uint32_t max_degree = *std::max_element(degree.begin(), degree.end());
+        var_msg.resize(max_degree);
+        check_msg.resize(edge_var.size());
+    }
+
+    void decode_frame(const double* soft, uint8_t* out) {
+        size_t n = structure.code_length();
+        size_t k = structure.info_length();
+        size_t m = structure.parity_length();
+        float scale = config.min_sum_scale;
+
+        // Internally LLR = log(P0/P1), so flip the positive-is-one input
+        posterior.resize(n);
+        for (size_t v = 0; v < n; ++v) posterior[v] = -static_cast<float>(soft[v]);
+        std::fill(check_msg.begin(), check_msg.end(), 0.0f);
+
+        last_iterations = 0;
+        for (int it = 0; it < config.iterations; ++it) {
+            ++last_iterations;
+
+            for (size_t c = 0; c < m; ++c) {
+                uint32_t begin = check_start[c];
+                uint32_t end = check_start[c + 1];
+
+                float min1 = 1e30f, min2 = 1e30f;
+                uint32_t min_idx = 0;
+                uint32_t sign = 0;
+                float* q = var_msg.data();
+                uint32_t degree = end - begin;
+                for (uint32_t i = 0; i < degree; ++i) {
+                    uint32_t e = begin + i;
+                    float value = posterior[edge_var[e]] - check_msg[e];
+                    q[i] = value;
+                    float mag = std::fabs(value);
+                    sign ^= (value < 0.0f);
+                    min_idx = mag < min1 ? i : min_idx;
+                    min2 = std::min(min2, std::max(min1, mag));
+                    min1 = std::min(min1, mag);
+                }
+
+                float m1 = scale * min1;
+                float m2 = scale * min2;
+                for (uint32_t i = 0; i < degree; ++i) {
+                    uint32_t e = begin + i;
+                    float mag = i == min_idx ? m2 : m1;
+                    bool negative = sign ^ (q[i] < 0.0f);
+                    float r = negative ? -mag : mag;
+                    check_msg[e] = r;
+                    posterior[edge_var[e]] = q[i] + r;
+                }
+            }
+
+            if (syndrome_ok()) break;
+        }
+
+        for (size_t v = 0; v < k; ++v) out[v] = posterior[v] < 0.0f ? 1 : 0;
+    }
+
+    bool syndrome_ok() const {
+        size_t m = structure.parity_length();
+        for (size_t c = 0; c < m; ++c) {
+            uint32_t parity = 0;
+            for (uint32_t e = check_start[c]; e < check_start[c + 1]; ++e) {
+                parity ^= posterior[edge_var[e]] < 0.0f;
+            }
+            if (parity) return false;
+        }
+        return true;
+    }
 };
 
+// Reed-Solomon decoder: syndromes, Berlekamp-Massey, Chien search and Forney
 class ReedSolomonDecoder {
 public:
     struct Config {
@@ -126,59 +448,162 @@ public:
         int info_length = 223;
     };
 
-    ReedSolomonDecoder(const Config& cfg = Config()) : config(cfg) {}
+    ReedSolomonDecoder() : ReedSolomonDecoder(Config()) {}
+    explicit ReedSolomonDecoder(const Config& cfg) : config(cfg) {}
 
     std::vector<uint8_t> decode(const std::vector<uint8_t>& encoded_bytes) {
+        TRACE_SCOPE("ReedSolomonDecoder::decode");
         std::vector<uint8_t> decoded;
-        
+
         if (encoded_bytes.empty()) return decoded;
-        
-        size_t output_size = std::min(static_cast<size_t>(config.info_length), encoded_bytes.size());
-        decoded.insert(decoded.end(), encoded_bytes.begin(), encoded_bytes.begin() + output_size);
-        
+
+        size_t n = config.code_length;
+        size_t k = config.info_length;
+        if (encoded_bytes.size() < n) {
+            size_t output_size = std::min(k, encoded_bytes.size());
+            decoded.insert(decoded.end(), encoded_bytes.begin(), encoded_bytes.begin() + output_size);
+            return decoded;
+        }
+
+        std::vector<uint8_t> block(n);
+        for (size_t offset = 0; offset + n <= encoded_bytes.size(); offset += n) {
+            std::copy(encoded_bytes.begin() + offset, encoded_bytes.begin() + offset + n, block.begin());
+            int corrected = correct_block(block.data());
+            if (corrected < 0) {
+                ++failed_blocks;
+            } else {
+                corrected_symbols += corrected;
+            }
+            decoded.insert(decoded.end(), block.begin(), block.begin() + k);
+        }
+
         return decoded;
     }
 
-    double get_error_rate() const {
-        return 0.00001;
+    // Corrects one n-byte codeword in place. Returns the number of symbols
+    // fixed, or -1 when the errors exceed the correction capability.
+    int correct_block(uint8_t* block) const {
+        const GF256& gf = GF256::instance();
+        int n = config.code_length;
+        int nroots = config.code_length - config.info_length;
+
+        std::vector<uint8_t> syndromes(nroots, 0);
+        bool clean = true;
+        for (int i = 0; i < nroots; ++i) {
+            uint8_t root = gf.pow_alpha(i);
+            uint8_t s = 0;
+            for (int j = 0; j < n; ++j) s = gf.mul(s, root) ^ block[j];
+            syndromes[i] = s;
+            clean = clean && s == 0;
+        }
+        if (clean) return 0;
+
+        // Berlekamp-Massey
+        std::vector<uint8_t> lambda(nroots + 1, 0), prev(nroots + 1, 0), temp;
+        lambda[0] = 1;
+        prev[0] = 1;
+        int L = 0, shift = 1;
+        uint8_t prev_discrepancy = 1;
+        for (int r = 0; r < nroots; ++r) {
+            uint8_t d = syndromes[r];
+            for (int i = 1; i <= L; ++i) d ^= gf.mul(lambda[i], syndromes[r - i]);
+
+            if (d == 0) {
+                ++shift;
+                continue;
+            }
+
+            uint8_t coef = gf.div(d, prev_discrepancy);
+            temp = lambda;
+            for (int i = 0; i + shift <= nroots; ++i) lambda[i + shift] ^= gf.mul(coef, prev[i]);
+
+            if (2 * L <= r) {
+                L = r + 1 - L;
+                prev = temp;
+                prev_discrepancy = d;
+                shift = 1;
+            } else {
+                ++shift;
+            }
+        }
+        if (2 * L > nroots) return -1;
+
+        // Chien search: an error at degree e has locator root alpha^-e
+        std::vector<int> error_degrees;
+        for (int e = 0; e < n; ++e) {
+            uint8_t x_inv = gf.pow_alpha(-e);
+            uint8_t value = 0;
+            for (int i = L; i >= 0; --i) value = gf.mul(value, x_inv) ^ lambda[i];
+            if (value == 0) error_degrees.push_back(e);
+        }
+        if (static_cast<int>(error_degrees.size()) != L) return -1;
+
+        // Forney: Y = X * Omega(X^-1) / Lambda'(X^-1) for first root alpha^0
+        std::vector<uint8_t> omega(nroots, 0);
+        for (int i = 0; i < nroots; ++i) {
+            for (int j = 0; j <= std::min(i, L); ++j) omega[i] ^= gf.mul(lambda[j], syndromes[i - j]);
+        }
+
+        for (int e : error_degrees) {
+            uint8_t x_inv = gf.pow_alpha(-e);
+            uint8_t num = 0;
+            for (int i = nroots - 1; i >= 0; --i) num = gf.mul(num, x_inv) ^ omega[i];
+            uint8_t den = 0;
+            for (int i = L; i >= 1; --i) {
+                if (i & 1) den ^= gf.mul(lambda[i], gf.pow_alpha(-e * (i - 1)));
+            }
+            if (den == 0) return -1;
+            uint8_t magnitude = gf.mul(gf.pow_alpha(e), gf.div(num, den));
+            block[n - 1 - e] ^= magnitude;
+        }
+
+        return L;
     }
 
+    long get_corrected_symbols() const { return corrected_symbols; }
+    long get_failed_blocks() const { return failed_blocks; }
+
 private:
     Config config;
+    long corrected_symbols = 0;
+    long failed_blocks = 0;
 };
 
 class ConvolutionalDecoder {
 public:
     struct Config {
         int constraint_length = 7;
-        std::vector<int> generator_polys = {0o171, 0o133};
+        std::vector<int> generator_polys = {0171, 0133};
+        bool terminated = true;
     };
 
-    ConvolutionalDecoder(const Config& cfg = Config()) : config(cfg) {}
+    ConvolutionalDecoder() : ConvolutionalDecoder(Config()) {}
+    explicit ConvolutionalDecoder(const Config& cfg)
+        : config(cfg), viterbi(make_viterbi_config(cfg)) {}
 
     std::vector<uint8_t> decode(const std::vector<double>& soft_bits) {
-        std::vector<uint8_t> decoded;
-        
-        if (soft_bits.empty()) return decoded;
-        
-        size_t output_size = soft_bits.size() / config.generator_polys.size();
-        decoded.resize(output_size);
-        
-        for (size_t i = 0; i < output_size; ++i) {
-            decoded[i] = soft_bits[i * config.generator_polys.size()] > 0.0 ? 1 : 0;
-        }
-        
-        return decoded;
+        return viterbi.decode(soft_bits);
     }
 
-    double get_error_rate() const {
-        return 0.01;
+    void decode(const std::vector<double>& soft_bits, std::vector<uint8_t>& decoded) {
+        viterbi.decode(soft_bits, decoded);
     }
 
 private:
     Config config;
+    ViterbiDecoder viterbi;
+
+    static ViterbiDecoder::Config make_viterbi_config(const Config& cfg) {
+        ViterbiDecoder::Config vc;
+        vc.constraint_length = cfg.constraint_length;
+        vc.code_rate_den = static_cast<int>(cfg.generator_polys.size());
+        vc.generator_polys = cfg.generator_polys;
+        vc.terminated = cfg.terminated;
+        return vc;
+    }
 };
 
+// Single-error-correcting Hamming decoder for [parity bits, data bits] blocks
 class HammingDecoder {
 public:
     struct Config {
@@ -186,29 +611,57 @@ public:
         int data_bits = 4;
     };
 
-    HammingDecoder(const Config& cfg = Config()) : config(cfg) {}
+    HammingDecoder() : HammingDecoder(Config()) {}
+    explicit HammingDecoder(const Config& cfg) : config(cfg) {
+        data_columns = hamming_data_syndromes(config.parity_bits, config.data_bits);
+        syndrome_position.assign(size_t(1) << config.parity_bits, -1);
+        for (int j = 0; j < config.parity_bits; ++j) syndrome_position[size_t(1) << j] = j;
+        for (int j = 0; j < config.data_bits; ++j) {
+            syndrome_position[data_columns[j]] = config.parity_bits + j;
+        }
+    }
 
     std::vector<uint8_t> decode(const std::vector<uint8_t>& encoded_bits) {
+        TRACE_SCOPE("HammingDecoder::decode");
         std::vector<uint8_t> decoded;
-        
+
         if (encoded_bits.empty()) return decoded;
-        
+
         int block_size = config.parity_bits + config.data_bits;
+        decoded.reserve(encoded_bits.size() / block_size * config.data_bits);
+        std::vector<uint8_t> block(block_size);
         for (size_t i = 0; i + block_size <= encoded_bits.size(); i += block_size) {
+            uint32_t syndrome = 0;
+            for (int j = 0; j < block_size; ++j) {
+                block[j] = encoded_bits[i + j] & 1;
+            }
+            for (int j = 0; j < config.parity_bits; ++j) {
+                if (block[j]) syndrome ^= 1u << j;
+            }
+            for (int j = 0; j < config.data_bits; ++j) {
+                if (block[config.parity_bits + j]) syndrome ^= data_columns[j];
+            }
+
+            if (syndrome != 0 && syndrome_position[syndrome] >= 0) {
+                block[syndrome_position[syndrome]] ^= 1;
+                ++corrected_bits;
+            }
+
             for (int j = 0; j < config.data_bits; ++j) {
-                decoded.push_back(encoded_bits[i + config.parity_bits + j]);
+                decoded.push_back(block[config.parity_bits + j]);
             }
         }
-        
+
         return decoded;
     }
 
-    double get_error_rate() const {
-        return 0.001;
-    }
+    long get_corrected_bits() const { return corrected_bits; }
 
 private:
     Config config;
+    std::vector<uint32_t> data_columns;
+    std::vector<int> syndrome_position;
+    long corrected_bits = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,418 @@
+#ifndef FEC_ENCODERS_H
+#define FEC_ENCODERS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "fec_common.h"
+
+// Encoders matching the decoders in fec_decoders.h. Bit-oriented APIs use one
+// bit per byte (0/1), the same layout the decoders consume after slicing.
+
+// Rate 1/n convolutional encoder. A (state, input byte) table produces all
+// n*8 output bits of a byte in one lookup.
+class ConvolutionalEncoder {
+public:
+    struct Config {
+        int constraint_length = 7;
+        std::vector<int> generator_polys = {0171, 0133};
+        bool terminate = true;   // append K-1 zero bits to return to state 0
+    };
+
+    ConvolutionalEncoder() : ConvolutionalEncoder(Config()) {}
+    explicit ConvolutionalEncoder(const Config& cfg) : config(cfg), state(0) {
+        init_tables();
+    }
+
+    std::vector<uint8_t> encode(const std::vector<uint8_t>& bits) {
+        std::vector<uint8_t> out;
+        encode(bits, out);
+        return out;
+    }
+
+    void encode(const std::vector<uint8_t>& bits, std::vector<uint8_t>& out) {
+        size_t n = config.generator_polys.size();
+        size_t tail = config.terminate ? config.constraint_length - 1 : 0;
+        out.resize((bits.size() + tail) * n);
+        state = 0;
+
+        size_t i = 0;
+        uint8_t* dst = out.data();
+        for (; i + 8 <= bits.size(); i += 8) {
+            uint8_t byte = 0;
+            for (int b = 0; b < 8; ++b) byte = static_cast<uint8_t>((byte << 1) | (bits[i + b] & 1));
+            uint32_t word = byte_table[(state << 8) | byte];
+            for (size_t b = 0; b < 8 * n; ++b) {
+                dst[b] = static_cast<uint8_t>((word >> (8 * n - 1 - b)) & 1);
+            }
+            dst += 8 * n;
+            state = next_state_after_byte(byte);
+        }
+
+        for (; i < bits.size(); ++i) dst = encode_bit(bits[i] & 1, dst);
+        for (size_t t = 0; t < tail; ++t) dst = encode_bit(0, dst);
+    }
+
+    // Packed MSB-first encoding: each input byte yields n output bytes. The
+    // register carries over between calls; call reset() to start a new stream.
+    void encode_packed(const uint8_t* in, size_t num_bytes, uint8_t* out) {
+        size_t n = config.generator_polys.size();
+        for (size_t i = 0; i < num_bytes; ++i) {
+            uint8_t byte = in[i];
+            uint32_t word = byte_table[(state << 8) | byte];
+            for (size_t j = 0; j < n; ++j) {
+                out[j] = static_cast<uint8_t>(word >> (8 * (n - 1 - j)));
+            }
+            out += n;
+            state = next_state_after_byte(byte);
+        }
+    }
+
+    void reset() { state = 0; }
+
+    size_t encoded_length(size_t num_bits) const {
+        size_t tail = config.terminate ? config.constraint_length - 1 : 0;
+        return (num_bits + tail) * config.generator_polys.size();
+    }
+
+private:
+    Config config;
+    uint32_t state;
+    std::vector<uint32_t> byte_table;    // [state << 8 | byte] -> n*8 output bits
+    std::vector<uint8_t> branch_output;  // [state << 1 | bit] -> n output bits
+    std::vector<uint32_t> byte_state;    // [byte] -> register after the byte (K <= 9)
+
+    void init_tables() {
+        int K = config.constraint_length;
+        size_t n = config.generator_polys.size();
+        size_t num_states = size_t(1) << (K - 1);
+
+        branch_output.resize(num_states * 2);
+        for (size_t s = 0; s < num_states; ++s) {
+            for (int bit = 0; bit < 2; ++bit) {
+                uint32_t reg = (static_cast<uint32_t>(bit) << (K - 1)) | static_cast<uint32_t>(s);
+                uint8_t out = 0;
+                for (size_t j = 0; j < n; ++j) {
+                    out = static_cast<uint8_t>((out << 1) | bit_parity(reg & config.generator_polys[j]));
+                }
+                branch_output[(s << 1) | bit] = out;
+            }
+        }
+
+        byte_table.resize(num_states * 256);
+        for (size_t s = 0; s < num_states; ++s) {
+            for (uint32_t byte = 0; byte < 256; ++byte) {
+                uint32_t st = static_cast<uint32_t>(s);
+                uint32_t word = 0;
+                for (int b = 7; b >= 0; --b) {
+                    uint32_t bit = (byte >> b) & 1;
+                    word = (word << n) | branch_output[(st << 1) | bit];
+                    st = ((bit << (K - 1)) | st) >> 1;
+                }
+                byte_table[(s << 8) | byte] = word;
+            }
+        }
+
+        // With K-1 <= 8 the register after a byte holds only that byte's
+        // last K-1 bits, most recent on top
+        if (K - 1 <= 8) {
+            byte_state.resize(256);
+            for (uint32_t byte = 0; byte < 256; ++byte) {
+                uint32_t st = 0;
+                for (int b = 0; b < K - 1; ++b) st |= ((byte >> b) & 1u) << (K - 2 - b);
+                byte_state[byte] = st;
+            }
+        }
+    }
+
+    uint32_t next_state_after_byte(uint8_t byte) const {
+        if (!byte_state.empty()) return byte_state[byte];
+        uint32_t st = state;
+        for (int b = 7; b >= 0; --b) st = ((((byte >> b) & 1u) << (config.constraint_length - 1)) | st) >> 1;
+        return st;
+    }
+
+    uint8_t* encode_bit(uint32_t bit, uint8_t* dst) {
+        size_t n = config.generator_polys.size();
+        uint8_t out = branch_output[(state << 1) | bit];
+        for (size_t j = 0; j < n; ++j) *dst++ = (out >> (n - 1 - j)) & 1;
+        state = ((bit << (config.constraint_length - 1)) | state) >> 1;
+        return dst;
+    }
+};
+
+// Systematic Reed-Solomon encoder over GF(2^8). The parity LFSR uses a
+// precomputed row per feedback symbol, so each data byte costs one table row
+// of XORs. Shortened codes (n < 255) are supported.
+class ReedSolomonEncoder {
+public:
+    struct Config {
+        int symbol_size = 8;
+        int code_length = 255;
+        int info_length = 223;
+    };
+
+    ReedSolomonEncoder() : ReedSolomonEncoder(Config()) {}
+    explicit ReedSolomonEncoder(const Config& cfg) : config(cfg) {
+        init_tables();
+    }
+
+    // Encodes whole info_length blocks; a partial final block is zero padded
+    std::vector<uint8_t> encode(const std::vector<uint8_t>& data) {
+        std::vector<uint8_t> out;
+        encode(data, out);
+        return out;
+    }
+
+    void encode(const std::vector<uint8_t>& data, std::vector<uint8_t>& out) {
+        size_t k = config.info_length;
+        size_t n = config.code_length;
+        size_t blocks = (data.size() + k - 1) / k;
+        out.assign(blocks * n, 0);
+
+        std::vector<uint8_t> padded;
+        for (size_t b = 0; b < blocks; ++b) {
+            const uint8_t* src = data.data() + b * k;
+            if ((b + 1) * k > data.size()) {
+                padded.assign(k, 0);
+                std::copy(data.begin() + b * k, data.end(), padded.begin());
+                src = padded.data();
+            }
+            uint8_t* dst = out.data() + b * n;
+            std::memcpy(dst, src, k);
+            encode_block(src, dst + k);
+        }
+    }
+
+    // Computes the n-k parity bytes of one k-byte message
+    void encode_block(const uint8_t* data, uint8_t* parity) const {
+        size_t nroots = parity_symbols;
+        std::memset(parity, 0, nroots);
+        for (int i = 0; i < config.info_length; ++i) {
+            uint8_t feedback = data[i] ^ parity[0];
+            const uint8_t* row = &feedback_rows[feedback * nroots];
+            for (size_t j = 0; j + 1 < nroots; ++j) parity[j] = parity[j + 1] ^ row[j];
+            parity[nroots - 1] = row[nroots - 1];
+        }
+    }
+
+private:
+    Config config;
+    size_t parity_symbols = 0;
+    std::vector<uint8_t> feedback_rows;   // [feedback][j] = feedback * g[2t-1-j]
+
+    void init_tables() {
+        const GF256& gf = GF256::instance();
+        parity_symbols = static_cast<size_t>(config.code_length - config.info_length);
+        std::vector<uint8_t> g = reed_solomon_generator(static_cast<int>(parity_symbols));
+
+        feedback_rows.resize(256 * parity_symbols);
+        for (int fb = 0; fb < 256; ++fb) {
+            for (size_t j = 0; j < parity_symbols; ++j) {
+                feedback_rows[fb * parity_symbols + j] =
+                    gf.mul(static_cast<uint8_t>(fb), g[parity_symbols - 1 - j]);
+            }
+        }
+    }
+};
+
+// DVB-S2 style LDPC encoder. Walks the sparse information-bit address table
+// lane by lane, then runs the parity accumulator. Codeword is [info, parity].
+class LDPCEncoder {
+public:
+    struct Config {
+        int code_length = 64800;
+        int info_length = 32400;
+    };
+
+    LDPCEncoder() : LDPCEncoder(Config()) {}
+    explicit LDPCEncoder(const Config& cfg)
+        : config(cfg), structure(cfg.code_length, cfg.info_length) {}
+
+    std::vector<uint8_t> encode(const std::vector<uint8_t>& bits) {
+        std::vector<uint8_t> out;
+        encode(bits, out);
+        return out;
+    }
+
+    // Encodes whole info_length blocks; a partial final block is zero padded
+    void encode(const std::vector<uint8_t>& bits, std::vector<uint8_t>& out) {
+        size_t k = structure.info_length();
+        size_t n = structure.code_length();
+        size_t blocks = (bits.size() + k - 1) / k;
+        out.assign(blocks * n, 0);
+
+        for (size_t b = 0; b < blocks; ++b) {
+            size_t count = std::min(k, bits.size() - b * k);
+            uint8_t* dst = out.data() + b * n;
+            std::copy(bits.begin() + b * k, bits.begin() + b * k + count, dst);
+            encode_block(dst, dst + k);
+        }
+    }
+
+    void encode_block(const uint8_t* info, uint8_t* parity) const {
+        size_t m = structure.parity_length();
+        size_t lanes = structure.lane_count();
+        size_t q = structure.lane_step();
+        const auto& groups = structure.addresses();
+
+        std::memset(parity, 0, m);
+        for (size_t g = 0; g < groups.size(); ++g) {
+            const uint8_t* group_bits = info + g * lanes;
+            for (uint32_t x : groups[g]) {
+                size_t check = x;
+                for (size_t j = 0; j < lanes; ++j) {
+                    parity[check] ^= group_bits[j];
+                    check += q;
+                    if (check >= m) check -= m;
+                }
+            }
+        }
+
+        for (size_t i = 1; i < m; ++i) parity[i] ^= parity[i - 1];
+    }
+
+    const LDPCParityStructure& get_structure() const { return structure; }
+
+private:
+    Config config;
+    LDPCParityStructure structure;
+};
+
+// LTE-style rate 1/3 turbo encoder: two 8-state RSC encoders joined by a QPP
+// interleaver. Output is [x_k, z_k, z'_k] per bit followed by 12 tail bits
+// (x, z) x 3 for encoder 1 then (x', z') x 3 for encoder 2.
+class TurboEncoder {
+public:
+    struct Config {
+        int frame_size = 6144;
+    };
+
+    TurboEncoder() : TurboEncoder(Config()) {}
+    explicit TurboEncoder(const Config& cfg) : config(cfg), interleaver(cfg.frame_size) {
+        for (int s = 0; s < TurboTrellis::STATES; ++s) {
+            for (int u = 0; u < 2; ++u) {
+                next_state[s][u] = static_cast<uint8_t>(TurboTrellis::next_state(s, u));
+                parity_bit[s][u] = static_cast<uint8_t>(TurboTrellis::parity(s, u));
+            }
+        }
+    }
+
+    std::vector<uint8_t> encode(const std::vector<uint8_t>& bits) {
+        std::vector<uint8_t> out;
+        encode(bits, out);
+        return out;
+    }
+
+    // Encodes whole frames; a partial final frame is zero padded
+    void encode(const std::vector<uint8_t>& bits, std::vector<uint8_t>& out) {
+        size_t K = config.frame_size;
+        size_t frame_out = encoded_frame_length();
+        size_t frames = (bits.size() + K - 1) / K;
+        out.resize(frames * frame_out);
+
+        std::vector<uint8_t> padded;
+        for (size_t f = 0; f < frames; ++f) {
+            const uint8_t* src = bits.data() + f * K;
+            if ((f + 1) * K > bits.size()) {
+                padded.assign(K, 0);
+                std::copy(bits.begin() + f * K, bits.end(), padded.begin());
+                src = padded.data();
+            }
+            encode_frame(src, out.data() + f * frame_out);
+        }
+    }
+
+    size_t encoded_frame_length() const {
+        return 3 * static_cast<size_t>(config.frame_size) + 4 * TurboTrellis::TAIL;
+    }
+
+    const QPPInterleaver& get_interleaver() const { return interleaver; }
+
+private:
+    Config config;
+    QPPInterleaver interleaver;
+    uint8_t next_state[TurboTrellis::STATES][2];
+    uint8_t parity_bit[TurboTrellis::STATES][2];
+
+    void encode_frame(const uint8_t* bits, uint8_t* out) const {
+        size_t K = config.frame_size;
+        int s1 = 0, s2 = 0;
+        for (size_t k = 0; k < K; ++k) {
+            int u = bits[k] & 1;
+            int v = bits[interleaver[k]] & 1;
+            out[3 * k] = static_cast<uint8_t>(u);
+            out[3 * k + 1] = parity_bit[s1][u];
+            out[3 * k + 2] = parity_bit[s2][v];
+            s1 = next_state[s1][u];
+            s2 = next_state[s2][v];
+        }
+
+        uint8_t* tail = out + 3 * K;
+        for (int t = 0; t < TurboTrellis::TAIL; ++t) {
+            int u = TurboTrellis::tail_input(s1);
+            *tail++ = static_cast<uint8_t>(u);
+            *tail++ = parity_bit[s1][u];
+            s1 = next_state[s1][u];
+        }
+        for (int t = 0; t < TurboTrellis::TAIL; ++t) {
+            int v = TurboTrellis::tail_input(s2);
+            *tail++ = static_cast<uint8_t>(v);
+            *tail++ = parity_bit[s2][v];
+            s2 = next_state[s2][v];
+        }
+    }
+};
+
+// Hamming encoder. Each block is laid out [parity bits, data bits], the layout
+// HammingDecoder expects. Parity bit j covers the data columns whose syndrome
+// has bit j set.
+class HammingEncoder {
+public:
+    struct Config {
+        int parity_bits = 3;
+        int data_bits = 4;
+    };
+
+    HammingEncoder() : HammingEncoder(Config()) {}
+    explicit HammingEncoder(const Config& cfg) : config(cfg) {
+        init_tables();
+    }
+
+    std::vector<uint8_t> encode(const std::vector<uint8_t>& bits) {
+        std::vector<uint8_t> out;
+        encode(bits, out);
+        return out;
+    }
+
+    // Encodes whole data_bits blocks; a partial final block is zero padded
+    void encode(const std::vector<uint8_t>& bits, std::vector<uint8_t>& out) {
+        size_t r = config.parity_bits;
+        size_t d = config.data_bits;
+        size_t blocks = (bits.size() + d - 1) / d;
+        out.assign(blocks * (r + d), 0);
+
+        for (size_t b = 0; b < blocks; ++b) {
+            uint8_t* dst = out.data() + b * (r + d);
+            uint32_t parity = 0;
+            for (size_t j = 0; j < d; ++j) {
+                size_t idx = b * d + j;
+                uint8_t bit = idx < bits.size() ? (bits[idx] & 1) : 0;
+                dst[r + j] = bit;
+                parity ^= bit ? data_columns[j] : 0u;
+            }
+            for (size_t j = 0; j < r; ++j) dst[j] = (parity >> j) & 1;
+        }
+    }
+
+private:
+    Config config;
+    std::vector<uint32_t> data_columns;
+
+    void init_tables() {
+        data_columns = hamming_data_syndromes(config.parity_bits, config.data_bits);
+    }
+};
+
+#endif // FEC_ENCODERS_H
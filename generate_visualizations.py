@@ -5,8 +5,14 @@ Creates 3 images (4000x4000 pixels each):
 1. Orbital trajectory (azimuth/elevation)
 2. Signal processing metrics over time
 3. Frequency search correlation results
+
+With --sweeps FILE, plots the scaling sweeps written by
+`benchmark_suite --sweeps` instead: one image per benchmark family.
 """
 
+import argparse
+import json
+import re
 import matplotlib.pyplot as plt
 import matplotlib.patches as mpatches
 import numpy as np
@@ -268,10 +274,109 @@ def generate_frequency_search():
     print("✓ Generated: frequency_search.png (4000x4000)")
 
 
+# ============================================================================
+# SCALING SWEEPS (benchmark_suite --sweeps)
+# ============================================================================
+def load_sweep_families(path):
+    """Group sweep points by family; returns {family: (x_param, points)}"""
+    with open(path) as f:
+        data = json.load(f)
+    families = {}
+    for bench in data.get('benchmarks', []):
+        if 'family' in bench:
+            families.setdefault(bench['family'], []).append(bench)
+
+    result = {}
+    for family, points in families.items():
+        # Plot against the first parameter that changes across the family
+        names = list(points[0]['params'].keys())
+        varying = [n for n in names if len({p['params'].get(n) for p in points}) > 1]
+        x_param = varying[0] if varying else names[0]
+        points.sort(key=lambda p: p['params'][x_param])
+        result[family] = (x_param, points)
+    return result
+
+
+def generate_scaling_plot(family, x_param, points):
+    """Throughput and time against the swept parameter for one family"""
+    fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(SIZE, SIZE / 2), dpi=DPI)
+    fig.patch.set_facecolor('#0a0e27')
+
+    for ax in [ax1, ax2]:
+        ax.set_facecolor('#0a0e27')
+        ax.spines['top'].set_visible(False)
+        ax.spines['right'].set_visible(False)
+        ax.spines['left'].set_color('cyan')
+        ax.spines['bottom'].set_color('cyan')
+        ax.spines['left'].set_linewidth(3)
+        ax.spines['bottom'].set_linewidth(3)
+        ax.tick_params(colors='cyan', labelsize=35, width=2, length=8)
+        ax.grid(True, which='both', alpha=0.2, color='cyan', linewidth=2)
+        ax.set_xscale('log', base=2)
+        ax.set_xlabel(x_param, fontsize=45, color='cyan', weight='bold')
+
+    x = np.array([p['params'][x_param] for p in points], dtype=float)
+    median_ms = np.array([p['median_ms'] for p in points])
+
+    # Plot 1: throughput (or calls per second when no rate was recorded)
+    if all('items_per_second' in p for p in points):
+        rate = np.array([p['items_per_second'] for p in points]) / 1e6
+        rate_label = 'M %s/s' % points[0]['item_unit']
+    else:
+        rate = 1e3 / median_ms
+        rate_label = 'Calls/s'
+    ax1.plot(x, rate, 'o-', color='lime', linewidth=5, markersize=20,
+             markeredgecolor='cyan', markeredgewidth=3, label='Measured')
+    if x_param == 'threads':
+        ax1.plot(x, rate[0] * x / x[0], '--', color='orange', linewidth=4,
+                 alpha=0.7, label='Linear scaling')
+        ax1.legend(fontsize=35, edgecolor='cyan', facecolor='#1a1f3a', labelcolor='lime')
+    ax1.set_ylim(bottom=0)
+    ax1.set_ylabel(rate_label, fontsize=45, color='cyan', weight='bold')
+    ax1.set_title('Throughput', fontsize=50, color='lime', weight='bold', pad=30)
+
+    # Plot 2: median time per call with the min-max spread
+    low = np.array([p['min_ms'] for p in points])
+    high = np.array([p['max_ms'] for p in points])
+    ax2.fill_between(x, low, high, alpha=0.3, color='magenta')
+    ax2.plot(x, median_ms, 's-', color='magenta', linewidth=5, markersize=20,
+             markeredgecolor='yellow', markeredgewidth=3)
+    ax2.set_yscale('log')
+    ax2.set_ylabel('Median time per call (ms)', fontsize=45, color='cyan', weight='bold')
+    ax2.set_title('Time per Call', fontsize=50, color='lime', weight='bold', pad=30)
+
+    fig.text(0.5, 0.98, family.upper(), ha='center', fontsize=60, color='lime', weight='bold',
+             bbox=dict(boxstyle='round', facecolor='#1a1f3a', edgecolor='cyan', linewidth=4))
+
+    filename = 'scaling_%s.png' % re.sub(r'[^a-z0-9]+', '_', family.lower()).strip('_')
+    plt.tight_layout(rect=[0, 0, 1, 0.92])
+    plt.savefig(filename, dpi=DPI, facecolor='#0a0e27',
+                edgecolor='cyan', bbox_inches='tight', pad_inches=0.5)
+    plt.close()
+    print("✓ Generated: %s" % filename)
+    return filename
+
+
+def generate_scaling_plots(path):
+    families = load_sweep_families(path)
+    if not families:
+        print("No benchmark families in %s (run benchmark_suite --sweeps)" % path)
+    return [generate_scaling_plot(family, x_param, points)
+            for family, (x_param, points) in families.items()]
+
+
 # ============================================================================
 # MAIN
 # ============================================================================
 if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Satellite signal processing visualizations')
+    parser.add_argument('--sweeps', metavar='FILE',
+                        help='plot scaling sweeps from benchmark_suite --sweeps output')
+    args = parser.parse_args()
+    if args.sweeps:
+        generate_scaling_plots(args.sweeps)
+        raise SystemExit(0)
+
     print("\n" + "="*70)
     print("  SATELLITE SIGNAL PROCESSING - VISUALIZATION GENERATOR")
     print("  Creating 3 × 4000x4000 pixel PNG images...")
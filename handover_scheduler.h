@@ -0,0 +1,320 @@
+#ifndef HANDOVER_SCHEDULER_H
+#define HANDOVER_SCHEDULER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "orbital_types.h"
+#include "pass_predictor.h"
+#include "interval_tree.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Contact planning for a ground network. Passes of every satellite over every
+// station are held in an interval tree, so "what is up anywhere during
+// [t0, t1]" is a logarithmic query. Each station has a number of antennas,
+// each tracking one satellite at a time with a setup (slew and reacquisition)
+// time between contacts, and the plan picks which passes each antenna takes
+// over the whole horizon:
+//   MinCostFlow  maximizes total contact time. Event times form a chain of
+//                nodes with capacity = antennas, every pass is an arc from
+//                its AOS to its LOS plus setup with cost = -duration, and
+//                successive shortest paths (Dijkstra on reduced costs) push
+//                one antenna at a time. Optimal.
+//   Greedy       maximizes the number of contacts: passes in order of LOS,
+//                each given to the antenna that became free latest but in
+//                time. Optimal for that objective and cheaper.
+// Stations are planned independently and in parallel.
+class HandoverScheduler {
+public:
+    enum class Solver { Greedy, MinCostFlow };
+
+    struct Config {
+        PassPredictor::Config prediction;
+        double setup_minutes = 1.0;        // between contacts on one antenna
+        double min_contact_minutes = 0.5;  // shorter passes are not scheduled
+        Solver solver = Solver::MinCostFlow;
+        unsigned num_threads = 0;          // 0 = all cores
+    };
+
+    struct Contact {
+        uint32_t satellite;
+        uint32_t station;
+        uint32_t antenna;
+        double aos, los;                   // minutes after the window start
+        double max_elevation_deg;
+    };
+
+    // One antenna moving from one satellite to the next
+    struct Handover {
+        uint32_t station;
+        uint32_t antenna;
+        uint32_t from_satellite;
+        uint32_t to_satellite;
+        double time;                       // LOS of the outgoing contact
+        double gap;                        // until AOS of the incoming one
+    };
+
+    HandoverScheduler() : HandoverScheduler(Config()) {}
+    explicit HandoverScheduler(const Config& cfg) : config(cfg), predictor(cfg.prediction) {}
+
+    size_t add_station(const GroundStation& station, unsigned antennas = 1) {
+        antenna_count.push_back(std::max(1u, antennas));
+        return predictor.add_station(station);
+    }
+
+    size_t add_satellite(const TLE& tle) { return predictor.add_satellite(tle); }
+    void add_satellites(const std::vector<TLE>& tles) { predictor.add_satellites(tles); }
+
+    // Predict every pass over every station in the window and index them
+    void predict(double start_jd, double duration_minutes) {
+        set_passes(predictor.predict(start_jd, duration_minutes));
+    }
+
+    // Use passes predicted elsewhere; stations are those added here, in order
+    void set_passes(std::vector<PassPredictor::Pass> predicted) {
+        passes = std::move(predicted);
+        std::vector<double> aos(passes.size()), los(passes.size());
+        std::vector<uint32_t> index(passes.size());
+        for (size_t i = 0; i < passes.size(); ++i) {
+            aos[i] = passes[i].aos;
+            los[i] = passes[i].los;
+            index[i] = static_cast<uint32_t>(i);
+        }
+        tree.build(aos, los, index);
+    }
+
+    const std::vector<PassPredictor::Pass>& get_passes() const { return passes; }
+
+    // Indices into get_passes() of the passes in progress at some time in
+    // [t0, t1], at any station
+    void passes_during(double t0, double t1, std::vector<uint32_t>& out) const {
+        out.clear();
+        tree.query(t0, t1, out);
+    }
+
+    // Distinct satellites above the mask of at least one station at some
+    // time in [t0, t1], ascending
+    void visible_satellites(double t0, double t1, std::vector<uint32_t>& out) const {
+        out.clear();
+        tree.query(t0, t1, [&](uint32_t p, double, double) { out.push_back(passes[p].satellite); });
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    // Antenna assignment over the indexed passes, sorted by station, antenna
+    // and AOS
+    std::vector<Contact> plan() const {
+        const size_t num_stations = antenna_count.size();
+        std::vector<std::vector<uint32_t>> by_station(num_stations);
+        for (size_t i = 0; i < passes.size(); ++i) {
+            const auto& p = passes[i];
+            if (p.station < num_stations && p.duration() >= config.min_contact_minutes) {
+                by_station[p.station].push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        std::vector<std::vector<Contact>> per_station(num_stations);
+        parallel_for(num_stations, [&](size_t begin, size_t end, unsigned) {
+            for (size_t k = begin; k < end; ++k) {
+                if (config.solver == Solver::Greedy) {
+                    plan_greedy(by_station[k], antenna_count[k], per_station[k]);
+                } else {
+                    plan_flow(by_station[k], antenna_count[k], per_station[k]);
+                }
+            }
+        }, 1, config.num_threads);
+
+        std::vector<Contact> contacts;
+        for (auto& c : per_station) {
+            std::sort(c.begin(), c.end(), [](const Contact& a, const Contact& b) {
+                return a.antenna != b.antenna ? a.antenna < b.antenna : a.aos < b.aos;
+            });
+            contacts.insert(contacts.end(), c.begin(), c.end());
+        }
+        return contacts;
+    }
+
+    // Satellite changes on each antenna of a plan
+    static std::vector<Handover> handovers(const std::vector<Contact>& contacts) {
+        std::vector<Handover> out;
+        for (size_t i = 1; i < contacts.size(); ++i) {
+            const Contact& a = contacts[i - 1];
+            const Contact& b = contacts[i];
+            if (a.station != b.station || a.antenna != b.antenna) continue;
+            out.push_back({b.station, b.antenna, a.satellite, b.satellite, a.los, b.aos - a.los});
+        }
+        return out;
+    }
+
+    // Sum of contact durations, minutes
+    static double contact_minutes(const std::vector<Contact>& contacts) {
+        double total = 0.0;
+        for (const auto& c : contacts) total += c.los - c.aos;
+        return total;
+    }
+
+    size_t station_count() const { return antenna_count.size(); }
+    size_t satellite_count() const { return predictor.satellite_count(); }
+    const Config& get_config() const { return config; }
+
+private:
+    Config config;
+    PassPredictor predictor;
+    std::vector<unsigned> antenna_count;
+    std::vector<PassPredictor::Pass> passes;
+    IntervalTree tree;
+
+    Contact make_contact(uint32_t pass, uint32_t antenna) const {
+        const auto& p = passes[pass];
+        return {p.satellite, p.station, antenna, p.aos, p.los, p.max_elevation_deg};
+    }
+
+    void plan_greedy(std::vector<uint32_t> candidates, unsigned antennas, std::vector<Contact>& out) const {
+        std::sort(candidates.begin(), candidates.end(),
+                  [&](uint32_t a, uint32_t b) { return passes[a].los < passes[b].los; });
+        std::vector<double> free_at(antennas, -std::numeric_limits<double>::infinity());
+        for (uint32_t p : candidates) {
+            // Best fit: the antenna idle for the shortest time
+            int best = -1;
+            for (unsigned a = 0; a < antennas; ++a) {
+                if (free_at[a] <= passes[p].aos && (best < 0 || free_at[a] > free_at[best])) {
+                    best = static_cast<int>(a);
+                }
+            }
+            if (best < 0) continue;
+            free_at[best] = passes[p].los + config.setup_minutes;
+            out.push_back(make_contact(p, static_cast<uint32_t>(best)));
+        }
+    }
+
+    void plan_flow(const std::vector<uint32_t>& candidates, unsigned antennas, std::vector<Contact>& out) const {
+        if (candidates.empty()) return;
+
+        // Nodes are the distinct AOS and LOS + setup times in order
+        std::vector<double> times;
+        times.reserve(2 * candidates.size());
+        for (uint32_t p : candidates) {
+            times.push_back(passes[p].aos);
+            times.push_back(passes[p].los + config.setup_minutes);
+        }
+        std::sort(times.begin(), times.end());
+        times.erase(std::unique(times.begin(), times.end()), times.end());
+        auto node_of = [&](double t) {
+            return static_cast<int>(std::lower_bound(times.begin(), times.end(), t) - times.begin());
+        };
+        const int num_nodes = static_cast<int>(times.size());
+
+        // Residual graph; edge e and e ^ 1 are a pair. Costs are integer
+        // milliseconds so reduced costs stay exact.
+        FlowGraph g(num_nodes);
+        for (int v = 0; v + 1 < num_nodes; ++v) g.add_edge(v, v + 1, antennas, 0);
+        const size_t first_pass_edge = g.to.size();
+        for (uint32_t p : candidates) {
+            int64_t weight = static_cast<int64_t>(passes[p].duration() * 60000.0 + 0.5);
+            g.add_edge(node_of(passes[p].aos), node_of(passes[p].los + config.setup_minutes), 1, -weight);
+        }
+        g.augment(0, num_nodes - 1, antennas);
+
+        // Chosen passes never overlap more than `antennas` deep, so handing
+        // them out in AOS order to any free antenna always succeeds
+        std::vector<uint32_t> chosen;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (g.cap[first_pass_edge + 2 * i] == 0) chosen.push_back(candidates[i]);
+        }
+        std::sort(chosen.begin(), chosen.end(),
+                  [&](uint32_t a, uint32_t b) { return passes[a].aos < passes[b].aos; });
+        std::vector<double> free_at(antennas, -std::numeric_limits<double>::infinity());
+        for (uint32_t p : chosen) {
+            unsigned a = 0;
+            while (a + 1 < antennas && free_at[a] > passes[p].aos) ++a;
+            free_at[a] = passes[p].los + config.setup_minutes;
+            out.push_back(make_contact(p, a));
+        }
+    }
+
+    // Min-cost flow on a graph whose forward edges all point to later nodes
+    struct FlowGraph {
+        std::vector<int> head, next, to;
+        std::vector<int64_t> cap, cost;
+
+        explicit FlowGraph(int nodes) : head(nodes, -1) {}
+
+        void add_edge(int u, int v, int64_t capacity, int64_t c) {
+            push(u, v, capacity, c);
+            push(v, u, 0, -c);
+        }
+
+        void push(int u, int v, int64_t capacity, int64_t c) {
+            next.push_back(head[u]);
+            head[u] = static_cast<int>(to.size());
+            to.push_back(v);
+            cap.push_back(capacity);
+            cost.push_back(c);
+        }
+
+        // Successive shortest paths from s to t for up to `units` of flow,
+        // stopping once another unit would not lower the cost
+        void augment(int s, int t, int64_t units) {
+            const int n = static_cast<int>(head.size());
+            const int64_t INF = std::numeric_limits<int64_t>::max() / 4;
+
+            // Initial potentials: shortest paths in the DAG in node order
+            std::vector<int64_t> pot(n, INF);
+            pot[s] = 0;
+            for (int u = 0; u < n; ++u) {
+                if (pot[u] == INF) continue;
+                for (int e = head[u]; e >= 0; e = next[e]) {
+                    if (cap[e] > 0 && pot[u] + cost[e] < pot[to[e]]) pot[to[e]] = pot[u] + cost[e];
+                }
+            }
+
+            std::vector<int64_t> dist(n);
+            std::vector<int> parent(n);
+            using Item = std::pair<int64_t, int>;
+            while (units > 0) {
+                std::fill(dist.begin(), dist.end(), INF);
+                std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+                dist[s] = 0;
+                queue.push({0, s});
+                while (!queue.empty()) {
+                    auto [d, u] = queue.top();
+                    queue.pop();
+                    if (d > dist[u]) continue;
+                    for (int e = head[u]; e >= 0; e = next[e]) {
+                        if (cap[e] == 0 || pot[to[e]] == INF) continue;
+                        int64_t nd = d + cost[e] + pot[u] - pot[to[e]];
+                        if (nd < dist[to[e]]) {
+                            dist[to[e]] = nd;
+                            parent[to[e]] = e;
+                            queue.push({nd, to[e]});
+                        }
+                    }
+                }
+                if (dist[t] == INF) break;
+                for (int v = 0; v < n; ++v) {
+                    if (dist[v] < INF) pot[v] += dist[v];
+                }
+                if (pot[t] - pot[s] >= 0) break;
+
+                int64_t amount = units;
+                for (int v = t; v != s; v = to[parent[v] ^ 1]) amount = std::min(amount, cap[parent[v]]);
+                for (int v = t; v != s; v = to[parent[v] ^ 1]) {
+                    cap[parent[v]] -= amount;
+                    cap[parent[v] ^ 1] += amount;
+                }
+                units -= amount;
+            }
+        }
+    };
+};
+
+}  // namespace SatelliteSignal
+
+#endif // HANDOVER_SCHEDULER_H
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include "scoped_trace.h"
 
 using ComplexSample = std::complex<double>;
 
@@ -20,6 +21,7 @@ public:
     };
 
     static DetectionResult detect(const std::vector<ComplexSample>& signal) {
+        TRACE_SCOPE("InterferenceDetector::detect");
         DetectionResult result;
         
         result.rfi_detected = detect_rfi(signal);
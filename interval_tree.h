@@ -0,0 +1,100 @@
+#ifndef INTERVAL_TREE_H
+#define INTERVAL_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace SatelliteSignal {
+
+// Static interval tree over closed intervals [start, end], each carrying a
+// 32-bit value. Intervals are sorted by start and the tree is implicit: the
+// node for a range of the sorted array is its middle element, and every node
+// stores the largest end in its range. An overlap query descends only into
+// ranges whose largest end reaches the query and whose starts do not pass
+// it, so it costs O(log n + k) for k results.
+class IntervalTree {
+public:
+    void build(const std::vector<double>& start, const std::vector<double>& end,
+               const std::vector<uint32_t>& value) {
+        const size_t n = start.size();
+        std::vector<uint32_t> order(n);
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(),
+                  [&](uint32_t a, uint32_t b) { return start[a] < start[b]; });
+
+        starts.resize(n);
+        ends.resize(n);
+        values.resize(n);
+        max_end.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            starts[i] = start[order[i]];
+            ends[i] = end[order[i]];
+            values[i] = value[order[i]];
+        }
+        if (n > 0) fill_max_end(0, n);
+    }
+
+    void clear() {
+        starts.clear();
+        ends.clear();
+        values.clear();
+        max_end.clear();
+    }
+
+    size_t size() const { return starts.size(); }
+
+    // Call visit(value, start, end) for every interval overlapping [t0, t1]
+    template <typename Visit>
+    void query(double t0, double t1, Visit&& visit) const {
+        if (starts.empty()) return;
+        size_t stack_lo[64], stack_hi[64];
+        int top = 0;
+        stack_lo[0] = 0;
+        stack_hi[0] = starts.size();
+        while (top >= 0) {
+            size_t lo = stack_lo[top], hi = stack_hi[top];
+            --top;
+            if (lo >= hi) continue;
+            size_t mid = lo + (hi - lo) / 2;
+            if (max_end[mid] < t0) continue;
+            // Everything right of mid starts no earlier, so stop there once
+            // mid starts past the query
+            if (starts[mid] <= t1) {
+                if (ends[mid] >= t0) visit(values[mid], starts[mid], ends[mid]);
+                ++top;
+                stack_lo[top] = mid + 1;
+                stack_hi[top] = hi;
+            }
+            ++top;
+            stack_lo[top] = lo;
+            stack_hi[top] = mid;
+        }
+    }
+
+    // Values of the intervals overlapping [t0, t1], appended to `out`
+    void query(double t0, double t1, std::vector<uint32_t>& out) const {
+        query(t0, t1, [&](uint32_t value, double, double) { out.push_back(value); });
+    }
+
+private:
+    std::vector<double> starts;
+    std::vector<double> ends;
+    std::vector<uint32_t> values;
+    std::vector<double> max_end;          // over the node's range
+
+    double fill_max_end(size_t lo, size_t hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        double m = ends[mid];
+        if (lo < mid) m = std::max(m, fill_max_end(lo, mid));
+        if (mid + 1 < hi) m = std::max(m, fill_max_end(mid + 1, hi));
+        max_end[mid] = m;
+        return m;
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // INTERVAL_TREE_H
@@ -0,0 +1,317 @@
+#ifndef IQ_FILE_READER_H
+#define IQ_FILE_READER_H
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+#include "signal_processor.h"
+
+namespace SatelliteSignal {
+
+// Interleaved I/Q sample encodings found in raw captures (little-endian)
+enum class IQFormat {
+    CF32,  // float32 I, float32 Q
+    CF64,  // float64 I, float64 Q
+    CS16,  // int16 I, int16 Q
+    CU8    // uint8 I, uint8 Q, offset binary around 127.5 (RTL-SDR)
+};
+
+inline size_t iq_sample_bytes(IQFormat format) {
+    switch (format) {
+        case IQFormat::CF32: return 8;
+        case IQFormat::CF64: return 16;
+        case IQFormat::CS16: return 4;
+        case IQFormat::CU8: return 2;
+    }
+    return 0;
+}
+
+// SigMF core:datatype names ("cf32_le", "ci16_le", "cu8", ...) and the
+// usual raw file extensions ("cf32", "cs16", ...)
+inline bool parse_iq_format(const std::string& name, IQFormat& format) {
+    std::string n = name;
+    if (n.size() > 3 && n.compare(n.size() - 3, 3, "_le") == 0) n.resize(n.size() - 3);
+    if (n == "cf32" || n == "fc32") format = IQFormat::CF32;
+    else if (n == "cf64" || n == "fc64") format = IQFormat::CF64;
+    else if (n == "ci16" || n == "cs16" || n == "sc16") format = IQFormat::CS16;
+    else if (n == "cu8" || n == "uc8") format = IQFormat::CU8;
+    else return false;
+    return true;
+}
+
+// A run of consecutive samples viewed in place in the mapping. Valid while
+// the reader that produced it stays open.
+struct IQBlock {
+    const char* data = nullptr;
+    size_t samples = 0;
+    uint64_t first_sample = 0;  // index in the recording
+    IQFormat format = IQFormat::CF32;
+
+    size_t bytes() const { return samples * iq_sample_bytes(format); }
+
+    // Typed views; null when the block is in another format
+    const std::complex<float>* cf32() const {
+        return format == IQFormat::CF32 ? reinterpret_cast<const std::complex<float>*>(data) : nullptr;
+    }
+    const std::complex<double>* cf64() const {
+        return format == IQFormat::CF64 ? reinterpret_cast<const std::complex<double>*>(data) : nullptr;
+    }
+    const int16_t* cs16() const {
+        return format == IQFormat::CS16 ? reinterpret_cast<const int16_t*>(data) : nullptr;
+    }
+    const uint8_t* cu8() const {
+        return format == IQFormat::CU8 ? reinterpret_cast<const uint8_t*>(data) : nullptr;
+    }
+};
+
+// Replays recorded IQ captures from a read-only memory mapping. Blocks are
+// handed out as views into the mapping rather than copies; a block's size
+// in bytes is kept a multiple of Config::alignment so every block starts
+// on that boundary (the mapping itself is page-aligned). While streaming,
+// the next blocks are prefetched and, optionally, consumed ones are
+// released from the resident set.
+//
+// open() accepts a SigMF recording (the .sigmf-meta or .sigmf-data file,
+// or their common base name), whose metadata supplies the format, sample
+// rate and center frequency, or a raw file whose extension names the
+// format (.cf32, .cf64, .cs16, .cu8). open_raw() takes the format
+// explicitly for any file name.
+class IQFileReader {
+public:
+    struct Config {
+        size_t block_samples = 65536;
+        size_t alignment = 64;          // bytes; blocks start on this boundary
+        size_t readahead_blocks = 4;    // prefetched ahead of the read position
+        bool release_consumed = true;   // drop pages behind the read position
+        bool huge_pages = false;        // best effort, see MappedFile
+    };
+
+    struct Metadata {
+        IQFormat format = IQFormat::CF32;
+        double sample_rate = 0.0;       // Hz; 0 when unknown
+        double center_frequency = 0.0;  // Hz; 0 when unknown
+        std::string datatype;           // as given in the metadata, if any
+    };
+
+    IQFileReader() : IQFileReader(Config()) {}
+    explicit IQFileReader(const Config& cfg) : config(cfg) {
+        const size_t align = std::max<size_t>(config.alignment, 1);
+        config.alignment = align;
+        config.block_samples = std::max<size_t>(config.block_samples, 1);
+    }
+
+    bool open(const std::string& path) {
+        close();
+        std::string base = path;
+        for (const char* ext : {".sigmf-meta", ".sigmf-data", ".sigmf"}) {
+            if (ends_with(base, ext)) {
+                base.resize(base.size() - std::strlen(ext));
+                return open_sigmf(base);
+            }
+        }
+        MappedFile probe(base + ".sigmf-meta");
+        if (probe.good()) return open_sigmf(base);
+
+        size_t dot = path.find_last_of('.');
+        IQFormat format;
+        if (dot == std::string::npos || !parse_iq_format(path.substr(dot + 1), format)) {
+            error = "cannot tell the sample format of " + path;
+            return false;
+        }
+        return open_raw(path, format);
+    }
+
+    bool open_raw(const std::string& path, IQFormat format, double sample_rate = 0.0,
+                  double center_frequency = 0.0) {
+        close();
+        if (!file.open(path)) {
+            error = "cannot open " + path;
+            return false;
+        }
+        meta.format = format;
+        meta.sample_rate = sample_rate;
+        meta.center_frequency = center_frequency;
+        start_stream();
+        return true;
+    }
+
+    void close() {
+        file.close();
+        meta = Metadata();
+        position = 0;
+        error.clear();
+    }
+
+    bool good() const { return file.good(); }
+    const std::string& get_error() const { return error; }
+    const Metadata& metadata() const { return meta; }
+    const Config& get_config() const { return config; }
+
+    // Whole samples in the file; a trailing partial sample is ignored
+    uint64_t total_samples() const { return file.size() / iq_sample_bytes(meta.format); }
+
+    // Samples per block after rounding up to the alignment
+    size_t block_samples() const { return block_size; }
+
+    // Next block of the stream; false at the end. The last block may be
+    // short.
+    bool next(IQBlock& block) {
+        const uint64_t total = total_samples();
+        if (position >= total) return false;
+        block = block_at(position, block_size);
+        const size_t sample_bytes = iq_sample_bytes(meta.format);
+        const size_t block_bytes = block_size * sample_bytes;
+        const size_t offset = static_cast<size_t>(position) * sample_bytes;
+
+        if (config.readahead_blocks > 0) {
+            file.prefetch(offset + config.readahead_blocks * block_bytes, block_bytes);
+        }
+        // Release the block before the one being handed out, which the
+        // caller may still hold
+        if (config.release_consumed && offset >= 2 * block_bytes) {
+            file.release(released_bytes, offset - block_bytes - released_bytes);
+            released_bytes = offset - block_bytes;
+        }
+        position += block.samples;
+        return true;
+    }
+
+    // View of up to `count` samples starting at `first`, clipped to the file
+    IQBlock block_at(uint64_t first, size_t count) const {
+        IQBlock block;
+        block.format = meta.format;
+        const uint64_t total = total_samples();
+        if (first >= total) return block;
+        block.first_sample = first;
+        block.samples = static_cast<size_t>(std::min<uint64_t>(count, total - first));
+        block.data = file.data() + static_cast<size_t>(first) * iq_sample_bytes(meta.format);
+        return block;
+    }
+
+    void rewind() {
+        position = 0;
+        released_bytes = 0;
+    }
+
+    uint64_t tell() const { return position; }
+
+    // Convert a block to the DSP's sample type, scaling integer formats to
+    // [-1, 1]. `out` is resized, not reallocated once large enough.
+    static void to_complex(const IQBlock& block, std::vector<ComplexSample>& out) {
+        out.resize(block.samples);
+        switch (block.format) {
+            case IQFormat::CF32: {
+                const float* in = reinterpret_cast<const float*>(block.data);
+                for (size_t i = 0; i < block.samples; ++i) out[i] = ComplexSample(in[2 * i], in[2 * i + 1]);
+                break;
+            }
+            case IQFormat::CF64:
+                std::memcpy(out.data(), block.data, block.samples * sizeof(ComplexSample));
+                break;
+            case IQFormat::CS16: {
+                const int16_t* in = block.cs16();
+                const double scale = 1.0 / 32768.0;
+                for (size_t i = 0; i < block.samples; ++i) {
+                    out[i] = ComplexSample(in[2 * i] * scale, in[2 * i + 1] * scale);
+                }
+                break;
+            }
+            case IQFormat::CU8: {
+                const uint8_t* in = block.cu8();
+                const double scale = 1.0 / 127.5;
+                for (size_t i = 0; i < block.samples; ++i) {
+                    out[i] = ComplexSample((in[2 * i] - 127.5) * scale, (in[2 * i + 1] - 127.5) * scale);
+                }
+                break;
+            }
+        }
+    }
+
+private:
+    Config config;
+    MappedFile file;
+    Metadata meta;
+    size_t block_size = 0;
+    uint64_t position = 0;
+    size_t released_bytes = 0;
+    std::string error;
+
+    void start_stream() {
+        // Smallest multiple of block_samples whose byte size is a multiple
+        // of the alignment
+        const size_t sample_bytes = iq_sample_bytes(meta.format);
+        block_size = config.block_samples;
+        while ((block_size * sample_bytes) % config.alignment != 0) ++block_size;
+        position = 0;
+        released_bytes = 0;
+        if (config.huge_pages) file.request_huge_pages();
+        if (config.readahead_blocks > 0) file.prefetch(0, config.readahead_blocks * block_size * sample_bytes);
+    }
+
+    bool open_sigmf(const std::string& base) {
+        MappedFile meta_file(base + ".sigmf-meta");
+        if (!meta_file.good()) {
+            error = "cannot open " + base + ".sigmf-meta";
+            return false;
+        }
+        const std::string json(meta_file.data() ? meta_file.data() : "", meta_file.size());
+
+        std::string datatype;
+        IQFormat format;
+        if (!json_string(json, "core:datatype", datatype) || !parse_iq_format(datatype, format)) {
+            error = "unsupported SigMF datatype '" + datatype + "' (complex little-endian cf32, cf64, ci16 or cu8)";
+            return false;
+        }
+        double sample_rate = 0.0, frequency = 0.0;
+        json_number(json, "core:sample_rate", sample_rate);
+        json_number(json, "core:frequency", frequency);  // first capture segment
+        if (!open_raw(base + ".sigmf-data", format, sample_rate, frequency)) return false;
+        meta.datatype = datatype;
+        return true;
+    }
+
+    static bool ends_with(const std::string& s, const char* suffix) {
+        size_t n = std::strlen(suffix);
+        return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+    }
+
+    // Value of the first "key": in the document. SigMF keys are unique
+    // within an object, and the two read from captures sit in its first
+    // segment, so a flat scan is enough here.
+    static size_t find_value(const std::string& json, const std::string& key) {
+        size_t pos = json.find("\"" + key + "\"");
+        if (pos == std::string::npos) return pos;
+        pos = json.find(':', pos + key.size() + 2);
+        if (pos == std::string::npos) return pos;
+        return json.find_first_not_of(" \t\r\n", pos + 1);
+    }
+
+    static bool json_string(const std::string& json, const std::string& key, std::string& out) {
+        size_t pos = find_value(json, key);
+        if (pos == std::string::npos || json[pos] != '"') return false;
+        size_t end = json.find('"', pos + 1);
+        if (end == std::string::npos) return false;
+        out = json.substr(pos + 1, end - pos - 1);
+        return true;
+    }
+
+    static bool json_number(const std::string& json, const std::string& key, double& out) {
+        size_t pos = find_value(json, key);
+        if (pos == std::string::npos) return false;
+        const char* begin = json.c_str() + pos;
+        char* end = nullptr;
+        double v = std::strtod(begin, &end);
+        if (end == begin) return false;
+        out = v;
+        return true;
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // IQ_FILE_READER_H
@@ -0,0 +1,458 @@
+#ifndef IQ_RECORDER_H
+#define IQ_RECORDER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include "iq_file_reader.h"
+#include "metrics_registry.h"
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace SatelliteSignal {
+
+// Records IQ samples to a SigMF recording (base.sigmf-data plus
+// base.sigmf-meta) without blocking the thread that produces them.
+//
+// The producer converts samples into one of a fixed pool of page-aligned
+// buffers. Full buffers go to a dedicated writer thread through a
+// lock-free single-producer/single-consumer ring, and come back through a
+// second ring once written. The writer issues one large write per buffer,
+// with O_DIRECT where the file system allows it, bypassing the page cache.
+//
+// When the disk falls behind and no buffer is free, write() drops the
+// samples instead of waiting. It counts them, marks the gap as a SigMF
+// annotation and reports false. queued_blocks() gives the backlog for
+// callers that want to shed load earlier.
+//
+// One thread may call write(); open() and close() must not run concurrently
+// with it.
+class IQRecorder {
+public:
+    struct Config {
+        IQFormat format = IQFormat::CF32;
+        double sample_rate = 0.0;       // Hz, for the metadata
+        double center_frequency = 0.0;  // Hz, for the metadata
+        std::string description;
+        size_t block_bytes = 1 << 20;   // per buffer, rounded up to whole pages
+        size_t buffers = 8;             // pool size
+        bool direct_io = true;          // fall back to buffered writes if refused
+    };
+
+    struct Stats {
+        uint64_t samples_recorded = 0;
+        uint64_t samples_dropped = 0;
+        uint64_t blocks_written = 0;
+        uint64_t bytes_written = 0;
+        uint64_t write_errors = 0;
+        size_t max_queued_blocks = 0;   // high-water mark of the backlog
+        bool direct_io = false;         // O_DIRECT in effect
+    };
+
+    // Samples lost to a full pool, before file sample `sample_start`
+    struct Gap {
+        uint64_t sample_start;
+        uint64_t dropped;
+    };
+
+    static constexpr size_t PAGE = 4096;
+    static constexpr size_t MAX_GAPS = 1024;
+
+    IQRecorder() : IQRecorder(Config()) {}
+    explicit IQRecorder(const Config& cfg) : config(cfg) {
+        config.buffers = std::max<size_t>(config.buffers, 2);
+        config.block_bytes = std::max(PAGE, (config.block_bytes + PAGE - 1) / PAGE * PAGE);
+    }
+
+    ~IQRecorder() { close(); }
+
+    IQRecorder(const IQRecorder&) = delete;
+    IQRecorder& operator=(const IQRecorder&) = delete;
+
+    // Start a recording at base.sigmf-data; the metadata is written by close()
+    bool open(const std::string& base) {
+        close();
+        base_path = base;
+        error.clear();
+        stats_direct = false;
+        if (!open_data(base + ".sigmf-data")) {
+            error = "cannot create " + base + ".sigmf-data";
+            return false;
+        }
+
+        storage.assign(config.buffers * config.block_bytes + PAGE, 0);
+        char* p = storage.data();
+        pool = p + (PAGE - reinterpret_cast<uintptr_t>(p) % PAGE) % PAGE;
+        used.assign(config.buffers, 0);
+        free_ring.reset(config.buffers);
+        full_ring.reset(config.buffers);
+        for (uint32_t i = 0; i < config.buffers; ++i) free_ring.push(i);
+
+        current = NONE;
+        fill = 0;
+        gaps.clear();
+        gaps.reserve(MAX_GAPS);
+        recorded.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        blocks.store(0, std::memory_order_relaxed);
+        bytes.store(0, std::memory_order_relaxed);
+        errors.store(0, std::memory_order_relaxed);
+        max_queued.store(0, std::memory_order_relaxed);
+        start_time = std::time(nullptr);
+        stopping.store(false, std::memory_order_relaxed);
+        writer = std::thread([this] { write_loop(); });
+        return true;
+    }
+
+    bool is_open() const { return writer.joinable(); }
+
+    // Convert and queue `n` samples; false if some were dropped because
+    // every buffer was waiting for the disk. Never blocks.
+    bool write(const ComplexSample* samples, size_t n) {
+        if (!is_open()) return false;
+        const size_t sample_bytes = iq_sample_bytes(config.format);
+        while (n > 0) {
+            if (current == NONE && !free_ring.pop(current)) {
+                drop(n);
+                return false;
+            }
+            const size_t take = std::min(n, (config.block_bytes - fill) / sample_bytes);
+            encode(samples, take, pool + current * config.block_bytes + fill);
+            fill += take * sample_bytes;
+            samples += take;
+            n -= take;
+            recorded.fetch_add(take, std::memory_order_relaxed);
+            if (config.block_bytes - fill < sample_bytes) submit();
+        }
+        return true;
+    }
+
+    bool write(const std::vector<ComplexSample>& samples) { return write(samples.data(), samples.size()); }
+
+    // Count drops in `counter` as well, e.g. ReceiverMetrics::overflow_drops
+    void set_drop_counter(Counter* counter) { drop_counter = counter; }
+
+    // Buffers waiting for or being written to disk
+    size_t queued_blocks() const { return full_ring.size(); }
+
+    // Flush the partial buffer, stop the writer and write the metadata
+    bool close() {
+        if (!is_open()) return false;
+        if (current != NONE && fill > 0) submit();
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+        finish_data();
+        return write_metadata() && errors.load(std::memory_order_relaxed) == 0;
+    }
+
+    Stats get_stats() const {
+        Stats s;
+        s.samples_recorded = recorded.load(std::memory_order_relaxed);
+        s.samples_dropped = dropped.load(std::memory_order_relaxed);
+        s.blocks_written = blocks.load(std::memory_order_relaxed);
+        s.bytes_written = bytes.load(std::memory_order_relaxed);
+        s.write_errors = errors.load(std::memory_order_relaxed);
+        s.max_queued_blocks = max_queued.load(std::memory_order_relaxed);
+        s.direct_io = stats_direct;
+        return s;
+    }
+
+    const std::vector<Gap>& get_gaps() const { return gaps; }
+    const std::string& get_error() const { return error; }
+    const Config& get_config() const { return config; }
+
+    static const char* sigmf_datatype(IQFormat format) {
+        switch (format) {
+            case IQFormat::CF32: return "cf32_le";
+            case IQFormat::CF64: return "cf64_le";
+            case IQFormat::CS16: return "ci16_le";
+            case IQFormat::CU8: return "cu8";
+        }
+        return "";
+    }
+
+private:
+    // Lock-free ring of buffer indices with one pushing and one popping
+    // thread
+    class IndexRing {
+    public:
+        void reset(size_t capacity) {
+            size_t n = 1;
+            while (n < capacity) n <<= 1;
+            slots.assign(n, 0);
+            mask = n - 1;
+            head.store(0, std::memory_order_relaxed);
+            tail.store(0, std::memory_order_relaxed);
+        }
+
+        bool push(uint32_t v) {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            if (t - head.load(std::memory_order_acquire) == slots.size()) return false;
+            slots[t & mask] = v;
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(uint32_t& v) {
+            const size_t h = head.load(std::memory_order_relaxed);
+            if (h == tail.load(std::memory_order_acquire)) return false;
+            v = slots[h & mask];
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t size() const {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::vector<uint32_t> slots;
+        size_t mask = 0;
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+    };
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    Config config;
+    std::string base_path;
+    std::string error;
+
+    // Buffer pool; `used` is written by the producer before a buffer is
+    // pushed and read by the writer after it pops it
+    std::vector<char> storage;
+    char* pool = nullptr;
+    std::vector<size_t> used;
+    IndexRing free_ring;  // writer -> producer
+    IndexRing full_ring;  // producer -> writer
+
+    // Producer state
+    uint32_t current = NONE;
+    size_t fill = 0;
+    std::vector<Gap> gaps;
+    Counter* drop_counter = nullptr;
+
+    std::atomic<uint64_t> recorded{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> blocks{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<size_t> max_queued{0};
+    std::atomic<bool> stopping{false};
+    std::time_t start_time = 0;
+    bool stats_direct = false;
+    std::thread writer;
+    int fd = -1;
+
+    void submit() {
+        used[current] = fill;
+        full_ring.push(current);  // cannot fail: the ring holds the whole pool
+        const size_t queued = full_ring.size();
+        if (queued > max_queued.load(std::memory_order_relaxed)) {
+            max_queued.store(queued, std::memory_order_relaxed);
+        }
+        current = NONE;
+        fill = 0;
+    }
+
+    void drop(size_t n) {
+        dropped.fetch_add(n, std::memory_order_relaxed);
+        if (drop_counter) drop_counter->inc(n);
+        const uint64_t at = recorded.load(std::memory_order_relaxed);
+        if (!gaps.empty() && gaps.back().sample_start == at) {
+            gaps.back().dropped += n;
+        } else if (gaps.size() < MAX_GAPS) {
+            gaps.push_back({at, n});
+        }
+    }
+
+    void encode(const ComplexSample* in, size_t n, char* out) const {
+        switch (config.format) {
+            case IQFormat::CF32: {
+                float* f = reinterpret_cast<float*>(out);
+                for (size_t i = 0; i < n; ++i) {
+                    f[2 * i] = static_cast<float>(in[i].real());
+                    f[2 * i + 1] = static_cast<float>(in[i].imag());
+                }
+                break;
+            }
+            case IQFormat::CF64:
+                std::memcpy(out, in, n * sizeof(ComplexSample));
+                break;
+            case IQFormat::CS16: {
+                int16_t* s = reinterpret_cast<int16_t*>(out);
+                for (size_t i = 0; i < n; ++i) {
+                    s[2 * i] = to_int16(in[i].real());
+                    s[2 * i + 1] = to_int16(in[i].imag());
+                }
+                break;
+            }
+            case IQFormat::CU8: {
+                uint8_t* u = reinterpret_cast<uint8_t*>(out);
+                for (size_t i = 0; i < n; ++i) {
+                    u[2 * i] = to_uint8(in[i].real());
+                    u[2 * i + 1] = to_uint8(in[i].imag());
+                }
+                break;
+            }
+        }
+    }
+
+    // Inverses of IQFileReader::to_complex, saturating
+    static int16_t to_int16(double v) {
+        return static_cast<int16_t>(std::lround(std::min(32767.0, std::max(-32768.0, v * 32768.0))));
+    }
+
+    static uint8_t to_uint8(double v) {
+        return static_cast<uint8_t>(std::lround(std::min(255.0, std::max(0.0, v * 127.5 + 127.5))));
+    }
+
+    void write_loop() {
+        uint32_t index;
+        for (;;) {
+            if (!full_ring.pop(index)) {
+                // The producer submits its last buffer before raising the
+                // flag, so one more look after seeing it drains the queue
+                if (!stopping.load(std::memory_order_acquire)) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                    continue;
+                }
+                if (!full_ring.pop(index)) return;
+            }
+            write_block(pool + index * config.block_bytes, used[index]);
+            free_ring.push(index);
+        }
+    }
+
+    void write_block(const char* data, size_t length) {
+        // Direct I/O needs whole pages; the tail of the last buffer is
+        // zero-padded here and truncated away in finish_data()
+        size_t padded = length;
+        if (stats_direct && length % PAGE != 0) {
+            padded = (length + PAGE - 1) / PAGE * PAGE;
+            std::memset(const_cast<char*>(data) + length, 0, padded - length);
+        }
+        if (!write_all(data, padded)) {
+            errors.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        blocks.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(length, std::memory_order_relaxed);
+    }
+
+#ifdef _WIN32
+    bool open_data(const std::string& path) {
+        fd = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+        return fd >= 0;
+    }
+
+    bool write_all(const char* data, size_t length) {
+        while (length > 0) {
+            int n = _write(fd, data, static_cast<unsigned>(std::min<size_t>(length, 1u << 30)));
+            if (n <= 0) return false;
+            data += n;
+            length -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    void finish_data() {
+        if (fd < 0) return;
+        _chsize_s(fd, static_cast<long long>(bytes.load()));
+        _close(fd);
+        fd = -1;
+    }
+#else
+    bool open_data(const std::string& path) {
+        const int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+        if (config.direct_io) {
+            fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+            if (fd >= 0) {
+                stats_direct = true;
+                return true;
+            }
+        }
+#endif
+        fd = ::open(path.c_str(), flags, 0644);
+#if defined(F_NOCACHE)
+        if (fd >= 0 && config.direct_io) fcntl(fd, F_NOCACHE, 1);
+#endif
+        return fd >= 0;
+    }
+
+    bool write_all(const char* data, size_t length) {
+        while (length > 0) {
+            ssize_t n = ::write(fd, data, length);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            data += n;
+            length -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    void finish_data() {
+        if (fd < 0) return;
+        if (ftruncate(fd, static_cast<off_t>(bytes.load())) != 0) errors.fetch_add(1);
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+
+    bool write_metadata() const {
+        std::ofstream meta(base_path + ".sigmf-meta");
+        if (!meta.is_open()) return false;
+        char datetime[32];
+        std::strftime(datetime, sizeof(datetime), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&start_time));
+
+        meta << std::setprecision(17);
+        meta << "{\n  \"global\": {\n";
+        meta << "    \"core:datatype\": \"" << sigmf_datatype(config.format) << "\",\n";
+        if (config.sample_rate > 0.0) meta << "    \"core:sample_rate\": " << config.sample_rate << ",\n";
+        if (!config.description.empty()) meta << "    \"core:description\": \"" << escape(config.description) << "\",\n";
+        meta << "    \"core:recorder\": \"satellite_signal IQRecorder\",\n";
+        meta << "    \"core:version\": \"1.0.0\"\n  },\n";
+        meta << "  \"captures\": [\n    {\"core:sample_start\": 0";
+        if (config.center_frequency != 0.0) meta << ", \"core:frequency\": " << config.center_frequency;
+        meta << ", \"core:datetime\": \"" << datetime << "\"}\n  ],\n";
+        meta << "  \"annotations\": [";
+        for (size_t i = 0; i < gaps.size(); ++i) {
+            meta << (i ? ",\n" : "\n") << "    {\"core:sample_start\": " << gaps[i].sample_start
+                 << ", \"core:comment\": \"" << gaps[i].dropped
+                 << " samples dropped here: recorder buffers full\"}";
+        }
+        meta << (gaps.empty() ? "]\n}\n" : "\n  ]\n}\n");
+        return static_cast<bool>(meta);
+    }
+
+    static std::string escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out += c;
+        }
+        return out;
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // IQ_RECORDER_H
@@ -0,0 +1,172 @@
+#ifndef ISL_ANALYZER_H
+#define ISL_ANALYZER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "orbital_types.h"
+#include "catalog_propagator.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Inter-satellite link geometry for a whole constellation at one epoch.
+// Positions are bucketed into a uniform grid of cubes at least one maximum
+// range on a side (counting sort, positions stored in cell order), so each
+// satellite only tests the satellites in its own and the 26 neighbouring
+// cells; cells adjacent along z are contiguous, so that is nine runs. A pair
+// is linked when it is within range and the straight line between them stays
+// above the Earth plus a grazing altitude. Satellites are split across worker
+// threads and the result is a flat list of index pairs grouped by ascending
+// first index.
+class ISLAnalyzer {
+public:
+    struct Config {
+        double max_range_km = 5000.0;
+        double grazing_altitude_km = 100.0;  // line of sight must clear this
+        unsigned num_threads = 0;            // 0 = all cores
+        size_t grain = 256;                  // satellites per work item
+    };
+
+    struct Link {
+        uint32_t a, b;                       // satellite indices, a < b
+        float range_km;
+    };
+
+    ISLAnalyzer() : ISLAnalyzer(Config()) {}
+    explicit ISLAnalyzer(const Config& cfg) : config(cfg) {}
+
+    void analyze(const CatalogPropagator::States& states, std::vector<Link>& out) {
+        analyze(states.x.data(), states.y.data(), states.z.data(), states.size(), out);
+    }
+
+    void analyze(const double* x, const double* y, const double* z, size_t count, std::vector<Link>& out) {
+        out.clear();
+        if (count < 2) return;
+        bin(x, y, z, count);
+
+        const double range2 = config.max_range_km * config.max_range_km;
+        const double clear = WGS84_A_KM + config.grazing_altitude_km;
+        const double clear2 = clear * clear;
+        const size_t grain = std::max<size_t>(1, config.grain);
+        chunks.resize((count + grain - 1) / grain);
+        for (auto& c : chunks) c.clear();
+
+        // Satellites are visited in index order and each chunk writes its own
+        // list, so concatenating the chunks groups links by ascending a
+        parallel_for(count, [&](size_t begin, size_t end, unsigned) {
+            std::vector<Link>& links = chunks[begin / grain];
+            for (size_t id = begin; id < end; ++id) {
+                const size_t slot = slot_of[id];
+                const double ax = sx[slot], ay = sy[slot], az = sz[slot];
+                const long cx = cell_x[slot], cy = cell_y[slot], cz = cell_z[slot];
+
+                for (long i = std::max(0L, cx - 1); i <= std::min(dims[0] - 1, cx + 1); ++i) {
+                    for (long j = std::max(0L, cy - 1); j <= std::min(dims[1] - 1, cy + 1); ++j) {
+                        long k0 = std::max(0L, cz - 1), k1 = std::min(dims[2] - 1, cz + 1);
+                        size_t row = static_cast<size_t>((i * dims[1] + j) * dims[2]);
+                        // Cells along z are adjacent in storage: one run,
+                        // range-tested a block at a time in a loop that
+                        // vectorizes
+                        const uint32_t run_end = cell_start[row + k1 + 1];
+                        for (uint32_t o = cell_start[row + k0]; o < run_end; o += BLOCK) {
+                            const uint32_t n = std::min<uint32_t>(BLOCK, run_end - o);
+                            double d2[BLOCK];
+                            for (uint32_t m = 0; m < n; ++m) {
+                                double dx = sx[o + m] - ax, dy = sy[o + m] - ay, dz = sz[o + m] - az;
+                                d2[m] = dx * dx + dy * dy + dz * dz;
+                            }
+                            for (uint32_t m = 0; m < n; ++m) {
+                                if (d2[m] > range2 || ids[o + m] <= id) continue;
+                                double dx = sx[o + m] - ax, dy = sy[o + m] - ay, dz = sz[o + m] - az;
+                                if (!clears_earth(ax, ay, az, dx, dy, dz, d2[m], clear2)) continue;
+                                links.push_back({static_cast<uint32_t>(id), ids[o + m],
+                                                 static_cast<float>(std::sqrt(d2[m]))});
+                            }
+                        }
+                    }
+                }
+            }
+        }, grain, config.num_threads);
+
+        size_t total = 0;
+        for (const auto& c : chunks) total += c.size();
+        out.reserve(total);
+        for (const auto& c : chunks) out.insert(out.end(), c.begin(), c.end());
+    }
+
+    // Segment from p to p + d stays outside the sphere of radius sqrt(clear2)
+    static bool clears_earth(double px, double py, double pz, double dx, double dy, double dz,
+                             double d2, double clear2) {
+        double t = -(px * dx + py * dy + pz * dz) / d2;
+        t = std::min(1.0, std::max(0.0, t));
+        double qx = px + t * dx, qy = py + t * dy, qz = pz + t * dz;
+        return qx * qx + qy * qy + qz * qz >= clear2;
+    }
+
+    const Config& get_config() const { return config; }
+
+private:
+    static constexpr uint32_t BLOCK = 64;
+
+    Config config;
+    long dims[3] = {1, 1, 1};
+    std::vector<uint32_t> cell_start;   // CSR offsets into ids
+    std::vector<uint32_t> ids;          // in cell order
+    std::vector<uint32_t> slot_of;      // cell-order slot of each satellite
+    std::vector<double> sx, sy, sz;
+    std::vector<int32_t> cell_x, cell_y, cell_z;
+    std::vector<std::vector<Link>> chunks;  // per work item, reused across epochs
+
+    void bin(const double* x, const double* y, const double* z, size_t count) {
+        double lo[3] = {x[0], y[0], z[0]}, hi[3] = {x[0], y[0], z[0]};
+        for (size_t i = 1; i < count; ++i) {
+            lo[0] = std::min(lo[0], x[i]); hi[0] = std::max(hi[0], x[i]);
+            lo[1] = std::min(lo[1], y[i]); hi[1] = std::max(hi[1], y[i]);
+            lo[2] = std::min(lo[2], z[i]); hi[2] = std::max(hi[2], z[i]);
+        }
+        // Cells at least one maximum range wide; sparse catalogs with a
+        // short range get larger cells so the grid stays O(count)
+        double size = config.max_range_km;
+        for (;;) {
+            for (int a = 0; a < 3; ++a) {
+                dims[a] = std::max(1L, static_cast<long>((hi[a] - lo[a]) / size) + 1);
+            }
+            if (static_cast<double>(dims[0]) * dims[1] * dims[2] <= 2.0 * count + 64.0) break;
+            size *= 1.25;
+        }
+        const double inv = 1.0 / size;
+
+        std::vector<uint32_t> cell(count);
+        cell_start.assign(static_cast<size_t>(dims[0] * dims[1] * dims[2]) + 1, 0);
+        for (size_t i = 0; i < count; ++i) {
+            long cx = std::min(dims[0] - 1, static_cast<long>((x[i] - lo[0]) * inv));
+            long cy = std::min(dims[1] - 1, static_cast<long>((y[i] - lo[1]) * inv));
+            long cz = std::min(dims[2] - 1, static_cast<long>((z[i] - lo[2]) * inv));
+            cell[i] = static_cast<uint32_t>((cx * dims[1] + cy) * dims[2] + cz);
+            ++cell_start[cell[i] + 1];
+        }
+        for (size_t c = 1; c < cell_start.size(); ++c) cell_start[c] += cell_start[c - 1];
+
+        ids.resize(count);
+        slot_of.resize(count);
+        sx.resize(count); sy.resize(count); sz.resize(count);
+        cell_x.resize(count); cell_y.resize(count); cell_z.resize(count);
+        std::vector<uint32_t> fill(cell_start.begin(), cell_start.end() - 1);
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t slot = fill[cell[i]]++;
+            ids[slot] = static_cast<uint32_t>(i);
+            slot_of[i] = slot;
+            sx[slot] = x[i]; sy[slot] = y[i]; sz[slot] = z[i];
+            cell_x[slot] = static_cast<int32_t>(cell[i] / (dims[1] * dims[2]));
+            cell_y[slot] = static_cast<int32_t>(cell[i] / dims[2] % dims[1]);
+            cell_z[slot] = static_cast<int32_t>(cell[i] % dims[2]);
+        }
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // ISL_ANALYZER_H
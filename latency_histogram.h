@@ -0,0 +1,171 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace SatelliteSignal {
+
+// High-dynamic-range latency histogram in nanoseconds. Buckets are
+// log-linear: each power of two from 1 ns up to Config::highest_ns is split
+// into the same number of linear sub-buckets, so every recorded value keeps
+// the configured number of significant digits whether it is 40 ns or 40 s.
+// Memory is fixed at construction (about 32 KiB with the defaults) no
+// matter how many values are recorded.
+//
+// Recording is not synchronized: give each thread its own histogram and
+// merge() them afterwards. Values above highest_ns are counted in the top
+// bucket, where percentiles report max(); min() and max() stay exact.
+class LatencyHistogram {
+public:
+    struct Config {
+        uint64_t highest_ns = 60000000000ULL;  // 60 s
+        int significant_digits = 2;            // 1 to 5
+    };
+
+    LatencyHistogram() : LatencyHistogram(Config()) {}
+    explicit LatencyHistogram(const Config& cfg) : config(cfg) {
+        const int digits = std::min(5, std::max(1, config.significant_digits));
+        config.significant_digits = digits;
+        config.highest_ns = std::max<uint64_t>(config.highest_ns, 2);
+
+        // Enough linear sub-buckets per power of two to resolve one unit in
+        // the last significant digit
+        uint64_t resolution = 2;
+        for (int d = 0; d < digits; ++d) resolution *= 10;
+        sub_bucket_bits = 1;
+        while ((uint64_t(1) << sub_bucket_bits) < resolution) ++sub_bucket_bits;
+        sub_bucket_half = size_t(1) << (sub_bucket_bits - 1);
+
+        counts.assign(index_of(config.highest_ns) + 1, 0);
+    }
+
+    const Config& get_config() const { return config; }
+
+    void record(uint64_t value_ns, uint64_t n = 1) {
+        if (n == 0) return;
+        size_t i = std::min(index_of(value_ns), counts.size() - 1);
+        counts[i] += n;
+        total += n;
+        sum += static_cast<double>(value_ns) * n;
+        sum_squares += static_cast<double>(value_ns) * value_ns * n;
+        min_value = std::min(min_value, value_ns);
+        max_value = std::max(max_value, value_ns);
+    }
+
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> d) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        record(static_cast<uint64_t>(std::max<decltype(ns)>(ns, 0)));
+    }
+
+    // Add the counts of `other`; false (and nothing added) if the two were
+    // built with different configurations
+    bool merge(const LatencyHistogram& other) {
+        if (other.counts.size() != counts.size() || other.sub_bucket_bits != sub_bucket_bits) return false;
+        for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+        total += other.total;
+        sum += other.sum;
+        sum_squares += other.sum_squares;
+        min_value = std::min(min_value, other.min_value);
+        max_value = std::max(max_value, other.max_value);
+        return true;
+    }
+
+    void reset() {
+        std::fill(counts.begin(), counts.end(), 0);
+        total = 0;
+        sum = sum_squares = 0.0;
+        min_value = std::numeric_limits<uint64_t>::max();
+        max_value = 0;
+    }
+
+    uint64_t count() const { return total; }
+    bool empty() const { return total == 0; }
+    uint64_t min() const { return total ? min_value : 0; }
+    uint64_t max() const { return max_value; }
+    double mean() const { return total ? sum / total : 0.0; }
+
+    double stddev() const {
+        if (total == 0) return 0.0;
+        double m = mean();
+        return std::sqrt(std::max(0.0, sum_squares / total - m * m));
+    }
+
+    // Smallest recorded value such that at least p percent of the values
+    // are at or below it, to within the histogram's precision: the top of
+    // the bucket holding that rank, clamped to the exact min and max
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        p = std::min(100.0, std::max(0.0, p));
+        uint64_t rank = static_cast<uint64_t>(std::ceil(p / 100.0 * total));
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                if (i + 1 == counts.size()) return max_value;  // may hold values past the range
+                return std::min(max_value, std::max(min_value, highest_equivalent(i)));
+            }
+        }
+        return max_value;
+    }
+
+    double percentile_ms(double p) const { return percentile(p) * 1e-6; }
+
+    size_t bucket_count() const { return counts.size(); }
+    uint64_t bucket(size_t i) const { return counts[i]; }
+
+    // Lowest and highest value that share bucket `i`
+    uint64_t lowest_equivalent(size_t i) const {
+        if (i < 2 * sub_bucket_half) return i;
+        size_t bucket = (i >> (sub_bucket_bits - 1)) - 1;
+        uint64_t sub = (i & (sub_bucket_half - 1)) + sub_bucket_half;
+        return sub << bucket;
+    }
+
+    uint64_t highest_equivalent(size_t i) const {
+        size_t bucket = i < 2 * sub_bucket_half ? 0 : (i >> (sub_bucket_bits - 1)) - 1;
+        return lowest_equivalent(i) + ((uint64_t(1) << bucket) - 1);
+    }
+
+    // Bucket holding `value_ns`, before clamping to the configured range
+    size_t index_of(uint64_t value_ns) const {
+        // Values below 2 * sub_bucket_half are stored exactly in bucket 0
+        int msb = highest_bit(value_ns | (2 * sub_bucket_half - 1));
+        int bucket = msb - static_cast<int>(sub_bucket_bits) + 1;
+        uint64_t sub = value_ns >> bucket;
+        return (static_cast<size_t>(bucket) << (sub_bucket_bits - 1)) + static_cast<size_t>(sub);
+    }
+
+private:
+    Config config;
+    int sub_bucket_bits = 1;
+    size_t sub_bucket_half = 1;
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    uint64_t min_value = std::numeric_limits<uint64_t>::max();
+    uint64_t max_value = 0;
+
+    static int highest_bit(uint64_t v) {
+        int bit = 0;
+        for (int shift = 32; shift > 0; shift >>= 1) {
+            if (v >> shift) {
+                v >>= shift;
+                bit += shift;
+            }
+        }
+        return bit;
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,182 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SatelliteSignal {
+
+// Read-only memory mapping of a whole file. Empty files map to a null view
+// with size() == 0 and still count as open.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { take(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            take(other);
+        }
+        return *this;
+    }
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_handle, &file_size)) {
+            close();
+            return false;
+        }
+        length = static_cast<size_t>(file_size.QuadPart);
+        is_open = true;
+        if (length == 0) return true;
+        mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle == nullptr) {
+            close();
+            return false;
+        }
+        view = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+        if (view == nullptr) {
+            close();
+            return false;
+        }
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close();
+            return false;
+        }
+        length = static_cast<size_t>(st.st_size);
+        is_open = true;
+        if (length == 0) return true;
+        void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close();
+            return false;
+        }
+        view = static_cast<const char*>(p);
+        madvise(p, length, MADV_SEQUENTIAL);
+#endif
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (view) UnmapViewOfFile(view);
+        if (mapping_handle) CloseHandle(mapping_handle);
+        if (file_handle != INVALID_HANDLE_VALUE) CloseHandle(file_handle);
+        mapping_handle = nullptr;
+        file_handle = INVALID_HANDLE_VALUE;
+#else
+        if (view) munmap(const_cast<char*>(view), length);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        view = nullptr;
+        length = 0;
+        is_open = false;
+    }
+
+    const char* data() const { return view; }
+    size_t size() const { return length; }
+    bool good() const { return is_open; }
+
+    // Paging hints for [offset, offset + bytes), widened to whole pages.
+    // They are advisory: false only means the hint was not taken, and on
+    // Windows the hints are no-ops.
+    bool prefetch(size_t offset, size_t bytes) const { return advise(offset, bytes, Hint::WillNeed); }
+
+    // Drop pages already consumed from this mapping; the page cache keeps
+    // them, so a long sequential read does not grow the resident set
+    bool release(size_t offset, size_t bytes) const { return advise(offset, bytes, Hint::DontNeed); }
+
+    // Ask for transparent huge pages behind the mapping. File-backed
+    // mappings only get them where the kernel supports read-only THP for
+    // the file system.
+    bool request_huge_pages() const { return advise(0, length, Hint::HugePages); }
+
+private:
+    const char* view = nullptr;
+    size_t length = 0;
+    bool is_open = false;
+#ifdef _WIN32
+    HANDLE file_handle = INVALID_HANDLE_VALUE;
+    HANDLE mapping_handle = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    enum class Hint { WillNeed, DontNeed, HugePages };
+
+    bool advise(size_t offset, size_t bytes, Hint hint) const {
+        if (view == nullptr || offset >= length) return false;
+        bytes = std::min(bytes, length - offset);
+#ifdef _WIN32
+        (void)hint;
+        return false;
+#else
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t begin = offset / page * page;
+        void* start = const_cast<char*>(view) + begin;
+        const size_t span = offset + bytes - begin;
+        switch (hint) {
+            case Hint::WillNeed: return madvise(start, span, MADV_WILLNEED) == 0;
+            case Hint::DontNeed: return madvise(start, span, MADV_DONTNEED) == 0;
+            case Hint::HugePages:
+#ifdef MADV_HUGEPAGE
+                return madvise(start, span, MADV_HUGEPAGE) == 0;
+#else
+                return false;
+#endif
+        }
+        return false;
+#endif
+    }
+
+    void take(MappedFile& other) {
+        view = other.view;
+        length = other.length;
+        is_open = other.is_open;
+#ifdef _WIN32
+        file_handle = other.file_handle;
+        mapping_handle = other.mapping_handle;
+        other.file_handle = INVALID_HANDLE_VALUE;
+        other.mapping_handle = nullptr;
+#else
+        fd = other.fd;
+        other.fd = -1;
+#endif
+        other.view = nullptr;
+        other.length = 0;
+        other.is_open = false;
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,374 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SatelliteSignal {
+
+// Live operational metrics for a running receiver: counters, gauges and
+// histograms registered once up front and updated from the hot path with
+// relaxed atomics, exported in the Prometheus text format.
+//
+// Counters and histograms are split across METRIC_SHARDS cache-line-sized
+// cells. Each thread is assigned a cell on first use, so threads updating
+// the same metric do not contend on one line; reads sum the cells.
+constexpr size_t METRIC_SHARDS = 16;
+
+namespace MetricCells {
+
+struct alignas(64) Cell {
+    std::atomic<uint64_t> value{0};
+};
+
+// Cell of the calling thread, assigned round-robin
+inline size_t shard() {
+    static std::atomic<size_t> next{0};
+    thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return index;
+}
+
+inline uint64_t to_bits(double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+inline double from_bits(uint64_t bits) {
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+inline void add_double(std::atomic<uint64_t>& target, double v) {
+    uint64_t old = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(old, to_bits(from_bits(old) + v), std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace MetricCells
+
+// Monotonically increasing count
+class Counter {
+public:
+    void inc(uint64_t n = 1) { cells[MetricCells::shard()].value.fetch_add(n, std::memory_order_relaxed); }
+
+    uint64_t value() const {
+        uint64_t total = 0;
+        for (const auto& c : cells) total += c.value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    std::array<MetricCells::Cell, METRIC_SHARDS> cells;
+};
+
+// Last value written
+class Gauge {
+public:
+    void set(double v) { bits.store(MetricCells::to_bits(v), std::memory_order_relaxed); }
+    double value() const { return MetricCells::from_bits(bits.load(std::memory_order_relaxed)); }
+
+private:
+    std::atomic<uint64_t> bits{0};  // 0.0
+};
+
+// Distribution over fixed upper bounds (Prometheus "le" buckets)
+class Histogram {
+public:
+    struct Snapshot {
+        std::vector<uint64_t> cumulative;  // per bound, then +Inf
+        uint64_t count = 0;
+        double sum = 0.0;
+    };
+
+    explicit Histogram(std::vector<double> upper_bounds) : bounds(std::move(upper_bounds)) {
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+        for (auto& s : shards) s.counts.reset(new std::atomic<uint64_t>[bounds.size() + 1]());
+    }
+
+    void observe(double v) {
+        size_t b = std::lower_bound(bounds.begin(), bounds.end(), v) - bounds.begin();
+        Shard& s = shards[MetricCells::shard()];
+        s.counts[b].fetch_add(1, std::memory_order_relaxed);
+        MetricCells::add_double(s.sum_bits, v);
+    }
+
+    const std::vector<double>& upper_bounds() const { return bounds; }
+
+    Snapshot snapshot() const {
+        Snapshot snap;
+        snap.cumulative.assign(bounds.size() + 1, 0);
+        for (const auto& s : shards) {
+            for (size_t b = 0; b <= bounds.size(); ++b) {
+                snap.cumulative[b] += s.counts[b].load(std::memory_order_relaxed);
+            }
+            snap.sum += MetricCells::from_bits(s.sum_bits.load(std::memory_order_relaxed));
+        }
+        for (size_t b = 1; b < snap.cumulative.size(); ++b) snap.cumulative[b] += snap.cumulative[b - 1];
+        snap.count = snap.cumulative.back();
+        return snap;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> counts;
+        std::atomic<uint64_t> sum_bits{0};
+    };
+
+    std::vector<double> bounds;
+    std::array<Shard, METRIC_SHARDS> shards;
+};
+
+// Owner of every metric. Registration takes a lock and returns a reference
+// that stays valid for the registry's lifetime; keep it and update through
+// it rather than looking metrics up by name on the hot path. Registering the
+// same name and labels again returns the existing metric.
+class MetricsRegistry {
+public:
+    // `labels` is the Prometheus label set without braces, e.g.
+    // decoder="ldpc"; metrics sharing a name are exported as one family
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "") {
+        return *find_or_add(name, help, labels, Type::Counter, {}).counter;
+    }
+
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "") {
+        return *find_or_add(name, help, labels, Type::Gauge, {}).gauge;
+    }
+
+    Histogram& histogram(const std::string& name, const std::string& help, const std::vector<double>& upper_bounds,
+                         const std::string& labels = "") {
+        return *find_or_add(name, help, labels, Type::Histogram, upper_bounds).histogram;
+    }
+
+    // Prometheus text exposition format 0.0.4
+    void write_prometheus(std::ostream& os) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<bool> written(entries.size(), false);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (written[i]) continue;
+            const Entry& family = *entries[i];
+            os << "# HELP " << family.name << " " << family.help << "\n";
+            os << "# TYPE " << family.name << " " << type_name(family.type) << "\n";
+            for (size_t j = i; j < entries.size(); ++j) {
+                if (written[j] || entries[j]->name != family.name) continue;
+                written[j] = true;
+                write_entry(os, *entries[j]);
+            }
+        }
+    }
+
+    // Write to `path` through a temporary file and a rename, so a scraper
+    // (such as node_exporter's textfile collector) never sees a partial file
+    bool export_prometheus(const std::string& path) const {
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream file(tmp);
+            if (!file.is_open()) return false;
+            write_prometheus(file);
+            if (!file) return false;
+        }
+        // POSIX rename replaces the target atomically; Windows refuses to
+        if (std::rename(tmp.c_str(), path.c_str()) == 0) return true;
+        std::remove(path.c_str());
+        return std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+private:
+    enum class Type { Counter, Gauge, Histogram };
+
+    struct Entry {
+        std::string name;
+        std::string help;
+        std::string labels;
+        Type type;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Entry>> entries;
+
+    Entry& find_or_add(const std::string& name, const std::string& help, const std::string& labels, Type type,
+                       const std::vector<double>& bounds) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& e : entries) {
+            if (e->name != name) continue;
+            if (e->type != type) throw std::invalid_argument("metric " + name + " registered with another type");
+            if (e->labels == labels) return *e;
+        }
+        std::unique_ptr<Entry> e(new Entry{name, help, labels, type, nullptr, nullptr, nullptr});
+        if (type == Type::Counter) e->counter.reset(new Counter());
+        if (type == Type::Gauge) e->gauge.reset(new Gauge());
+        if (type == Type::Histogram) e->histogram.reset(new Histogram(bounds));
+        entries.push_back(std::move(e));
+        return *entries.back();
+    }
+
+    static const char* type_name(Type t) {
+        switch (t) {
+            case Type::Counter: return "counter";
+            case Type::Gauge: return "gauge";
+            default: return "histogram";
+        }
+    }
+
+    static std::string format_value(double v) {
+        if (std::isnan(v)) return "NaN";
+        if (std::isinf(v)) return v > 0 ? "+Inf" : "-Inf";
+        // Shortest of 15 to 17 digits that reads back as the same double
+        std::string text;
+        for (int digits = 15; digits <= std::numeric_limits<double>::max_digits10; ++digits) {
+            std::ostringstream oss;
+            oss.precision(digits);
+            oss << v;
+            text = oss.str();
+            if (std::strtod(text.c_str(), nullptr) == v) break;
+        }
+        return text;
+    }
+
+    static std::string label_set(const std::string& labels, const std::string& extra = "") {
+        if (labels.empty() && extra.empty()) return "";
+        return "{" + labels + (labels.empty() || extra.empty() ? "" : ",") + extra + "}";
+    }
+
+    static void write_entry(std::ostream& os, const Entry& e) {
+        switch (e.type) {
+            case Type::Counter:
+                os << e.name << label_set(e.labels) << " " << e.counter->value() << "\n";
+                break;
+            case Type::Gauge:
+                os << e.name << label_set(e.labels) << " " << format_value(e.gauge->value()) << "\n";
+                break;
+            case Type::Histogram: {
+                auto snap = e.histogram->snapshot();
+                const auto& bounds = e.histogram->upper_bounds();
+                for (size_t b = 0; b <= bounds.size(); ++b) {
+                    std::string le = b < bounds.size() ? format_value(bounds[b]) : "+Inf";
+                    os << e.name << "_bucket" << label_set(e.labels, "le=\"" + le + "\"") << " "
+                       << snap.cumulative[b] << "\n";
+                }
+                os << e.name << "_sum" << label_set(e.labels) << " " << format_value(snap.sum) << "\n";
+                os << e.name << "_count" << label_set(e.labels) << " " << snap.count << "\n";
+                break;
+            }
+        }
+    }
+};
+
+// Background thread that rewrites a registry's Prometheus file every
+// interval, plus once more when stopped
+class MetricsExporter {
+public:
+    struct Config {
+        std::string path = "satellite_signal.prom";
+        double interval_seconds = 5.0;
+    };
+
+    MetricsExporter(const MetricsRegistry& reg, const Config& cfg)
+        : registry(reg), config(cfg), worker([this] { run(); }) {}
+
+    ~MetricsExporter() { stop(); }
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) return;
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+    }
+
+    uint64_t get_writes() const { return writes.load(std::memory_order_relaxed); }
+    uint64_t get_failures() const { return failures.load(std::memory_order_relaxed); }
+
+private:
+    const MetricsRegistry& registry;
+    Config config;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::atomic<uint64_t> writes{0};
+    std::atomic<uint64_t> failures{0};
+    std::thread worker;  // last, so it starts after the members it reads
+
+    void run() {
+        const auto interval = std::chrono::duration<double>(config.interval_seconds);
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            bool done = wake.wait_for(lock, interval, [this] { return stopping; });
+            lock.unlock();
+            (registry.export_prometheus(config.path) ? writes : failures).fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
+            if (done) return;
+        }
+    }
+};
+
+// The receiver's standard metric set, for the receive chain up to the
+// demodulated symbols
+struct ReceiverMetrics {
+    Counter& samples_processed;
+    Gauge& snr_db;
+    Gauge& carrier_locked;
+    Counter& overflow_drops;
+    Histogram& block_latency_seconds;
+
+    explicit ReceiverMetrics(MetricsRegistry& r)
+        : samples_processed(r.counter("satellite_signal_samples_processed_total",
+                                      "IQ samples through the receive chain")),
+          snr_db(r.gauge("satellite_signal_snr_db", "Latest SNR estimate in dB")),
+          carrier_locked(r.gauge("satellite_signal_carrier_locked", "1 while the signal analyzer reports lock")),
+          overflow_drops(r.counter("satellite_signal_overflow_drops_total",
+                                   "Samples dropped because a buffer was full")),
+          block_latency_seconds(r.histogram("satellite_signal_block_latency_seconds",
+                                            "Receive chain processing time per block",
+                                            {1e-4, 2.5e-4, 5e-4, 1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2, 0.1})) {}
+};
+
+// Metrics of an FEC decode stage. Registered only by receivers that decode,
+// so an exporter never shows counters that nothing updates.
+struct DecoderMetrics {
+    Counter& frames_decoded;
+    Counter& fec_corrections;
+
+    explicit DecoderMetrics(MetricsRegistry& r)
+        : frames_decoded(r.counter("satellite_signal_frames_decoded_total", "FEC frames decoded")),
+          fec_corrections(r.counter("satellite_signal_fec_corrections_total",
+                                    "Symbols or bits corrected by the FEC decoders")) {}
+
+    // One decoded frame and the symbols or bits its decoder corrected
+    void record_frame(uint64_t corrected) {
+        frames_decoded.inc();
+        if (corrected > 0) fec_corrections.inc(corrected);
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // METRICS_REGISTRY_H
@@ -0,0 +1,61 @@
+#ifndef ORBITAL_TYPES_H
+#define ORBITAL_TYPES_H
+
+#include <array>
+
+namespace SatelliteSignal {
+
+constexpr double EARTH_RADIUS_KM = 6371.0;
+constexpr double EARTH_MU = 398600.4418;  // GM in km^3/s^2
+constexpr double WGS84_A_KM = 6378.137;                // equatorial radius
+constexpr double WGS84_F = 1.0 / 298.257223563;        // flattening
+constexpr double EARTH_ROTATION_RATE = 7.292115e-5;    // rad/s
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double RAD_TO_DEG = 180.0 / 3.14159265358979323846;
+
+// Satellite position and velocity in ECI (Earth-Centered Inertial)
+struct StateVector {
+    double x, y, z;      // Position in km
+    double vx, vy, vz;   // Velocity in km/s
+};
+
+// Ground station location
+struct GroundStation {
+    double latitude;     // degrees
+    double longitude;    // degrees
+    double elevation;    // meters
+};
+
+// Topocentric view (from ground station perspective)
+struct TopocentricView {
+    double azimuth;      // degrees (0-360)
+    double elevation;    // degrees (-90 to +90)
+    double range;        // km
+    double range_rate;   // km/s (positive = receding)
+};
+
+// Two-Line Element (TLE) set for SGP4 propagation. Angles are in radians
+// and mean motion in revolutions per day.
+struct TLE {
+    std::array<char, 24> satellite_name;
+    long catalog_number;
+    int epoch_year;
+    double epoch_day;
+    double ndot;         // First derivative of mean motion
+    double nddot;        // Second derivative of mean motion
+    double bstar;        // Drag term
+    int element_set_num;
+    double mean_motion;
+    long element_number;
+    
+    // Orbital elements
+    double inclination;
+    double raan;         // Right ascension of ascending node
+    double eccentricity;
+    double argument_perigee;
+    double mean_anomaly;
+};
+
+}  // namespace SatelliteSignal
+
+#endif // ORBITAL_TYPES_H
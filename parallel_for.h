@@ -0,0 +1,75 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace SatelliteSignal {
+
+// Number of worker threads to use when the caller passes 0
+inline unsigned default_thread_count() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// Run body(begin, end, worker) over [0, count) split into chunks of `grain`
+// items. Workers pull chunks from a shared counter so uneven work balances
+// itself. Runs inline when only one worker is needed.
+template <typename Body>
+void parallel_for(size_t count, Body&& body, size_t grain = 1, unsigned num_threads = 0) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+    if (num_threads == 0) num_threads = default_thread_count();
+
+    size_t num_chunks = (count + grain - 1) / grain;
+    unsigned workers = static_cast<unsigned>(std::min<size_t>(num_threads, num_chunks));
+
+    if (workers <= 1) {
+        body(size_t(0), count, 0u);
+        return;
+    }
+
+    std::atomic<size_t> next_chunk(0);
+    auto worker_loop = [&](unsigned worker) {
+        for (;;) {
+            size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= num_chunks) break;
+            size_t begin = chunk * grain;
+            size_t end = std::min(count, begin + grain);
+            body(begin, end, worker);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (unsigned w = 1; w < workers; ++w) {
+        threads.emplace_back(worker_loop, w);
+    }
+    worker_loop(0);
+    for (auto& t : threads) t.join();
+}
+
+// Run body(worker) once on each of `num_threads` workers
+template <typename Body>
+void parallel_workers(unsigned num_threads, Body&& body) {
+    if (num_threads == 0) num_threads = default_thread_count();
+    if (num_threads == 1) {
+        body(0u);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (unsigned w = 1; w < num_threads; ++w) {
+        threads.emplace_back([&body, w]() { body(w); });
+    }
+    body(0u);
+    for (auto& t : threads) t.join();
+}
+
+}  // namespace SatelliteSignal
+
+#endif // PARALLEL_FOR_H
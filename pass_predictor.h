@@ -0,0 +1,315 @@
+#ifndef PASS_PREDICTOR_H
+#define PASS_PREDICTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "satellite_ephemeris.h"
+#include "station_frame.h"
+#include "root_finding.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Pass prediction (AOS, TCA, LOS) for many satellites over many stations.
+// Each satellite is sampled on an adaptive grid: one propagation per sample
+// serves all stations, and while the satellite is far from every station the
+// step grows to the time it needs to reach the edge of the nearest station's
+// visibility circle at its fastest ground-track rate. Near a station the step
+// is a fixed fraction of the orbital period. Local maxima of the sampled
+// elevation are refined with Brent's minimizer, so passes that peak between
+// samples are still found, and AOS/LOS are located by Brent's root finder
+// inside the bracketing samples. Satellites are processed in parallel.
+class PassPredictor {
+public:
+    struct Config {
+        double min_elevation_deg = 0.0;
+        double step_fraction = 1.0 / 24.0;     // coarse step, fraction of the period
+        double max_step_minutes = 10.0;
+        double time_tolerance_seconds = 0.1;   // AOS/LOS
+        double tca_tolerance_seconds = 1.0;    // elevation is flat at the peak
+        unsigned num_threads = 0;              // 0 = all cores
+        size_t grain = 4;                      // satellites per work item
+    };
+
+    struct Pass {
+        uint32_t satellite;
+        uint32_t station;
+        double aos, tca, los;                  // minutes after the window start
+        double max_elevation_deg;
+        double tca_range_acceleration;         // d(range rate)/dt at TCA, km/s^2
+        bool aos_clipped;                      // already in progress at the window start
+        bool los_clipped;                      // still in progress at the window end
+
+        double duration() const { return los - aos; }
+    };
+
+    PassPredictor() : PassPredictor(Config()) {}
+    explicit PassPredictor(const Config& cfg) : config(cfg) {}
+
+    size_t add_satellite(const TLE& tle) {
+        satellites.emplace_back(tle);
+        orbits.push_back(orbit_bounds(tle));
+        return satellites.size() - 1;
+    }
+
+    // Replace the elements of satellite `index`
+    void set_satellite(size_t index, const TLE& tle) {
+        satellites[index] = SatelliteEphemeris(tle);
+        orbits[index] = orbit_bounds(tle);
+    }
+
+    // Remove satellite `index`; the last satellite moves into its place
+    void remove_satellite(size_t index) {
+        if (index + 1 != satellites.size()) {
+            satellites[index] = std::move(satellites.back());
+            orbits[index] = orbits.back();
+        }
+        satellites.pop_back();
+        orbits.pop_back();
+    }
+
+    void add_satellites(const std::vector<TLE>& tles) {
+        satellites.reserve(satellites.size() + tles.size());
+        orbits.reserve(orbits.size() + tles.size());
+        for (const auto& tle : tles) add_satellite(tle);
+    }
+
+    size_t add_station(const GroundStation& station) {
+        stations.emplace_back(station);
+        const StationFrame& f = stations.back();
+        double r = std::sqrt(f.get_x() * f.get_x() + f.get_y() * f.get_y() + f.get_z() * f.get_z());
+        station_radius.push_back(r);
+        station_unit.push_back({f.get_x() / r, f.get_y() / r, f.get_z() / r});
+        return stations.size() - 1;
+    }
+
+    void clear() {
+        satellites.clear();
+        orbits.clear();
+    }
+
+    size_t satellite_count() const { return satellites.size(); }
+    size_t station_count() const { return stations.size(); }
+    const Config& get_config() const { return config; }
+
+    // Every pass in [start_jd, start_jd + duration_minutes), sorted by AOS
+    std::vector<Pass> predict(double start_jd, double duration_minutes) {
+        std::vector<std::vector<Pass>> per_satellite = predict_each(start_jd, duration_minutes);
+
+        std::vector<Pass> passes;
+        size_t total = 0;
+        for (const auto& p : per_satellite) total += p.size();
+        passes.reserve(total);
+        for (const auto& p : per_satellite) passes.insert(passes.end(), p.begin(), p.end());
+        std::stable_sort(passes.begin(), passes.end(),
+                         [](const Pass& a, const Pass& b) { return a.aos < b.aos; });
+        return passes;
+    }
+
+    // Same passes, one list per satellite
+    std::vector<std::vector<Pass>> predict_each(double start_jd, double duration_minutes) {
+        std::vector<std::vector<Pass>> per_satellite(satellites.size());
+        parallel_for(satellites.size(), [&](size_t begin, size_t end, unsigned) {
+            Samples samples;
+            for (size_t s = begin; s < end; ++s) {
+                predict_satellite(s, start_jd, duration_minutes, samples, per_satellite[s]);
+            }
+        }, config.grain, config.num_threads);
+        return per_satellite;
+    }
+
+    std::vector<Pass> predict(size_t satellite, double start_jd, double duration_minutes) {
+        Samples samples;
+        std::vector<Pass> passes;
+        predict_satellite(satellite, start_jd, duration_minutes, samples, passes);
+        return passes;
+    }
+
+private:
+    struct OrbitBounds {
+        double period;                         // minutes
+        double max_radius;                     // km
+        double max_rate;                       // deg/min
+    };
+
+    // Sample times plus, per station (sample-major), elevation above the mask
+    // and angular distance outside the visibility circle
+    struct Samples {
+        std::vector<double> times;
+        std::vector<double> elevation;
+        std::vector<double> gap;
+    };
+
+    Config config;
+    std::vector<SatelliteEphemeris> satellites;
+    std::vector<OrbitBounds> orbits;
+    std::vector<StationFrame> stations;
+    std::vector<double> station_radius;
+    std::vector<std::array<double, 3>> station_unit;
+
+    // Bounds used to skip ahead: apogee radius and the fastest angular rate
+    // of the sub-satellite point (perigee rate plus Earth rotation), both
+    // padded for perturbations
+    static OrbitBounds orbit_bounds(const TLE& tle) {
+        double n = tle.mean_motion * 2.0 * M_PI / 1440.0;  // rad/min
+        double e = tle.eccentricity;
+        double a = std::cbrt(EARTH_MU * 3600.0 / (n * n));
+        OrbitBounds bounds;
+        bounds.period = 1440.0 / tle.mean_motion;
+        bounds.max_radius = a * (1.0 + e) * 1.02 + 20.0;
+        bounds.max_rate = (n * (1.0 + e) * (1.0 + e) / std::pow(1.0 - e * e, 1.5) * 1.05 +
+                           EARTH_ROTATION_RATE * 60.0) * RAD_TO_DEG;
+        return bounds;
+    }
+
+    void predict_satellite(size_t s, double start_jd, double duration,
+                           Samples& samples, std::vector<Pass>& out) {
+        SatelliteEphemeris& eph = satellites[s];
+        const OrbitBounds& orbit = orbits[s];
+        const double offset = (start_jd - eph.get_propagator().get_epoch_jd()) * 1440.0;
+        const double step = std::min(config.max_step_minutes, orbit.period * config.step_fraction);
+        const size_t num_stations = stations.size();
+        const double tolerance = config.time_tolerance_seconds / 60.0;
+        const double tca_tolerance = config.tca_tolerance_seconds / 60.0;
+
+        // Earth central angle of each station's visibility circle at the
+        // apogee radius, with a degree of slack for the geodetic normal
+        std::vector<double> circle(num_stations);
+        const double mask = config.min_elevation_deg * DEG_TO_RAD;
+        for (size_t k = 0; k < num_stations; ++k) {
+            double c = std::min(1.0, station_radius[k] * std::cos(mask) / orbit.max_radius);
+            circle[k] = (std::acos(c) - mask) * RAD_TO_DEG + 1.0;
+        }
+
+        samples.times.clear();
+        samples.elevation.clear();
+        samples.gap.clear();
+        for (double t = 0.0;;) {
+            double m = offset + t;
+            StateVector pos = eph.get_position(m);
+            double gmst = eph.get_gmst(m);
+            double c = std::cos(gmst), sn = std::sin(gmst);
+            double ex = c * pos.x + sn * pos.y, ey = -sn * pos.x + c * pos.y, ez = pos.z;
+            double r = std::sqrt(ex * ex + ey * ey + ez * ez);
+
+            double next = duration;
+            samples.times.push_back(t);
+            for (size_t k = 0; k < num_stations; ++k) {
+                const auto& u = station_unit[k];
+                double cos_psi = (u[0] * ex + u[1] * ey + u[2] * ez) / r;
+                double gap = std::acos(std::max(-1.0, std::min(1.0, cos_psi))) * RAD_TO_DEG - circle[k];
+                samples.gap.push_back(gap);
+                samples.elevation.push_back(stations[k].view(pos, gmst).elevation - config.min_elevation_deg);
+                next = std::min(next, t + std::max(step, gap / orbit.max_rate));
+            }
+            if (t >= duration) break;
+            t = std::min(next, duration);
+        }
+        const size_t n = samples.times.size();
+        const double* times = samples.times.data();
+        auto time_at = [&](size_t i) { return times[i]; };
+
+        for (size_t k = 0; k < num_stations; ++k) {
+            auto f = [&](size_t i) { return samples.elevation[i * num_stations + k]; };
+            auto gap = [&](size_t i) { return samples.gap[i * num_stations + k]; };
+            auto elevation = [&](double t) {
+                double m = offset + t;
+                return stations[k].view(eph.get_position(m), eph.get_gmst(m)).elevation -
+                       config.min_elevation_deg;
+            };
+            const size_t first_pass = out.size();
+
+            for (size_t i = 0; i < n; ++i) {
+                double left = i > 0 ? f(i - 1) : -std::numeric_limits<double>::infinity();
+                double right = i + 1 < n ? f(i + 1) : -std::numeric_limits<double>::infinity();
+                if (!(f(i) >= left && f(i) > right)) continue;
+
+                // Skip maxima where the satellite cannot have entered the
+                // visibility circle between the neighbouring samples: moving
+                // at most max_rate, its angular distance over [t_a, t_b] stays
+                // above (gap_a + gap_b - max_rate * (t_b - t_a)) / 2
+                size_t lo_i = i > 0 ? i - 1 : 0, hi_i = std::min(i + 1, n - 1);
+                auto reach = [&](size_t a, size_t b) {
+                    return 0.5 * (gap(a) + gap(b) - orbit.max_rate * (time_at(b) - time_at(a)));
+                };
+                if (std::min(reach(lo_i, i), reach(i, hi_i)) > 0.0) continue;
+
+                // Refine the maximum between the neighbouring samples
+                double a = time_at(lo_i);
+                double b = time_at(hi_i);
+                auto best = brent_minimize([&](double t) { return -elevation(t); }, a, b, tca_tolerance);
+                double tca = best.first, peak = -best.second;
+                if (f(i) > peak) {
+                    tca = time_at(i);
+                    peak = f(i);
+                }
+                if (peak < 0.0) continue;
+
+                Pass pass;
+                pass.satellite = static_cast<uint32_t>(s);
+                pass.station = static_cast<uint32_t>(k);
+                pass.tca = tca;
+                pass.max_elevation_deg = peak + config.min_elevation_deg;
+
+                // AOS: last sample below the mask before TCA, then Brent
+                // between it and the next point above
+                long j = time_at(i) <= tca ? static_cast<long>(i) : static_cast<long>(i) - 1;
+                const long rising_start = j;
+                while (j >= 0 && f(j) >= 0.0) --j;
+                pass.aos_clipped = j < 0;
+                if (pass.aos_clipped) {
+                    pass.aos = 0.0;
+                } else {
+                    double hi = j < rising_start ? time_at(j + 1) : tca;
+                    double f_hi = j < rising_start ? f(j + 1) : peak;
+                    pass.aos = brent_root(elevation, time_at(j), hi, f(j), f_hi, tolerance);
+                }
+
+                // LOS: first sample below the mask after TCA
+                j = time_at(i) >= tca ? static_cast<long>(i) : static_cast<long>(i) + 1;
+                const long setting_start = j;
+                while (j < static_cast<long>(n) && f(j) >= 0.0) ++j;
+                pass.los_clipped = j >= static_cast<long>(n);
+                if (pass.los_clipped) {
+                    pass.los = duration;
+                } else {
+                    double lo = j > setting_start ? time_at(j - 1) : tca;
+                    double f_lo = j > setting_start ? f(j - 1) : peak;
+                    pass.los = brent_root(elevation, lo, time_at(j), f_lo, f(j), tolerance);
+                }
+
+                // Range acceleration at TCA sets the peak Doppler rate
+                const double dt = 1.0 / 60.0;
+                auto range_rate = [&](double t) {
+                    double m = offset + t;
+                    return stations[k].view(eph.get_position(m), eph.get_gmst(m)).range_rate;
+                };
+                pass.tca_range_acceleration = (range_rate(tca + dt) - range_rate(tca - dt)) / 2.0;
+
+                // Two maxima above the mask within one pass: keep one pass
+                if (out.size() > first_pass && out.back().los >= pass.aos) {
+                    Pass& prev = out.back();
+                    prev.los = std::max(prev.los, pass.los);
+                    prev.los_clipped = pass.los_clipped;
+                    if (pass.max_elevation_deg > prev.max_elevation_deg) {
+                        prev.tca = pass.tca;
+                        prev.max_elevation_deg = pass.max_elevation_deg;
+                        prev.tca_range_acceleration = pass.tca_range_acceleration;
+                    }
+                    continue;
+                }
+                out.push_back(pass);
+            }
+        }
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // PASS_PREDICTOR_H
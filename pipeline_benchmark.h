@@ -0,0 +1,227 @@
+#ifndef PIPELINE_BENCHMARK_H
+#define PIPELINE_BENCHMARK_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "signal_processor.h"
+#include "doppler_compensator.h"
+#include "allocation_tracker.h"
+#include "latency_histogram.h"
+#include "scoped_trace.h"
+
+namespace SatelliteSignal {
+
+// End-to-end timing of the receive chain the demo runs: QPSK source with
+// carrier offset and noise -> Doppler compensation -> lowpass FIR -> QPSK
+// demodulation -> signal analysis. A long stream is pushed through in
+// fixed-size blocks with every stage keeping its state across blocks, as a
+// live receiver would. The source stands in for the radio, so the real-time
+// factor counts only the four receive stages; its time is still reported
+// in the stage shares. When allocation tracking is built in, each stage
+// runs under its own AllocationScope and heap allocations per block are
+// reported per stage.
+class ReceiveChainBenchmark {
+public:
+    enum Stage { Generate, Doppler, Filter, Demodulate, Analyze, STAGE_COUNT };
+
+    struct Config {
+        double sample_rate = 1e6;      // Hz, the rate a deployment must sustain
+        double duration_seconds = 2.0; // of signal
+        size_t block_size = 4096;      // samples per block
+        double snr_db = 8.0;
+        double doppler_hz = 5000.0;
+        size_t fir_taps = 64;
+        double fir_cutoff = 0.1;       // normalized
+        uint32_t seed = 12345;
+    };
+
+    struct Result {
+        size_t samples = 0;
+        size_t blocks = 0;
+        double chain_seconds = 0.0;                 // receive stages only
+        double processed_sample_rate = 0.0;         // samples / chain_seconds
+        double realtime_factor = 0.0;               // processed / configured rate
+        std::array<double, STAGE_COUNT> stage_seconds{};
+        LatencyHistogram block_latency;             // receive stages, per block
+        std::array<LatencyHistogram, STAGE_COUNT> stage_latency;  // per block
+        double p50_ms = 0.0, p90_ms = 0.0, p99_ms = 0.0, p999_ms = 0.0, max_ms = 0.0;
+        double block_period_ms = 0.0;               // signal time per block
+        double final_snr_db = 0.0;
+        std::array<double, STAGE_COUNT> stage_allocations{};  // per block
+        std::array<double, STAGE_COUNT> stage_allocated_bytes{};  // per block
+
+        // Receive stages only, per block
+        double allocations_per_block() const {
+            double total = 0.0;
+            for (int s = Doppler; s < STAGE_COUNT; ++s) total += stage_allocations[s];
+            return total;
+        }
+
+        double allocated_bytes_per_block() const {
+            double total = 0.0;
+            for (int s = Doppler; s < STAGE_COUNT; ++s) total += stage_allocated_bytes[s];
+            return total;
+        }
+
+        double stage_share(Stage s) const {
+            double total = 0.0;
+            for (double t : stage_seconds) total += t;
+            return total > 0.0 ? stage_seconds[s] / total : 0.0;
+        }
+    };
+
+    ReceiveChainBenchmark() : ReceiveChainBenchmark(Config()) {}
+    explicit ReceiveChainBenchmark(const Config& cfg) : config(cfg) {}
+
+    static const char* stage_name(Stage s) {
+        static const char* names[STAGE_COUNT] = {"generate", "doppler", "filter", "demodulate", "analyze"};
+        return names[s];
+    }
+
+    Result run() const {
+        using Clock = std::chrono::steady_clock;
+        Result result;
+        const size_t total = static_cast<size_t>(config.duration_seconds * config.sample_rate);
+        result.blocks = (total + config.block_size - 1) / config.block_size;
+        result.block_period_ms = 1e3 * config.block_size / config.sample_rate;
+
+        Source source(config);
+        DopplerCompensator compensator(config.sample_rate);
+        LowpassFilter filter(config.fir_cutoff, config.fir_taps);
+        QPSKDemodulator demod(config.doppler_hz);
+
+        std::array<size_t, STAGE_COUNT> tags;
+        std::array<AllocationTracker::Snapshot, STAGE_COUNT> allocations_before;
+        for (int s = 0; s < STAGE_COUNT; ++s) {
+            tags[s] = AllocationTracker::tag(stage_tag(static_cast<Stage>(s)));
+            allocations_before[s] = AllocationTracker::tag_snapshot(tags[s]);
+        }
+
+        std::vector<ComplexSample> block;
+        std::vector<double> real_part;
+        std::vector<ComplexSample> filtered_complex;
+        for (size_t done = 0; done < total; done += block.size()) {
+            const size_t n = std::min(config.block_size, total - done);
+            TRACE_SCOPE("ReceiveChain::block");
+
+            auto t0 = Clock::now();
+            {
+                AllocationScope scope(tags[Generate]);
+                source.generate(n, block);
+            }
+            auto t1 = Clock::now();
+
+            std::vector<ComplexSample> corrected;
+            {
+                AllocationScope scope(tags[Doppler]);
+                compensator.update_doppler(config.doppler_hz);
+                corrected = compensator.compensate_buffer(block);
+            }
+            auto t2 = Clock::now();
+
+            {
+                AllocationScope scope(tags[Filter]);
+                real_part.resize(n);
+                for (size_t i = 0; i < n; ++i) real_part[i] = corrected[i].real();
+                auto filtered = filter.process_buffer(real_part);
+                filtered_complex.resize(n);
+                for (size_t i = 0; i < n; ++i) filtered_complex[i] = ComplexSample(filtered[i], 0.0);
+            }
+            auto t3 = Clock::now();
+
+            size_t symbols = 0;
+            {
+                AllocationScope scope(tags[Demodulate]);
+                symbols = demod.demodulate(filtered_complex).size();
+            }
+            auto t4 = Clock::now();
+
+            {
+                AllocationScope scope(tags[Analyze]);
+                result.final_snr_db = SignalAnalyzer::analyze(corrected).snr_db;
+            }
+            auto t5 = Clock::now();
+
+            result.samples += symbols;
+            const Clock::time_point marks[] = {t0, t1, t2, t3, t4, t5};
+            for (int s = 0; s < STAGE_COUNT; ++s) {
+                result.stage_seconds[s] += std::chrono::duration<double>(marks[s + 1] - marks[s]).count();
+                result.stage_latency[s].record(marks[s + 1] - marks[s]);
+            }
+            result.block_latency.record(t5 - t1);
+        }
+
+        for (int s = 0; s < STAGE_COUNT; ++s) {
+            auto used = AllocationTracker::tag_snapshot(tags[s]) - allocations_before[s];
+            if (result.blocks > 0) {
+                result.stage_allocations[s] = static_cast<double>(used.allocations) / result.blocks;
+                result.stage_allocated_bytes[s] = static_cast<double>(used.bytes) / result.blocks;
+            }
+        }
+
+        for (int s = Doppler; s < STAGE_COUNT; ++s) result.chain_seconds += result.stage_seconds[s];
+        if (result.chain_seconds > 0.0) {
+            result.processed_sample_rate = result.samples / result.chain_seconds;
+            result.realtime_factor = result.processed_sample_rate / config.sample_rate;
+        }
+
+        result.p50_ms = result.block_latency.percentile_ms(50.0);
+        result.p90_ms = result.block_latency.percentile_ms(90.0);
+        result.p99_ms = result.block_latency.percentile_ms(99.0);
+        result.p999_ms = result.block_latency.percentile_ms(99.9);
+        result.max_ms = result.block_latency.max() * 1e-6;
+        return result;
+    }
+
+    // Allocation tag of each stage
+    static const char* stage_tag(Stage s) {
+        static const char* tags[STAGE_COUNT] = {"receive_chain/generate", "receive_chain/doppler",
+                                                "receive_chain/filter", "receive_chain/demodulate",
+                                                "receive_chain/analyze"};
+        return tags[s];
+    }
+
+    const Config& get_config() const { return config; }
+
+private:
+    Config config;
+
+    // generate_qpsk_signal from the demo, made continuous across blocks
+    class Source {
+    public:
+        explicit Source(const Config& cfg)
+            : gen(cfg.seed),
+              noise(0.0, std::sqrt(1.0 / std::pow(10.0, cfg.snr_db / 10.0))),
+              phase_increment(cfg.doppler_hz * 2.0 * PI / cfg.sample_rate) {}
+
+        void generate(size_t n, std::vector<ComplexSample>& out) {
+            static const double A = 1.0 / std::sqrt(2.0);
+            static const ComplexSample symbols[] = {{A, A}, {-A, A}, {-A, -A}, {A, -A}};
+            out.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                ComplexSample received = symbols[index++ % 4] * std::polar(1.0, phase);
+                double re = noise(gen);
+                double im = noise(gen);
+                out[i] = received + ComplexSample(re, im);
+                phase = std::fmod(phase + phase_increment, 2.0 * PI);
+            }
+        }
+
+    private:
+        std::mt19937 gen;
+        std::normal_distribution<> noise;
+        double phase_increment;
+        double phase = 0.0;
+        size_t index = 0;
+    };
+};
+
+}  // namespace SatelliteSignal
+
+#endif // PIPELINE_BENCHMARK_H
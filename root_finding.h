@@ -0,0 +1,127 @@
+#ifndef ROOT_FINDING_H
+#define ROOT_FINDING_H
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace SatelliteSignal {
+
+// Brent's method for a root of f in [a, b], given f(a) and f(b) of opposite
+// sign (or one of them zero). Combines bisection with secant and inverse
+// quadratic steps; converges superlinearly on smooth functions and never
+// does worse than bisection.
+template <typename F>
+double brent_root(F&& f, double a, double b, double fa, double fb,
+                  double tolerance, int max_iterations = 60) {
+    if (fa == 0.0) return a;
+    if (fb == 0.0) return b;
+
+    double c = a, fc = fa;
+    double d = b - a, e = d;
+    for (int it = 0; it < max_iterations; ++it) {
+        if ((fb > 0.0) == (fc > 0.0)) {
+            c = a; fc = fa;
+            d = e = b - a;
+        }
+        if (std::fabs(fc) < std::fabs(fb)) {
+            a = b; b = c; c = a;
+            fa = fb; fb = fc; fc = fa;
+        }
+        double tol = 2.0 * 1e-16 * std::fabs(b) + 0.5 * tolerance;
+        double m = 0.5 * (c - b);
+        if (std::fabs(m) <= tol || fb == 0.0) return b;
+
+        if (std::fabs(e) >= tol && std::fabs(fa) > std::fabs(fb)) {
+            double s = fb / fa, p, q;
+            if (a == c) {
+                p = 2.0 * m * s;
+                q = 1.0 - s;
+            } else {
+                double r = fb / fc;
+                q = fa / fc;
+                p = s * (2.0 * m * q * (q - r) - (b - a) * (r - 1.0));
+                q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0) q = -q;
+            else p = -p;
+            if (2.0 * p < std::min(3.0 * m * q - std::fabs(tol * q), std::fabs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = m;
+                e = m;
+            }
+        } else {
+            d = m;
+            e = m;
+        }
+        a = b; fa = fb;
+        b += std::fabs(d) > tol ? d : (m > 0.0 ? tol : -tol);
+        fb = f(b);
+    }
+    return b;
+}
+
+// Brent's method for a minimum of f in [a, b]: golden-section search with
+// parabolic interpolation steps. Returns {x, f(x)}.
+template <typename F>
+std::pair<double, double> brent_minimize(F&& f, double a, double b,
+                                         double tolerance, int max_iterations = 60) {
+    const double golden = 0.3819660112501051;
+    double x = a + golden * (b - a);
+    double w = x, v = x;
+    double fx = f(x), fw = fx, fv = fx;
+    double d = 0.0, e = 0.0;
+
+    for (int it = 0; it < max_iterations; ++it) {
+        double mid = 0.5 * (a + b);
+        double tol = 1e-16 * std::fabs(x) + 0.5 * tolerance;
+        if (std::fabs(x - mid) <= 2.0 * tol - 0.5 * (b - a)) break;
+
+        bool golden_step = true;
+        if (std::fabs(e) > tol) {
+            double r = (x - w) * (fx - fv);
+            double q = (x - v) * (fx - fw);
+            double p = (x - v) * q - (x - w) * r;
+            q = 2.0 * (q - r);
+            if (q > 0.0) p = -p;
+            else q = -q;
+            if (std::fabs(p) < std::fabs(0.5 * q * e) && p > q * (a - x) && p < q * (b - x)) {
+                e = d;
+                d = p / q;
+                double u = x + d;
+                if (u - a < 2.0 * tol || b - u < 2.0 * tol) d = mid > x ? tol : -tol;
+                golden_step = false;
+            }
+        }
+        if (golden_step) {
+            e = (x >= mid ? a : b) - x;
+            d = golden * e;
+        }
+
+        double u = x + (std::fabs(d) >= tol ? d : (d > 0.0 ? tol : -tol));
+        double fu = f(u);
+        if (fu <= fx) {
+            if (u >= x) a = x;
+            else b = x;
+            v = w; fv = fw;
+            w = x; fw = fx;
+            x = u; fx = fu;
+        } else {
+            if (u < x) a = u;
+            else b = u;
+            if (fu <= fw || w == x) {
+                v = w; fv = fw;
+                w = u; fw = fu;
+            } else if (fu <= fv || v == x || v == w) {
+                v = u; fv = fu;
+            }
+        }
+    }
+    return {x, fx};
+}
+
+}  // namespace SatelliteSignal
+
+#endif // ROOT_FINDING_H
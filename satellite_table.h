@@ -0,0 +1,244 @@
+#ifndef SATELLITE_TABLE_H
+#define SATELLITE_TABLE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "orbital_types.h"
+#include "station_frame.h"
+#include "catalog_propagator.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Dense satellite index: position in every column of a SatelliteTable and in
+// the arrays handed to the propagator, visibility index and ISL analyzer
+using SatelliteId = uint32_t;
+
+// Interned names in one character buffer. Each distinct name is stored once;
+// lookups go through an open-addressed table of ids (linear probing, names
+// compared in place, at most three quarters full).
+class NameTable {
+public:
+    static constexpr SatelliteId npos = static_cast<SatelliteId>(-1);
+
+    // Id of `name`, adding it if new
+    SatelliteId intern(std::string_view name) {
+        SatelliteId id = find(name);
+        if (id != npos) return id;
+        id = static_cast<SatelliteId>(size());
+        chars.insert(chars.end(), name.begin(), name.end());
+        offsets.push_back(static_cast<uint32_t>(chars.size()));
+        if (4 * size() > 3 * slots.size()) {
+            rehash(std::max<size_t>(16, 2 * slots.size()));
+        } else {
+            insert_slot(id, hash(name));
+        }
+        return id;
+    }
+
+    SatelliteId find(std::string_view name) const {
+        if (slots.empty()) return npos;
+        const size_t mask = slots.size() - 1;
+        for (size_t i = hash(name) & mask;; i = (i + 1) & mask) {
+            if (slots[i] == npos || get(slots[i]) == name) return slots[i];
+        }
+    }
+
+    // Valid until the next intern()
+    std::string_view get(SatelliteId id) const {
+        return std::string_view(chars.data() + offsets[id], offsets[id + 1] - offsets[id]);
+    }
+
+    size_t size() const { return offsets.size() - 1; }
+
+    void reserve(size_t count, size_t total_chars) {
+        chars.reserve(total_chars);
+        offsets.reserve(count + 1);
+        size_t capacity = 16;
+        while (3 * capacity < 4 * count) capacity *= 2;
+        if (capacity > slots.size()) rehash(capacity);
+    }
+
+    void clear() {
+        chars.clear();
+        offsets.assign(1, 0);
+        slots.clear();
+    }
+
+    size_t memory_bytes() const {
+        return chars.capacity() + (offsets.capacity() + slots.capacity()) * sizeof(uint32_t);
+    }
+
+private:
+    std::vector<char> chars;
+    std::vector<uint32_t> offsets = {0};
+    std::vector<SatelliteId> slots;       // power-of-two size, npos = empty
+
+    // FNV-1a
+    static uint64_t hash(std::string_view s) {
+        uint64_t h = 14695981039346656037ull;
+        for (char c : s) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    void insert_slot(SatelliteId id, uint64_t h) {
+        const size_t mask = slots.size() - 1;
+        size_t i = h & mask;
+        while (slots[i] != npos) i = (i + 1) & mask;
+        slots[i] = id;
+    }
+
+    void rehash(size_t capacity) {
+        slots.assign(capacity, npos);
+        for (SatelliteId id = 0; id < size(); ++id) insert_slot(id, hash(get(id)));
+    }
+};
+
+// Per-satellite state held structure-of-arrays and indexed by SatelliteId.
+// Names live in the NameTable; the numeric columns are what bulk scans
+// touch. Sub-satellite point, altitude and speed are single precision
+// (display and screening, not propagation) and are refreshed from a
+// propagated state set in blocks whose loops vectorize.
+class SatelliteTable {
+public:
+    struct Config {
+        unsigned num_threads = 0;  // 0 = all cores
+        size_t grain = 4096;       // satellites per work item
+    };
+
+    std::vector<int32_t> catalog_number;
+    std::vector<float> latitude_deg;       // geocentric
+    std::vector<float> longitude_deg;      // -180 to 180
+    std::vector<float> altitude_km;        // above the equatorial radius
+    std::vector<float> speed_km_s;         // inertial
+    std::vector<float> signal_strength_dbm;
+    std::vector<uint8_t> in_range;
+
+    SatelliteTable() : SatelliteTable(Config()) {}
+    explicit SatelliteTable(const Config& cfg) : config(cfg) {}
+
+    SatelliteId add(int32_t catalog, std::string_view name, float signal_dbm = 0.0f) {
+        SatelliteId id = static_cast<SatelliteId>(catalog_number.size());
+        catalog_number.push_back(catalog);
+        latitude_deg.push_back(0.0f);
+        longitude_deg.push_back(0.0f);
+        altitude_km.push_back(0.0f);
+        speed_km_s.push_back(0.0f);
+        signal_strength_dbm.push_back(signal_dbm);
+        in_range.push_back(0);
+        name_ids.push_back(names.intern(name));
+        return id;
+    }
+
+    // Replace the catalog number and name of satellite `id`
+    void set(SatelliteId id, int32_t catalog, std::string_view name) {
+        catalog_number[id] = catalog;
+        name_ids[id] = names.intern(name);
+    }
+
+    // Remove satellite `id`; the last satellite moves into its place. Its
+    // name stays interned.
+    void remove(SatelliteId id) {
+        auto move_last = [id](auto& column) {
+            column[id] = column.back();
+            column.pop_back();
+        };
+        move_last(catalog_number);
+        move_last(latitude_deg); move_last(longitude_deg);
+        move_last(altitude_km); move_last(speed_km_s);
+        move_last(signal_strength_dbm); move_last(in_range);
+        move_last(name_ids);
+    }
+
+    void reserve(size_t n, size_t name_chars = 0) {
+        names.reserve(n, name_chars);
+        catalog_number.reserve(n);
+        latitude_deg.reserve(n); longitude_deg.reserve(n);
+        altitude_km.reserve(n); speed_km_s.reserve(n);
+        signal_strength_dbm.reserve(n); in_range.reserve(n);
+        name_ids.reserve(n);
+    }
+
+    void clear() {
+        catalog_number.clear();
+        latitude_deg.clear(); longitude_deg.clear();
+        altitude_km.clear(); speed_km_s.clear();
+        signal_strength_dbm.clear(); in_range.clear();
+        name_ids.clear();
+        names.clear();
+    }
+
+    size_t size() const { return catalog_number.size(); }
+    std::string_view name(SatelliteId id) const { return names.get(name_ids[id]); }
+    const NameTable& get_names() const { return names; }
+
+    SatelliteId find(std::string_view name) const {
+        SatelliteId n = names.find(name);
+        if (n == NameTable::npos) return NameTable::npos;
+        auto it = std::find(name_ids.begin(), name_ids.end(), n);
+        return it == name_ids.end() ? NameTable::npos : static_cast<SatelliteId>(it - name_ids.begin());
+    }
+
+    // Refresh the geodetic columns from TEME states at sidereal angle `gmst`
+    void update(const CatalogPropagator::States& states, double gmst) {
+        update(states, gmst, 0, std::min(size(), states.size()));
+    }
+
+    // Same for satellites [first, last) only
+    void update(const CatalogPropagator::States& states, double gmst, size_t first, size_t last) {
+        const double c = std::cos(gmst), s = std::sin(gmst);
+        parallel_for(last - first, [&](size_t begin, size_t end, unsigned) {
+            begin += first;
+            end += first;
+            for (size_t b = begin; b < end; b += BLOCK) {
+                update_block(states, std::min(end, b + BLOCK) - b, c, s, b);
+            }
+        }, config.grain, config.num_threads);
+    }
+
+    // Column storage plus names, bytes
+    size_t memory_bytes() const {
+        return catalog_number.capacity() * sizeof(int32_t) +
+               (latitude_deg.capacity() + longitude_deg.capacity() + altitude_km.capacity() +
+                speed_km_s.capacity() + signal_strength_dbm.capacity()) * sizeof(float) +
+               in_range.capacity() + name_ids.capacity() * sizeof(SatelliteId) + names.memory_bytes();
+    }
+
+private:
+    static constexpr size_t BLOCK = 64;
+
+    Config config;
+    std::vector<SatelliteId> name_ids;
+    NameTable names;
+
+    void update_block(const CatalogPropagator::States& st, size_t count, double c, double s, size_t o) {
+        float lat[BLOCK], lon[BLOCK], alt[BLOCK], speed[BLOCK];
+        const double *x = st.x.data() + o, *y = st.y.data() + o, *z = st.z.data() + o;
+        const double *vx = st.vx.data() + o, *vy = st.vy.data() + o, *vz = st.vz.data() + o;
+        for (size_t j = 0; j < count; ++j) {
+            double rx = c * x[j] + s * y[j];
+            double ry = -s * x[j] + c * y[j];
+            double horizontal = std::sqrt(rx * rx + ry * ry);
+            lat[j] = static_cast<float>(fast_atan2(z[j], horizontal) * RAD_TO_DEG);
+            lon[j] = static_cast<float>(fast_atan2(ry, rx) * RAD_TO_DEG);
+            alt[j] = static_cast<float>(std::sqrt(horizontal * horizontal + z[j] * z[j]) - WGS84_A_KM);
+            speed[j] = static_cast<float>(std::sqrt(vx[j] * vx[j] + vy[j] * vy[j] + vz[j] * vz[j]));
+        }
+        std::copy(lat, lat + count, latitude_deg.begin() + o);
+        std::copy(lon, lon + count, longitude_deg.begin() + o);
+        std::copy(alt, alt + count, altitude_km.begin() + o);
+        std::copy(speed, speed + count, speed_km_s.begin() + o);
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // SATELLITE_TABLE_H
@@ -0,0 +1,227 @@
+#ifndef SCOPED_TRACE_H
+#define SCOPED_TRACE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace SatelliteSignal {
+
+// One begin ('B') or end ('E') event. Names are not copied: they must be
+// string literals or otherwise outlive the tracer.
+struct TraceEvent {
+    const char* name;
+    uint64_t timestamp_ns;  // since the tracer was created
+    char phase;
+};
+
+// Fixed-capacity ring of one thread's events. Only the owning thread
+// writes; once full, the oldest events are overwritten. Readers take a
+// snapshot after tracing has stopped, since a slot being overwritten while
+// it is copied would be torn.
+class TraceBuffer {
+public:
+    TraceBuffer(size_t capacity, uint32_t tid, std::string thread_name)
+        : events(round_up_pow2(capacity)), mask(events.size() - 1), tid(tid), name(std::move(thread_name)) {}
+
+    void push(const char* event_name, char phase, uint64_t timestamp_ns) {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        events[h & mask] = {event_name, timestamp_ns, phase};
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // Retained events, oldest first
+    std::vector<TraceEvent> snapshot() const {
+        const uint64_t h = head.load(std::memory_order_acquire);
+        const uint64_t n = std::min<uint64_t>(h, events.size());
+        std::vector<TraceEvent> out;
+        out.reserve(static_cast<size_t>(n));
+        for (uint64_t i = h - n; i < h; ++i) out.push_back(events[i & mask]);
+        return out;
+    }
+
+    uint64_t dropped() const {
+        const uint64_t h = head.load(std::memory_order_acquire);
+        return h > events.size() ? h - events.size() : 0;
+    }
+
+    void clear() { head.store(0, std::memory_order_release); }
+
+    uint32_t thread_id() const { return tid; }
+    const std::string& thread_name() const { return name; }
+    void set_thread_name(std::string n) { name = std::move(n); }
+
+private:
+    std::vector<TraceEvent> events;
+    size_t mask;
+    uint32_t tid;
+    std::string name;
+    std::atomic<uint64_t> head{0};
+
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+};
+
+// Process-wide collector of scoped begin/end events, written as Chrome
+// Trace Event JSON (chrome://tracing, ui.perfetto.dev). Each thread gets its
+// own ring buffer on its first event, so recording takes no lock; the
+// registry lock is only taken when a thread first traces and on export.
+// Buffers outlive their threads so a pool's events survive until export.
+//
+// Events are recorded only between start() and stop(). Library code is
+// instrumented with TRACE_SCOPE, which compiles to nothing unless
+// SATELLITE_SIGNAL_TRACING is defined (CMake option ENABLE_TRACING).
+class Tracer {
+public:
+    struct Config {
+        size_t events_per_thread = 1 << 16;  // ring capacity, rounded up to a power of two
+    };
+
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    // Applies to threads that have not traced yet
+    void set_config(const Config& cfg) { config = cfg; }
+    const Config& get_config() const { return config; }
+
+    void start() { enabled.store(true, std::memory_order_release); }
+    void stop() { enabled.store(false, std::memory_order_release); }
+    bool active() const { return enabled.load(std::memory_order_relaxed); }
+
+    void begin(const char* name) { local_buffer().push(name, 'B', now_ns()); }
+    void end(const char* name) { local_buffer().push(name, 'E', now_ns()); }
+
+    // Label the calling thread in the exported trace
+    void set_thread_name(const std::string& name) { local_buffer().set_thread_name(name); }
+
+    // Forget recorded events; call while stopped
+    void clear() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (auto& b : buffers) b->clear();
+    }
+
+    // Events lost to ring overwrites across all threads
+    uint64_t dropped_events() const {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        uint64_t total = 0;
+        for (const auto& b : buffers) total += b->dropped();
+        return total;
+    }
+
+    // Chrome Trace Event JSON of every retained event. An end whose begin
+    // was overwritten is skipped so the remaining pairs stay balanced.
+    void write_chrome_trace(std::ostream& os) const {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+        bool first = true;
+        auto separator = [&]() {
+            os << (first ? "  " : ",\n  ");
+            first = false;
+        };
+        for (const auto& b : buffers) {
+            separator();
+            os << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << b->thread_id()
+               << ", \"args\": {\"name\": \"" << escape(b->thread_name()) << "\"}}";
+            int depth = 0;
+            for (const auto& e : b->snapshot()) {
+                if (e.phase == 'E' && depth == 0) continue;
+                depth += e.phase == 'B' ? 1 : -1;
+                separator();
+                os << "{\"name\": \"" << escape(e.name) << "\", \"ph\": \"" << e.phase
+                   << "\", \"pid\": 1, \"tid\": " << b->thread_id() << ", \"ts\": " << std::fixed
+                   << std::setprecision(3) << e.timestamp_ns * 1e-3 << "}";
+            }
+        }
+        os << "\n]}\n";
+    }
+
+    bool export_chrome_trace(const std::string& filename) const {
+        std::ofstream file(filename);
+        if (!file.is_open()) return false;
+        write_chrome_trace(file);
+        return static_cast<bool>(file);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Config config;
+    std::atomic<bool> enabled{false};
+    Clock::time_point epoch = Clock::now();
+    mutable std::mutex registry_mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+
+    Tracer() = default;
+
+    uint64_t now_ns() const {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count());
+    }
+
+    TraceBuffer& local_buffer() {
+        thread_local std::shared_ptr<TraceBuffer> local;
+        if (!local) {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            const uint32_t tid = static_cast<uint32_t>(buffers.size()) + 1;
+            local = std::make_shared<TraceBuffer>(config.events_per_thread, tid,
+                                                  "thread " + std::to_string(tid));
+            buffers.push_back(local);
+        }
+        return *local;
+    }
+
+    static std::string escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out += c;
+        }
+        return out;
+    }
+};
+
+// Begin event on construction and the matching end on destruction, when
+// the tracer is running at construction
+class TraceScope {
+public:
+    explicit TraceScope(const char* scope_name)
+        : name(Tracer::instance().active() ? scope_name : nullptr) {
+        if (name) Tracer::instance().begin(name);
+    }
+    ~TraceScope() {
+        if (name) Tracer::instance().end(name);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+};
+
+}  // namespace SatelliteSignal
+
+#define TRACE_SCOPE_CONCAT_(a, b) a##b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT_(a, b)
+
+// Trace the rest of the enclosing block under `name` (a string literal)
+#ifdef SATELLITE_SIGNAL_TRACING
+#define TRACE_SCOPE(name) ::SatelliteSignal::TraceScope TRACE_SCOPE_CONCAT(trace_scope_, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif // SCOPED_TRACE_H
@@ -0,0 +1,910 @@
+#ifndef SGP4_PROPAGATOR_H
+#define SGP4_PROPAGATOR_H
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#include "orbital_types.h"
+
+namespace SatelliteSignal {
+
+// SGP4/SDP4 analytic propagator (Spacetrack Report #3 as revised by Vallado
+// et al., AIAA 2006-6753). The constructor runs the one-time initialization
+// and caches every quantity that depends only on the element set; propagate()
+// then evaluates the secular, long-period and short-period terms for a single
+// time. Orbits with a period of 225 minutes or more use the deep-space (SDP4)
+// lunar-solar and resonance terms.
+class SGP4Propagator {
+public:
+    enum class GravityModel { WGS72_OLD, WGS72, WGS84 };
+
+    enum Error {
+        OK = 0,
+        MEAN_ECCENTRICITY = 1,       // mean eccentricity outside [0, 1)
+        MEAN_MOTION = 2,             // mean motion not positive
+        PERTURBED_ECCENTRICITY = 3,  // perturbed eccentricity outside [0, 1]
+        SEMI_LATUS_RECTUM = 4,       // semi-latus rectum negative
+        DECAYED = 6                  // orbit radius below one Earth radius
+    };
+
+    struct Config {
+        GravityModel gravity = GravityModel::WGS72;
+        bool afspc_mode = false;  // AFSPC sidereal time and node handling
+    };
+
+    SGP4Propagator(const TLE& tle) : SGP4Propagator(tle, Config()) {}
+    SGP4Propagator(const TLE& tle, const Config& cfg);
+
+    // Position (km) and velocity (km/s) in TEME at `minutes_from_epoch`.
+    // Returns false and sets get_error() if the elements have gone invalid.
+    // Deep-space resonance integration state is kept between calls, so
+    // monotonic time steps are cheapest.
+    bool propagate(double minutes_from_epoch, StateVector& state);
+
+    // Same state, leaving the propagator untouched so one instance can be
+    // shared between threads. The resonance integrator continues from the
+    // last non-const call on a copy of its state; get_error() is not set.
+    bool propagate(double minutes_from_epoch, StateVector& state) const;
+
+    Error get_error() const { return error; }
+    bool is_deep_space() const { return deep_space; }
+    double get_epoch_jd() const { return epoch_jd; }
+    double get_gmst_at_epoch() const { return gsto; }
+    double get_earth_radius_km() const { return radius_earth_km; }
+
+    // Greenwich mean sidereal time (IAU-82) in radians for a UT1 Julian date
+    static double gmst(double jd_ut1) {
+        const double two_pi = 2.0 * M_PI;
+        double tut1 = (jd_ut1 - 2451545.0) / 36525.0;
+        double temp = -6.2e-6 * tut1 * tut1 * tut1 + 0.093104 * tut1 * tut1 +
+                      (876600.0 * 3600.0 + 8640184.812866) * tut1 + 67310.54841;
+        temp = std::fmod(temp * (M_PI / 180.0) / 240.0, two_pi);
+        if (temp < 0.0) temp += two_pi;
+        return temp;
+    }
+
+    // Julian date of a TLE epoch (two- or four-digit year, fractional day)
+    static double epoch_julian_date(int year, double day_of_year) {
+        if (year < 57) year += 2000;
+        else if (year < 100) year += 1900;
+        // Days from 1950 Jan 0.0 (JD 2433281.5) to Jan 0.0 of `year`; valid 1901-2099
+        double days = 365.0 * (year - 1950) + std::floor((year - 1) / 4.0) - 487.0;
+        return 2433281.5 + days + day_of_year;
+    }
+
+private:
+    Config config;
+    Error error = OK;
+
+    // Gravity model
+    double radius_earth_km, xke, j2, j3oj2, j4, velocity_km_s;
+
+    // Mean elements at epoch (Kozai mean motion converted to Brouwer)
+    double epoch_jd, bstar, ecco, argpo, inclo, mo, no, nodeo;
+
+    // Near-Earth constants
+    bool simple = false;
+    double aycof, con41, cc1, cc4, cc5, d2, d3, d4, delmo, eta, argpdot, omgcof;
+    double sinmao, t2cof, t3cof, t4cof, t5cof, x1mth2, x7thm1, mdot, nodedot;
+    double xlcof, xmcof, nodecf, gsto;
+
+    // Deep-space constants
+    bool deep_space = false;
+    int irez = 0;
+    double d2201, d2211, d3210, d3222, d4410, d4422, d5220, d5232, d5421, d5433;
+    double dedt, del1, del2, del3, didt, dmdt, dnodt, domdt;
+    double e3, ee2, peo, pgho, pho, pinco, plo, se2, se3, sgh2, sgh3, sgh4;
+    double sh2, sh3, si2, si3, sl2, sl3, sl4, xfact, xgh2, xgh3, xgh4;
+    double xh2, xh3, xi2, xi3, xl2, xl3, xl4, xlamo, zmol, zmos;
+
+    // Resonance integrator state carried between calls
+    struct Resonance {
+        double atime = 0.0, xli = 0.0, xni = 0.0;
+    };
+    Resonance resonance;
+
+    void set_gravity_model();
+
+    struct DeepSpaceCommon;
+    void deep_space_common(double tc, DeepSpaceCommon& ds);
+    void deep_space_init(const DeepSpaceCommon& ds, double xpidot);
+    void deep_space_secular(double t, double& em, double& argpm, double& inclm,
+                            double& mm, double& nodem, double& nm, Resonance& rs) const;
+    void deep_space_periodics(double t, double& ep, double& inclp, double& nodep,
+                              double& argpp, double& mp) const;
+
+    Error evaluate(double t, StateVector& state, Resonance& rs) const;
+};
+
+// Intermediate quantities shared between the deep-space setup routines
+struct SGP4Propagator::DeepSpaceCommon {
+    double sinim, cosim, emsq;
+    double s1, s2, s3, s4, s5, ss1, ss2, ss3, ss4, ss5;
+    double sz1, sz3, sz11, sz13, sz21, sz23, sz31, sz33;
+    double z1, z3, z11, z13, z21, z23, z31, z33;
+};
+
+inline SGP4Propagator::SGP4Propagator(const TLE& tle, const Config& cfg) : config(cfg) {
+    set_gravity_model();
+
+    const double x2o3 = 2.0 / 3.0;
+    const double two_pi = 2.0 * M_PI;
+
+    epoch_jd = epoch_julian_date(tle.epoch_year, tle.epoch_day);
+    bstar = tle.bstar;
+    ecco = tle.eccentricity;
+    argpo = tle.argument_perigee;
+    inclo = tle.inclination;
+    mo = tle.mean_anomaly;
+    nodeo = tle.raan;
+    double no_kozai = tle.mean_motion * two_pi / 1440.0;  // rad/min
+
+    // Un-Kozai the mean motion and derive the basic orbit geometry
+    double eccsq = ecco * ecco;
+    double omeosq = 1.0 - eccsq;
+    double rteosq = std::sqrt(omeosq);
+    double cosio = std::cos(inclo);
+    double cosio2 = cosio * cosio;
+
+    double ak = std::pow(xke / no_kozai, x2o3);
+    double d1 = 0.75 * j2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+    double del = d1 / (ak * ak);
+    double adel = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+    del = d1 / (adel * adel);
+    no = no_kozai / (1.0 + del);
+
+    double ao = std::pow(xke / no, x2o3);
+    double sinio = std::sin(inclo);
+    double po = ao * omeosq;
+    double con42 = 1.0 - 5.0 * cosio2;
+    con41 = -con42 - cosio2 - cosio2;
+    double posq = po * po;
+    double rp = ao * (1.0 - ecco);
+
+    double epoch = epoch_jd - 2433281.5;  // days since 1950 Jan 0.0
+    if (config.afspc_mode) {
+        double ts70 = epoch - 7305.0;
+        double ds70 = std::floor(ts70 + 1.0e-8);
+        double tfrac = ts70 - ds70;
+        const double c1 = 1.72027916940703639e-2;
+        const double thgr70 = 1.7321343856509374;
+        const double fk5r = 5.07551419432269442e-15;
+        gsto = std::fmod(thgr70 + c1 * ds70 + (c1 + two_pi) * tfrac + ts70 * ts70 * fk5r, two_pi);
+        if (gsto < 0.0) gsto += two_pi;
+    } else {
+        gsto = gmst(epoch_jd);
+    }
+
+    if (ecco < 0.0 || ecco >= 1.0) { error = MEAN_ECCENTRICITY; return; }
+    if (no <= 0.0) { error = MEAN_MOTION; return; }
+
+    // Perigees below 220 km drop the higher-order drag terms
+    simple = rp < (220.0 / radius_earth_km + 1.0);
+
+    // Atmospheric density parameters, adjusted for low perigees
+    double ss = 78.0 / radius_earth_km + 1.0;
+    double qzms2t = std::pow((120.0 - 78.0) / radius_earth_km, 4);
+    double sfour = ss;
+    double qzms24 = qzms2t;
+    double perige = (rp - 1.0) * radius_earth_km;
+    if (perige < 156.0) {
+        sfour = perige - 78.0;
+        if (perige < 98.0) sfour = 20.0;
+        qzms24 = std::pow((120.0 - sfour) / radius_earth_km, 4);
+        sfour = sfour / radius_earth_km + 1.0;
+    }
+
+    double pinvsq = 1.0 / posq;
+    double tsi = 1.0 / (ao - sfour);
+    eta = ao * ecco * tsi;
+    double etasq = eta * eta;
+    double eeta = ecco * eta;
+    double psisq = std::fabs(1.0 - etasq);
+    double coef = qzms24 * std::pow(tsi, 4);
+    double coef1 = coef / std::pow(psisq, 3.5);
+    double cc2 = coef1 * no * (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+                 0.375 * j2 * tsi / psisq * con41 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+    cc1 = bstar * cc2;
+    double cc3 = 0.0;
+    if (ecco > 1.0e-4) cc3 = -2.0 * coef * tsi * j3oj2 * no * sinio / ecco;
+    x1mth2 = 1.0 - cosio2;
+    cc4 = 2.0 * no * coef1 * ao * omeosq *
+          (eta * (2.0 + 0.5 * etasq) + ecco * (0.5 + 2.0 * etasq) -
+           j2 * tsi / (ao * psisq) *
+           (-3.0 * con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+            0.75 * x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) * std::cos(2.0 * argpo)));
+    cc5 = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+
+    // Secular rates from J2 and J4
+    double cosio4 = cosio2 * cosio2;
+    double temp1 = 1.5 * j2 * pinvsq * no;
+    double temp2 = 0.5 * temp1 * j2 * pinvsq;
+    double temp3 = -0.46875 * j4 * pinvsq * pinvsq * no;
+    mdot = no + 0.5 * temp1 * rteosq * con41 +
+           0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+    argpdot = -0.5 * temp1 * con42 + 0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) +
+              temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+    double xhdot1 = -temp1 * cosio;
+    nodedot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2)) * cosio;
+    double xpidot = argpdot + nodedot;
+
+    omgcof = bstar * cc3 * std::cos(argpo);
+    xmcof = 0.0;
+    if (ecco > 1.0e-4) xmcof = -x2o3 * coef * bstar / eeta;
+    nodecf = 3.5 * omeosq * xhdot1 * cc1;
+    t2cof = 1.5 * cc1;
+
+    // Long-period J3 coefficients; guard the 1 + cos(i) pole
+    double denom = std::fabs(cosio + 1.0) > 1.5e-12 ? 1.0 + cosio : 1.5e-12;
+    xlcof = -0.25 * j3oj2 * sinio * (3.0 + 5.0 * cosio) / denom;
+    aycof = -0.5 * j3oj2 * sinio;
+    delmo = std::pow(1.0 + eta * std::cos(mo), 3);
+    sinmao = std::sin(mo);
+    x7thm1 = 7.0 * cosio2 - 1.0;
+
+    if (two_pi / no >= 225.0) {
+        deep_space = true;
+        simple = true;
+        DeepSpaceCommon ds;
+        deep_space_common(0.0, ds);
+        deep_space_init(ds, xpidot);
+    }
+
+    if (!simple) {
+        double cc1sq = cc1 * cc1;
+        d2 = 4.0 * ao * tsi * cc1sq;
+        double temp = d2 * tsi * cc1 / 3.0;
+        d3 = (17.0 * ao + sfour) * temp;
+        d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * cc1;
+        t3cof = d2 + 2.0 * cc1sq;
+        t4cof = 0.25 * (3.0 * d3 + cc1 * (12.0 * d2 + 10.0 * cc1sq));
+        t5cof = 0.2 * (3.0 * d4 + 12.0 * cc1 * d3 + 6.0 * d2 * d2 + 15.0 * cc1sq * (2.0 * d2 + cc1sq));
+    }
+}
+
+inline bool SGP4Propagator::propagate(double t, StateVector& state) {
+    if (error == MEAN_ECCENTRICITY || error == MEAN_MOTION) {
+        state = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        return false;
+    }
+    error = evaluate(t, state, resonance);
+    return error == OK;
+}
+
+inline bool SGP4Propagator::propagate(double t, StateVector& state) const {
+    if (error == MEAN_ECCENTRICITY || error == MEAN_MOTION) {
+        state = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        return false;
+    }
+    Resonance rs = resonance;
+    return evaluate(t, state, rs) == OK;
+}
+
+inline SGP4Propagator::Error SGP4Propagator::evaluate(double t, StateVector& state, Resonance& rs) const {
+    const double two_pi = 2.0 * M_PI;
+    const double x2o3 = 2.0 / 3.0;
+
+    state = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    // Secular gravity and atmospheric drag
+    double xmdf = mo + mdot * t;
+    double argpdf = argpo + argpdot * t;
+    double nodedf = nodeo + nodedot * t;
+    double argpm = argpdf;
+    double mm = xmdf;
+    double t2 = t * t;
+    double nodem = nodedf + nodecf * t2;
+    double tempa = 1.0 - cc1 * t;
+    double tempe = bstar * cc4 * t;
+    double templ = t2cof * t2;
+
+    if (!simple) {
+        double delomg = omgcof * t;
+        double delmtemp = 1.0 + eta * std::cos(xmdf);
+        double delm = xmcof * (delmtemp * delmtemp * delmtemp - delmo);
+        double temp = delomg + delm;
+        mm = xmdf + temp;
+        argpm = argpdf - temp;
+        double t3 = t2 * t;
+        double t4 = t3 * t;
+        tempa = tempa - d2 * t2 - d3 * t3 - d4 * t4;
+        tempe = tempe + bstar * cc5 * (std::sin(mm) - sinmao);
+        templ = templ + t3cof * t3 + t4 * (t4cof + t * t5cof);
+    }
+
+    double nm = no;
+    double em = ecco;
+    double inclm = inclo;
+    if (deep_space) {
+        deep_space_secular(t, em, argpm, inclm, mm, nodem, nm, rs);
+    }
+
+    if (nm <= 0.0) return MEAN_MOTION;
+
+    double am = std::pow(xke / nm, x2o3) * tempa * tempa;
+    nm = xke / std::pow(am, 1.5);
+    em = em - tempe;
+
+    if (em >= 1.0 || em < -0.001) return MEAN_ECCENTRICITY;
+    if (em < 1.0e-6) em = 1.0e-6;
+
+    mm = mm + no * templ;
+    double xlm = mm + argpm + nodem;
+    nodem = std::fmod(nodem, two_pi);
+    argpm = std::fmod(argpm, two_pi);
+    xlm = std::fmod(xlm, two_pi);
+    mm = std::fmod(xlm - argpm - nodem, two_pi);
+
+    // Lunar-solar periodics
+    double ep = em;
+    double xincp = inclm;
+    double argpp = argpm;
+    double nodep = nodem;
+    double mp = mm;
+    double sinip = std::sin(inclm);
+    double cosip = std::cos(inclm);
+    double aycof_p = aycof;
+    double xlcof_p = xlcof;
+    double con41_p = con41;
+    double x1mth2_p = x1mth2;
+    double x7thm1_p = x7thm1;
+
+    if (deep_space) {
+        deep_space_periodics(t, ep, xincp, nodep, argpp, mp);
+        if (xincp < 0.0) {
+            xincp = -xincp;
+            nodep += M_PI;
+            argpp -= M_PI;
+        }
+        if (ep < 0.0 || ep > 1.0) return PERTURBED_ECCENTRICITY;
+
+        sinip = std::sin(xincp);
+        cosip = std::cos(xincp);
+        aycof_p = -0.5 * j3oj2 * sinip;
+        double denom = std::fabs(cosip + 1.0) > 1.5e-12 ? 1.0 + cosip : 1.5e-12;
+        xlcof_p = -0.25 * j3oj2 * sinip * (3.0 + 5.0 * cosip) / denom;
+
+        double cosisq = cosip * cosip;
+        con41_p = 3.0 * cosisq - 1.0;
+        x1mth2_p = 1.0 - cosisq;
+        x7thm1_p = 7.0 * cosisq - 1.0;
+    }
+
+    // Long-period periodics
+    double axnl = ep * std::cos(argpp);
+    double temp = 1.0 / (am * (1.0 - ep * ep));
+    double aynl = ep * std::sin(argpp) + temp * aycof_p;
+    double xl = mp + argpp + nodep + temp * xlcof_p * axnl;
+
+    // Kepler's equation in equinoctial form
+    double u = std::fmod(xl - nodep, two_pi);
+    double eo1 = u;
+    double tem5 = 9999.9;
+    double sineo1 = 0.0, coseo1 = 0.0;
+    for (int ktr = 1; std::fabs(tem5) >= 1.0e-12 && ktr <= 10; ++ktr) {
+        sineo1 = std::sin(eo1);
+        coseo1 = std::cos(eo1);
+        tem5 = 1.0 - coseo1 * axnl - sineo1 * aynl;
+        tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / tem5;
+        if (std::fabs(tem5) >= 0.95) tem5 = tem5 > 0.0 ? 0.95 : -0.95;
+        eo1 += tem5;
+    }
+
+    // Short-period preliminary quantities
+    double ecose = axnl * coseo1 + aynl * sineo1;
+    double esine = axnl * sineo1 - aynl * coseo1;
+    double el2 = axnl * axnl + aynl * aynl;
+    double pl = am * (1.0 - el2);
+    if (pl < 0.0) return SEMI_LATUS_RECTUM;
+
+    double rl = am * (1.0 - ecose);
+    double rdotl = std::sqrt(am) * esine / rl;
+    double rvdotl = std::sqrt(pl) / rl;
+    double betal = std::sqrt(1.0 - el2);
+    temp = esine / (1.0 + betal);
+    double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+    double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+    double su = std::atan2(sinu, cosu);
+    double sin2u = (cosu + cosu) * sinu;
+    double cos2u = 1.0 - 2.0 * sinu * sinu;
+    temp = 1.0 / pl;
+    double temp1 = 0.5 * j2 * temp;
+    double temp2 = temp1 * temp;
+
+    // Short-period periodics
+    double mrt = rl * (1.0 - 1.5 * temp2 * betal * con41_p) + 0.5 * temp1 * x1mth2_p * cos2u;
+    su = su - 0.25 * temp2 * x7thm1_p * sin2u;
+    double xnode = nodep + 1.5 * temp2 * cosip * sin2u;
+    double xinc = xincp + 1.5 * temp2 * cosip * sinip * cos2u;
+    double mvt = rdotl - nm * temp1 * x1mth2_p * sin2u / xke;
+    double rvdot = rvdotl + nm * temp1 * (x1mth2_p * cos2u + 1.5 * con41_p) / xke;
+
+    // Orientation vectors
+    double sinsu = std::sin(su), cossu = std::cos(su);
+    double snod = std::sin(xnode), cnod = std::cos(xnode);
+    double sini = std::sin(xinc), cosi = std::cos(xinc);
+    double xmx = -snod * cosi;
+    double xmy = cnod * cosi;
+    double ux = xmx * sinsu + cnod * cossu;
+    double uy = xmy * sinsu + snod * cossu;
+    double uz = sini * sinsu;
+    double vx = xmx * cossu - cnod * sinsu;
+    double vy = xmy * cossu - snod * sinsu;
+    double vz = sini * cossu;
+
+    state.x = mrt * ux * radius_earth_km;
+    state.y = mrt * uy * radius_earth_km;
+    state.z = mrt * uz * radius_earth_km;
+    state.vx = (mvt * ux + rvdot * vx) * velocity_km_s;
+    state.vy = (mvt * uy + rvdot * vy) * velocity_km_s;
+    state.vz = (mvt * uz + rvdot * vz) * velocity_km_s;
+
+    if (mrt < 1.0) return DECAYED;
+    return OK;
+}
+
+inline void SGP4Propagator::set_gravity_model() {
+    double mu;
+    switch (config.gravity) {
+        case GravityModel::WGS72_OLD:
+            mu = 398600.79964;
+            radius_earth_km = 6378.135;
+            xke = 0.0743669161;
+            j2 = 0.001082616;
+            j3oj2 = -0.00000253881 / j2;
+            j4 = -0.00000165597;
+            break;
+        case GravityModel::WGS84:
+            mu = 398600.5;
+            radius_earth_km = 6378.137;
+            xke = 60.0 / std::sqrt(radius_earth_km * radius_earth_km * radius_earth_km / mu);
+            j2 = 0.00108262998905;
+            j3oj2 = -0.00000253215306 / j2;
+            j4 = -0.00000161098761;
+            break;
+        case GravityModel::WGS72:
+        default:
+            mu = 398600.8;
+            radius_earth_km = 6378.135;
+            xke = 60.0 / std::sqrt(radius_earth_km * radius_earth_km * radius_earth_km / mu);
+            j2 = 0.001082616;
+            j3oj2 = -0.00000253881 / j2;
+            j4 = -0.00000165597;
+            break;
+    }
+    velocity_km_s = radius_earth_km * xke / 60.0;
+}
+
+// Lunar and solar coefficients (Vallado's dscom)
+inline void SGP4Propagator::deep_space_common(double tc, DeepSpaceCommon& ds) {
+    const double two_pi = 2.0 * M_PI;
+    const double zes = 0.01675, zel = 0.05490;
+    const double c1ss = 2.9864797e-6, c1l = 4.7968065e-7;
+    const double zsinis = 0.39785416, zcosis = 0.91744867;
+    const double zcosgs = 0.1945905, zsings = -0.98088458;
+
+    double nm = no;
+    double em = ecco;
+    double snodm = std::sin(nodeo), cnodm = std::cos(nodeo);
+    double sinomm = std::sin(argpo), cosomm = std::cos(argpo);
+    ds.sinim = std::sin(inclo);
+    ds.cosim = std::cos(inclo);
+    ds.emsq = em * em;
+    double betasq = 1.0 - ds.emsq;
+    double rtemsq = std::sqrt(betasq);
+
+    peo = pinco = plo = pgho = pho = 0.0;
+    double day = epoch_jd - 2433281.5 + 18261.5 + tc / 1440.0;
+    double xnodce = std::fmod(4.5236020 - 9.2422029e-4 * day, two_pi);
+    double stem = std::sin(xnodce), ctem = std::cos(xnodce);
+    double zcosil = 0.91375164 - 0.03568096 * ctem;
+    double zsinil = std::sqrt(1.0 - zcosil * zcosil);
+    double zsinhl = 0.089683511 * stem / zsinil;
+    double zcoshl = std::sqrt(1.0 - zsinhl * zsinhl);
+    double gam = 5.8351514 + 0.0019443680 * day;
+    double zx = 0.39785416 * stem / zsinil;
+    double zy = zcoshl * ctem + 0.91744867 * zsinhl * stem;
+    zx = std::atan2(zx, zy);
+    zx = gam + zx - xnodce;
+    double zcosgl = std::cos(zx), zsingl = std::sin(zx);
+
+    // Pass 1 is the sun, pass 2 the moon
+    double zcosg = zcosgs, zsing = zsings, zcosi = zcosis, zsini = zsinis;
+    double zcosh = cnodm, zsinh = snodm;
+    double cc = c1ss;
+    double xnoi = 1.0 / nm;
+    double s1 = 0, s2 = 0, s3 = 0, s4 = 0, s5 = 0, s6 = 0, s7 = 0;
+    double ss6 = 0, ss7 = 0;
+    double z1 = 0, z2 = 0, z3 = 0, z11 = 0, z12 = 0, z13 = 0;
+    double z21 = 0, z22 = 0, z23 = 0, z31 = 0, z32 = 0, z33 = 0;
+    double sz2 = 0, sz12 = 0, sz22 = 0, sz32 = 0;
+
+    for (int lsflg = 1; lsflg <= 2; ++lsflg) {
+        double a1 = zcosg * zcosh + zsing * zcosi * zsinh;
+        double a3 = -zsing * zcosh + zcosg * zcosi * zsinh;
+        double a7 = -zcosg * zsinh + zsing * zcosi * zcosh;
+        double a8 = zsing * zsini;
+        double a9 = zsing * zsinh + zcosg * zcosi * zcosh;
+        double a10 = zcosg * zsini;
+        double a2 = ds.cosim * a7 + ds.sinim * a8;
+        double a4 = ds.cosim * a9 + ds.sinim * a10;
+        double a5 = -ds.sinim * a7 + ds.cosim * a8;
+        double a6 = -ds.sinim * a9 + ds.cosim * a10;
+
+        double x1 = a1 * cosomm + a2 * sinomm;
+        double x2 = a3 * cosomm + a4 * sinomm;
+        double x3 = -a1 * sinomm + a2 * cosomm;
+        double x4 = -a3 * sinomm + a4 * cosomm;
+        double x5 = a5 * sinomm;
+        double x6 = a6 * sinomm;
+        double x7 = a5 * cosomm;
+        double x8 = a6 * cosomm;
+
+        z31 = 12.0 * x1 * x1 - 3.0 * x3 * x3;
+        z32 = 24.0 * x1 * x2 - 6.0 * x3 * x4;
+        z33 = 12.0 * x2 * x2 - 3.0 * x4 * x4;
+        z1 = 3.0 * (a1 * a1 + a2 * a2) + z31 * ds.emsq;
+        z2 = 6.0 * (a1 * a3 + a2 * a4) + z32 * ds.emsq;
+        z3 = 3.0 * (a3 * a3 + a4 * a4) + z33 * ds.emsq;
+        z11 = -6.0 * a1 * a5 + ds.emsq * (-24.0 * x1 * x7 - 6.0 * x3 * x5);
+        z12 = -6.0 * (a1 * a6 + a3 * a5) +
+              ds.emsq * (-24.0 * (x2 * x7 + x1 * x8) - 6.0 * (x3 * x6 + x4 * x5));
+        z13 = -6.0 * a3 * a6 + ds.emsq * (-24.0 * x2 * x8 - 6.0 * x4 * x6);
+        z21 = 6.0 * a2 * a5 + ds.emsq * (24.0 * x1 * x5 - 6.0 * x3 * x7);
+        z22 = 6.0 * (a4 * a5 + a2 * a6) +
+              ds.emsq * (24.0 * (x2 * x5 + x1 * x6) - 6.0 * (x4 * x7 + x3 * x8));
+        z23 = 6.0 * a4 * a6 + ds.emsq * (24.0 * x2 * x6 - 6.0 * x4 * x8);
+        z1 = z1 + z1 + betasq * z31;
+        z2 = z2 + z2 + betasq * z32;
+        z3 = z3 + z3 + betasq * z33;
+        s3 = cc * xnoi;
+        s2 = -0.5 * s3 / rtemsq;
+        s4 = s3 * rtemsq;
+        s1 = -15.0 * em * s4;
+        s5 = x1 * x3 + x2 * x4;
+        s6 = x2 * x3 + x1 * x4;
+        s7 = x2 * x4 - x1 * x3;
+
+        if (lsflg == 1) {
+            ds.ss1 = s1; ds.ss2 = s2; ds.ss3 = s3; ds.ss4 = s4; ds.ss5 = s5;
+            ss6 = s6; ss7 = s7;
+            ds.sz1 = z1; sz2 = z2; ds.sz3 = z3;
+            ds.sz11 = z11; sz12 = z12; ds.sz13 = z13;
+            ds.sz21 = z21; sz22 = z22; ds.sz23 = z23;
+            ds.sz31 = z31; sz32 = z32; ds.sz33 = z33;
+            zcosg = zcosgl;
+            zsing = zsingl;
+            zcosi = zcosil;
+            zsini = zsinil;
+            zcosh = zcoshl * cnodm + zsinhl * snodm;
+            zsinh = snodm * zcoshl - cnodm * zsinhl;
+            cc = c1l;
+        }
+    }
+
+    ds.s1 = s1; ds.s2 = s2; ds.s3 = s3; ds.s4 = s4; ds.s5 = s5;
+    ds.z1 = z1; ds.z3 = z3; ds.z11 = z11; ds.z13 = z13;
+    ds.z21 = z21; ds.z23 = z23; ds.z31 = z31; ds.z33 = z33;
+
+    zmol = std::fmod(4.7199672 + 0.22997150 * day - gam, two_pi);
+    zmos = std::fmod(6.2565837 + 0.017201977 * day, two_pi);
+
+    // Solar terms
+    se2 = 2.0 * ds.ss1 * ss6;
+    se3 = 2.0 * ds.ss1 * ss7;
+    si2 = 2.0 * ds.ss2 * sz12;
+    si3 = 2.0 * ds.ss2 * (ds.sz13 - ds.sz11);
+    sl2 = -2.0 * ds.ss3 * sz2;
+    sl3 = -2.0 * ds.ss3 * (ds.sz3 - ds.sz1);
+    sl4 = -2.0 * ds.ss3 * (-21.0 - 9.0 * ds.emsq) * zes;
+    sgh2 = 2.0 * ds.ss4 * sz32;
+    sgh3 = 2.0 * ds.ss4 * (ds.sz33 - ds.sz31);
+    sgh4 = -18.0 * ds.ss4 * zes;
+    sh2 = -2.0 * ds.ss2 * sz22;
+    sh3 = -2.0 * ds.ss2 * (ds.sz23 - ds.sz21);
+
+    // Lunar terms
+    ee2 = 2.0 * s1 * s6;
+    e3 = 2.0 * s1 * s7;
+    xi2 = 2.0 * s2 * z12;
+    xi3 = 2.0 * s2 * (z13 - z11);
+    xl2 = -2.0 * s3 * z2;
+    xl3 = -2.0 * s3 * (z3 - z1);
+    xl4 = -2.0 * s3 * (-21.0 - 9.0 * ds.emsq) * zel;
+    xgh2 = 2.0 * s4 * z32;
+    xgh3 = 2.0 * s4 * (z33 - z31);
+    xgh4 = -18.0 * s4 * zel;
+    xh2 = -2.0 * s2 * z22;
+    xh3 = -2.0 * s2 * (z23 - z21);
+}
+
+// Secular lunar-solar rates and 12h/24h resonance coefficients (dsinit)
+inline void SGP4Propagator::deep_space_init(const DeepSpaceCommon& ds, double xpidot) {
+    const double two_pi = 2.0 * M_PI;
+    const double x2o3 = 2.0 / 3.0;
+    const double q22 = 1.7891679e-6, q31 = 2.1460748e-6, q33 = 2.2123015e-7;
+    const double root22 = 1.7891679e-6, root44 = 7.3636953e-9, root54 = 2.1765803e-9;
+    const double root32 = 3.7393792e-7, root52 = 1.1428639e-7;
+    const double rptim = 4.37526908801129966e-3;
+    const double znl = 1.5835218e-4, zns = 1.19459e-5;
+
+    double nm = no;
+    double em = ecco;
+    double emsq = ds.emsq;
+    double sinim = ds.sinim, cosim = ds.cosim;
+
+    irez = 0;
+    if (nm < 0.0052359877 && nm > 0.0034906585) irez = 1;
+    if (nm >= 8.26e-3 && nm <= 9.24e-3 && em >= 0.5) irez = 2;
+
+    // Solar secular terms
+    double ses = ds.ss1 * zns * ds.ss5;
+    double sis = ds.ss2 * zns * (ds.sz11 + ds.sz13);
+    double sls = -zns * ds.ss3 * (ds.sz1 + ds.sz3 - 14.0 - 6.0 * emsq);
+    double sghs = ds.ss4 * zns * (ds.sz31 + ds.sz33 - 6.0);
+    double shs = -zns * ds.ss2 * (ds.sz21 + ds.sz23);
+    if (inclo < 5.2359877e-2 || inclo > M_PI - 5.2359877e-2) shs = 0.0;
+    if (sinim != 0.0) shs = shs / sinim;
+    double sgs = sghs - cosim * shs;
+
+    // Lunar secular terms
+    dedt = ses + ds.s1 * znl * ds.s5;
+    didt = sis + ds.s2 * znl * (ds.z11 + ds.z13);
+    dmdt = sls - znl * ds.s3 * (ds.z1 + ds.z3 - 14.0 - 6.0 * emsq);
+    double sghl = ds.s4 * znl * (ds.z31 + ds.z33 - 6.0);
+    double shll = -znl * ds.s2 * (ds.z21 + ds.z23);
+    if (inclo < 5.2359877e-2 || inclo > M_PI - 5.2359877e-2) shll = 0.0;
+    domdt = sgs + sghl;
+    dnodt = shs;
+    if (sinim != 0.0) {
+        domdt = domdt - cosim / sinim * shll;
+        dnodt = dnodt + shll / sinim;
+    }
+
+    d2201 = d2211 = d3210 = d3222 = d4410 = d4422 = 0.0;
+    d5220 = d5232 = d5421 = d5433 = 0.0;
+    del1 = del2 = del3 = 0.0;
+    xfact = xlamo = 0.0;
+
+    if (irez == 0) return;
+
+    double theta = std::fmod(gsto, two_pi);
+    double aonv = std::pow(nm / xke, x2o3);
+
+    if (irez == 2) {
+        // Half-day (Molniya) resonance, evaluated at the epoch eccentricity
+        double cosisq = cosim * cosim;
+        double eoc = em * emsq;
+        double g201 = -0.306 - (em - 0.64) * 0.440;
+        double g211, g310, g322, g410, g422, g520, g521, g532, g533;
+        if (em <= 0.65) {
+            g211 = 3.616 - 13.2470 * em + 16.2900 * emsq;
+            g310 = -19.302 + 117.3900 * em - 228.4190 * emsq + 156.5910 * eoc;
+            g322 = -18.9068 + 109.7927 * em - 214.6334 * emsq + 146.5816 * eoc;
+            g410 = -41.122 + 242.6940 * em - 471.0940 * emsq + 313.9530 * eoc;
+            g422 = -146.407 + 841.8800 * em - 1629.014 * emsq + 1083.4350 * eoc;
+            g520 = -532.114 + 3017.977 * em - 5740.032 * emsq + 3708.2760 * eoc;
+        } else {
+            g211 = -72.099 + 331.819 * em - 508.738 * emsq + 266.724 * eoc;
+            g310 = -346.844 + 1582.851 * em - 2415.925 * emsq + 1246.113 * eoc;
+            g322 = -342.585 + 1554.908 * em - 2366.899 * emsq + 1215.972 * eoc;
+            g410 = -1052.797 + 4758.686 * em - 7193.992 * emsq + 3651.957 * eoc;
+            g422 = -3581.690 + 16178.110 * em - 24462.770 * emsq + 12422.520 * eoc;
+            if (em > 0.715) g520 = -5149.66 + 29936.92 * em - 54087.36 * emsq + 31324.56 * eoc;
+            else g520 = 1464.74 - 4664.75 * em + 3763.64 * emsq;
+        }
+        if (em < 0.7) {
+            g533 = -919.22770 + 4988.6100 * em - 9064.7700 * emsq + 5542.21 * eoc;
+            g521 = -822.71072 + 4568.6173 * em - 8491.4146 * emsq + 5337.524 * eoc;
+            g532 = -853.66600 + 4690.2500 * em - 8624.7700 * emsq + 5341.4 * eoc;
+        } else {
+            g533 = -37995.780 + 161616.52 * em - 229838.20 * emsq + 109377.94 * eoc;
+            g521 = -51752.104 + 218913.95 * em - 309468.16 * emsq + 146349.42 * eoc;
+            g532 = -40023.880 + 170470.89 * em - 242699.48 * emsq + 115605.82 * eoc;
+        }
+
+        double sini2 = sinim * sinim;
+        double f220 = 0.75 * (1.0 + 2.0 * cosim + cosisq);
+        double f221 = 1.5 * sini2;
+        double f321 = 1.875 * sinim * (1.0 - 2.0 * cosim - 3.0 * cosisq);
+        double f322 = -1.875 * sinim * (1.0 + 2.0 * cosim - 3.0 * cosisq);
+        double f441 = 35.0 * sini2 * f220;
+        double f442 = 39.3750 * sini2 * sini2;
+        double f522 = 9.84375 * sinim * (sini2 * (1.0 - 2.0 * cosim - 5.0 * cosisq) +
+                      0.33333333 * (-2.0 + 4.0 * cosim + 6.0 * cosisq));
+        double f523 = sinim * (4.92187512 * sini2 * (-2.0 - 4.0 * cosim + 10.0 * cosisq) +
+                      6.56250012 * (1.0 + 2.0 * cosim - 3.0 * cosisq));
+        double f542 = 29.53125 * sinim * (2.0 - 8.0 * cosim + cosisq * (-12.0 + 8.0 * cosim + 10.0 * cosisq));
+        double f543 = 29.53125 * sinim * (-2.0 - 8.0 * cosim + cosisq * (12.0 + 8.0 * cosim - 10.0 * cosisq));
+
+        double xno2 = nm * nm;
+        double ainv2 = aonv * aonv;
+        double temp1 = 3.0 * xno2 * ainv2;
+        double temp = temp1 * root22;
+        d2201 = temp * f220 * g201;
+        d2211 = temp * f221 * g211;
+        temp1 = temp1 * aonv;
+        temp = temp1 * root32;
+        d3210 = temp * f321 * g310;
+        d3222 = temp * f322 * g322;
+        temp1 = temp1 * aonv;
+        temp = 2.0 * temp1 * root44;
+        d4410 = temp * f441 * g410;
+        d4422 = temp * f442 * g422;
+        temp1 = temp1 * aonv;
+        temp = temp1 * root52;
+        d5220 = temp * f522 * g520;
+        d5232 = temp * f523 * g532;
+        temp = 2.0 * temp1 * root54;
+        d5421 = temp * f542 * g521;
+        d5433 = temp * f543 * g533;
+        xlamo = std::fmod(mo + nodeo + nodeo - theta - theta, two_pi);
+        xfact = mdot + dmdt + 2.0 * (nodedot + dnodt - rptim) - no;
+    } else {
+        // One-day (geosynchronous) resonance
+        double g200 = 1.0 + emsq * (-2.5 + 0.8125 * emsq);
+        double g310 = 1.0 + 2.0 * emsq;
+        double g300 = 1.0 + emsq * (-6.0 + 6.60937 * emsq);
+        double f220 = 0.75 * (1.0 + cosim) * (1.0 + cosim);
+        double f311 = 0.9375 * sinim * sinim * (1.0 + 3.0 * cosim) - 0.75 * (1.0 + cosim);
+        double f330 = 1.0 + cosim;
+        f330 = 1.875 * f330 * f330 * f330;
+        del1 = 3.0 * nm * nm * aonv * aonv;
+        del2 = 2.0 * del1 * f220 * g200 * q22;
+        del3 = 3.0 * del1 * f330 * g300 * q33 * aonv;
+        del1 = del1 * f311 * g310 * q31 * aonv;
+        xlamo = std::fmod(mo + nodeo + argpo - theta, two_pi);
+        xfact = mdot + xpidot - rptim + dmdt + domdt + dnodt - no;
+    }
+
+    resonance.xli = xlamo;
+    resonance.xni = no;
+    resonance.atime = 0.0;
+}
+
+// Deep-space secular effects and resonance integration (dspace)
+inline void SGP4Propagator::deep_space_secular(double t, double& em, double& argpm, double& inclm,
+                                               double& mm, double& nodem, double& nm, Resonance& rs) const {
+    const double two_pi = 2.0 * M_PI;
+    const double fasx2 = 0.13130908, fasx4 = 2.8843198, fasx6 = 0.37448087;
+    const double g22 = 5.7686396, g32 = 0.95240898, g44 = 1.8014998;
+    const double g52 = 1.0508330, g54 = 4.4108898;
+    const double rptim = 4.37526908801129966e-3;
+    const double stepp = 720.0, stepn = -720.0, step2 = 259200.0;
+
+    double theta = std::fmod(gsto + t * rptim, two_pi);
+    em += dedt * t;
+    inclm += didt * t;
+    argpm += domdt * t;
+    nodem += dnodt * t;
+    mm += dmdt * t;
+
+    if (irez == 0) return;
+    double& atime = rs.atime;
+    double& xli = rs.xli;
+    double& xni = rs.xni;
+
+    // Restart the integrator at epoch when stepping backwards or across it
+    if (atime == 0.0 || t * atime <= 0.0 || std::fabs(t) < std::fabs(atime)) {
+        atime = 0.0;
+        xni = no;
+        xli = xlamo;
+    }
+    double delt = t > 0.0 ? stepp : stepn;
+
+    double xndt = 0.0, xnddt = 0.0, xldot = 0.0, ft = 0.0;
+    for (;;) {
+        if (irez != 2) {
+            xndt = del1 * std::sin(xli - fasx2) + del2 * std::sin(2.0 * (xli - fasx4)) +
+                   del3 * std::sin(3.0 * (xli - fasx6));
+            xldot = xni + xfact;
+            xnddt = del1 * std::cos(xli - fasx2) + 2.0 * del2 * std::cos(2.0 * (xli - fasx4)) +
+                    3.0 * del3 * std::cos(3.0 * (xli - fasx6));
+            xnddt *= xldot;
+        } else {
+            double xomi = argpo + argpdot * atime;
+            double x2omi = xomi + xomi;
+            double x2li = xli + xli;
+            xndt = d2201 * std::sin(x2omi + xli - g22) + d2211 * std::sin(xli - g22) +
+                   d3210 * std::sin(xomi + xli - g32) + d3222 * std::sin(-xomi + xli - g32) +
+                   d4410 * std::sin(x2omi + x2li - g44) + d4422 * std::sin(x2li - g44) +
+                   d5220 * std::sin(xomi + xli - g52) + d5232 * std::sin(-xomi + xli - g52) +
+                   d5421 * std::sin(xomi + x2li - g54) + d5433 * std::sin(-xomi + x2li - g54);
+            xldot = xni + xfact;
+            xnddt = d2201 * std::cos(x2omi + xli - g22) + d2211 * std::cos(xli - g22) +
+                    d3210 * std::cos(xomi + xli - g32) + d3222 * std::cos(-xomi + xli - g32) +
+                    d5220 * std::cos(xomi + xli - g52) + d5232 * std::cos(-xomi + xli - g52) +
+                    2.0 * (d4410 * std::cos(x2omi + x2li - g44) + d4422 * std::cos(x2li - g44) +
+                           d5421 * std::cos(xomi + x2li - g54) + d5433 * std::cos(-xomi + x2li - g54));
+            xnddt *= xldot;
+        }
+
+        if (std::fabs(t - atime) < stepp) {
+            ft = t - atime;
+            break;
+        }
+        xli += xldot * delt + xndt * step2;
+        xni += xndt * delt + xnddt * step2;
+        atime += delt;
+    }
+
+    nm = xni + xndt * ft + xnddt * ft * ft * 0.5;
+    double xl = xli + xldot * ft + xndt * ft * ft * 0.5;
+    if (irez != 1) mm = xl - 2.0 * nodem + 2.0 * theta;
+    else mm = xl - nodem - argpm + theta;
+}
+
+// Lunar-solar periodic perturbations (dpper)
+inline void SGP4Propagator::deep_space_periodics(double t, double& ep, double& inclp, double& nodep,
+                                                 double& argpp, double& mp) const {
+    const double two_pi = 2.0 * M_PI;
+    const double zns = 1.19459e-5, zes = 0.01675;
+    const double znl = 1.5835218e-4, zel = 0.05490;
+
+    double zm = zmos + zns * t;
+    double zf = zm + 2.0 * zes * std::sin(zm);
+    double sinzf = std::sin(zf);
+    double f2 = 0.5 * sinzf * sinzf - 0.25;
+    double f3 = -0.5 * sinzf * std::cos(zf);
+    double ses = se2 * f2 + se3 * f3;
+    double sis = si2 * f2 + si3 * f3;
+    double sls = sl2 * f2 + sl3 * f3 + sl4 * sinzf;
+    double sghs = sgh2 * f2 + sgh3 * f3 + sgh4 * sinzf;
+    double shs = sh2 * f2 + sh3 * f3;
+
+    zm = zmol + znl * t;
+    zf = zm + 2.0 * zel * std::sin(zm);
+    sinzf = std::sin(zf);
+    f2 = 0.5 * sinzf * sinzf - 0.25;
+    f3 = -0.5 * sinzf * std::cos(zf);
+    double sel = ee2 * f2 + e3 * f3;
+    double sil = xi2 * f2 + xi3 * f3;
+    double sll = xl2 * f2 + xl3 * f3 + xl4 * sinzf;
+    double sghl = xgh2 * f2 + xgh3 * f3 + xgh4 * sinzf;
+    double shll = xh2 * f2 + xh3 * f3;
+
+    double pe = ses + sel - peo;
+    double pinc = sis + sil - pinco;
+    double pl = sls + sll - plo;
+    double pgh = sghs + sghl - pgho;
+    double ph = shs + shll - pho;
+
+    inclp += pinc;
+    ep += pe;
+    double sinip = std::sin(inclp);
+    double cosip = std::cos(inclp);
+
+    if (inclp >= 0.2) {
+        ph /= sinip;
+        pgh -= cosip * ph;
+        argpp += pgh;
+        nodep += ph;
+        mp += pl;
+    } else {
+        // Lyddane modification for low inclinations
+        double sinop = std::sin(nodep);
+        double cosop = std::cos(nodep);
+        double alfdp = sinip * sinop + (ph * cosop + pinc * cosip * sinop);
+        double betdp = sinip * cosop + (-ph * sinop + pinc * cosip * cosop);
+        nodep = std::fmod(nodep, two_pi);
+        if (nodep < 0.0 && config.afspc_mode) nodep += two_pi;
+        double xls = mp + argpp + cosip * nodep;
+        double dls = pl + pgh - pinc * nodep * sinip;
+        xls += dls;
+        double xnoh = nodep;
+        nodep = std::atan2(alfdp, betdp);
+        if (nodep < 0.0 && config.afspc_mode) nodep += two_pi;
+        if (std::fabs(xnoh - nodep) > M_PI) {
+            if (nodep < xnoh) nodep += two_pi;
+            else nodep -= two_pi;
+        }
+        mp += pl;
+        argpp = xls - mp - cosip * nodep;
+    }
+}
+
+}  // namespace SatelliteSignal
+
+#endif // SGP4_PROPAGATOR_H
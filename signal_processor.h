@@ -7,6 +7,7 @@
 #include <cmath>
 #include <algorithm>
 #include <array>
+#include "scoped_trace.h"
 
 namespace SatelliteSignal {
 
@@ -57,6 +58,7 @@ public:
     }
 
     std::vector<double> process_buffer(const std::vector<double>& input) {
+        TRACE_SCOPE("FIRFilter::process_buffer");
         std::vector<double> output(input.size());
         for (size_t i = 0; i < input.size(); ++i) {
             output[i] = process(input[i]);
@@ -137,6 +139,7 @@ public:
           pll(carrier_freq) {}
 
     std::vector<int> demodulate(const std::vector<ComplexSample>& symbols) {
+        TRACE_SCOPE("QPSKDemodulator::demodulate");
         decisions.clear();
         decisions.reserve(symbols.size());
         
@@ -0,0 +1,117 @@
+#ifndef STATION_FRAME_H
+#define STATION_FRAME_H
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <algorithm>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#include "orbital_types.h"
+
+namespace SatelliteSignal {
+
+// Branch-free atan2 that vectorizes. Both arguments are folded into the
+// first octant, then the Cephes rational approximation for atan on
+// [0, 0.66] (with the pi/4 shift above that) gives full double precision.
+// Selects are written as arithmetic on 0/1 flags so plain SSE2 can
+// vectorize loops over it.
+inline double fast_atan2(double y, double x) {
+    double ay = std::fabs(y), ax = std::fabs(x);
+    double z = std::min(ay, ax) / std::max(std::max(ay, ax), 1e-300);
+
+    double big = static_cast<double>(z > 0.66);
+    double shifted = (z - 1.0) / (z + 1.0);
+    double u = z + big * (shifted - z);
+    double u2 = u * u;
+    double p = -8.750608600031904122785e-1;
+    p = p * u2 - 1.615753718733365076637e1;
+    p = p * u2 - 7.500855792314704667340e1;
+    p = p * u2 - 1.228866684490136173410e2;
+    p = p * u2 - 6.485021904942025371773e1;
+    double q = u2 + 2.485846490142306297962e1;
+    q = q * u2 + 1.650270098316988542046e2;
+    q = q * u2 + 4.328810604912902668951e2;
+    q = q * u2 + 4.853903996359136964868e2;
+    q = q * u2 + 1.945506571482613964425e2;
+    double r = big * (M_PI / 4.0) + u + u * u2 * p / q;
+
+    r += static_cast<double>(ay > ax) * (M_PI / 2.0 - 2.0 * r);
+    r += static_cast<double>(x < 0.0) * (M_PI - 2.0 * r);
+    return std::copysign(r, y);
+}
+
+// Ground station with everything that depends only on its location computed
+// once: the WGS84 Earth-fixed position and the Earth-fixed to
+// south-east-zenith rotation. A view at a given time rotates the satellite's
+// TEME state into the Earth-fixed frame by GMST, so Earth rotation is
+// accounted for in both the geometry and the range rate.
+class StationFrame {
+public:
+    explicit StationFrame(const GroundStation& location) : station(location) {
+        double lat = location.latitude * DEG_TO_RAD;
+        double lon = location.longitude * DEG_TO_RAD;
+        double alt_km = location.elevation / 1000.0;
+        double sin_lat = std::sin(lat), cos_lat = std::cos(lat);
+        double sin_lon = std::sin(lon), cos_lon = std::cos(lon);
+
+        double e2 = WGS84_F * (2.0 - WGS84_F);
+        double n = WGS84_A_KM / std::sqrt(1.0 - e2 * sin_lat * sin_lat);
+        x = (n + alt_km) * cos_lat * cos_lon;
+        y = (n + alt_km) * cos_lat * sin_lon;
+        z = (n * (1.0 - e2) + alt_km) * sin_lat;
+
+        south[0] = sin_lat * cos_lon; south[1] = sin_lat * sin_lon; south[2] = -cos_lat;
+        east[0] = -sin_lon;           east[1] = cos_lon;            east[2] = 0.0;
+        zenith[0] = cos_lat * cos_lon; zenith[1] = cos_lat * sin_lon; zenith[2] = sin_lat;
+    }
+
+    // Azimuth/elevation/range/range-rate of a TEME state at sidereal angle
+    // `gmst` (radians)
+    TopocentricView view(const StateVector& s, double gmst) const {
+        double c = std::cos(gmst), sn = std::sin(gmst);
+        double rx = c * s.x + sn * s.y;
+        double ry = -sn * s.x + c * s.y;
+        double rz = s.z;
+        double vx = c * s.vx + sn * s.vy + EARTH_ROTATION_RATE * ry;
+        double vy = -sn * s.vx + c * s.vy - EARTH_ROTATION_RATE * rx;
+        double vz = s.vz;
+
+        double dx = rx - x, dy = ry - y, dz = rz - z;
+        double range = std::sqrt(dx * dx + dy * dy + dz * dz);
+        double sk = south[0] * dx + south[1] * dy + south[2] * dz;
+        double ek = east[0] * dx + east[1] * dy;
+        double zk = zenith[0] * dx + zenith[1] * dy + zenith[2] * dz;
+
+        double azimuth = std::atan2(ek, -sk) * RAD_TO_DEG;
+        if (azimuth < 0.0) azimuth += 360.0;
+        double elevation = std::atan2(zk, std::sqrt(sk * sk + ek * ek)) * RAD_TO_DEG;
+        double range_rate = (vx * dx + vy * dy + vz * dz) / range;
+        return {azimuth, elevation, range, range_rate};
+    }
+
+    // Station position and velocity in TEME at sidereal angle `gmst`
+    StateVector inertial_state(double gmst) const {
+        double c = std::cos(gmst), sn = std::sin(gmst);
+        double ix = c * x - sn * y;
+        double iy = sn * x + c * y;
+        return {ix, iy, z, -EARTH_ROTATION_RATE * iy, EARTH_ROTATION_RATE * ix, 0.0};
+    }
+
+    const GroundStation& get_station() const { return station; }
+    double get_x() const { return x; }
+    double get_y() const { return y; }
+    double get_z() const { return z; }
+    const double* get_south() const { return south; }
+    const double* get_east() const { return east; }
+    const double* get_zenith() const { return zenith; }
+
+private:
+    GroundStation station;
+    double x, y, z;                      // Earth-fixed position, km
+    double south[3], east[3], zenith[3]; // rows of the Earth-fixed to SEZ rotation
+};
+
+}  // namespace SatelliteSignal
+
+#endif // STATION_FRAME_H
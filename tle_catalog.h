@@ -0,0 +1,461 @@
+#ifndef TLE_CATALOG_H
+#define TLE_CATALOG_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "orbital_types.h"
+#include "sgp4_propagator.h"
+#include "mapped_file.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Catalog of two-line element sets loaded from a memory-mapped file. Records
+// may be plain 2-line sets or 3-line sets with a name line (with or without
+// the "0 " prefix). The file is split into records in one pass over the
+// mapping, then fixed-column fields are parsed in parallel straight from the
+// mapped bytes, and an SGP4 propagator is initialized per satellite.
+//
+// reload() re-reads the file and only re-initializes satellites whose element
+// set changed (its number, epoch or any mean element); unchanged satellites
+// keep their propagator.
+class TLECatalog {
+public:
+    struct Config {
+        unsigned num_threads = 0;       // 0 = all cores
+        size_t grain = 512;             // records per work item
+        bool verify_checksums = true;
+        SGP4Propagator::Config sgp4;
+    };
+
+    enum class ParseStatus : uint8_t { OK, MALFORMED, CHECKSUM };
+
+    struct LoadStats {
+        size_t records = 0;             // 2-line sets found in the file
+        size_t loaded = 0;              // satellites in the catalog afterwards
+        size_t malformed = 0;
+        size_t checksum_failures = 0;
+        size_t added = 0;
+        size_t updated = 0;             // element set number, epoch or elements changed
+        size_t unchanged = 0;
+        size_t removed = 0;
+        double seconds = 0.0;
+    };
+
+    TLECatalog() : TLECatalog(Config()) {}
+    explicit TLECatalog(const Config& cfg) : config(cfg) {}
+
+    // Replace the catalog with the contents of `path`
+    bool load(const std::string& path) {
+        MappedFile file(path);
+        if (!file.good()) return false;
+        load_buffer(file.data(), file.size());
+        return true;
+    }
+
+    void load_buffer(const char* data, size_t size) {
+        clear();
+        reload_buffer(data, size);
+    }
+
+    // Merge `path` into the catalog keyed on catalog number
+    bool reload(const std::string& path) {
+        MappedFile file(path);
+        if (!file.good()) return false;
+        reload_buffer(file.data(), file.size());
+        return true;
+    }
+
+    void reload_buffer(const char* data, size_t size) {
+        auto start = std::chrono::steady_clock::now();
+        LoadStats st;
+
+        std::vector<TLE> fresh;
+        parse_buffer(data, size, fresh, st);
+
+        // Match against the current catalog; only new or changed sets need
+        // an SGP4 initialization. Propagators are heap-held so carrying an
+        // unchanged one across is a pointer move, not a copy of its state.
+        std::vector<std::unique_ptr<SGP4Propagator>> fresh_props(fresh.size());
+        std::vector<size_t> to_init;
+        size_t matched = 0;
+        for (size_t j = 0; j < fresh.size(); ++j) {
+            auto it = index.find(fresh[j].catalog_number);
+            if (it == index.end()) {
+                ++st.added;
+                to_init.push_back(j);
+            } else if (!same_element_set(tles[it->second], fresh[j])) {
+                ++matched;
+                ++st.updated;
+                to_init.push_back(j);
+            } else {
+                ++matched;
+                ++st.unchanged;
+                fresh_props[j] = std::move(propagators[it->second]);
+            }
+        }
+        st.removed = tles.size() - matched;
+
+        parallel_for(to_init.size(), [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; ++i) {
+                size_t j = to_init[i];
+                fresh_props[j] = std::make_unique<SGP4Propagator>(fresh[j], config.sgp4);
+            }
+        }, config.grain, config.num_threads);
+
+        tles.swap(fresh);
+        propagators.swap(fresh_props);
+        index.clear();
+        index.reserve(tles.size());
+        for (size_t i = 0; i < tles.size(); ++i) index[tles[i].catalog_number] = i;
+
+        st.loaded = tles.size();
+        st.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stats = st;
+    }
+
+    void clear() {
+        tles.clear();
+        propagators.clear();
+        index.clear();
+    }
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    size_t size() const { return tles.size(); }
+    const TLE& get_tle(size_t i) const { return tles[i]; }
+    const std::vector<TLE>& get_tles() const { return tles; }
+    SGP4Propagator& get_propagator(size_t i) { return *propagators[i]; }
+    const LoadStats& get_stats() const { return stats; }
+    const Config& get_config() const { return config; }
+
+    size_t find(long catalog_number) const {
+        auto it = index.find(catalog_number);
+        return it == index.end() ? npos : it->second;
+    }
+
+    // Parse one element set; `name` may be empty
+    static ParseStatus parse(const std::string& name, const std::string& line1,
+                             const std::string& line2, TLE& out, bool verify_checksums = true) {
+        return parse_record(name.data(), name.size(), line1.data(), line1.size(),
+                            line2.data(), line2.size(), out, verify_checksums);
+    }
+
+    static ParseStatus parse_record(const char* name, size_t name_len,
+                                    const char* l1, size_t len1,
+                                    const char* l2, size_t len2,
+                                    TLE& out, bool verify_checksums) {
+        const size_t min_len = verify_checksums ? 69 : 68;
+        if (len1 < min_len || len2 < min_len || l1[0] != '1' || l2[0] != '2') {
+            return ParseStatus::MALFORMED;
+        }
+        if (verify_checksums && (l1[68] - '0' != checksum(l1) || l2[68] - '0' != checksum(l2))) {
+            return ParseStatus::CHECKSUM;
+        }
+
+        out = TLE();
+        copy_name(name, name_len, out);
+
+        long satnum2 = 0;
+        long epoch_year = 0;
+        long elset = 0;
+        long revs = 0;
+        bool ok = parse_satnum(l1 + 2, out.catalog_number) &&
+                  parse_satnum(l2 + 2, satnum2) &&
+                  parse_int(l1 + 18, 2, epoch_year) &&
+                  parse_decimal(l1 + 20, 12, out.epoch_day) &&
+                  parse_decimal(l1 + 33, 10, out.ndot) &&
+                  parse_implied(l1 + 44, out.nddot) &&
+                  parse_implied(l1 + 53, out.bstar) &&
+                  parse_int(l1 + 64, 4, elset) &&
+                  parse_decimal(l2 + 8, 8, out.inclination) &&
+                  parse_decimal(l2 + 17, 8, out.raan) &&
+                  parse_fraction(l2 + 26, 7, out.eccentricity) &&
+                  parse_decimal(l2 + 34, 8, out.argument_perigee) &&
+                  parse_decimal(l2 + 43, 8, out.mean_anomaly) &&
+                  parse_decimal(l2 + 52, 11, out.mean_motion) &&
+                  parse_int(l2 + 63, 5, revs);
+        if (!ok || satnum2 != out.catalog_number) return ParseStatus::MALFORMED;
+
+        out.epoch_year = static_cast<int>(epoch_year);
+        out.element_set_num = static_cast<int>(elset);
+        out.element_number = revs;
+        out.inclination *= DEG_TO_RAD;
+        out.raan *= DEG_TO_RAD;
+        out.argument_perigee *= DEG_TO_RAD;
+        out.mean_anomaly *= DEG_TO_RAD;
+        return ParseStatus::OK;
+    }
+
+    // Standard line checksum: digits count at face value, '-' counts as 1
+    static int checksum(const char* line) {
+        int sum = 0;
+        for (int i = 0; i < 68; ++i) {
+            char c = line[i];
+            if (c >= '0' && c <= '9') sum += c - '0';
+            else if (c == '-') sum += 1;
+        }
+        return sum % 10;
+    }
+
+    // Write `tle` back out as two 69-column lines with checksums
+    static void format_lines(const TLE& tle, std::string& line1, std::string& line2) {
+        char satnum[24];
+        format_satnum(tle.catalog_number, satnum);
+        char ndot[32], nddot[24], bstar[24];
+        long ndot_digits = std::lround(std::fabs(tle.ndot) * 1e8);
+        std::snprintf(ndot, sizeof(ndot), "%c.%08ld", tle.ndot < 0.0 ? '-' : ' ', ndot_digits % 100000000);
+        format_implied(tle.nddot, nddot);
+        format_implied(tle.bstar, bstar);
+
+        char buf[256];
+        std::snprintf(buf, sizeof(buf), "1 %sU          %02d%012.8f %s %s %s 0 %4d",
+                      satnum, tle.epoch_year % 100, tle.epoch_day, ndot, nddot, bstar,
+                      tle.element_set_num % 10000);
+        line1.assign(buf, 68);
+        line1.push_back(static_cast<char>('0' + checksum(line1.data())));
+
+        std::snprintf(buf, sizeof(buf), "2 %s %8.4f %8.4f %07ld %8.4f %8.4f %11.8f%5ld",
+                      satnum, wrap_degrees(tle.inclination), wrap_degrees(tle.raan),
+                      std::lround(tle.eccentricity * 1e7), wrap_degrees(tle.argument_perigee),
+                      wrap_degrees(tle.mean_anomaly), tle.mean_motion, tle.element_number % 100000);
+        line2.assign(buf, 68);
+        line2.push_back(static_cast<char>('0' + checksum(line2.data())));
+    }
+
+private:
+    Config config;
+    std::vector<TLE> tles;
+    std::vector<std::unique_ptr<SGP4Propagator>> propagators;
+    std::unordered_map<long, size_t> index;
+    LoadStats stats;
+
+    // Hand-edited or regenerated sets can change the epoch or elements
+    // without bumping the element set number, so that alone is not enough
+    static bool same_element_set(const TLE& a, const TLE& b) {
+        return a.element_set_num == b.element_set_num && a.epoch_year == b.epoch_year &&
+               a.epoch_day == b.epoch_day && a.ndot == b.ndot && a.nddot == b.nddot &&
+               a.bstar == b.bstar && a.mean_motion == b.mean_motion &&
+               a.inclination == b.inclination && a.raan == b.raan &&
+               a.eccentricity == b.eccentricity && a.argument_perigee == b.argument_perigee &&
+               a.mean_anomaly == b.mean_anomaly;
+    }
+
+    struct Record {
+        const char* name;
+        const char* line1;
+        const char* line2;
+        uint32_t name_len, len1, len2;
+    };
+
+    // Split into records in one pass, then parse them in parallel. Later
+    // duplicates of a catalog number replace earlier ones.
+    void parse_buffer(const char* data, size_t size, std::vector<TLE>& out, LoadStats& st) const {
+        std::vector<Record> records;
+        split_records(data, size, records);
+        st.records = records.size();
+
+        std::vector<TLE> parsed(records.size());
+        std::vector<ParseStatus> status(records.size());
+        parallel_for(records.size(), [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; ++i) {
+                const Record& r = records[i];
+                status[i] = parse_record(r.name, r.name_len, r.line1, r.len1, r.line2, r.len2,
+                                         parsed[i], config.verify_checksums);
+            }
+        }, config.grain, config.num_threads);
+
+        out.clear();
+        out.reserve(records.size());
+        std::unordered_map<long, size_t> seen;
+        seen.reserve(records.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            if (status[i] == ParseStatus::MALFORMED) { ++st.malformed; continue; }
+            if (status[i] == ParseStatus::CHECKSUM) { ++st.checksum_failures; continue; }
+            auto inserted = seen.emplace(parsed[i].catalog_number, out.size());
+            if (inserted.second) out.push_back(parsed[i]);
+            else out[inserted.first->second] = parsed[i];
+        }
+    }
+
+    static void split_records(const char* data, size_t size, std::vector<Record>& records) {
+        records.reserve(size / 160);
+        const char* end = data + size;
+        const char* p = data;
+        const char* name = nullptr;
+        size_t name_len = 0;
+        const char* line1 = nullptr;
+        size_t len1 = 0;
+
+        while (p < end) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            const char* line_end = nl ? nl : end;
+            size_t len = static_cast<size_t>(line_end - p);
+            if (len > 0 && p[len - 1] == '\r') --len;
+
+            if (len >= 2 && p[0] == '1' && p[1] == ' ') {
+                line1 = p;
+                len1 = len;
+            } else if (len >= 2 && p[0] == '2' && p[1] == ' ' && line1) {
+                records.push_back({name, line1, p, static_cast<uint32_t>(name_len),
+                                   static_cast<uint32_t>(len1), static_cast<uint32_t>(len)});
+                name = nullptr;
+                name_len = 0;
+                line1 = nullptr;
+            } else {
+                line1 = nullptr;
+                if (len > 0) {
+                    name = p;
+                    name_len = len;
+                }
+            }
+            p = line_end + 1;
+        }
+    }
+
+    static void copy_name(const char* name, size_t len, TLE& out) {
+        out.satellite_name.fill('\0');
+        if (!name) return;
+        if (len >= 2 && name[0] == '0' && name[1] == ' ') {
+            name += 2;
+            len -= 2;
+        }
+        while (len > 0 && (name[len - 1] == ' ' || name[len - 1] == '\t')) --len;
+        len = std::min(len, out.satellite_name.size() - 1);
+        std::memcpy(out.satellite_name.data(), name, len);
+    }
+
+    static bool parse_int(const char* p, size_t n, long& out) {
+        size_t i = 0;
+        while (i < n && p[i] == ' ') ++i;
+        bool neg = i < n && p[i] == '-';
+        if (i < n && (p[i] == '-' || p[i] == '+')) ++i;
+        long v = 0;
+        for (; i < n && p[i] >= '0' && p[i] <= '9'; ++i) v = v * 10 + (p[i] - '0');
+        while (i < n && p[i] == ' ') ++i;
+        if (i != n) return false;
+        out = neg ? -v : v;
+        return true;
+    }
+
+    // Satellite number, including the alpha-5 form (A0000 = 100000; I and O
+    // are skipped)
+    static bool parse_satnum(const char* p, long& out) {
+        char c = p[0];
+        if (c >= 'A' && c <= 'Z' && c != 'I' && c != 'O') {
+            long lead = 10 + (c - 'A') - (c > 'I') - (c > 'O');
+            long rest = 0;
+            if (!parse_int(p + 1, 4, rest)) return false;
+            out = lead * 10000 + rest;
+            return true;
+        }
+        return parse_int(p, 5, out);
+    }
+
+    static void format_satnum(long num, char* out) {
+        if (num >= 100000 && num < 340000) {
+            long lead = num / 10000 - 10;
+            char c = static_cast<char>('A' + lead);
+            if (c >= 'I') ++c;
+            if (c >= 'O') ++c;
+            std::snprintf(out, 24, "%c%04ld", c, num % 10000);
+        } else {
+            std::snprintf(out, 24, "%05ld", num % 100000);
+        }
+    }
+
+    static double pow10(int e) {
+        static const double table[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+                                       1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16};
+        return table[e];
+    }
+
+    // Fixed-point decimal such as " 51.6416", "-.00002182" or "15.72125391"
+    static bool parse_decimal(const char* p, size_t n, double& out) {
+        size_t i = 0;
+        while (i < n && p[i] == ' ') ++i;
+        bool neg = i < n && p[i] == '-';
+        if (i < n && (p[i] == '-' || p[i] == '+')) ++i;
+        int64_t mantissa = 0;
+        int frac_digits = 0;
+        int digits = 0;
+        for (; i < n && p[i] >= '0' && p[i] <= '9'; ++i, ++digits) mantissa = mantissa * 10 + (p[i] - '0');
+        if (i < n && p[i] == '.') {
+            for (++i; i < n && p[i] >= '0' && p[i] <= '9'; ++i, ++digits, ++frac_digits) {
+                mantissa = mantissa * 10 + (p[i] - '0');
+            }
+        }
+        while (i < n && p[i] == ' ') ++i;
+        if (i != n || digits == 0 || digits > 16) return false;
+        double v = static_cast<double>(mantissa) / pow10(frac_digits);
+        out = neg ? -v : v;
+        return true;
+    }
+
+    // Digits with an implied leading decimal point, e.g. eccentricity "1859667"
+    static bool parse_fraction(const char* p, size_t n, double& out) {
+        int64_t mantissa = 0;
+        for (size_t i = 0; i < n; ++i) {
+            char c = p[i] == ' ' ? '0' : p[i];
+            if (c < '0' || c > '9') return false;
+            mantissa = mantissa * 10 + (c - '0');
+        }
+        out = static_cast<double>(mantissa) / pow10(static_cast<int>(n));
+        return true;
+    }
+
+    // Implied-decimal exponent field "SMMMMMSE", e.g. " 28098-4" = 0.28098e-4
+    static bool parse_implied(const char* p, double& out) {
+        bool neg = p[0] == '-';
+        if (p[0] != ' ' && p[0] != '-' && p[0] != '+') return false;
+        int64_t mantissa = 0;
+        for (int i = 1; i <= 5; ++i) {
+            char c = p[i] == ' ' ? '0' : p[i];
+            if (c < '0' || c > '9') return false;
+            mantissa = mantissa * 10 + (c - '0');
+        }
+        if (p[7] < '0' || p[7] > '9') return false;
+        int exponent = p[7] - '0';
+        if (p[6] == '-') exponent = -exponent;
+        else if (p[6] != '+' && p[6] != ' ') return false;
+
+        int scale = exponent - 5;
+        double v = scale < 0 ? static_cast<double>(mantissa) / pow10(-scale)
+                             : static_cast<double>(mantissa) * pow10(scale);
+        out = neg ? -v : v;
+        return true;
+    }
+
+    static void format_implied(double x, char* out) {
+        if (x == 0.0) {
+            std::snprintf(out, 24, " 00000-0");
+            return;
+        }
+        int exponent = static_cast<int>(std::floor(std::log10(std::fabs(x)))) + 1;
+        long mantissa = std::lround(std::fabs(x) / std::pow(10.0, exponent) * 1e5);
+        if (mantissa >= 100000) {
+            mantissa /= 10;
+            ++exponent;
+        }
+        exponent = std::max(-9, std::min(9, exponent));
+        std::snprintf(out, 24, "%c%05ld%c%d", x < 0.0 ? '-' : ' ', mantissa,
+                      exponent < 0 ? '-' : '+', std::abs(exponent));
+    }
+
+    static double wrap_degrees(double radians) {
+        double deg = std::fmod(radians * RAD_TO_DEG, 360.0);
+        return deg < 0.0 ? deg + 360.0 : deg;
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // TLE_CATALOG_H
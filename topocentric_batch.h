@@ -0,0 +1,144 @@
+#ifndef TOPOCENTRIC_BATCH_H
+#define TOPOCENTRIC_BATCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "station_frame.h"
+#include "catalog_propagator.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Azimuth/elevation/range/range-rate for M satellites against K stations in
+// one call. Station frames are held structure-of-arrays; satellites are
+// rotated into the Earth-fixed frame once per block, then each station's
+// views for the block are computed in a loop that vectorizes (fast_atan2
+// stands in for atan2/asin). Blocks are spread across worker threads.
+//
+// All satellite states must be TEME at the same instant, whose sidereal
+// angle is passed as `gmst`.
+class TopocentricBatch {
+public:
+    struct Config {
+        unsigned num_threads = 0;  // 0 = all cores
+        size_t grain = 1024;       // satellites per work item
+    };
+
+    // Views stored station-major: index = station * satellites + satellite
+    struct Views {
+        size_t satellites = 0;
+        size_t stations = 0;
+        std::vector<double> azimuth;     // degrees (0-360)
+        std::vector<double> elevation;   // degrees
+        std::vector<double> range;       // km
+        std::vector<double> range_rate;  // km/s (positive = receding)
+
+        void resize(size_t num_satellites, size_t num_stations) {
+            satellites = num_satellites;
+            stations = num_stations;
+            size_t n = num_satellites * num_stations;
+            azimuth.resize(n); elevation.resize(n);
+            range.resize(n); range_rate.resize(n);
+        }
+
+        TopocentricView get(size_t satellite, size_t station) const {
+            size_t i = station * satellites + satellite;
+            return {azimuth[i], elevation[i], range[i], range_rate[i]};
+        }
+    };
+
+    TopocentricBatch() : TopocentricBatch(Config()) {}
+    explicit TopocentricBatch(const Config& cfg) : config(cfg) {}
+
+    size_t add_station(const GroundStation& station) {
+        frames.emplace_back(station);
+        const StationFrame& f = frames.back();
+        sx.push_back(f.get_x()); sy.push_back(f.get_y()); sz.push_back(f.get_z());
+        for (int i = 0; i < 3; ++i) {
+            south[i].push_back(f.get_south()[i]);
+            east[i].push_back(f.get_east()[i]);
+            zenith[i].push_back(f.get_zenith()[i]);
+        }
+        return frames.size() - 1;
+    }
+
+    size_t station_count() const { return frames.size(); }
+    const StationFrame& get_station(size_t i) const { return frames[i]; }
+
+    void compute(const CatalogPropagator::States& states, double gmst, Views& out) const {
+        compute(states.x.data(), states.y.data(), states.z.data(),
+                states.vx.data(), states.vy.data(), states.vz.data(), states.size(), gmst, out);
+    }
+
+    void compute(const double* x, const double* y, const double* z,
+                 const double* vx, const double* vy, const double* vz,
+                 size_t count, double gmst, Views& out) const {
+        out.resize(count, frames.size());
+        const double c = std::cos(gmst), s = std::sin(gmst);
+        parallel_for(count, [&](size_t begin, size_t end, unsigned) {
+            for (size_t b = begin; b < end; b += BLOCK) {
+                size_t n = std::min(end, b + BLOCK) - b;
+                compute_block(x + b, y + b, z + b, vx + b, vy + b, vz + b, n, c, s, b, out);
+            }
+        }, config.grain, config.num_threads);
+    }
+
+    const Config& get_config() const { return config; }
+
+private:
+    static constexpr size_t BLOCK = 64;
+
+    Config config;
+    std::vector<StationFrame> frames;
+    std::vector<double> sx, sy, sz;
+    std::vector<double> south[3], east[3], zenith[3];
+
+    void compute_block(const double* x, const double* y, const double* z,
+                       const double* vx, const double* vy, const double* vz,
+                       size_t count, double c, double s, size_t offset, Views& out) const {
+        // TEME to Earth-fixed, with the Earth-rotation term in the velocity
+        double rx[BLOCK], ry[BLOCK], rz[BLOCK], ux[BLOCK], uy[BLOCK], uz[BLOCK];
+        for (size_t j = 0; j < count; ++j) {
+            rx[j] = c * x[j] + s * y[j];
+            ry[j] = -s * x[j] + c * y[j];
+            rz[j] = z[j];
+            ux[j] = c * vx[j] + s * vy[j] + EARTH_ROTATION_RATE * ry[j];
+            uy[j] = -s * vx[j] + c * vy[j] - EARTH_ROTATION_RATE * rx[j];
+            uz[j] = vz[j];
+        }
+
+        double az[BLOCK], el[BLOCK], rng[BLOCK], rr[BLOCK];
+        for (size_t k = 0; k < frames.size(); ++k) {
+            const double px = sx[k], py = sy[k], pz = sz[k];
+            const double s0 = south[0][k], s1 = south[1][k], s2 = south[2][k];
+            const double e0 = east[0][k], e1 = east[1][k];
+            const double z0 = zenith[0][k], z1 = zenith[1][k], z2 = zenith[2][k];
+
+            for (size_t j = 0; j < count; ++j) {
+                double dx = rx[j] - px, dy = ry[j] - py, dz = rz[j] - pz;
+                double range = std::sqrt(dx * dx + dy * dy + dz * dz);
+                double north_km = -(s0 * dx + s1 * dy + s2 * dz);
+                double east_km = e0 * dx + e1 * dy;
+                double up_km = z0 * dx + z1 * dy + z2 * dz;
+
+                double a = fast_atan2(east_km, north_km) * RAD_TO_DEG;
+                az[j] = a + 360.0 * static_cast<double>(a < 0.0);
+                el[j] = fast_atan2(up_km, std::sqrt(north_km * north_km + east_km * east_km)) * RAD_TO_DEG;
+                rng[j] = range;
+                rr[j] = (ux[j] * dx + uy[j] * dy + uz[j] * dz) / range;
+            }
+
+            size_t o = k * out.satellites + offset;
+            std::copy(az, az + count, out.azimuth.begin() + o);
+            std::copy(el, el + count, out.elevation.begin() + o);
+            std::copy(rng, rng + count, out.range.begin() + o);
+            std::copy(rr, rr + count, out.range_rate.begin() + o);
+        }
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // TOPOCENTRIC_BATCH_H
@@ -1,10 +1,43 @@
+#define ALLOCATION_TRACKER_IMPLEMENTATION
 #include <iostream>
 #include <vector>
 #include <complex>
 #include <cmath>
+#include <random>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <bitset>
+#include <sstream>
+#include <thread>
 #include "signal_processor.h"
 #include "satellite_ephemeris.h"
 #include "doppler_compensator.h"
+#include "ber_simulator.h"
+#include "fec_encoders.h"
+#include "fec_decoders.h"
+#include "fec_codecs.h"
+#include "catalog_propagator.h"
+#include "tle_catalog.h"
+#include "chebyshev_ephemeris.h"
+#include "topocentric_batch.h"
+#include "pass_predictor.h"
+#include "constellation_tracker.h"
+#include "visibility_index.h"
+#include "isl_analyzer.h"
+#include "satellite_table.h"
+#include "interval_tree.h"
+#include "handover_scheduler.h"
+#include "coverage_grid.h"
+#include "conjunction_screener.h"
+#include "benchmark_compare.h"
+#include "pipeline_benchmark.h"
+#include "allocation_tracker.h"
+#include "latency_histogram.h"
+#include "scoped_trace.h"
+#include "metrics_registry.h"
+#include "iq_file_reader.h"
+#include "iq_recorder.h"
 #include "test_framework.h"
 
 using namespace SatelliteSignal;
@@ -138,8 +171,9 @@ TEST(topocentric_conversion_valid) {
 
     SatelliteEphemeris ephemeris(tle);
     GroundStation station = {40.0, -105.0, 1600.0};
-    StateVector pos = ephemeris.get_position(0.0);
-    TopocentricView view = ephemeris.get_topocentric(pos, station);
+    const double t = 30.0;
+    StateVector pos = ephemeris.get_position(t);
+    TopocentricView view = ephemeris.get_topocentric(pos, station, t);
     
     ASSERT_TRUE(view.range > 0.0);
 }
@@ -164,13 +198,1980 @@ TEST(doppler_calculation_reasonable) {
 
     SatelliteEphemeris ephemeris(tle);
     GroundStation station = {40.0, -105.0, 1600.0};
-    StateVector pos = ephemeris.get_position(0.0);
-    TopocentricView view = ephemeris.get_topocentric(pos, station);
+    const double t = 30.0;
+    StateVector pos = ephemeris.get_position(t);
+    TopocentricView view = ephemeris.get_topocentric(pos, station, t);
     double doppler = ephemeris.calculate_doppler_shift(view, 10e9);
     
     ASSERT_TRUE(std::fabs(doppler) < 100000.0);
 }
 
+// Vanguard 1 (00005) from the Vallado et al. SGP4 verification set:
+// 1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753
+// 2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667
+static TLE make_vanguard_tle() {
+    TLE tle = TLE();
+    tle.catalog_number = 5;
+    tle.epoch_year = 0;
+    tle.epoch_day = 179.78495062;
+    tle.ndot = 0.00000023;
+    tle.bstar = 0.28098e-4;
+    tle.inclination = 34.2682 * DEG_TO_RAD;
+    tle.raan = 348.7242 * DEG_TO_RAD;
+    tle.eccentricity = 0.1859667;
+    tle.argument_perigee = 331.7664 * DEG_TO_RAD;
+    tle.mean_anomaly = 19.3264 * DEG_TO_RAD;
+    tle.mean_motion = 10.82419157;
+    return tle;
+}
+
+TEST(sgp4_matches_reference_vectors) {
+    SGP4Propagator sgp4(make_vanguard_tle());
+    ASSERT_FALSE(sgp4.is_deep_space());
+
+    StateVector s;
+    ASSERT_TRUE(sgp4.propagate(0.0, s));
+    ASSERT_CLOSE(s.x, 7022.46529266, 1e-6);
+    ASSERT_CLOSE(s.y, -1400.08296755, 1e-6);
+    ASSERT_CLOSE(s.z, 0.03995155, 1e-6);
+    ASSERT_CLOSE(s.vx, 1.893841015, 1e-9);
+    ASSERT_CLOSE(s.vy, 6.405893759, 1e-9);
+    ASSERT_CLOSE(s.vz, 4.534807250, 1e-9);
+
+    ASSERT_TRUE(sgp4.propagate(360.0, s));
+    ASSERT_CLOSE(s.x, -7154.03120202, 1e-6);
+    ASSERT_CLOSE(s.y, -3783.17682504, 1e-6);
+    ASSERT_CLOSE(s.z, -3536.19412294, 1e-6);
+    ASSERT_CLOSE(s.vx, 4.741887409, 1e-9);
+    ASSERT_CLOSE(s.vy, -4.151817765, 1e-9);
+    ASSERT_CLOSE(s.vz, -2.093935425, 1e-9);
+}
+
+TEST(sgp4_deep_space_geostationary) {
+    TLE tle = TLE();
+    tle.epoch_year = 24;
+    tle.epoch_day = 100.5;
+    tle.bstar = 1e-4;
+    tle.mean_motion = 1.00271;
+    tle.inclination = 0.05 * DEG_TO_RAD;
+    tle.eccentricity = 0.0002;
+    tle.raan = 80.0 * DEG_TO_RAD;
+    tle.argument_perigee = 200.0 * DEG_TO_RAD;
+    tle.mean_anomaly = 50.0 * DEG_TO_RAD;
+
+    SGP4Propagator sgp4(tle);
+    ASSERT_TRUE(sgp4.is_deep_space());
+
+    // Ten days of one-day resonance integration stays on the GEO ring, and a
+    // fresh propagator lands on the same state as one stepped there
+    StateVector s;
+    for (double t = 0.0; t <= 14400.0; t += 60.0) {
+        ASSERT_TRUE(sgp4.propagate(t, s));
+        double r = std::sqrt(s.x * s.x + s.y * s.y + s.z * s.z);
+        ASSERT_TRUE(r > 42100.0 && r < 42230.0);
+    }
+    StateVector fresh;
+    SGP4Propagator(tle).propagate(14400.0, fresh);
+    ASSERT_CLOSE(fresh.x, s.x, 1e-9);
+    ASSERT_CLOSE(fresh.y, s.y, 1e-9);
+}
+
+// Deep-space cases from the Vallado et al. verification set: 08195
+// (Molniya 2-14, 12 h resonant), 11801 (the original STR#3 SDP4 case,
+// e = 0.73) and 09998 (SMS 1 AKM, 24 h synchronous resonant)
+struct SGP4Reference {
+    double minutes;
+    double x, y, z, vx, vy, vz;
+};
+
+static void assert_sgp4_reference(const char* line1, const char* line2,
+                                  const std::vector<SGP4Reference>& expected) {
+    TLE tle;
+    ASSERT_TRUE(TLECatalog::parse("", line1, line2, tle) == TLECatalog::ParseStatus::OK);
+    SGP4Propagator sgp4(tle);
+    ASSERT_TRUE(sgp4.is_deep_space());
+    for (const auto& e : expected) {
+        StateVector s;
+        ASSERT_TRUE(sgp4.propagate(e.minutes, s));
+        ASSERT_CLOSE(s.x, e.x, 1e-6);
+        ASSERT_CLOSE(s.y, e.y, 1e-6);
+        ASSERT_CLOSE(s.z, e.z, 1e-6);
+        ASSERT_CLOSE(s.vx, e.vx, 1e-9);
+        ASSERT_CLOSE(s.vy, e.vy, 1e-9);
+        ASSERT_CLOSE(s.vz, e.vz, 1e-9);
+    }
+}
+
+TEST(sdp4_matches_reference_vectors) {
+    assert_sgp4_reference(
+        "1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813",
+        "2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656",
+        {{0.0, 2349.89483350, -14785.93811562, 0.02119378, 2.721488096, -3.256811655, 4.498416672},
+         {1440.0, 2890.80638268, -15446.43952300, 948.77010176, 2.654407490, -2.909344895, 4.486437362},
+         {2880.0, 3417.20931586, -16038.79510665, 1894.74934058, 2.585515864, -2.596818146, 4.456882556}});
+    assert_sgp4_reference(
+        "1 11801U          80230.29629788  .01431103  00000-0  14311-1      13",
+        "2 11801  46.7916 230.4354 7318036  47.4722  10.4117  2.28537848    13",
+        {{0.0, 7473.37102491, 428.94748312, 5828.74846783, 5.107155391, 6.444680305, -0.186133297},
+         {720.0, 14271.29083858, 24110.44309009, -4725.76320143, -0.320504528, 2.679841539, -2.084054355},
+         {1440.0, 9787.87836256, 33753.32249667, -15030.79874625, -1.094251553, 0.923589906, -1.522311008}});
+    assert_sgp4_reference(
+        "1 09998U 74033F   05148.79417928 -.00000112  00000-0  00000+0 0  4480",
+        "2 09998   9.4958 313.1750 0270971 327.5225  30.8097  1.16186785 45878",
+        {{0.0, 25532.98947267, -27244.26327953, -1.11572421, 2.410283885, 2.194175683, 0.545888526},
+         {1440.0, 36939.27815814, 8219.80327089, 5454.53314079, -0.651685745, 3.149347600, 0.280935904},
+         {2880.0, 13218.16860991, 36343.84709522, 5773.47964957, -2.930090896, 1.150031421, -0.226480687}});
+}
+
+TEST(ephemeris_uses_sgp4) {
+    TLE tle = make_vanguard_tle();
+    SatelliteEphemeris ephemeris(tle);
+    StateVector s = ephemeris.get_position(360.0);
+    ASSERT_CLOSE(s.x, -7154.03120202, 1e-6);
+    ASSERT_TRUE(ephemeris.get_propagator().get_error() == SGP4Propagator::OK);
+}
+
+static const char* VANGUARD_LINE1 = "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753";
+static const char* VANGUARD_LINE2 = "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667";
+
+TEST(tle_catalog_parses_fixed_columns) {
+    TLE tle;
+    auto status = TLECatalog::parse("0 VANGUARD 1", VANGUARD_LINE1, VANGUARD_LINE2, tle);
+    ASSERT_TRUE(status == TLECatalog::ParseStatus::OK);
+    ASSERT_TRUE(std::string(tle.satellite_name.data()) == "VANGUARD 1");
+    ASSERT_TRUE(tle.catalog_number == 5);
+    ASSERT_TRUE(tle.epoch_year == 0);
+    ASSERT_TRUE(tle.element_set_num == 475);
+    ASSERT_TRUE(tle.element_number == 41366);
+    ASSERT_CLOSE(tle.epoch_day, 179.78495062, 1e-12);
+    ASSERT_CLOSE(tle.ndot, 0.00000023, 1e-15);
+    ASSERT_CLOSE(tle.bstar, 0.28098e-4, 1e-15);
+    ASSERT_CLOSE(tle.eccentricity, 0.1859667, 1e-15);
+    ASSERT_CLOSE(tle.inclination, 34.2682 * DEG_TO_RAD, 1e-15);
+    ASSERT_CLOSE(tle.mean_motion, 10.82419157, 1e-12);
+
+    // Same propagation as the hand-built elements
+    StateVector s;
+    ASSERT_TRUE(SGP4Propagator(tle).propagate(360.0, s));
+    ASSERT_CLOSE(s.x, -7154.03120202, 1e-6);
+
+    // Round trip through the formatter reproduces the original lines
+    std::string line1, line2;
+    TLECatalog::format_lines(tle, line1, line2);
+    ASSERT_TRUE(line2 == VANGUARD_LINE2);
+    ASSERT_TRUE(line1.substr(18, 50) == std::string(VANGUARD_LINE1).substr(18, 50));
+}
+
+TEST(tle_catalog_rejects_bad_checksum) {
+    std::string line2 = VANGUARD_LINE2;
+    line2[20] = '9';
+    TLE tle;
+    ASSERT_TRUE(TLECatalog::parse("", VANGUARD_LINE1, line2, tle) == TLECatalog::ParseStatus::CHECKSUM);
+    ASSERT_TRUE(TLECatalog::parse("", VANGUARD_LINE1, line2, tle, false) == TLECatalog::ParseStatus::OK);
+    ASSERT_TRUE(TLECatalog::parse("", VANGUARD_LINE1, "2 00005", tle) == TLECatalog::ParseStatus::MALFORMED);
+}
+
+static void write_catalog_file(const std::string& path, const std::vector<TLE>& tles) {
+    std::ofstream file(path, std::ios::binary);
+    for (size_t i = 0; i < tles.size(); ++i) {
+        std::string line1, line2;
+        TLECatalog::format_lines(tles[i], line1, line2);
+        // Mix 3-line (with CRLF) and 2-line records
+        if (i % 2 == 0) file << "SAT " << tles[i].catalog_number << "\r\n";
+        file << line1 << "\n" << line2 << "\n";
+    }
+}
+
+TEST(tle_catalog_incremental_reload) {
+    std::vector<TLE> tles;
+    for (int i = 0; i < 50; ++i) {
+        TLE tle = make_vanguard_tle();
+        tle.catalog_number = 1000 + i;
+        tle.element_set_num = 1;
+        tle.raan = i * 0.1;
+        tles.push_back(tle);
+    }
+    const std::string path = "tle_catalog_test.txt";
+    write_catalog_file(path, tles);
+
+    TLECatalog catalog;
+    ASSERT_TRUE(catalog.load(path));
+    ASSERT_TRUE(catalog.size() == 50);
+    ASSERT_TRUE(catalog.get_stats().checksum_failures == 0);
+    ASSERT_TRUE(std::string(catalog.get_tle(0).satellite_name.data()) == "SAT 1000");
+    ASSERT_TRUE(catalog.get_tle(1).satellite_name[0] == '\0');
+
+    // Advance one satellite past epoch so its propagator carries state, then
+    // publish a new element set for two others, drop one and add one
+    size_t kept = catalog.find(1003);
+    StateVector before;
+    catalog.get_propagator(kept).propagate(100.0, before);
+
+    tles[5].element_set_num = 2;
+    tles[5].mean_anomaly += 0.5;
+    tles[6].element_set_num = 2;
+    tles.erase(tles.begin() + 10);
+    TLE extra = make_vanguard_tle();
+    extra.catalog_number = 2000;
+    tles.push_back(extra);
+    write_catalog_file(path, tles);
+
+    ASSERT_TRUE(catalog.reload(path));
+    std::remove(path.c_str());
+    const auto& stats = catalog.get_stats();
+    ASSERT_TRUE(stats.added == 1);
+    ASSERT_TRUE(stats.updated == 2);
+    ASSERT_TRUE(stats.removed == 1);
+    ASSERT_TRUE(stats.unchanged == 47);
+    ASSERT_TRUE(catalog.size() == 50);
+    ASSERT_TRUE(catalog.find(1010) == TLECatalog::npos);
+
+    size_t updated = catalog.find(1005);
+    ASSERT_CLOSE(catalog.get_tle(updated).mean_anomaly, tles[5].mean_anomaly, 1e-6);
+    StateVector a, b;
+    catalog.get_propagator(updated).propagate(0.0, a);
+    SGP4Propagator(catalog.get_tle(updated)).propagate(0.0, b);
+    ASSERT_CLOSE(a.x, b.x, 1e-9);
+
+    StateVector after;
+    catalog.get_propagator(catalog.find(1003)).propagate(100.0, after);
+    ASSERT_CLOSE(after.x, before.x, 1e-9);
+}
+
+TEST(tle_catalog_reload_detects_changed_elements_with_same_elset) {
+    std::vector<TLE> tles;
+    for (int i = 0; i < 3; ++i) {
+        TLE tle = make_vanguard_tle();
+        tle.catalog_number = 3000 + i;
+        tle.element_set_num = 7;
+        tles.push_back(tle);
+    }
+    const std::string path = "tle_catalog_elset_test.txt";
+    write_catalog_file(path, tles);
+    TLECatalog catalog;
+    ASSERT_TRUE(catalog.load(path));
+
+    // Regenerated sets: new epoch for one, new elements for another, both
+    // still numbered 7
+    tles[0].epoch_day += 1.0;
+    tles[1].raan += 0.2;
+    tles[1].mean_anomaly += 0.3;
+    write_catalog_file(path, tles);
+    ASSERT_TRUE(catalog.reload(path));
+    std::remove(path.c_str());
+
+    ASSERT_TRUE(catalog.get_stats().updated == 2);
+    ASSERT_TRUE(catalog.get_stats().unchanged == 1);
+    for (long satnum : {3000L, 3001L}) {
+        size_t i = catalog.find(satnum);
+        StateVector a, b;
+        catalog.get_propagator(i).propagate(60.0, a);
+        SGP4Propagator(catalog.get_tle(i)).propagate(60.0, b);
+        ASSERT_CLOSE(a.x, b.x, 1e-9);
+        ASSERT_CLOSE(a.y, b.y, 1e-9);
+        ASSERT_CLOSE(a.z, b.z, 1e-9);
+    }
+}
+
+TEST(chebyshev_ephemeris_matches_sgp4) {
+    TLE tle = make_vanguard_tle();
+    ChebyshevEphemeris cache(tle);
+    SGP4Propagator sgp4(tle);
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<> when(0.0, 360.0);
+    std::vector<double> times(2000);
+    for (auto& t : times) t = when(gen);
+    std::sort(times.begin(), times.end());
+
+    double max_position_error = 0.0, max_velocity_error = 0.0;
+    for (double t : times) {
+        StateVector fit = cache.get_position(t), truth;
+        sgp4.propagate(t, truth);
+        max_position_error = std::max(max_position_error, std::sqrt(
+            (fit.x - truth.x) * (fit.x - truth.x) + (fit.y - truth.y) * (fit.y - truth.y) +
+            (fit.z - truth.z) * (fit.z - truth.z)));
+        max_velocity_error = std::max(max_velocity_error, std::fabs(fit.vx - truth.vx) +
+            std::fabs(fit.vy - truth.vy) + std::fabs(fit.vz - truth.vz));
+    }
+    ASSERT_TRUE(max_position_error < 1e-3);
+    ASSERT_TRUE(max_velocity_error < 1e-6);
+    ASSERT_TRUE(cache.get_error_bound() <= cache.get_config().tolerance_km);
+
+    ASSERT_TRUE(cache.get_segments().size() == 12);
+
+    // A tighter tolerance splits the segments around perigee
+    ChebyshevEphemeris::Config config;
+    config.tolerance_km = 1e-8;
+    ChebyshevEphemeris tight(tle, config);
+    tight.prefill(0.0);
+    ASSERT_TRUE(tight.get_segments().size() > 12);
+    ASSERT_TRUE(tight.get_error_bound() <= 1e-8);
+}
+
+TEST(chebyshev_ephemeris_refills_lazily) {
+    ChebyshevEphemeris cache(make_vanguard_tle());
+    ASSERT_TRUE(cache.get_refill_count() == 0);
+
+    for (double t = 0.0; t < 119.0; t += 0.01) cache.get_position(t);
+    ASSERT_TRUE(cache.get_refill_count() == 1);
+    ASSERT_TRUE(cache.covers(119.0));
+
+    cache.get_position(125.0);
+    ASSERT_TRUE(cache.get_refill_count() == 2);
+    ASSERT_CLOSE(cache.get_window_start(), 120.0, 1e-12);
+    ASSERT_FALSE(cache.covers(0.0));
+}
+
+TEST(chebyshev_ephemeris_doppler_matches_direct) {
+    TLE tle = make_vanguard_tle();
+    ChebyshevEphemeris cache(tle);
+    SGP4Propagator sgp4(tle);
+    StateVector observer = {6378.0, 0.0, 0.0, 0.0, 0.4651, 0.0};
+
+    for (double t = 5.0; t < 200.0; t += 13.7) {
+        StateVector s;
+        sgp4.propagate(t, s);
+        double dx = s.x - observer.x, dy = s.y - observer.y, dz = s.z - observer.z;
+        double range = std::sqrt(dx * dx + dy * dy + dz * dz);
+        double range_rate = ((s.vx - observer.vx) * dx + (s.vy - observer.vy) * dy +
+                             (s.vz - observer.vz) * dz) / range;
+        ASSERT_CLOSE(cache.get_range_rate(t, observer), range_rate, 1e-6);
+        ASSERT_CLOSE(cache.get_doppler_shift(t, observer, 2.2e9), doppler_shift_hz(range_rate, 2.2e9), 0.01);
+    }
+    // 1 km/s receding at 1 GHz
+    ASSERT_CLOSE(doppler_shift_hz(1.0, 1e9), -3335.64, 0.01);
+}
+
+TEST(fast_atan2_matches_std) {
+    double max_error = 0.0;
+    for (double y = -3.0; y <= 3.0; y += 0.0137) {
+        for (double x = -3.0; x <= 3.0; x += 0.0241) {
+            max_error = std::max(max_error, std::fabs(fast_atan2(y, x) - std::atan2(y, x)));
+        }
+    }
+    ASSERT_TRUE(max_error < 1e-14);
+    ASSERT_CLOSE(fast_atan2(0.0, 0.0), 0.0, 0.0);
+    ASSERT_CLOSE(fast_atan2(1.0, 0.0), M_PI / 2.0, 1e-15);
+    ASSERT_CLOSE(fast_atan2(0.0, -1.0), M_PI, 1e-15);
+    ASSERT_CLOSE(fast_atan2(-1.0, -1.0), -0.75 * M_PI, 1e-15);
+}
+
+TEST(station_frame_azimuth_and_elevation) {
+    // Station on the equator at the prime meridian, sidereal angle zero so
+    // TEME and Earth-fixed coincide
+    StationFrame station({0.0, 0.0, 0.0});
+    ASSERT_CLOSE(station.get_x(), WGS84_A_KM, 1e-9);
+
+    TopocentricView overhead = station.view({7000.0, 0.0, 0.0, 0.0, 0.0, 0.0}, 0.0);
+    ASSERT_CLOSE(overhead.elevation, 90.0, 1e-9);
+    ASSERT_CLOSE(overhead.range, 7000.0 - WGS84_A_KM, 1e-9);
+
+    TopocentricView north = station.view({WGS84_A_KM + 100.0, 0.0, 1000.0, 0.0, 0.0, 0.0}, 0.0);
+    ASSERT_CLOSE(north.azimuth, 0.0, 1e-9);
+    ASSERT_CLOSE(north.elevation, std::atan2(100.0, 1000.0) * RAD_TO_DEG, 1e-9);
+
+    TopocentricView east = station.view({WGS84_A_KM, 1000.0, 0.0, 0.0, 0.0, 0.0}, 0.0);
+    ASSERT_CLOSE(east.azimuth, 90.0, 1e-9);
+
+    // A quarter turn of the Earth puts the station under the +y axis
+    TopocentricView rotated = station.view({0.0, 7000.0, 0.0, 0.0, 0.0, 0.0}, M_PI / 2.0);
+    ASSERT_CLOSE(rotated.elevation, 90.0, 1e-9);
+}
+
+TEST(station_frame_geostationary_range_rate) {
+    // A geostationary satellite barely moves relative to a station under it;
+    // ignoring Earth rotation would show ~3 km/s
+    TLE tle = TLE();
+    tle.epoch_year = 24;
+    tle.epoch_day = 100.5;
+    tle.mean_motion = 1.00273791;
+    tle.eccentricity = 0.0001;
+    tle.mean_anomaly = 0.0;
+
+    SatelliteEphemeris ephemeris(tle);
+    StateVector s = ephemeris.get_position(0.0);
+    double gmst = ephemeris.get_gmst(0.0);
+    double longitude = (std::atan2(s.y, s.x) - gmst) * RAD_TO_DEG;
+    StationFrame station({0.0, longitude, 0.0});
+
+    for (double t = 0.0; t < 1440.0; t += 60.0) {
+        TopocentricView view = ephemeris.get_topocentric(ephemeris.get_position(t), station, t);
+        ASSERT_TRUE(std::fabs(view.range_rate) < 0.01);
+        ASSERT_TRUE(view.elevation > 89.0);
+    }
+
+    // Station inertial state agrees with the view's range rate
+    StateVector obs = station.inertial_state(gmst);
+    double dx = s.x - obs.x, dy = s.y - obs.y, dz = s.z - obs.z;
+    double range_rate = ((s.vx - obs.vx) * dx + (s.vy - obs.vy) * dy + (s.vz - obs.vz) * dz) /
+                        std::sqrt(dx * dx + dy * dy + dz * dz);
+    ASSERT_CLOSE(station.view(s, gmst).range_rate, range_rate, 1e-9);
+}
+
+static TLE make_leo_tle() {
+    TLE tle = TLE();
+    tle.catalog_number = 25544;
+    tle.epoch_year = 24;
+    tle.epoch_day = 1.0;
+    tle.bstar = 0.00003;
+    tle.mean_motion = 15.49;
+    tle.inclination = 51.6 * DEG_TO_RAD;
+    tle.raan = 120.0 * DEG_TO_RAD;
+    tle.eccentricity = 0.0001;
+    tle.argument_perigee = 180.0 * DEG_TO_RAD;
+    tle.mean_anomaly = 90.0 * DEG_TO_RAD;
+    return tle;
+}
+
+TEST(pass_predictor_matches_dense_scan) {
+    TLE tle = make_leo_tle();
+    GroundStation station = {40.0, -105.0, 1600.0};
+    PassPredictor predictor;
+    predictor.add_satellite(tle);
+    predictor.add_station(station);
+
+    const double start_jd = SGP4Propagator::epoch_julian_date(24, 1.0) + 0.25;
+    const double duration = 1440.0;
+    auto passes = predictor.predict(start_jd, duration);
+    ASSERT_TRUE(passes.size() >= 3);
+
+    // Reference: elevation every second, crossings located to the sample
+    SatelliteEphemeris ephemeris(tle);
+    StationFrame frame(station);
+    const double offset = 0.25 * 1440.0;
+    std::vector<double> rises, sets, peaks;
+    double previous = -90.0, peak = -90.0;
+    for (double t = 0.0; t <= duration; t += 1.0 / 60.0) {
+        StateVector pos = ephemeris.get_position(offset + t);
+        double el = ephemeris.get_topocentric(pos, frame, offset + t).elevation;
+        if (previous < 0.0 && el >= 0.0) { rises.push_back(t); peak = el; }
+        if (el >= 0.0) peak = std::max(peak, el);
+        if (previous >= 0.0 && el < 0.0) { sets.push_back(t); peaks.push_back(peak); }
+        previous = el;
+    }
+    ASSERT_TRUE(rises.size() == passes.size() && sets.size() == passes.size());
+
+    for (size_t i = 0; i < passes.size(); ++i) {
+        ASSERT_FALSE(passes[i].aos_clipped || passes[i].los_clipped);
+        ASSERT_TRUE(std::fabs(passes[i].aos - rises[i]) < 1.0 / 60.0);
+        ASSERT_TRUE(std::fabs(passes[i].los - sets[i]) < 1.0 / 60.0);
+        ASSERT_TRUE(passes[i].tca > passes[i].aos && passes[i].tca < passes[i].los);
+        ASSERT_CLOSE(passes[i].max_elevation_deg, peaks[i], 0.01);
+    }
+}
+
+TEST(constellation_tracker_predicts_walker_passes) {
+    ConstellationTracker::ConstellationConfig config = {"TEST", 24, 550.0, 53.0, 4, 6};
+    ConstellationTracker tracker(config);
+
+    auto elements = ConstellationTracker::generate_elements(config);
+    ASSERT_TRUE(elements.size() == 24);
+    ASSERT_CLOSE(elements[6].raan, M_PI / 2.0, 1e-12);
+    SGP4Propagator sgp4(elements[0]);
+    StateVector s;
+    sgp4.propagate(0.0, s);
+    ASSERT_CLOSE(std::sqrt(s.x * s.x + s.y * s.y + s.z * s.z), WGS84_A_KM + 550.0, 15.0);
+
+    auto passes = tracker.predict_passes(60.0, 6.0);
+    ASSERT_TRUE(passes.size() > 10);
+    for (size_t i = 0; i < passes.size(); ++i) {
+        ASSERT_TRUE(passes[i].rise_time_minutes >= 60.0);
+        ASSERT_TRUE(passes[i].set_time_minutes <= 420.0);
+        ASSERT_TRUE(passes[i].max_elevation_degrees >= 5.0);
+        ASSERT_TRUE(passes[i].duration_minutes > 0.0 && passes[i].duration_minutes < 15.0);
+        ASSERT_TRUE(passes[i].doppler_rate_hz_per_s > 0.0);
+        if (i > 0) ASSERT_TRUE(passes[i].rise_time_minutes >= passes[i - 1].rise_time_minutes);
+    }
+
+    // Mid-pass of the highest pass, that satellite is among the visible ones
+    auto best = *std::max_element(passes.begin(), passes.end(), [](const PassPrediction& a, const PassPrediction& b) {
+        return a.max_elevation_degrees < b.max_elevation_degrees;
+    });
+    auto visible = tracker.get_visible_satellites(0.5 * (best.rise_time_minutes + best.set_time_minutes));
+    ASSERT_TRUE(std::find(visible.begin(), visible.end(), best.satellite) != visible.end());
+    ASSERT_TRUE(tracker.get_satellites().in_range[best.satellite] == 1);
+    ASSERT_TRUE(tracker.get_satellite_name(best.satellite) ==
+                "TEST-" + std::to_string(elements[best.satellite].catalog_number));
+}
+
+// Bulk visibility and links come from the same SGP4 states as pass
+// prediction, so the satellites in view at any time are exactly those
+// inside a predicted pass
+TEST(constellation_tracker_bulk_queries_match_passes) {
+    ConstellationTracker::ConstellationConfig config = {"TEST", 24, 550.0, 53.0, 4, 6};
+    ConstellationTracker tracker(config);
+    auto passes = tracker.predict_passes(0.0, 24.0);
+    ASSERT_TRUE(!passes.empty());
+
+    size_t checked = 0;
+    for (double t = 3.0; t < 1440.0; t += 7.0) {
+        std::vector<SatelliteId> expected;
+        bool near_edge = false;
+        for (const auto& p : passes) {
+            near_edge |= std::fabs(t - p.rise_time_minutes) < 0.01 || std::fabs(t - p.set_time_minutes) < 0.01;
+            if (t > p.rise_time_minutes && t < p.set_time_minutes) expected.push_back(p.satellite);
+        }
+        if (near_edge) continue;
+        std::vector<SatelliteId> visible = tracker.get_visible_satellites(t);
+        std::sort(visible.begin(), visible.end());
+        std::sort(expected.begin(), expected.end());
+        ASSERT_TRUE(visible == expected);
+        checked += expected.size();
+    }
+    ASSERT_TRUE(checked > 20);
+
+    auto elements = ConstellationTracker::generate_elements(config);
+    const auto& links = tracker.get_inter_satellite_links(720.0);
+    ASSERT_TRUE(!links.empty());
+    for (const auto& l : links) {
+        StateVector a, b;
+        SGP4Propagator(elements[l.a]).propagate(720.0, a);
+        SGP4Propagator(elements[l.b]).propagate(720.0, b);
+        double range = std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z));
+        ASSERT_CLOSE(static_cast<double>(l.range_km), range, 1e-3 * range);
+    }
+}
+
+// A satellite whose TLE epoch is days from the constellation epoch is
+// propagated from its own epoch, so the tracker sees it where SGP4 (and
+// the pass predictor) put it, J2 node drift included
+TEST(constellation_tracker_inserts_satellite_with_distant_epoch) {
+    ConstellationTracker::ConstellationConfig config = {"TEST", 24, 550.0, 53.0, 4, 6};
+    ConstellationTracker tracker(config);
+    TLE iss = make_leo_tle();
+    iss.epoch_day = 4.25;
+    SatelliteId id = tracker.insert_satellite(iss, "ISS (ZARYA)");
+
+    auto passes = tracker.predict_passes(0.0, 24.0);
+    size_t inside = 0;
+    SGP4Propagator sgp4(iss);
+    const double offset = (SGP4Propagator::epoch_julian_date(24, 1.0) - sgp4.get_epoch_jd()) * 1440.0;
+    for (double t = 0.5; t < 1440.0; t += 1.0) {
+        bool in_pass = false, near_edge = false;
+        for (const auto& p : passes) {
+            if (p.satellite != id) continue;
+            near_edge |= std::fabs(t - p.rise_time_minutes) < 0.01 || std::fabs(t - p.set_time_minutes) < 0.01;
+            in_pass |= t > p.rise_time_minutes && t < p.set_time_minutes;
+        }
+        if (near_edge) continue;
+        const auto& visible = tracker.get_visible_satellites(t);
+        ASSERT_TRUE((std::find(visible.begin(), visible.end(), id) != visible.end()) == in_pass);
+        inside += in_pass;
+
+        StateVector s;
+        sgp4.propagate(t + offset, s);
+        double latitude = std::asin(s.z / std::sqrt(s.x * s.x + s.y * s.y + s.z * s.z)) * RAD_TO_DEG;
+        ASSERT_CLOSE(static_cast<double>(tracker.get_satellites().latitude_deg[id]), latitude, 0.01);
+    }
+    ASSERT_TRUE(inside > 5);
+}
+
+TEST(constellation_tracker_incremental_updates) {
+    ConstellationTracker::ConstellationConfig config = {"TEST", 24, 550.0, 53.0, 4, 6};
+    ConstellationTracker tracker(config);
+    auto before = tracker.predict_passes(0.0, 6.0);
+    tracker.update(30.0);
+
+    TLE iss = make_leo_tle();
+    iss.epoch_day = 1.5;                      // different epoch from the shell
+    SatelliteId added = tracker.insert_satellite(iss, "ISS (ZARYA)");
+    ASSERT_TRUE(added == 24 && tracker.get_satellite_count() == 25);
+    ASSERT_TRUE(tracker.find_satellite(25544) == added);
+
+    TLE moved = ConstellationTracker::generate_elements(config)[3];
+    moved.raan += 0.5;
+    tracker.update_satellite(3, moved);
+    ASSERT_TRUE(tracker.remove_satellite(5) == added);
+    ASSERT_TRUE(tracker.get_satellite_name(5) == "ISS (ZARYA)");
+    ASSERT_TRUE(tracker.find_satellite(25544) == 5);
+
+    // Patched results match a full rebuild
+    auto patched_passes = tracker.predict_passes(0.0, 6.0);
+    std::vector<SatelliteId> patched_visible = tracker.get_visible_satellites(30.0);
+    ASSERT_TRUE(patched_passes.size() != before.size() ||
+                !std::equal(patched_passes.begin(), patched_passes.end(), before.begin(),
+                            [](const PassPrediction& a, const PassPrediction& b) { return a.satellite == b.satellite; }));
+    std::vector<uint8_t> patched_flags = tracker.get_satellites().in_range;
+
+    tracker.predict_passes(1.0, 6.0);
+    auto full_passes = tracker.predict_passes(0.0, 6.0);
+    ASSERT_TRUE(patched_passes.size() == full_passes.size());
+    for (size_t i = 0; i < full_passes.size(); ++i) {
+        ASSERT_TRUE(patched_passes[i].satellite == full_passes[i].satellite);
+        ASSERT_CLOSE(patched_passes[i].rise_time_minutes, full_passes[i].rise_time_minutes, 1e-9);
+    }
+    tracker.update(30.0);
+    std::vector<SatelliteId> full_visible = tracker.get_visible_satellites(30.0);
+    std::sort(patched_visible.begin(), patched_visible.end());
+    std::sort(full_visible.begin(), full_visible.end());
+    ASSERT_TRUE(patched_visible == full_visible);
+    ASSERT_TRUE(patched_flags == tracker.get_satellites().in_range);
+}
+
+TEST(interval_tree_matches_linear_scan) {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> start(0.0, 1000.0), length(0.0, 20.0);
+    std::vector<double> lo(2000), hi(2000);
+    std::vector<uint32_t> values(2000);
+    for (size_t i = 0; i < lo.size(); ++i) {
+        lo[i] = start(gen);
+        hi[i] = lo[i] + length(gen);
+        values[i] = static_cast<uint32_t>(i);
+    }
+    IntervalTree tree;
+    tree.build(lo, hi, values);
+
+    for (int q = 0; q < 200; ++q) {
+        double t0 = start(gen), t1 = t0 + length(gen) * (q % 4);
+        std::vector<uint32_t> got, expected;
+        tree.query(t0, t1, got);
+        for (size_t i = 0; i < lo.size(); ++i) {
+            if (lo[i] <= t1 && hi[i] >= t0) expected.push_back(values[i]);
+        }
+        std::sort(got.begin(), got.end());
+        ASSERT_TRUE(got == expected);
+    }
+}
+
+// Passes at one station with random times, for exhaustive comparison
+static std::vector<PassPredictor::Pass> make_random_passes(size_t count, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> start(0.0, 60.0), length(2.0, 12.0);
+    std::vector<PassPredictor::Pass> passes;
+    for (size_t i = 0; i < count; ++i) {
+        PassPredictor::Pass p = {};
+        p.satellite = static_cast<uint32_t>(i);
+        p.aos = start(gen);
+        p.los = p.aos + length(gen);
+        p.tca = 0.5 * (p.aos + p.los);
+        passes.push_back(p);
+    }
+    return passes;
+}
+
+TEST(handover_scheduler_plans_are_optimal) {
+    const size_t N = 12;
+    for (unsigned antennas : {1u, 2u}) {
+        for (uint32_t seed = 1; seed <= 5; ++seed) {
+            auto passes = make_random_passes(N, seed);
+            HandoverScheduler::Config cfg;
+            cfg.setup_minutes = 1.0;
+            cfg.min_contact_minutes = 0.0;
+
+            // Best total time and count over every subset that fits on the
+            // antennas: interval graphs need as many antennas as the depth
+            double best_minutes = 0.0;
+            size_t best_count = 0;
+            for (uint32_t mask = 1; mask < (1u << N); ++mask) {
+                unsigned depth = 0;
+                double minutes = 0.0;
+                for (size_t i = 0; i < N; ++i) {
+                    if (!(mask >> i & 1)) continue;
+                    minutes += passes[i].duration();
+                    unsigned d = 0;
+                    for (size_t j = 0; j < N; ++j) {
+                        if ((mask >> j & 1) && passes[j].aos <= passes[i].aos &&
+                            passes[j].los + cfg.setup_minutes > passes[i].aos) ++d;
+                    }
+                    depth = std::max(depth, d);
+                }
+                if (depth > antennas) continue;
+                best_minutes = std::max(best_minutes, minutes);
+                best_count = std::max<size_t>(best_count, std::bitset<N>(mask).count());
+            }
+
+            for (auto solver : {HandoverScheduler::Solver::MinCostFlow, HandoverScheduler::Solver::Greedy}) {
+                cfg.solver = solver;
+                HandoverScheduler scheduler(cfg);
+                scheduler.add_station({40.0, -105.0, 1600.0}, antennas);
+                scheduler.set_passes(passes);
+                auto plan = scheduler.plan();
+
+                // No antenna tracks two satellites or skips its setup time
+                for (size_t i = 1; i < plan.size(); ++i) {
+                    ASSERT_TRUE(plan[i].antenna < antennas);
+                    if (plan[i].antenna == plan[i - 1].antenna) {
+                        ASSERT_TRUE(plan[i].aos >= plan[i - 1].los + cfg.setup_minutes);
+                    }
+                }
+                if (solver == HandoverScheduler::Solver::MinCostFlow) {
+                    ASSERT_CLOSE(HandoverScheduler::contact_minutes(plan), best_minutes, 1e-3);
+                } else {
+                    ASSERT_TRUE(plan.size() == best_count);
+                }
+                // One handover between consecutive contacts of each antenna
+                std::vector<uint32_t> used;
+                for (const auto& c : plan) used.push_back(c.antenna);
+                used.erase(std::unique(used.begin(), used.end()), used.end());
+                ASSERT_TRUE(HandoverScheduler::handovers(plan).size() == plan.size() - used.size());
+            }
+        }
+    }
+}
+
+TEST(handover_scheduler_visible_from_any_station) {
+    ConstellationTracker::ConstellationConfig cfg = {"TEST", 24, 550.0, 53.0, 4, 6};
+    HandoverScheduler scheduler;
+    scheduler.add_satellites(ConstellationTracker::generate_elements(cfg));
+    scheduler.add_station({40.0, -105.0, 1600.0});
+    scheduler.add_station({-33.9, 18.4, 10.0}, 2);
+    scheduler.add_station({78.2, 15.4, 500.0});
+    scheduler.predict(SGP4Propagator::epoch_julian_date(24, 1.0), 720.0);
+    const auto& passes = scheduler.get_passes();
+    ASSERT_TRUE(passes.size() > 10);
+
+    for (double t0 = 0.0; t0 < 720.0; t0 += 37.0) {
+        std::vector<uint32_t> got, expected;
+        scheduler.visible_satellites(t0, t0 + 15.0, got);
+        for (const auto& p : passes) {
+            if (p.aos <= t0 + 15.0 && p.los >= t0) expected.push_back(p.satellite);
+        }
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+        ASSERT_TRUE(got == expected);
+    }
+
+    // Every contact is one of the predicted passes at its station
+    for (const auto& c : scheduler.plan()) {
+        bool found = false;
+        for (const auto& p : passes) {
+            found |= p.satellite == c.satellite && p.station == c.station && p.aos == c.aos;
+        }
+        ASSERT_TRUE(found && c.antenna < (c.station == 1 ? 2u : 1u));
+    }
+}
+
+TEST(coverage_grid_cells_are_equal_area) {
+    CoverageGrid grid;
+    double total = 0.0, smallest = 1.0, largest = 0.0;
+    for (uint32_t c = 0; c < grid.cell_count(); ++c) {
+        double lat, lon;
+        grid.cell_center(c, lat, lon);
+        ASSERT_TRUE(grid.cell_of(lat, lon) == c);
+        total += grid.cell_area(c);
+        smallest = std::min(smallest, grid.cell_area(c));
+        largest = std::max(largest, grid.cell_area(c));
+    }
+    ASSERT_CLOSE(total, 1.0, 1e-9);
+    ASSERT_TRUE(largest < 1.5 * smallest);
+}
+
+TEST(coverage_grid_matches_direct_visibility) {
+    ConstellationTracker::ConstellationConfig cfg = {"TEST", 24, 550.0, 53.0, 4, 6};
+    CatalogPropagator catalog;
+    catalog.add(ConstellationTracker::generate_elements(cfg));
+    const double epoch_jd = SGP4Propagator::epoch_julian_date(24, 1.0);
+
+    CoverageGrid::Config gc;
+    gc.min_elevation_deg = 10.0;
+    gc.time_step_minutes = 2.0;
+    CoverageGrid grid(gc);
+    grid.analyze(catalog, epoch_jd, 0.0, 180.0);
+    ASSERT_TRUE(grid.step_count() == 90);
+
+    // Elevation from each sampled cell center on a spherical Earth
+    size_t mismatches = 0, checks = 0;
+    const double sin_mask = std::sin(gc.min_elevation_deg * DEG_TO_RAD);
+    for (uint32_t c = 0; c < grid.cell_count(); c += 13) {
+        double lat, lon;
+        grid.cell_center(c, lat, lon);
+        double ux = std::cos(lat * DEG_TO_RAD) * std::cos(lon * DEG_TO_RAD);
+        double uy = std::cos(lat * DEG_TO_RAD) * std::sin(lon * DEG_TO_RAD);
+        double uz = std::sin(lat * DEG_TO_RAD);
+        const uint64_t* bits = grid.coverage_bits(c);
+        size_t covered = 0, run = 0, max_run = 0;
+        for (size_t k = 0; k < grid.step_count(); ++k) {
+            double t = k * gc.time_step_minutes;
+            double gmst = SGP4Propagator::gmst(epoch_jd + t / 1440.0);
+            auto states = catalog.propagate(t);
+            bool seen = false;
+            for (size_t i = 0; i < states.size(); ++i) {
+                double ex = std::cos(gmst) * states.x[i] + std::sin(gmst) * states.y[i];
+                double ey = -std::sin(gmst) * states.x[i] + std::cos(gmst) * states.y[i];
+                double dx = ex - WGS84_A_KM * ux, dy = ey - WGS84_A_KM * uy, dz = states.z[i] - WGS84_A_KM * uz;
+                double d = std::sqrt(dx * dx + dy * dy + dz * dz);
+                seen |= dx * ux + dy * uy + dz * uz >= sin_mask * d;
+            }
+            bool bit = (bits[k / 64] >> (k % 64)) & 1;
+            mismatches += bit != seen;
+            ++checks;
+            covered += bit;
+            run = bit ? 0 : run + 1;
+            max_run = std::max(max_run, run);
+        }
+        const auto& m = grid.get_cell_metrics()[c];
+        ASSERT_CLOSE(static_cast<double>(m.coverage_fraction), static_cast<double>(covered) / grid.step_count(), 1e-6);
+        ASSERT_CLOSE(static_cast<double>(m.max_gap_minutes), max_run * gc.time_step_minutes, 1e-6);
+    }
+    ASSERT_TRUE(mismatches * 1000 <= checks);
+
+    auto stats = grid.statistics();
+    ASSERT_TRUE(stats.coverage_percent > 0.0 && stats.coverage_percent <= stats.ever_covered_percent);
+    ASSERT_TRUE(stats.ever_covered_percent <= 100.0 + 1e-9);
+    ASSERT_TRUE(stats.max_revisit_gap_minutes <= 180.0 && stats.mean_response_minutes > 0.0);
+}
+
+TEST(coverage_grid_places_stations_greedily) {
+    ConstellationTracker::ConstellationConfig cfg = {"TEST", 24, 550.0, 53.0, 4, 6};
+    CatalogPropagator catalog;
+    catalog.add(ConstellationTracker::generate_elements(cfg));
+    const double epoch_jd = SGP4Propagator::epoch_julian_date(24, 1.0);
+    CoverageGrid grid;
+
+    auto placement = grid.place_stations(catalog, epoch_jd, 0.0, 1440.0, 6);
+    ASSERT_TRUE(placement.cells.size() == 6);
+    for (size_t i = 1; i < placement.cells.size(); ++i) {
+        ASSERT_TRUE(placement.contact_percent[i] > placement.contact_percent[i - 1]);
+        ASSERT_TRUE(std::count(placement.cells.begin(), placement.cells.end(), placement.cells[i]) == 1);
+    }
+    ASSERT_TRUE(placement.contact_percent.back() <= 100.0);
+
+    // Restricted to candidate sites, the first pick is the best of them
+    std::vector<uint32_t> sites = {grid.cell_of(40.0, -105.0), grid.cell_of(0.0, 0.0), grid.cell_of(85.0, 0.0)};
+    auto restricted = grid.place_stations(catalog, epoch_jd, 0.0, 1440.0, 1, sites);
+    ASSERT_TRUE(restricted.cells.size() == 1 && restricted.cells[0] != sites[2]);
+    for (uint32_t site : sites) {
+        auto single = grid.place_stations(catalog, epoch_jd, 0.0, 1440.0, 1, {site});
+        double percent = single.contact_percent.empty() ? 0.0 : single.contact_percent[0];
+        ASSERT_TRUE(percent <= restricted.contact_percent[0]);
+    }
+
+    // Through the tracker (5 degree mask)
+    ConstellationTracker tracker(cfg);
+    double one = tracker.estimate_global_coverage(1), six = tracker.estimate_global_coverage(6);
+    ASSERT_TRUE(one > 0.0 && six > one && six > placement.contact_percent.back());
+    auto stats = tracker.analyze_coverage(3.0, 2.0);
+    ASSERT_TRUE(stats.coverage_percent > 0.0 && stats.coverage_percent < 100.0);
+}
+
+TEST(conjunction_screener_finds_crossing_orbits) {
+    // Two circular orbits through the same point of the equator 30 minutes
+    // after epoch, one 1 km higher than the other
+    auto make = [](double altitude_km, double inclination_deg) {
+        TLE tle = TLE();
+        double a = WGS84_A_KM + altitude_km;
+        tle.mean_motion = std::sqrt(EARTH_MU / (a * a * a)) * 86400.0 / (2.0 * M_PI);
+        tle.inclination = inclination_deg * DEG_TO_RAD;
+        tle.mean_anomaly = -tle.mean_motion * 2.0 * M_PI * 30.0 / 1440.0;
+        return tle;
+    };
+    CatalogPropagator catalog;
+    catalog.add(make(550.0, 53.0));
+    catalog.add(make(551.0, 97.0));
+    catalog.add(make(550.0, 30.0));   // same point, but 200 km along track
+    TLE shifted = make(550.0, 30.0);
+    catalog.set(2, [&] { shifted.mean_anomaly += 200.0 / (WGS84_A_KM + 550.0); return shifted; }());
+
+    ConjunctionScreener screener;
+    std::vector<ConjunctionScreener::Conjunction> found;
+    screener.screen(catalog, 0.0, 60.0, found);
+    ASSERT_TRUE(found.size() == 1);
+    ASSERT_TRUE(found[0].a == 0 && found[0].b == 1);
+
+    // Dense reference around the approach
+    double best_t = 0.0, best_d = 1e9;
+    for (double t = 29.0; t <= 31.0; t += 1e-5) {
+        StateVector p = catalog.propagate_one(0, t), q = catalog.propagate_one(1, t);
+        double d = std::sqrt((p.x - q.x) * (p.x - q.x) + (p.y - q.y) * (p.y - q.y) + (p.z - q.z) * (p.z - q.z));
+        if (d < best_d) {
+            best_d = d;
+            best_t = t;
+        }
+    }
+    ASSERT_CLOSE(found[0].miss_distance_km, best_d, 1e-3);
+    ASSERT_CLOSE(found[0].tca_minutes, best_t, 1e-3);
+    ASSERT_TRUE(found[0].relative_speed_km_s > 5.0 && found[0].relative_speed_km_s < 10.0);
+}
+
+TEST(conjunction_screener_matches_all_pairs) {
+    // Near-circular orbits in a 20 km altitude band
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * M_PI), altitude(540.0, 560.0);
+    CatalogPropagator catalog;
+    for (int i = 0; i < 120; ++i) {
+        TLE tle = TLE();
+        double a = WGS84_A_KM + altitude(gen);
+        tle.mean_motion = std::sqrt(EARTH_MU / (a * a * a)) * 86400.0 / (2.0 * M_PI);
+        tle.eccentricity = 0.001;
+        tle.inclination = angle(gen) / 2.0;
+        tle.raan = angle(gen);
+        tle.argument_perigee = angle(gen);
+        tle.mean_anomaly = angle(gen);
+        catalog.add(tle);
+    }
+    const double limit = 50.0, duration = 120.0;
+    ConjunctionScreener::Config cfg;
+    cfg.screening_distance_km = limit;
+    ConjunctionScreener screener(cfg);
+    std::vector<ConjunctionScreener::Conjunction> found;
+    screener.screen(catalog, 0.0, duration, found);
+    ASSERT_TRUE(found.size() > 3);
+
+    // Local minima of every pair's distance on a 2 s grid, refined
+    std::vector<CatalogPropagator::States> grid;
+    const double dt = 2.0 / 60.0;
+    for (double t = 0.0; t <= duration + 1e-9; t += dt) grid.push_back(catalog.propagate(t));
+    auto distance = [&](uint32_t a, uint32_t b, double t) {
+        StateVector p = catalog.propagate_one(a, t), q = catalog.propagate_one(b, t);
+        return std::sqrt((p.x - q.x) * (p.x - q.x) + (p.y - q.y) * (p.y - q.y) + (p.z - q.z) * (p.z - q.z));
+    };
+    size_t expected = 0;
+    for (uint32_t a = 0; a < catalog.size(); ++a) {
+        for (uint32_t b = a + 1; b < catalog.size(); ++b) {
+            auto d2 = [&](size_t k) {
+                const auto& s = grid[k];
+                double x = s.x[a] - s.x[b], y = s.y[a] - s.y[b], z = s.z[a] - s.z[b];
+                return x * x + y * y + z * z;
+            };
+            for (size_t k = 0; k < grid.size(); ++k) {
+                if (k > 0 && d2(k - 1) < d2(k)) continue;
+                if (k + 1 < grid.size() && d2(k + 1) < d2(k)) continue;
+                if (d2(k) > (limit + 10.0) * (limit + 10.0)) continue;
+                auto [t, d] = brent_minimize([&](double u) { return distance(a, b, u); },
+                                             std::max(0.0, (k - 1.0) * dt), std::min(duration, (k + 1.0) * dt), 1e-7);
+                if (d > limit - 0.01 && d < limit + 0.01) continue;  // too close to call
+                if (d > limit) continue;
+                ++expected;
+                bool matched = false;
+                for (const auto& c : found) {
+                    matched |= c.a == a && c.b == b && std::fabs(c.tca_minutes - t) < 1e-3 &&
+                               std::fabs(c.miss_distance_km - d) < 1e-3;
+                }
+                ASSERT_TRUE(matched);
+            }
+        }
+    }
+    ASSERT_TRUE(found.size() == expected);
+}
+
+TEST(conjunction_screener_matches_sgp4_sweep) {
+    // The crossing orbits again, screened on SGP4 states, plus two objects
+    // SGP4 rejects; their zero states must not pair up
+    auto make = [](double altitude_km, double inclination_deg) {
+        TLE tle = TLE();
+        double a = WGS84_A_KM + altitude_km;
+        tle.mean_motion = std::sqrt(EARTH_MU / (a * a * a)) * 86400.0 / (2.0 * M_PI);
+        tle.inclination = inclination_deg * DEG_TO_RAD;
+        tle.mean_anomaly = -tle.mean_motion * 2.0 * M_PI * 30.0 / 1440.0;
+        return tle;
+    };
+    CatalogPropagator::Config cc;
+    cc.model = CatalogPropagator::Model::SGP4;
+    CatalogPropagator catalog(cc);
+    catalog.add(make(550.0, 53.0));
+    catalog.add(make(551.0, 97.0));
+    TLE hyperbolic = make(550.0, 30.0);
+    hyperbolic.eccentricity = 1.5;
+    catalog.add(hyperbolic);
+    catalog.add(hyperbolic);
+
+    ConjunctionScreener::Config sc;
+    sc.screening_distance_km = 50.0;
+    ConjunctionScreener screener(sc);
+    std::vector<ConjunctionScreener::Conjunction> found;
+    screener.screen(catalog, 0.0, 60.0, found);
+    ASSERT_TRUE(found.size() == 1);
+    ASSERT_TRUE(found[0].a == 0 && found[0].b == 1);
+
+    // Dense SGP4 sweep: 0.1 s steps through the hour, then 1 ms steps
+    // around the closest sample
+    SGP4Propagator p(make(550.0, 53.0)), q(make(551.0, 97.0));
+    auto distance = [&](double t) {
+        StateVector u, v;
+        p.propagate(t, u);
+        q.propagate(t, v);
+        return std::sqrt((u.x - v.x) * (u.x - v.x) + (u.y - v.y) * (u.y - v.y) + (u.z - v.z) * (u.z - v.z));
+    };
+    double best_t = 0.0, best_d = 1e9;
+    for (double t = 0.0; t < 60.0; t += 0.1 / 60.0) {
+        double d = distance(t);
+        if (d < best_d) {
+            best_d = d;
+            best_t = t;
+        }
+    }
+    const double coarse_t = best_t;
+    for (double t = coarse_t - 0.1 / 60.0; t <= coarse_t + 0.1 / 60.0; t += 1e-3 / 60.0) {
+        double d = distance(t);
+        if (d < best_d) {
+            best_d = d;
+            best_t = t;
+        }
+    }
+    ASSERT_CLOSE(found[0].miss_distance_km, best_d, 1e-3);
+    ASSERT_CLOSE(found[0].tca_minutes, best_t, 1e-3);
+    // The two-body states put the approach elsewhere
+    ASSERT_TRUE(std::fabs(best_d - 1.0) > 0.1);
+}
+
+TEST(benchmark_comparison_flags_regressions) {
+    // Fully separated samples of three: U = 0, z = -4 / sqrt(5.25)
+    auto mw = BenchmarkComparison::mann_whitney({{1.0, 1}, {2.0, 1}, {3.0, 1}}, {{4.0, 1}, {5.0, 1}, {6.0, 1}});
+    ASSERT_CLOSE(mw.u, 0.0, 1e-12);
+    ASSERT_CLOSE(mw.p_value, 0.0809, 1e-3);
+    ASSERT_TRUE(BenchmarkComparison::mann_whitney({{2.0, 3}}, {{2.0, 2}}).p_value == 1.0);
+    // A bucket shared by both runs is one run of ties: ranks 1-2, 3-5, 6-7
+    mw = BenchmarkComparison::mann_whitney({{1.0, 2}, {2.0, 1}}, {{2.0, 2}, {3.0, 2}});
+    ASSERT_CLOSE(mw.u, 1.0 + 2.0 + 4.0 - 6.0, 1e-12);
+
+    // Per-call samples of about 1 ms, kept as histograms of batch times
+    std::mt19937 gen(3);
+    std::lognormal_distribution<> noise(0.0, 0.05);
+    auto result_of = [&](const std::string& name, double scale, int batch) {
+        BenchmarkFramework::BenchmarkResult r{};
+        r.name = name;
+        r.batch = batch;
+        for (int i = 0; i < 50; ++i) r.histogram.record(static_cast<uint64_t>(scale * noise(gen) * 1e6 * batch));
+        r.median_ms = r.histogram.percentile_ms(50.0) / batch;
+        return r;
+    };
+
+    // Baseline file in export_json's layout, one entry with raw times from
+    // before histograms were exported and one with neither
+    const std::string path = "benchmark_compare_test.json";
+    std::vector<double> legacy;
+    for (int i = 0; i < 50; ++i) legacy.push_back(noise(gen));
+    {
+        std::ofstream file(path);
+        file << "{\n  \"timestamp\": \"2026-01-01 00:00:00\",\n  \"benchmarks\": [\n";
+        for (const char* name : {"Slower", "Faster", "Same"}) {
+            auto r = result_of(name, 1.0, 4);
+            file << "    {\"name\": \"" << name << "\", \"median_ms\": " << r.median_ms
+                 << ", \"batch\": 4, \"histogram_ns\": [";
+            bool first = true;
+            for (size_t k = 0; k < r.histogram.bucket_count(); ++k) {
+                if (r.histogram.bucket(k) == 0) continue;
+                file << (first ? "" : ", ") << "[" << r.histogram.lowest_equivalent(k) << ", "
+                     << r.histogram.bucket(k) << "]";
+                first = false;
+            }
+            file << "]},\n";
+        }
+        file << "    {\"name\": \"Legacy\", \"median_ms\": 1.0, \"batch\": 1, \"times_ms\": [";
+        for (size_t i = 0; i < legacy.size(); ++i) file << (i ? ", " : "") << std::setprecision(17) << legacy[i];
+        file << "]},\n";
+        file << "    {\"name\": \"Old \\\"format\\\"\", \"median_ms\": 2.0, \"iterations\": 5}\n  ]\n}\n";
+    }
+    std::vector<BenchmarkFramework::BenchmarkResult> baseline;
+    ASSERT_TRUE(BenchmarkComparison::load(path, baseline));
+    std::remove(path.c_str());
+    ASSERT_TRUE(baseline.size() == 5);
+    ASSERT_TRUE(baseline[0].batch == 4 && baseline[0].histogram.count() == 50);
+    ASSERT_TRUE(baseline[3].histogram.count() == 50);
+    ASSERT_TRUE(baseline[4].name == "Old \"format\"" && baseline[4].histogram.empty());
+
+    std::vector<BenchmarkFramework::BenchmarkResult> current = {
+        result_of("Slower", 1.2, 1), result_of("Faster", 0.8, 2), result_of("Same", 1.0, 1),
+        result_of("Legacy", 1.0, 2), result_of("Old \"format\"", 1.0, 1), result_of("New", 1.0, 1)};
+
+    BenchmarkComparison comparison;
+    auto result = comparison.compare(baseline, current);
+    ASSERT_TRUE(result.size() == 6);
+    ASSERT_TRUE(result[0].verdict == BenchmarkComparison::Verdict::Regression);
+    ASSERT_TRUE(result[0].ratio_low > 1.1 && result[0].ratio_high < 1.3);
+    ASSERT_TRUE(result[1].verdict == BenchmarkComparison::Verdict::Faster);
+    ASSERT_TRUE(result[2].verdict == BenchmarkComparison::Verdict::Unchanged);
+    ASSERT_TRUE(result[2].ratio_low < 1.0 && result[2].ratio_high > 1.0);
+    ASSERT_TRUE(result[3].verdict == BenchmarkComparison::Verdict::Unchanged && result[3].sampled);
+    ASSERT_TRUE(result[4].verdict == BenchmarkComparison::Verdict::Untested);
+    ASSERT_TRUE(result[5].verdict == BenchmarkComparison::Verdict::Missing);
+
+    std::ostringstream report;
+    ASSERT_TRUE(comparison.report(result, report) == 1);
+    ASSERT_TRUE(report.str().find("1 untested") != std::string::npos);
+}
+
+TEST(benchmark_comparison_gates_histogram_results) {
+    // Block latencies as record() keeps them: a histogram per run, with
+    // 2% of the blocks in a slow tail
+    auto chain = [](const std::string& name, double scale, double tail_scale) {
+        BenchmarkFramework::BenchmarkResult result{};
+        result.name = name;
+        for (int i = 0; i < 1000; ++i) {
+            double us = (i < 980 ? 100.0 * scale : 400.0 * tail_scale) + i % 10;
+            result.histogram.record(static_cast<uint64_t>(us * 1000.0));
+        }
+        result.median_ms = result.histogram.percentile_ms(50.0);
+        result.p99_ms = result.histogram.percentile_ms(99.0);
+        return result;
+    };
+    std::vector<BenchmarkFramework::BenchmarkResult> baseline = {
+        chain("Median", 1.0, 1.0), chain("Tail", 1.0, 1.0), chain("Same", 1.0, 1.0), chain("Faster", 1.0, 1.0)};
+    std::vector<BenchmarkFramework::BenchmarkResult> current = {
+        chain("Median", 1.3, 1.0), chain("Tail", 1.0, 2.0), chain("Same", 1.0, 1.0), chain("Faster", 0.7, 0.7)};
+
+    // The same, from a file with percentiles only
+    auto percentiles_only = [](BenchmarkFramework::BenchmarkResult r) {
+        r.name += " (percentiles)";
+        r.histogram.reset();
+        return r;
+    };
+    for (size_t k = 0; k < 4; ++k) {
+        baseline.push_back(percentiles_only(baseline[k]));
+        current.push_back(percentiles_only(current[k]));
+    }
+
+    BenchmarkComparison comparison;
+    auto result = comparison.compare(baseline, current);
+    for (size_t k = 0; k < 8; k += 4) {
+        ASSERT_TRUE(result[k].verdict == BenchmarkComparison::Verdict::Regression);
+        ASSERT_CLOSE(result[k].ratio, 1.3, 0.02);
+        ASSERT_TRUE(result[k + 1].verdict == BenchmarkComparison::Verdict::Regression);
+        ASSERT_CLOSE(result[k + 1].ratio, 1.0, 0.02);
+        ASSERT_TRUE(result[k + 1].tail_ratio > 1.5);
+        ASSERT_TRUE(result[k + 2].verdict == BenchmarkComparison::Verdict::Unchanged);
+        ASSERT_TRUE(result[k + 3].verdict == BenchmarkComparison::Verdict::Faster);
+        for (size_t i = k; i < k + 4; ++i) ASSERT_TRUE(result[i].sampled == (k == 0));
+    }
+
+    std::ostringstream report;
+    ASSERT_TRUE(comparison.report(result, report) == 4);
+}
+
+TEST(receive_chain_benchmark_accounts_for_every_block) {
+    ReceiveChainBenchmark::Config cfg;
+    cfg.sample_rate = 100000.0;
+    cfg.duration_seconds = 0.5;
+    cfg.block_size = 1000;
+    auto r = ReceiveChainBenchmark(cfg).run();
+    ASSERT_TRUE(r.samples == 50000);
+    ASSERT_TRUE(r.blocks == 50 && r.block_latency.count() == 50);
+    ASSERT_TRUE(r.stage_latency[ReceiveChainBenchmark::Filter].count() == 50);
+    ASSERT_CLOSE(r.block_period_ms, 10.0, 1e-12);
+    ASSERT_TRUE(r.p50_ms <= r.p90_ms && r.p90_ms <= r.p99_ms && r.p99_ms <= r.p999_ms && r.p999_ms <= r.max_ms);
+    ASSERT_CLOSE(r.realtime_factor, r.samples / r.chain_seconds / cfg.sample_rate, 1e-9);
+
+    double share = 0.0;
+    for (int s = 0; s < ReceiveChainBenchmark::STAGE_COUNT; ++s) {
+        share += r.stage_share(static_cast<ReceiveChainBenchmark::Stage>(s));
+    }
+    ASSERT_CLOSE(share, 1.0, 1e-9);
+    ASSERT_TRUE(r.final_snr_db > 0.0);
+}
+
+TEST(latency_histogram_percentiles_and_merge) {
+    // Small values are exact and percentiles are nearest-rank
+    LatencyHistogram small;
+    for (uint64_t v : {5, 1, 4, 2, 3}) small.record(v);
+    ASSERT_TRUE(small.percentile(50.0) == 3 && small.percentile(99.9) == 5 && small.percentile(0.0) == 1);
+
+    // 1 us to 1 s spread over two threads' histograms: percentiles stay
+    // within the two-digit precision across six decades
+    LatencyHistogram a, b;
+    for (uint64_t i = 1; i <= 1000000; ++i) (i % 2 ? a : b).record(i * 1000);
+    ASSERT_TRUE(a.merge(b));
+    ASSERT_TRUE(a.count() == 1000000 && a.min() == 1000 && a.max() == 1000000000);
+    ASSERT_CLOSE(static_cast<double>(a.percentile(50.0)), 5e8, 5e8 / 100);
+    ASSERT_CLOSE(static_cast<double>(a.percentile(99.9)), 9.99e8, 9.99e8 / 100);
+    ASSERT_CLOSE(static_cast<double>(a.percentile(0.01)), 1e5, 1e5 / 100);
+    ASSERT_CLOSE(a.mean(), 500000500.0, 1.0);
+    ASSERT_TRUE(a.bucket_count() < 5000);
+
+    // Recording far past the range lands in the top bucket
+    a.record(uint64_t(1) << 50);
+    ASSERT_TRUE(a.percentile(100.0) == uint64_t(1) << 50);
+
+    LatencyHistogram::Config fine;
+    fine.significant_digits = 3;
+    LatencyHistogram c(fine);
+    ASSERT_TRUE(!c.merge(b));
+    c.record(123456789);
+    ASSERT_CLOSE(static_cast<double>(c.percentile(50.0)), 123456789.0, 123456789.0 / 1000);
+}
+
+TEST(allocation_tracker_counts_by_scope) {
+    if (!AllocationTracker::installed()) return;  // built without TRACK_ALLOCATIONS
+
+    const size_t tag = AllocationTracker::tag("test/vectors");
+    ASSERT_TRUE(AllocationTracker::tag("test/vectors") == tag && tag != AllocationTracker::UNTAGGED);
+    ASSERT_TRUE(std::string(AllocationTracker::tag_name(tag)) == "test/vectors");
+
+    auto total_before = AllocationTracker::snapshot();
+    auto tag_before = AllocationTracker::tag_snapshot(tag);
+    {
+        AllocationScope scope(tag);
+        std::vector<double> a(100);
+        auto* b = new int[7];
+        delete[] b;
+    }
+    std::vector<char> untagged(10);
+    auto total = AllocationTracker::snapshot() - total_before;
+    auto tagged = AllocationTracker::tag_snapshot(tag) - tag_before;
+    ASSERT_TRUE(tagged.allocations == 2 && tagged.deallocations == 2);
+    ASSERT_TRUE(tagged.bytes == 100 * sizeof(double) + 7 * sizeof(int));
+    ASSERT_TRUE(total.allocations == 3 && total.bytes == tagged.bytes + 10);
+
+    // The receive chain attributes its allocations to stages
+    ReceiveChainBenchmark::Config cfg;
+    cfg.sample_rate = 10000.0;
+    cfg.duration_seconds = 0.4;
+    cfg.block_size = 1000;
+    auto r = ReceiveChainBenchmark(cfg).run();
+    ASSERT_TRUE(r.stage_allocations[ReceiveChainBenchmark::Doppler] >= 1.0);
+    ASSERT_TRUE(r.allocated_bytes_per_block() >= cfg.block_size * sizeof(ComplexSample));
+}
+
+TEST(tracer_writes_balanced_chrome_trace) {
+    auto& tracer = Tracer::instance();
+    Tracer::Config cfg;
+    cfg.events_per_thread = 64;
+    tracer.set_config(cfg);
+    tracer.clear();
+
+    // Nothing is recorded while stopped
+    std::thread([] { TraceScope idle("test/idle"); }).join();
+
+    // 100 nested pairs overflow the 64-event ring of the second thread
+    tracer.start();
+    std::thread first([] {
+        TraceScope outer("test/outer");
+        TraceScope inner("test/inner");
+    });
+    std::thread second([] {
+        for (int i = 0; i < 100; ++i) TraceScope block("test/block");
+    });
+    first.join();
+    second.join();
+#ifdef SATELLITE_SIGNAL_TRACING
+    std::thread([] { LowpassFilter(0.1, 16).process_buffer(std::vector<double>(64, 1.0)); }).join();
+#endif
+    tracer.stop();
+    tracer.set_config(Tracer::Config());
+
+    std::ostringstream json;
+    tracer.write_chrome_trace(json);
+    const std::string trace = json.str();
+    auto count = [&](const std::string& needle) {
+        size_t n = 0;
+        for (size_t pos = trace.find(needle); pos != std::string::npos; pos = trace.find(needle, pos + 1)) ++n;
+        return n;
+    };
+    ASSERT_TRUE(trace.find("\"traceEvents\"") != std::string::npos);
+    ASSERT_TRUE(count("test/idle") == 0);
+    ASSERT_TRUE(count("\"test/outer\", \"ph\": \"B\"") == 1 && count("\"test/inner\", \"ph\": \"E\"") == 1);
+    ASSERT_TRUE(tracer.dropped_events() == 200 - 64);
+    ASSERT_TRUE(count("\"test/block\", \"ph\": \"B\"") == 32 && count("\"test/block\", \"ph\": \"E\"") == 32);
+    ASSERT_TRUE(count("\"ph\": \"B\"") == count("\"ph\": \"E\""));
+#ifdef SATELLITE_SIGNAL_TRACING
+    ASSERT_TRUE(count("FIRFilter::process_buffer") == 2);
+#endif
+    tracer.clear();
+}
+
+TEST(metrics_registry_exports_prometheus_text) {
+    MetricsRegistry registry;
+    ReceiverMetrics metrics(registry);
+    ASSERT_TRUE(&registry.counter("satellite_signal_samples_processed_total", "ignored") ==
+                &metrics.samples_processed);
+
+    // Updates from several threads land in different cells and sum on read
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; ++i) metrics.samples_processed.inc(2);
+        });
+    }
+    for (auto& t : threads) t.join();
+    ASSERT_TRUE(metrics.samples_processed.value() == 8000);
+
+    metrics.snr_db.set(12.5);
+    for (double v : {5e-5, 3e-4, 3e-4, 1.0}) metrics.block_latency_seconds.observe(v);
+    auto snap = metrics.block_latency_seconds.snapshot();
+    ASSERT_TRUE(snap.count == 4 && snap.cumulative[0] == 1 && snap.cumulative[2] == 3);
+    ASSERT_CLOSE(snap.sum, 1.00065, 1e-12);
+
+    registry.counter("satellite_signal_decoder_frames_total", "Frames per decoder", "decoder=\"ldpc\"").inc(3);
+    registry.counter("satellite_signal_decoder_frames_total", "Frames per decoder", "decoder=\"turbo\"").inc();
+
+    std::ostringstream out;
+    registry.write_prometheus(out);
+    const std::string text = out.str();
+    auto has = [&](const std::string& line) { return text.find(line + "\n") != std::string::npos; };
+    ASSERT_TRUE(has("# TYPE satellite_signal_samples_processed_total counter"));
+    ASSERT_TRUE(has("satellite_signal_samples_processed_total 8000"));
+    ASSERT_TRUE(has("satellite_signal_snr_db 12.5"));
+    ASSERT_TRUE(has("satellite_signal_block_latency_seconds_bucket{le=\"0.00025\"} 1"));
+    ASSERT_TRUE(has("satellite_signal_block_latency_seconds_bucket{le=\"+Inf\"} 4"));
+    ASSERT_TRUE(has("satellite_signal_block_latency_seconds_count 4"));
+    ASSERT_TRUE(has("satellite_signal_decoder_frames_total{decoder=\"ldpc\"} 3"));
+    ASSERT_TRUE(text.find("# HELP satellite_signal_decoder_frames_total") ==
+                text.rfind("# HELP satellite_signal_decoder_frames_total"));
+    // Decoder counters only appear once a decode stage registers them
+    ASSERT_TRUE(text.find("satellite_signal_frames_decoded_total") == std::string::npos);
+
+    // The exporter rewrites the file and writes once more on stop
+    const std::string path = "test_metrics.prom";
+    {
+        MetricsExporter exporter(registry, {path, 0.01});
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        exporter.stop();
+        ASSERT_TRUE(exporter.get_writes() >= 2 && exporter.get_failures() == 0);
+    }
+    std::ifstream file(path);
+    std::stringstream written;
+    written << file.rdbuf();
+    ASSERT_TRUE(written.str() == text);
+    file.close();
+    std::remove(path.c_str());
+}
+
+TEST(iq_file_reader_streams_sigmf_and_raw_captures) {
+    // SigMF: 1000 ci16 samples, I = n, Q = -n
+    {
+        std::ofstream data("test_capture.sigmf-data", std::ios::binary);
+        for (int16_t n = 0; n < 1000; ++n) {
+            int16_t iq[2] = {n, static_cast<int16_t>(-n)};
+            data.write(reinterpret_cast<const char*>(iq), sizeof(iq));
+        }
+        std::ofstream meta("test_capture.sigmf-meta");
+        meta << "{\"global\": {\"core:datatype\": \"ci16_le\", \"core:sample_rate\": 2.4e6, \"core:version\": \"1.0.0\"},\n"
+             << " \"captures\": [{\"core:sample_start\": 0, \"core:frequency\": 1.6e9}], \"annotations\": []}\n";
+    }
+    IQFileReader::Config cfg;
+    cfg.block_samples = 250;
+    IQFileReader reader(cfg);
+    ASSERT_TRUE(reader.open("test_capture.sigmf-meta"));
+    ASSERT_TRUE(reader.metadata().format == IQFormat::CS16 && reader.metadata().datatype == "ci16_le");
+    ASSERT_CLOSE(reader.metadata().sample_rate, 2.4e6, 1e-6);
+    ASSERT_CLOSE(reader.metadata().center_frequency, 1.6e9, 1e-3);
+    ASSERT_TRUE(reader.total_samples() == 1000 && reader.block_samples() == 256);
+
+    // Blocks are views into the mapping, aligned, and cover the file once
+    IQBlock block;
+    std::vector<ComplexSample> samples;
+    uint64_t seen = 0;
+    const char* base = reader.block_at(0, 1).data;
+    while (reader.next(block)) {
+        ASSERT_TRUE(block.first_sample == seen && block.data == base + seen * 4);
+        ASSERT_TRUE(reinterpret_cast<uintptr_t>(block.data) % cfg.alignment == 0);
+        ASSERT_TRUE(block.cs16()[0] == static_cast<int16_t>(seen) && block.cf32() == nullptr);
+        seen += block.samples;
+    }
+    ASSERT_TRUE(seen == 1000 && block.samples == 1000 - 3 * 256);
+    IQFileReader::to_complex(reader.block_at(500, 2), samples);
+    ASSERT_CLOSE(samples[1].real(), 501.0 / 32768.0, 1e-15);
+    ASSERT_CLOSE(samples[1].imag(), -501.0 / 32768.0, 1e-15);
+    reader.close();
+
+    // The base name finds the SigMF pair; an unsupported datatype is refused
+    ASSERT_TRUE(reader.open("test_capture") && reader.total_samples() == 1000);
+    {
+        std::ofstream meta("test_capture.sigmf-meta");
+        meta << "{\"global\": {\"core:datatype\": \"ri16_be\"}}";
+    }
+    ASSERT_TRUE(!reader.open("test_capture.sigmf-data") && !reader.get_error().empty());
+    std::remove("test_capture.sigmf-data");
+    std::remove("test_capture.sigmf-meta");
+
+    // Raw files by extension: cf32 views in place, cu8 is offset binary
+    {
+        std::ofstream cf32("test_capture.cf32", std::ios::binary);
+        float iq[6] = {0.5f, -0.25f, 1.0f, 0.0f, -1.0f, 0.125f};
+        cf32.write(reinterpret_cast<const char*>(iq), sizeof(iq));
+        std::ofstream cu8("test_capture.cu8", std::ios::binary);
+        uint8_t raw[4] = {255, 0, 128, 127};
+        cu8.write(reinterpret_cast<const char*>(raw), sizeof(raw));
+    }
+    ASSERT_TRUE(reader.open("test_capture.cf32") && reader.total_samples() == 3);
+    ASSERT_TRUE(reader.next(block) && block.samples == 3 && block.cf32()[2] == std::complex<float>(-1.0f, 0.125f));
+    ASSERT_TRUE(!reader.next(block));
+    ASSERT_TRUE(reader.open("test_capture.cu8"));
+    IQFileReader::to_complex(reader.block_at(0, 2), samples);
+    ASSERT_CLOSE(samples[0].real(), 1.0, 1e-12);
+    ASSERT_CLOSE(samples[0].imag(), -1.0, 1e-12);
+    ASSERT_CLOSE(samples[1].real(), 0.5 / 127.5, 1e-12);
+    reader.close();
+    std::remove("test_capture.cf32");
+    std::remove("test_capture.cu8");
+    ASSERT_TRUE(!reader.open("test_capture.bin"));
+}
+
+TEST(iq_recorder_writes_sigmf_readable_by_reader) {
+    std::vector<ComplexSample> block(1000);
+    for (size_t i = 0; i < block.size(); ++i) block[i] = ComplexSample(i * 1e-3, -0.5);
+
+    // Several buffers' worth in uneven writes, then back through the reader
+    IQRecorder::Config cfg;
+    cfg.format = IQFormat::CS16;
+    cfg.sample_rate = 1e6;
+    cfg.center_frequency = 2.2e9;
+    cfg.block_bytes = 4096;
+    cfg.buffers = 64;
+    IQRecorder recorder(cfg);
+    ASSERT_TRUE(recorder.open("test_recording"));
+    for (int k = 0; k < 5; ++k) ASSERT_TRUE(recorder.write(block.data(), block.size() - k));
+    ASSERT_TRUE(recorder.close());
+    auto stats = recorder.get_stats();
+    ASSERT_TRUE(stats.samples_recorded == 4990 && stats.samples_dropped == 0 && stats.write_errors == 0);
+    ASSERT_TRUE(stats.bytes_written == 4990 * 4 && stats.blocks_written == 5);
+
+    IQFileReader reader;
+    ASSERT_TRUE(reader.open("test_recording"));
+    ASSERT_TRUE(reader.metadata().format == IQFormat::CS16 && reader.total_samples() == 4990);
+    ASSERT_CLOSE(reader.metadata().sample_rate, 1e6, 1e-6);
+    ASSERT_CLOSE(reader.metadata().center_frequency, 2.2e9, 1e-3);
+    std::vector<ComplexSample> back;
+    IQFileReader::to_complex(reader.block_at(1000 + 999 - 1, 2), back);  // end of 2nd write, start of 3rd
+    ASSERT_CLOSE(back[0].real(), 0.998, 1.0 / 32768);
+    ASSERT_CLOSE(back[1].real(), 0.0, 1.0 / 32768);
+    ASSERT_CLOSE(back[1].imag(), -0.5, 1.0 / 32768);
+    reader.close();
+
+    // A two-buffer pool fed far faster than a disk: whatever does not fit
+    // is dropped and accounted for, and write() never waits
+    IQRecorder::Config small = cfg;
+    small.format = IQFormat::CF32;
+    small.buffers = 2;
+    IQRecorder burst(small);
+    ASSERT_TRUE(burst.open("test_recording"));
+    std::vector<ComplexSample> big(1 << 20);
+    for (int k = 0; k < 4; ++k) burst.write(big);
+    burst.close();
+    stats = burst.get_stats();
+    ASSERT_TRUE(stats.samples_recorded + stats.samples_dropped == 4u << 20);
+    uint64_t gap_total = 0;
+    for (const auto& g : burst.get_gaps()) gap_total += g.dropped;
+    ASSERT_TRUE(gap_total == stats.samples_dropped);
+    ASSERT_TRUE(reader.open("test_recording") && reader.total_samples() == stats.samples_recorded);
+    reader.close();
+    std::remove("test_recording.sigmf-data");
+    std::remove("test_recording.sigmf-meta");
+}
+
+TEST(name_table_interns_names) {
+    NameTable names;
+    SatelliteId a = names.intern("ISS (ZARYA)");
+    SatelliteId b = names.intern("NOAA 19");
+    ASSERT_TRUE(a == 0 && b == 1);
+    ASSERT_TRUE(names.intern("ISS (ZARYA)") == a);
+    ASSERT_TRUE(names.size() == 2);
+    ASSERT_TRUE(names.get(b) == "NOAA 19");
+    ASSERT_TRUE(names.find("NOAA 18") == NameTable::npos);
+}
+
+TEST(fast_sincos_matches_std) {
+    double max_error = 0.0;
+    for (double x = -100.0; x < 100.0; x += 0.0123) {
+        double s, c;
+        fast_sincos(x, s, c);
+        max_error = std::max(max_error, std::fabs(s - std::sin(x)));
+        max_error = std::max(max_error, std::fabs(c - std::cos(x)));
+    }
+    ASSERT_TRUE(max_error < 1e-15);
+}
+
+static std::vector<TLE> make_test_catalog(size_t count) {
+    std::vector<TLE> tles(count);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<> angle(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<> ecc(0.0, 0.9);
+    for (size_t i = 0; i < count; ++i) {
+        tles[i] = TLE();
+        tles[i].catalog_number = static_cast<long>(i);
+        tles[i].mean_motion = 1.0 + 15.0 * (i % 50) / 50.0;
+        tles[i].eccentricity = i % 3 == 0 ? ecc(gen) : 0.001;
+        tles[i].inclination = angle(gen) / 2.0;
+        tles[i].raan = angle(gen);
+        tles[i].argument_perigee = angle(gen);
+        tles[i].mean_anomaly = angle(gen);
+    }
+    return tles;
+}
+
+// Reference two-body position using library trigonometry
+static StateVector two_body_position(const TLE& tle, double minutes) {
+    double n = tle.mean_motion * 2.0 * M_PI / 86400.0;
+    double a = std::cbrt(EARTH_MU / (n * n));
+    double e = tle.eccentricity;
+    double M = tle.mean_anomaly + n * 60.0 * minutes;
+    double E = e > 0.8 ? M_PI : M;
+    for (int i = 0; i < 50; ++i) E -= (E - e * std::sin(E) - M) / (1.0 - e * std::cos(E));
+    double xp = a * (std::cos(E) - e);
+    double yp = a * std::sqrt(1.0 - e * e) * std::sin(E);
+
+    double co = std::cos(tle.raan), so = std::sin(tle.raan);
+    double ci = std::cos(tle.inclination), si = std::sin(tle.inclination);
+    double cw = std::cos(tle.argument_perigee), sw = std::sin(tle.argument_perigee);
+    StateVector s = {};
+    s.x = (co * cw - so * sw * ci) * xp + (-co * sw - so * cw * ci) * yp;
+    s.y = (so * cw + co * sw * ci) * xp + (-so * sw + co * cw * ci) * yp;
+    s.z = si * sw * xp + si * cw * yp;
+    return s;
+}
+
+TEST(catalog_propagator_matches_two_body) {
+    auto tles = make_test_catalog(500);
+    CatalogPropagator::Config cfg;
+    cfg.grain = 100;
+    cfg.num_threads = 3;
+    CatalogPropagator catalog(cfg);
+    catalog.add(tles);
+
+    double max_error = 0.0;
+    for (double t : {0.0, 97.5, 4000.0}) {
+        auto states = catalog.propagate(t);
+        for (size_t i = 0; i < tles.size(); ++i) {
+            StateVector ref = two_body_position(tles[i], t);
+            StateVector s = states.get(i);
+            max_error = std::max(max_error, std::fabs(s.x - ref.x) + std::fabs(s.y - ref.y) +
+                                            std::fabs(s.z - ref.z));
+        }
+    }
+    ASSERT_TRUE(max_error < 1e-6);
+}
+
+TEST(catalog_propagator_velocity_is_position_derivative) {
+    auto tles = make_test_catalog(60);
+    CatalogPropagator catalog;
+    catalog.add(tles);
+
+    const double dt_min = 1e-4;
+    for (size_t i = 0; i < tles.size(); ++i) {
+        StateVector s = catalog.propagate_one(i, 30.0);
+        StateVector ahead = catalog.propagate_one(i, 30.0 + dt_min);
+        StateVector behind = catalog.propagate_one(i, 30.0 - dt_min);
+        double dt_s = 2.0 * dt_min * 60.0;
+        ASSERT_CLOSE(s.vx, (ahead.x - behind.x) / dt_s, 1e-5);
+        ASSERT_CLOSE(s.vy, (ahead.y - behind.y) / dt_s, 1e-5);
+        ASSERT_CLOSE(s.vz, (ahead.z - behind.z) / dt_s, 1e-5);
+    }
+}
+
+TEST(catalog_propagator_sgp4_model_matches_sgp4) {
+    auto tles = make_test_catalog(300);
+    for (auto& tle : tles) {
+        tle.epoch_year = 24;
+        tle.epoch_day = 1.0;
+        tle.bstar = 1e-5;
+    }
+    CatalogPropagator::Config cfg;
+    cfg.model = CatalogPropagator::Model::SGP4;
+    cfg.grain = 50;
+    cfg.num_threads = 3;
+    CatalogPropagator catalog(cfg);
+    catalog.add(tles);
+    catalog.set(7, make_leo_tle());
+    tles[7] = make_leo_tle();
+    catalog.remove(20);
+    tles[20] = tles.back();
+    tles.pop_back();
+
+    for (double t : {0.0, 97.5, 1440.0}) {
+        auto states = catalog.propagate(t);
+        for (size_t i = 0; i < tles.size(); ++i) {
+            StateVector ref;
+            SGP4Propagator(tles[i]).propagate(t, ref);
+            StateVector s = states.get(i);
+            ASSERT_TRUE(s.x == ref.x && s.y == ref.y && s.z == ref.z);
+            ASSERT_TRUE(s.vx == ref.vx && s.vy == ref.vy && s.vz == ref.vz);
+        }
+        StateVector one = catalog.propagate_one(7, t);
+        ASSERT_TRUE(one.x == states.x[7] && one.vz == states.vz[7]);
+    }
+}
+
+TEST(topocentric_batch_matches_single_views) {
+    CatalogPropagator catalog;
+    catalog.add(make_test_catalog(300));
+    CatalogPropagator::States states = catalog.propagate(42.0);
+
+    TopocentricBatch batch;
+    batch.add_station({40.0, -105.0, 1600.0});
+    batch.add_station({-33.9, 18.4, 10.0});
+    batch.add_station({78.2, 15.4, 500.0});
+
+    const double gmst = 1.234;
+    TopocentricBatch::Views views;
+    batch.compute(states, gmst, views);
+    ASSERT_TRUE(views.satellites == 300 && views.stations == 3);
+
+    for (size_t k = 0; k < batch.station_count(); ++k) {
+        for (size_t i = 0; i < states.size(); ++i) {
+            TopocentricView expected = batch.get_station(k).view(states.get(i), gmst);
+            TopocentricView got = views.get(i, k);
+            ASSERT_CLOSE(got.azimuth, expected.azimuth, 1e-9);
+            ASSERT_CLOSE(got.elevation, expected.elevation, 1e-9);
+            ASSERT_CLOSE(got.range, expected.range, 1e-9);
+            ASSERT_CLOSE(got.range_rate, expected.range_rate, 1e-12);
+        }
+    }
+}
+
+TEST(visibility_index_matches_brute_force) {
+    const GroundStation sites[] = {{40.0, -105.0, 1600.0}, {78.2, 15.4, 500.0},
+                                   {-0.5, 179.9, 0.0}, {-89.0, 0.0, 2800.0}};
+    ConstellationTracker::ConstellationConfig shell = {"IDX", 1200, 550.0, 53.0, 30, 40};
+
+    for (const auto& tles : {make_test_catalog(2000), ConstellationTracker::generate_elements(shell)}) {
+        CatalogPropagator catalog;
+        catalog.add(tles);
+        CatalogPropagator::States states = catalog.propagate(42.0);
+        const double gmst = 1.234;
+
+        VisibilityIndex index;
+        for (const auto& site : sites) index.add_station(site, 10.0);
+        index.build(states, gmst);
+        ASSERT_TRUE(index.satellite_count() == tles.size());
+
+        std::vector<std::vector<uint32_t>> visible;
+        index.query_all(visible);
+        for (size_t k = 0; k < index.station_count(); ++k) {
+            std::vector<uint32_t> expected;
+            for (size_t i = 0; i < states.size(); ++i) {
+                if (index.get_station(k).view(states.get(i), gmst).elevation >= 10.0) {
+                    expected.push_back(static_cast<uint32_t>(i));
+                }
+            }
+            std::sort(visible[k].begin(), visible[k].end());
+            ASSERT_TRUE(visible[k] == expected);
+        }
+    }
+}
+
+TEST(visibility_index_patches_single_satellites) {
+    CatalogPropagator catalog;
+    catalog.add(make_test_catalog(1000));
+    CatalogPropagator::States states = catalog.propagate(42.0);
+    CatalogPropagator::States later = catalog.propagate(50.0);
+    const double gmst = 1.234;
+
+    VisibilityIndex index;
+    index.add_station({40.0, -105.0, 1600.0}, 10.0);
+    index.add_station({-33.9, 18.4, 10.0}, 0.0);
+    index.build(states, gmst);
+
+    // Move some satellites, add one, then remove with swap-with-last
+    std::vector<StateVector> truth;
+    for (size_t i = 0; i < states.size(); ++i) truth.push_back(states.get(i));
+    for (size_t i = 0; i < truth.size(); i += 7) {
+        truth[i] = later.get(i);
+        index.set_satellite(static_cast<uint32_t>(i), truth[i], gmst);
+    }
+    truth.push_back(later.get(3));
+    index.set_satellite(static_cast<uint32_t>(truth.size() - 1), truth.back(), gmst);
+    for (uint32_t id : {10u, 14u, 500u, static_cast<uint32_t>(truth.size() - 2)}) {
+        truth[id] = truth.back();
+        truth.pop_back();
+        index.remove_satellite(id);
+    }
+    ASSERT_TRUE(index.satellite_count() == truth.size());
+
+    for (size_t k = 0; k < index.station_count(); ++k) {
+        std::vector<uint32_t> got, expected;
+        index.query(k, got);
+        for (size_t i = 0; i < truth.size(); ++i) {
+            if (index.visible(k, truth[i], gmst)) expected.push_back(static_cast<uint32_t>(i));
+        }
+        std::sort(got.begin(), got.end());
+        ASSERT_TRUE(got == expected);
+    }
+}
+
+TEST(isl_analyzer_matches_all_pairs) {
+    CatalogPropagator catalog;
+    catalog.add(make_test_catalog(1500));
+    CatalogPropagator::States states = catalog.propagate(42.0);
+
+    ISLAnalyzer::Config cfg;
+    cfg.max_range_km = 8000.0;
+    cfg.grain = 64;
+    cfg.num_threads = 3;
+    ISLAnalyzer isl(cfg);
+    std::vector<ISLAnalyzer::Link> links;
+    isl.analyze(states, links);
+    for (size_t i = 1; i < links.size(); ++i) ASSERT_TRUE(links[i].a >= links[i - 1].a);
+    std::sort(links.begin(), links.end(), [](const ISLAnalyzer::Link& l, const ISLAnalyzer::Link& r) {
+        return l.a != r.a ? l.a < r.a : l.b < r.b;
+    });
+
+    const double clear = WGS84_A_KM + cfg.grazing_altitude_km;
+    size_t expected = 0;
+    for (size_t i = 0; i < states.size(); ++i) {
+        for (size_t j = i + 1; j < states.size(); ++j) {
+            StateVector a = states.get(i), b = states.get(j);
+            double dx = b.x - a.x, dy = b.y - a.y, dz = b.z - a.z;
+            double d2 = dx * dx + dy * dy + dz * dz;
+            if (d2 > cfg.max_range_km * cfg.max_range_km) continue;
+            if (!ISLAnalyzer::clears_earth(a.x, a.y, a.z, dx, dy, dz, d2, clear * clear)) continue;
+            ASSERT_TRUE(expected < links.size());
+            ASSERT_TRUE(links[expected].a == i && links[expected].b == j);
+            ASSERT_CLOSE(static_cast<double>(links[expected].range_km), std::sqrt(d2), 1e-3);
+            ++expected;
+        }
+    }
+    ASSERT_TRUE(links.size() == expected && expected > 1000);
+}
+
+TEST(isl_analyzer_blocks_earth_occultation) {
+    // Satellites at 550 km: 30 degrees apart the chord clears the Earth, 60
+    // degrees apart it dips below the grazing altitude
+    const double r = WGS84_A_KM + 550.0;
+    const double x[] = {r, r * std::cos(M_PI / 6.0), r * std::cos(M_PI / 6.0)};
+    const double y[] = {0.0, r * std::sin(M_PI / 6.0), r * std::sin(-M_PI / 6.0)};
+    const double z[] = {0.0, 0.0, 0.0};
+    ISLAnalyzer::Config cfg;
+    cfg.max_range_km = 20000.0;
+    ISLAnalyzer isl(cfg);
+    std::vector<ISLAnalyzer::Link> links;
+    isl.analyze(x, y, z, 3, links);
+    ASSERT_TRUE(links.size() == 2);
+    ASSERT_TRUE(links[0].a == 0 && links[0].b == 1);
+    ASSERT_TRUE(links[1].a == 0 && links[1].b == 2);
+}
+
+TEST(satellite_table_geodetic_columns) {
+    SatelliteTable table;
+    CatalogPropagator catalog;
+    auto tles = make_test_catalog(200);
+    catalog.add(tles);
+    for (const auto& tle : tles) {
+        table.add(static_cast<int32_t>(tle.catalog_number), "SAT-" + std::to_string(tle.catalog_number));
+    }
+    ASSERT_TRUE(table.find("SAT-17") == 17);
+
+    CatalogPropagator::States states = catalog.propagate(30.0);
+    const double gmst = 0.75;
+    table.update(states, gmst);
+    for (size_t i = 0; i < table.size(); ++i) {
+        StateVector s = states.get(i);
+        double x = std::cos(gmst) * s.x + std::sin(gmst) * s.y;
+        double y = -std::sin(gmst) * s.x + std::cos(gmst) * s.y;
+        double r = std::sqrt(s.x * s.x + s.y * s.y + s.z * s.z);
+        ASSERT_CLOSE(static_cast<double>(table.latitude_deg[i]), std::asin(s.z / r) * RAD_TO_DEG, 1e-4);
+        ASSERT_CLOSE(static_cast<double>(table.longitude_deg[i]), std::atan2(y, x) * RAD_TO_DEG, 1e-4);
+        ASSERT_CLOSE(static_cast<double>(table.altitude_km[i]), r - WGS84_A_KM, 1e-2 * r / 7000.0);
+        ASSERT_CLOSE(static_cast<double>(table.speed_km_s[i]), std::sqrt(s.vx * s.vx + s.vy * s.vy + s.vz * s.vz), 1e-5);
+    }
+}
+
+TEST(ber_simulator_uncoded_matches_theory) {
+    BerSimulator::Config cfg;
+    cfg.ebn0_start_db = 4.0;
+    cfg.ebn0_stop_db = 4.0;
+    cfg.target_bit_errors = 2000;
+    cfg.target_frame_errors = 1;
+    cfg.num_threads = 2;
+    cfg.seed = 7;
+
+    BerSimulator simulator(cfg);
+    auto curve = simulator.run(BerSimulator::uncoded(1024));
+
+    ASSERT_TRUE(curve.size() == 1);
+    double expected = BerSimulator::theoretical_qpsk_ber(4.0);
+    ASSERT_EQ(curve[0].ber, expected, expected * 0.15);
+}
+
+TEST(ber_simulator_stops_at_error_target) {
+    BerSimulator::Config cfg;
+    cfg.ebn0_start_db = 0.0;
+    cfg.ebn0_stop_db = 2.0;
+    cfg.target_bit_errors = 500;
+    cfg.target_frame_errors = 10;
+    cfg.num_threads = 1;
+
+    BerSimulator simulator(cfg);
+    auto curve = simulator.run(BerSimulator::uncoded(256));
+
+    ASSERT_TRUE(curve.size() == 3);
+    for (const auto& point : curve) {
+        ASSERT_TRUE(point.bit_errors >= 500);
+        ASSERT_TRUE(point.frame_errors >= 10);
+        ASSERT_TRUE(point.frames < cfg.max_frames);
+    }
+    ASSERT_TRUE(curve[0].ber > curve[2].ber);
+}
+
+static std::vector<uint8_t> random_bits(size_t count, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::vector<uint8_t> bits(count);
+    for (auto& b : bits) b = gen() & 1;
+    return bits;
+}
+
+static std::vector<double> to_soft(const std::vector<uint8_t>& bits, double noise_std, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<> noise(0.0, noise_std);
+    std::vector<double> soft(bits.size());
+    for (size_t i = 0; i < bits.size(); ++i) soft[i] = (bits[i] ? 1.0 : -1.0) + noise(gen);
+    return soft;
+}
+
+TEST(convolutional_roundtrip_corrects_errors) {
+    auto bits = random_bits(1000, 1);
+    ConvolutionalEncoder encoder;
+    auto coded = encoder.encode(bits);
+    ASSERT_TRUE(coded.size() == (bits.size() + 6) * 2);
+
+    auto soft = to_soft(coded, 0.0, 2);
+    for (size_t i = 10; i < soft.size(); i += 40) soft[i] = -soft[i];
+
+    ConvolutionalDecoder decoder;
+    auto decoded = decoder.decode(soft);
+    ASSERT_TRUE(decoded == bits);
+}
+
+TEST(convolutional_packed_matches_bitwise) {
+    auto bits = random_bits(64, 3);
+    ConvolutionalEncoder::Config cfg;
+    cfg.terminate = false;
+    ConvolutionalEncoder bitwise(cfg), packed(cfg);
+    auto coded = bitwise.encode(bits);
+
+    std::vector<uint8_t> in(8), out(16);
+    for (size_t i = 0; i < bits.size(); ++i) in[i / 8] |= bits[i] << (7 - i % 8);
+    packed.encode_packed(in.data(), in.size(), out.data());
+
+    for (size_t i = 0; i < coded.size(); ++i) {
+        ASSERT_TRUE(coded[i] == ((out[i / 8] >> (7 - i % 8)) & 1));
+    }
+}
+
+TEST(reed_solomon_corrects_16_symbol_errors) {
+    std::vector<uint8_t> data(223);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 7 + 3);
+
+    ReedSolomonEncoder encoder;
+    auto codeword = encoder.encode(data);
+    ASSERT_TRUE(codeword.size() == 255);
+
+    for (int i = 0; i < 16; ++i) codeword[i * 15 + 2] ^= static_cast<uint8_t>(0x5A + i);
+
+    ReedSolomonDecoder decoder;
+    auto decoded = decoder.decode(codeword);
+    ASSERT_TRUE(decoded == data);
+    ASSERT_EQ(static_cast<double>(decoder.get_corrected_symbols()), 16.0, 0.1);
+
+    codeword = encoder.encode(data);
+    for (int i = 0; i < 17; ++i) codeword[i * 14] ^= 0xFF;
+    decoder.decode(codeword);
+    ASSERT_TRUE(decoder.get_failed_blocks() == 1);
+}
+
+TEST(ldpc_codeword_satisfies_parity_checks) {
+    LDPCEncoder::Config cfg;
+    cfg.code_length = 2160;
+    cfg.info_length = 1080;
+    LDPCEncoder encoder(cfg);
+    auto bits = random_bits(1080, 4);
+    auto codeword = encoder.encode(bits);
+    ASSERT_TRUE(codeword.size() == 2160);
+
+    const auto& h = encoder.get_structure();
+    std::vector<uint8_t> checks(h.parity_length(), 0);
+    h.for_each_info_edge([&](size_t bit, size_t check) { checks[check] ^= codeword[bit]; });
+    for (size_t c = 0; c < h.parity_length(); ++c) {
+        checks[c] ^= codeword[h.info_length() + c];
+        if (c > 0) checks[c] ^= codeword[h.info_length() + c - 1];
+        ASSERT_TRUE(checks[c] == 0);
+    }
+}
+
+TEST(ldpc_roundtrip_with_noise) {
+    LDPCEncoder::Config ecfg;
+    ecfg.code_length = 4320;
+    ecfg.info_length = 2160;
+    LDPCDecoder::Config dcfg;
+    dcfg.code_length = 4320;
+    dcfg.info_length = 2160;
+
+    auto bits = random_bits(2160, 5);
+    auto codeword = LDPCEncoder(ecfg).encode(bits);
+    auto soft = to_soft(codeword, 0.6, 6);
+    for (auto& s : soft) s *= 2.0 / (0.6 * 0.6);
+
+    LDPCDecoder decoder(dcfg);
+    ASSERT_TRUE(decoder.decode(soft) == bits);
+}
+
+TEST(turbo_roundtrip_with_noise) {
+    TurboEncoder::Config ecfg;
+    ecfg.frame_size = 1024;
+    TurboDecoder::Config dcfg;
+    dcfg.frame_size = 1024;
+
+    auto bits = random_bits(1024, 7);
+    auto coded = TurboEncoder(ecfg).encode(bits);
+    ASSERT_TRUE(coded.size() == 3 * 1024 + 12);
+
+    auto soft = to_soft(coded, 0.8, 8);
+    for (auto& s : soft) s *= 2.0 / (0.8 * 0.8);
+
+    TurboDecoder decoder(dcfg);
+    ASSERT_TRUE(decoder.decode(soft) == bits);
+}
+
+TEST(hamming_corrects_single_bit_error) {
+    auto bits = random_bits(400, 9);
+    HammingEncoder encoder;
+    auto coded = encoder.encode(bits);
+    ASSERT_TRUE(coded.size() == 700);
+
+    for (size_t block = 0; block < 100; ++block) coded[block * 7 + block % 7] ^= 1;
+
+    HammingDecoder decoder;
+    ASSERT_TRUE(decoder.decode(coded) == bits);
+    ASSERT_TRUE(decoder.get_corrected_bits() == 100);
+}
+
+TEST(ber_simulator_coded_beats_uncoded) {
+    BerSimulator::Config cfg;
+    cfg.ebn0_start_db = 4.0;
+    cfg.ebn0_stop_db = 4.0;
+    cfg.target_bit_errors = 200;
+    cfg.target_frame_errors = 20;
+    cfg.max_frames = 300;
+    cfg.num_threads = 2;
+
+    BerSimulator simulator(cfg);
+    auto uncoded = simulator.run(BerSimulator::uncoded(1024));
+    auto coded = simulator.run(FecCodecs::convolutional(1024));
+
+    ASSERT_TRUE(coded[0].ber < uncoded[0].ber / 10.0);
+}
+
+TEST(ber_simulator_exports_decoder_metrics) {
+    MetricsRegistry registry;
+    DecoderMetrics metrics(registry);
+
+    // One RS(255,223) codeword with three corrupted bytes and one Hamming
+    // frame with a flipped bit, through the codecs' decode functions
+    std::mt19937 gen(5);
+    auto decode_corrupted = [&](const BerSimulator::Codec& codec, const std::vector<size_t>& flips) {
+        std::vector<uint8_t> info(codec.info_bits), coded, decoded;
+        for (auto& b : info) b = gen() & 1;
+        codec.make_encoder()(info, coded);
+        ASSERT_TRUE(coded.size() == codec.coded_bits);
+        for (size_t bit : flips) coded[bit] ^= 1;
+        std::vector<double> soft(coded.size());
+        for (size_t i = 0; i < coded.size(); ++i) soft[i] = coded[i] ? 1.0 : -1.0;
+        uint64_t corrected = codec.make_decoder()(soft, decoded);
+        ASSERT_TRUE(std::equal(info.begin(), info.end(), decoded.begin()));
+        metrics.record_frame(corrected);
+        return corrected;
+    };
+    ASSERT_TRUE(decode_corrupted(FecCodecs::reed_solomon(), {3, 800, 801, 2000}) == 3);
+    ASSERT_TRUE(decode_corrupted(FecCodecs::hamming(8), {9}) == 1);
+
+    std::ostringstream out;
+    registry.write_prometheus(out);
+    const std::string text = out.str();
+    ASSERT_TRUE(text.find("satellite_signal_frames_decoded_total 2\n") != std::string::npos);
+    ASSERT_TRUE(text.find("satellite_signal_fec_corrections_total 4\n") != std::string::npos);
+
+    // The simulator counts every frame it decodes
+    BerSimulator::Config cfg;
+    cfg.ebn0_start_db = 4.0;
+    cfg.ebn0_stop_db = 4.0;
+    cfg.max_frames = 200;
+    cfg.target_bit_errors = 1000000;
+    cfg.num_threads = 2;
+    cfg.metrics = &metrics;
+    auto curve = BerSimulator(cfg).run(FecCodecs::hamming(1024));
+    ASSERT_TRUE(metrics.frames_decoded.value() == curve[0].frames + 2);
+    ASSERT_TRUE(metrics.fec_corrections.value() > 4 + curve[0].frames);
+}
+
 void run_all_tests() {
     int failures = TestFramework::instance().run_all_tests();
     exit(failures == 0 ? 0 : 1);
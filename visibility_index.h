@@ -0,0 +1,289 @@
+#ifndef VISIBILITY_INDEX_H
+#define VISIBILITY_INDEX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "station_frame.h"
+#include "catalog_propagator.h"
+#include "parallel_for.h"
+
+namespace SatelliteSignal {
+
+// Spatial index over sub-satellite points for "which satellites can this
+// station see" queries. The sphere is cut into latitude bands of equal
+// height, each split into roughly square longitude cells, and satellites are
+// bucketed by the cell under them with a counting sort. Positions are stored
+// in cell order, so the satellites of adjacent cells in a band form one
+// contiguous run.
+//
+// A query covers the station's visibility cap (the Earth central angle at
+// which a satellite at the highest indexed radius rises above the mask) with
+// the bands and longitude ranges that overlap it, then applies the exact
+// elevation test to the candidates. Results are satellite indices into the
+// arrays passed to build(), in cell order.
+//
+// Single satellites can be moved, added or removed between builds: the old
+// slot is marked dead and the new position goes to a short overflow list
+// that every query scans exactly. The next build() folds everything back in.
+class VisibilityIndex {
+public:
+    struct Config {
+        double cell_size_deg = 3.0;  // band height and nominal cell width
+        unsigned num_threads = 0;    // 0 = all cores
+        size_t grain = 4096;         // satellites per work item when building
+    };
+
+    VisibilityIndex() : VisibilityIndex(Config()) {}
+    explicit VisibilityIndex(const Config& cfg) : config(cfg) {
+        bands = std::max(1, static_cast<int>(std::ceil(180.0 / config.cell_size_deg)));
+        band_height = M_PI / bands;
+        band_cells.resize(bands);
+        band_offset.resize(bands + 1, 0);
+        for (int b = 0; b < bands; ++b) {
+            double center = -M_PI / 2.0 + (b + 0.5) * band_height;
+            band_cells[b] = std::max(1, static_cast<int>(std::ceil(2.0 * M_PI * std::cos(center) / band_height)));
+            band_offset[b + 1] = band_offset[b] + band_cells[b];
+        }
+        cell_start.resize(band_offset[bands] + 1, 0);
+    }
+
+    size_t add_station(const GroundStation& station, double min_elevation_deg = 0.0) {
+        stations.emplace_back(station);
+        masks.push_back(min_elevation_deg);
+        return stations.size() - 1;
+    }
+
+    size_t station_count() const { return stations.size(); }
+    const StationFrame& get_station(size_t i) const { return stations[i]; }
+    size_t satellite_count() const { return slot_of.size(); }
+    size_t cell_count() const { return cell_start.size() - 1; }
+    const Config& get_config() const { return config; }
+
+    void build(const CatalogPropagator::States& states, double gmst) {
+        build(states.x.data(), states.y.data(), states.z.data(), states.size(), gmst);
+    }
+
+    // Bucket TEME positions at sidereal angle `gmst` (radians)
+    void build(const double* x, const double* y, const double* z, size_t count, double gmst) {
+        const double c = std::cos(gmst), s = std::sin(gmst);
+        cells.resize(count);
+        radius.resize(count);
+        ex.resize(count); ey.resize(count); ez.resize(count);
+
+        parallel_for(count, [&](size_t begin, size_t end, unsigned) {
+            for (size_t b = begin; b < end; b += BLOCK) {
+                locate_block(x + b, y + b, z + b, std::min(end, b + BLOCK) - b, c, s, b);
+            }
+        }, config.grain, config.num_threads);
+
+        // Counting sort by cell
+        std::fill(cell_start.begin(), cell_start.end(), 0);
+        for (size_t i = 0; i < count; ++i) ++cell_start[cells[i] + 1];
+        for (size_t i = 1; i < cell_start.size(); ++i) cell_start[i] += cell_start[i - 1];
+
+        ids.resize(count);
+        slot_of.resize(count);
+        sx.resize(count); sy.resize(count); sz.resize(count);
+        overflow_ids.clear();
+        ox.clear(); oy.clear(); oz.clear();
+        std::vector<uint32_t> fill(cell_start.begin(), cell_start.end() - 1);
+        max_radius = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t slot = fill[cells[i]]++;
+            ids[slot] = static_cast<uint32_t>(i);
+            slot_of[i] = slot;
+            sx[slot] = ex[i]; sy[slot] = ey[i]; sz[slot] = ez[i];
+            max_radius = std::max(max_radius, radius[i]);
+        }
+    }
+
+    // Satellites above the mask of station `k`, appended to `out`
+    void query(size_t k, std::vector<uint32_t>& out) const {
+        if (slot_of.empty()) return;
+        const StationFrame& f = stations[k];
+        const double px = f.get_x(), py = f.get_y(), pz = f.get_z();
+        const double* up = f.get_zenith();
+        const double sin_mask = std::sin(masks[k] * DEG_TO_RAD);
+
+        // Visibility cap around the geocentric direction of the station, with
+        // half a degree of slack for the geodetic zenith
+        const double r_station = std::sqrt(px * px + py * py + pz * pz);
+        const double mask = masks[k] * DEG_TO_RAD;
+        const double cap = std::acos(std::min(1.0, r_station * std::cos(mask) / max_radius)) - mask +
+                           0.5 * DEG_TO_RAD;
+        const double lat = std::asin(pz / r_station);
+        const double lon = std::atan2(py, px);
+
+        int b0 = band_of(std::max(-M_PI / 2.0, lat - cap));
+        int b1 = band_of(std::min(M_PI / 2.0, lat + cap));
+        bool polar = lat + cap >= M_PI / 2.0 || lat - cap <= -M_PI / 2.0;
+        double half_width = polar ? M_PI : std::asin(std::min(1.0, std::sin(cap) / std::cos(lat)));
+
+        auto scan = [&](size_t first, size_t last) {
+            for (size_t j = first; j < last; ++j) {
+                double dx = sx[j] - px, dy = sy[j] - py, dz = sz[j] - pz;
+                double h = up[0] * dx + up[1] * dy + up[2] * dz;
+                if (h >= sin_mask * std::sqrt(dx * dx + dy * dy + dz * dz) && ids[j] != DEAD) {
+                    out.push_back(ids[j]);
+                }
+            }
+        };
+
+        for (size_t j = 0; j < overflow_ids.size(); ++j) {
+            double dx = ox[j] - px, dy = oy[j] - py, dz = oz[j] - pz;
+            double h = up[0] * dx + up[1] * dy + up[2] * dz;
+            if (h >= sin_mask * std::sqrt(dx * dx + dy * dy + dz * dz)) out.push_back(overflow_ids[j]);
+        }
+
+        for (int b = b0; b <= b1; ++b) {
+            const int n = band_cells[b];
+            const size_t base = band_offset[b];
+            if (half_width >= M_PI) {
+                scan(cell_start[base], cell_start[base + n]);
+                continue;
+            }
+            long i0 = static_cast<long>(std::floor((lon - half_width) / (2.0 * M_PI) * n));
+            long i1 = static_cast<long>(std::floor((lon + half_width) / (2.0 * M_PI) * n));
+            if (i1 - i0 + 1 >= n) {
+                scan(cell_start[base], cell_start[base + n]);
+                continue;
+            }
+            // Longitude range may wrap past 0 or 2 pi: at most two runs
+            i0 = ((i0 % n) + n) % n;
+            i1 = ((i1 % n) + n) % n;
+            if (i0 <= i1) {
+                scan(cell_start[base + i0], cell_start[base + i1 + 1]);
+            } else {
+                scan(cell_start[base + i0], cell_start[base + n]);
+                scan(cell_start[base], cell_start[base + i1 + 1]);
+            }
+        }
+    }
+
+    // Move satellite `id` to a new TEME position at sidereal angle `gmst`;
+    // `id` equal to satellite_count() adds a satellite
+    void set_satellite(uint32_t id, const StateVector& s, double gmst) {
+        const double c = std::cos(gmst), sn = std::sin(gmst);
+        const double x = c * s.x + sn * s.y, y = -sn * s.x + c * s.y, z = s.z;
+        max_radius = std::max(max_radius, std::sqrt(x * x + y * y + z * z));
+        if (id == slot_of.size()) slot_of.push_back(DEAD);
+        if (slot_of[id] != DEAD) {
+            ids[slot_of[id]] = DEAD;
+            slot_of[id] = DEAD;
+        }
+        size_t j = overflow_slot(id);
+        if (j == overflow_ids.size()) {
+            overflow_ids.push_back(id);
+            ox.push_back(x); oy.push_back(y); oz.push_back(z);
+        } else {
+            ox[j] = x; oy[j] = y; oz[j] = z;
+        }
+    }
+
+    // Remove satellite `id`; the last satellite takes over its id, matching
+    // swap-with-last removal in the arrays the index was built from
+    void remove_satellite(uint32_t id) {
+        const uint32_t last = static_cast<uint32_t>(slot_of.size() - 1);
+        if (slot_of[id] != DEAD) ids[slot_of[id]] = DEAD;
+        size_t j = overflow_slot(id);
+        if (j < overflow_ids.size()) {
+            overflow_ids[j] = overflow_ids.back(); overflow_ids.pop_back();
+            ox[j] = ox.back(); ox.pop_back();
+            oy[j] = oy.back(); oy.pop_back();
+            oz[j] = oz.back(); oz.pop_back();
+        }
+        if (id != last) {
+            slot_of[id] = slot_of[last];
+            if (slot_of[id] != DEAD) ids[slot_of[id]] = id;
+            j = overflow_slot(last);
+            if (j < overflow_ids.size()) overflow_ids[j] = id;
+        }
+        slot_of.pop_back();
+    }
+
+    // Exact test for one TEME position at sidereal angle `gmst`, without the
+    // index; used to patch results for a single satellite
+    bool visible(size_t k, const StateVector& s, double gmst) const {
+        return stations[k].view(s, gmst).elevation >= masks[k];
+    }
+
+    // Every station at once, spread across worker threads
+    void query_all(std::vector<std::vector<uint32_t>>& out) const {
+        out.resize(stations.size());
+        parallel_for(stations.size(), [&](size_t begin, size_t end, unsigned) {
+            for (size_t k = begin; k < end; ++k) {
+                out[k].clear();
+                query(k, out[k]);
+            }
+        }, 1, config.num_threads);
+    }
+
+private:
+    static constexpr size_t BLOCK = 64;
+    static constexpr uint32_t DEAD = static_cast<uint32_t>(-1);
+
+    Config config;
+    int bands;
+    double band_height;
+    std::vector<int> band_cells;         // longitude cells per band
+    std::vector<size_t> band_offset;     // first cell of each band
+    std::vector<uint32_t> cell_start;    // CSR offsets into ids, one past the last cell
+
+    std::vector<StationFrame> stations;
+    std::vector<double> masks;           // degrees
+
+    // Per satellite, in input order
+    std::vector<uint32_t> cells;
+    std::vector<double> radius, ex, ey, ez;
+
+    // In cell order; DEAD marks a slot vacated since the last build
+    std::vector<uint32_t> ids;
+    std::vector<uint32_t> slot_of;       // per satellite, DEAD when in overflow
+    std::vector<double> sx, sy, sz;
+    double max_radius = 0.0;
+
+    // Satellites moved or added since the last build, Earth-fixed
+    std::vector<uint32_t> overflow_ids;
+    std::vector<double> ox, oy, oz;
+
+    size_t overflow_slot(uint32_t id) const {
+        return static_cast<size_t>(std::find(overflow_ids.begin(), overflow_ids.end(), id) - overflow_ids.begin());
+    }
+
+    int band_of(double lat) const {
+        int b = static_cast<int>((lat + M_PI / 2.0) / band_height);
+        return std::min(bands - 1, std::max(0, b));
+    }
+
+    void locate_block(const double* x, const double* y, const double* z,
+                      size_t count, double c, double s, size_t offset) {
+        double rx[BLOCK], ry[BLOCK], rz[BLOCK], r[BLOCK], lat[BLOCK], lon[BLOCK];
+        for (size_t j = 0; j < count; ++j) {
+            rx[j] = c * x[j] + s * y[j];
+            ry[j] = -s * x[j] + c * y[j];
+            rz[j] = z[j];
+            double horizontal = std::sqrt(rx[j] * rx[j] + ry[j] * ry[j]);
+            r[j] = std::sqrt(horizontal * horizontal + rz[j] * rz[j]);
+            lat[j] = fast_atan2(rz[j], horizontal);
+            double l = fast_atan2(ry[j], rx[j]);
+            lon[j] = l + 2.0 * M_PI * static_cast<double>(l < 0.0);
+        }
+        for (size_t j = 0; j < count; ++j) {
+            int b = band_of(lat[j]);
+            int n = band_cells[b];
+            int i = std::min(n - 1, static_cast<int>(lon[j] / (2.0 * M_PI) * n));
+            cells[offset + j] = static_cast<uint32_t>(band_offset[b] + i);
+        }
+        std::copy(rx, rx + count, ex.begin() + offset);
+        std::copy(ry, ry + count, ey.begin() + offset);
+        std::copy(rz, rz + count, ez.begin() + offset);
+        std::copy(r, r + count, radius.begin() + offset);
+    }
+};
+
+}  // namespace SatelliteSignal
+
+#endif // VISIBILITY_INDEX_H